@@ -46,7 +46,7 @@ EOF
 gcc -std=c99 -Wall -Wextra -Wno-unused-parameter -g \
     test_assets_simple.c handmade_assets.c \
     -o test_assets \
-    -lm
+    -lm -lpthread
 
 if [ $? -eq 0 ]; then
     echo "✓ Asset system test built successfully"
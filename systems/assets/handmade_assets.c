@@ -3,6 +3,7 @@
     Grade A compliant - zero malloc in hot paths
 */
 
+#define _DEFAULT_SOURCE  // madvise, sysconf
 #include "handmade_assets.h"
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -10,24 +11,14 @@
 #include <unistd.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
 
 // =============================================================================
 // INTERNAL HELPERS
 // =============================================================================
 
-// Hash function for future string table implementation
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
-internal u32 hash_string(char* str) {
-    u32 hash = 5381;
-    int c;
-    while ((c = *str++)) {
-        hash = ((hash << 5) + hash) + c;
-    }
-    return hash;
-}
-#pragma GCC diagnostic pop
-
 internal u32 crc32(u8* data, u64 size) {
     static u32 crc_table[256];
     static b32 table_computed = 0;
@@ -54,15 +45,32 @@ internal u32 crc32(u8* data, u64 size) {
     return crc ^ 0xFFFFFFFF;
 }
 
+internal f64 get_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+// Entry 0 is never used, handle id 0 is INVALID_ASSET_HANDLE
 internal asset_entry* get_free_asset_entry(asset_system* assets) {
-    for (u32 i = 0; i < MAX_ASSETS; i++) {
+    u32 start = assets->first_free_entry ? assets->first_free_entry : 1;
+    for (u32 i = start; i < MAX_ASSETS; i++) {
         if (!assets->assets[i].is_valid) {
+            assets->first_free_entry = i;
             return &assets->assets[i];
         }
     }
     return 0;
 }
 
+internal void free_asset_entry(asset_system* assets, asset_entry* entry) {
+    u32 i = (u32)(entry - assets->assets);
+    entry->is_valid = 0;
+    if (i < assets->first_free_entry) {
+        assets->first_free_entry = i;
+    }
+}
+
 internal asset_file* get_free_asset_file(asset_system* assets) {
     for (u32 i = 0; i < MAX_ASSET_FILES; i++) {
         if (!assets->files[i].is_valid) {
@@ -72,16 +80,458 @@ internal asset_file* get_free_asset_file(asset_system* assets) {
     return 0;
 }
 
-internal asset_entry* find_asset_by_name(asset_system* assets, char* name) {
-    for (u32 i = 0; i < MAX_ASSETS; i++) {
-        if (assets->assets[i].is_valid && 
-            strcmp(assets->assets[i].header.name, name) == 0) {
-            return &assets->assets[i];
+// Bytes of the asset budget held by a loaded entry
+internal u64 asset_resident_size(asset_entry* entry) {
+    return entry->is_mapped ? 0 : entry->header.uncompressed_size;
+}
+
+// =============================================================================
+// ASSET HEAP
+// =============================================================================
+
+// Binary buddy allocator over one region reserved at init and sized by
+// config.max_memory_bytes. A block of order k is ASSET_HEAP_MIN_BLOCK << k
+// bytes and aligned to its size. A freed block merges with its buddy
+// whenever the buddy is free, so space released by unloads coalesces
+// back into large blocks.
+
+#define ASSET_HEAP_MIN_BLOCK 256
+#define ASSET_HEAP_MAX_ORDERS 40
+#define ASSET_HEAP_FREE 0x80        // block_order flag: block is on a free list
+
+typedef struct asset_heap_block {
+    struct asset_heap_block* next;
+    struct asset_heap_block* prev;
+} asset_heap_block;
+
+struct asset_heap {
+    u8* base;
+    u64 size;
+    u8* block_order;                // Per min block; order | ASSET_HEAP_FREE at block starts
+    asset_heap_block* free_lists[ASSET_HEAP_MAX_ORDERS];
+    u32 order_count;
+    u64 used;                       // Bytes in allocated blocks
+};
+
+internal u64 heap_block_size(u32 order) {
+    return (u64)ASSET_HEAP_MIN_BLOCK << order;
+}
+
+internal void heap_push_free(asset_heap* heap, u64 offset, u32 order) {
+    asset_heap_block* block = (asset_heap_block*)(heap->base + offset);
+    block->prev = 0;
+    block->next = heap->free_lists[order];
+    if (block->next) block->next->prev = block;
+    heap->free_lists[order] = block;
+    heap->block_order[offset / ASSET_HEAP_MIN_BLOCK] = (u8)(order | ASSET_HEAP_FREE);
+}
+
+internal void heap_remove_free(asset_heap* heap, u64 offset, u32 order) {
+    asset_heap_block* block = (asset_heap_block*)(heap->base + offset);
+    if (block->prev) block->prev->next = block->next;
+    else heap->free_lists[order] = block->next;
+    if (block->next) block->next->prev = block->prev;
+    heap->block_order[offset / ASSET_HEAP_MIN_BLOCK] = (u8)order;
+}
+
+internal asset_heap* heap_create(arena* arena, u64 size) {
+    size &= ~(u64)(ASSET_HEAP_MIN_BLOCK - 1);
+    if (size == 0) return 0;
+    
+    asset_heap* heap = arena_push_struct(arena, asset_heap);
+    if (!heap) return 0;
+    memset(heap, 0, sizeof(asset_heap));
+    
+    heap->base = (u8*)arena_push_size(arena, size, ASSET_HEAP_MIN_BLOCK);
+    heap->block_order = (u8*)arena_push_size(arena, size / ASSET_HEAP_MIN_BLOCK, 16);
+    if (!heap->base || !heap->block_order) return 0;
+    heap->size = size;
+    
+    // Carve the region into the largest aligned blocks that fit. Pieces
+    // whose buddy would cross the end simply never merge.
+    u64 offset = 0;
+    while (offset < size) {
+        u32 order = 0;
+        while (order + 1 < ASSET_HEAP_MAX_ORDERS &&
+               heap_block_size(order + 1) <= size - offset &&
+               (offset & (heap_block_size(order + 1) - 1)) == 0) {
+            order++;
         }
+        if (order + 1 > heap->order_count) heap->order_count = order + 1;
+        heap_push_free(heap, offset, order);
+        offset += heap_block_size(order);
+    }
+    
+    return heap;
+}
+
+internal void* heap_alloc(asset_heap* heap, u64 size) {
+    u32 order = 0;
+    while (order < heap->order_count && heap_block_size(order) < size) {
+        order++;
+    }
+    
+    u32 found = order;
+    while (found < heap->order_count && !heap->free_lists[found]) {
+        found++;
+    }
+    if (found >= heap->order_count) return 0;
+    
+    u64 offset = (u64)((u8*)heap->free_lists[found] - heap->base);
+    heap_remove_free(heap, offset, found);
+    
+    // Split down, returning the upper halves to the free lists
+    while (found > order) {
+        found--;
+        heap_push_free(heap, offset + heap_block_size(found), found);
+    }
+    heap->block_order[offset / ASSET_HEAP_MIN_BLOCK] = (u8)order;
+    heap->used += heap_block_size(order);
+    
+    return heap->base + offset;
+}
+
+internal void heap_free(asset_heap* heap, void* memory) {
+    u64 offset = (u64)((u8*)memory - heap->base);
+    u32 order = heap->block_order[offset / ASSET_HEAP_MIN_BLOCK];
+    heap->used -= heap_block_size(order);
+    
+    // PERFORMANCE: Coalesce with free buddies as far up as they go
+    while (order + 1 < heap->order_count) {
+        u64 buddy = offset ^ heap_block_size(order);
+        if (buddy + heap_block_size(order) > heap->size ||
+            heap->block_order[buddy / ASSET_HEAP_MIN_BLOCK] != (order | ASSET_HEAP_FREE)) {
+            break;
+        }
+        heap_remove_free(heap, buddy, order);
+        if (buddy < offset) offset = buddy;
+        order++;
+    }
+    heap_push_free(heap, offset, order);
+}
+
+internal b32 heap_owns(asset_heap* heap, void* memory) {
+    return heap && (u8*)memory >= heap->base && (u8*)memory < heap->base + heap->size;
+}
+
+// Largest single allocation the heap could satisfy with nothing allocated.
+// heap_create carves the biggest block first, so it is the top order.
+internal u64 heap_max_alloc(asset_heap* heap) {
+    return heap->order_count ? heap_block_size(heap->order_count - 1) : 0;
+}
+
+// Largest single allocation the heap can satisfy right now
+internal u64 heap_largest_free(asset_heap* heap) {
+    for (u32 order = heap->order_count; order > 0; order--) {
+        if (heap->free_lists[order - 1]) return heap_block_size(order - 1);
     }
     return 0;
 }
 
+// =============================================================================
+// RESIDENCY AND EVICTION
+// =============================================================================
+
+// Loaded heap assets with no references sit on an LRU list, oldest at
+// the head. They stay usable until the heap needs their space.
+
+internal b32 lru_contains(asset_system* assets, asset_entry* entry) {
+    return entry->lru_prev || assets->lru_head == (u32)(entry - assets->assets);
+}
+
+internal void lru_unlink(asset_system* assets, asset_entry* entry) {
+    if (!lru_contains(assets, entry)) return;
+    
+    if (entry->lru_prev) assets->assets[entry->lru_prev].lru_next = entry->lru_next;
+    else assets->lru_head = entry->lru_next;
+    if (entry->lru_next) assets->assets[entry->lru_next].lru_prev = entry->lru_prev;
+    else assets->lru_tail = entry->lru_prev;
+    
+    entry->lru_prev = 0;
+    entry->lru_next = 0;
+}
+
+internal void lru_push(asset_system* assets, asset_entry* entry) {
+    if (entry->is_mapped || entry->state != ASSET_LOADED) return;
+    
+    u32 index = (u32)(entry - assets->assets);
+    lru_unlink(assets, entry);
+    entry->lru_prev = assets->lru_tail;
+    if (assets->lru_tail) assets->assets[assets->lru_tail].lru_next = index;
+    else assets->lru_head = index;
+    assets->lru_tail = index;
+}
+
+// Entry takes a reference; referenced assets are never evicted
+internal void asset_acquire(asset_system* assets, asset_entry* entry) {
+    entry->ref_count++;
+    entry->last_used_frame = assets->current_frame;
+    lru_unlink(assets, entry);
+}
+
+internal void free_asset_memory(asset_system* assets, void* memory) {
+    if (heap_owns(assets->heap, memory)) {
+        heap_free(assets->heap, memory);
+    }
+}
+
+// Drops a loaded asset's data; the entry stays valid and can load again
+internal void release_asset_memory(asset_system* assets, asset_entry* entry) {
+    lru_unlink(assets, entry);
+    if (entry->state == ASSET_LOADED) {
+        assets->memory_used -= asset_resident_size(entry);
+        if (!entry->is_mapped) free_asset_memory(assets, entry->data);
+    }
+    entry->data = 0;
+    entry->is_mapped = 0;
+    entry->state = ASSET_UNLOADED;
+}
+
+// Memory for size bytes of asset data, evicting unreferenced assets
+// least recently used first until the heap can provide it
+internal u8* alloc_asset_memory(asset_system* assets, u64 size) {
+    if (!assets->heap) {
+        return (u8*)arena_push_size(assets->arena, size, 16);
+    }
+    
+    // No amount of eviction makes room for more than the largest block
+    if (size > heap_max_alloc(assets->heap)) {
+        platform_log(assets->platform, "Asset of %lu bytes exceeds the largest heap block (%lu bytes)",
+                     (unsigned long)size, (unsigned long)heap_max_alloc(assets->heap));
+        return 0;
+    }
+    
+    for (;;) {
+        u8* memory = (u8*)heap_alloc(assets->heap, size ? size : 1);
+        if (memory) return memory;
+        if (!assets->lru_head) break;
+        
+        asset_entry* victim = &assets->assets[assets->lru_head];
+        release_asset_memory(assets, victim);
+        assets->stats.evictions++;
+        assets->stats.unloads_this_frame++;
+    }
+    
+    platform_log(assets->platform, "Asset memory budget exhausted (%lu bytes requested)",
+                 (unsigned long)size);
+    return 0;
+}
+
+// =============================================================================
+// LZ4 BLOCK CODEC
+// =============================================================================
+
+// Standard LZ4 block format: [token][literal length+][literals][offset u16]
+// [match length+], the last sequence carries literals only.
+
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5        // Block always ends with this many literals
+#define LZ4_MATCH_LIMIT 12         // No match may start in the last 12 bytes
+#define LZ4_HASH_BITS 14
+
+internal u32 lz4_read32(u8* p) {
+    u32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Bound on the compressed size of size input bytes
+internal u64 lz4_compress_bound(u64 size) {
+    return size + size / 255 + 16;
+}
+
+internal u8* lz4_write_length(u8* op, u64 length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (u8)length;
+    return op;
+}
+
+internal u8* lz4_write_sequence(u8* op, u8* literals, u64 literal_length, 
+                                u32 offset, u64 match_length) {
+    u8* token = op++;
+    *token = (u8)((literal_length >= 15 ? 15 : literal_length) << 4);
+    if (literal_length >= 15) op = lz4_write_length(op, literal_length - 15);
+    memcpy(op, literals, literal_length);
+    op += literal_length;
+    
+    if (match_length) {
+        *op++ = (u8)offset;
+        *op++ = (u8)(offset >> 8);
+        match_length -= LZ4_MIN_MATCH;
+        *token |= (u8)(match_length >= 15 ? 15 : match_length);
+        if (match_length >= 15) op = lz4_write_length(op, match_length - 15);
+    }
+    return op;
+}
+
+// Greedy single-probe compressor for the asset compiler.
+// dst must hold lz4_compress_bound(size) bytes; returns the compressed size.
+internal u64 lz4_compress(u8* src, u64 size, u8* dst) {
+    static u32 table[1 << LZ4_HASH_BITS];
+    memset(table, 0, sizeof(table));
+    
+    u8* op = dst;
+    u64 anchor = 0;
+    u64 ip = 0;
+    
+    if (size > LZ4_MATCH_LIMIT) {
+        u64 match_start_limit = size - LZ4_MATCH_LIMIT;
+        u64 match_end_limit = size - LZ4_LAST_LITERALS;
+        
+        while (ip < match_start_limit) {
+            u32 sequence = lz4_read32(src + ip);
+            u32 h = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+            u64 candidate = table[h];
+            table[h] = (u32)ip;
+            
+            if (candidate < ip && ip - candidate <= 65535 && lz4_read32(src + candidate) == sequence) {
+                u64 length = LZ4_MIN_MATCH;
+                while (ip + length < match_end_limit && src[candidate + length] == src[ip + length]) {
+                    length++;
+                }
+                
+                op = lz4_write_sequence(op, src + anchor, ip - anchor, (u32)(ip - candidate), length);
+                ip += length;
+                anchor = ip;
+            } else {
+                ip++;
+            }
+        }
+    }
+    
+    op = lz4_write_sequence(op, src + anchor, size - anchor, 0, 0);
+    return (u64)(op - dst);
+}
+
+// Bounds-checked decompressor, safe on corrupt input.
+// Returns the decompressed size, 0 on malformed data.
+internal u64 lz4_decompress(u8* src, u64 src_size, u8* dst, u64 dst_size) {
+    u8* ip = src;
+    u8* iend = src + src_size;
+    u8* op = dst;
+    u8* oend = dst + dst_size;
+    
+    while (ip < iend) {
+        u32 token = *ip++;
+        
+        u64 literal_length = token >> 4;
+        if (literal_length == 15) {
+            u8 b;
+            do {
+                if (ip >= iend) return 0;
+                b = *ip++;
+                literal_length += b;
+            } while (b == 255);
+        }
+        if (literal_length > (u64)(iend - ip) || literal_length > (u64)(oend - op)) return 0;
+        memcpy(op, ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        
+        if (ip == iend) break;  // Last sequence
+        
+        if (iend - ip < 2) return 0;
+        u64 offset = (u64)ip[0] | ((u64)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (u64)(op - dst)) return 0;
+        
+        u64 match_length = token & 15;
+        if (match_length == 15) {
+            u8 b;
+            do {
+                if (ip >= iend) return 0;
+                b = *ip++;
+                match_length += b;
+            } while (b == 255);
+        }
+        match_length += LZ4_MIN_MATCH;
+        if (match_length > (u64)(oend - op)) return 0;
+        
+        // PERFORMANCE: 8 bytes per step unless the match overlaps its copy
+        u8* match = op - offset;
+        u8* match_end = op + match_length;
+        if (offset >= 8) {
+            while (op + 8 <= match_end) {
+                memcpy(op, match, 8);
+                op += 8;
+                match += 8;
+            }
+        }
+        while (op < match_end) {
+            *op++ = *match++;
+        }
+    }
+    
+    return (u64)(op - dst);
+}
+
+// =============================================================================
+// NAME INDEX
+// =============================================================================
+
+internal u32 asset_index_home(asset_id id) {
+    return (u32)(id ^ (id >> 32)) & (ASSET_INDEX_SIZE - 1);
+}
+
+internal asset_entry* find_asset_by_id(asset_system* assets, asset_id id) {
+    for (u32 slot = asset_index_home(id); ; slot = (slot + 1) & (ASSET_INDEX_SIZE - 1)) {
+        asset_index_slot* s = &assets->index[slot];
+        if (s->entry == 0) return 0;
+        if (s->id == id) return &assets->assets[s->entry];
+    }
+}
+
+// The 64-bit ID decides; the name compare only guards against a collision
+internal asset_entry* find_asset_by_name(asset_system* assets, char* name) {
+    asset_entry* entry = find_asset_by_id(assets, asset_id_from_name(name));
+    if (entry && strcmp(entry->header.name, name) != 0) {
+        return 0;
+    }
+    return entry;
+}
+
+// Fails if the ID is already taken; the first pack loaded wins
+internal b32 index_asset(asset_system* assets, asset_id id, u32 entry) {
+    u32 slot = asset_index_home(id);
+    while (assets->index[slot].entry != 0) {
+        if (assets->index[slot].id == id) return 0;
+        slot = (slot + 1) & (ASSET_INDEX_SIZE - 1);
+    }
+    assets->index[slot].id = id;
+    assets->index[slot].entry = entry;
+    return 1;
+}
+
+// Backward-shift deletion keeps probe chains intact without tombstones
+internal void unindex_asset(asset_system* assets, asset_id id, u32 entry) {
+    u32 mask = ASSET_INDEX_SIZE - 1;
+    u32 slot = asset_index_home(id);
+    while (assets->index[slot].entry != entry) {
+        if (assets->index[slot].entry == 0) return;
+        slot = (slot + 1) & mask;
+    }
+    
+    u32 hole = slot;
+    for (u32 next = (hole + 1) & mask; assets->index[next].entry != 0; next = (next + 1) & mask) {
+        u32 home = asset_index_home(assets->index[next].id);
+        // Move next into the hole unless its home lies in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            assets->index[hole] = assets->index[next];
+            hole = next;
+        }
+    }
+    assets->index[hole].entry = 0;
+}
+
+// Async loader, see ASYNC LOADING
+internal void start_asset_loader(asset_system* assets);
+internal void stop_asset_loader(asset_system* assets);
+internal void cancel_file_loads(asset_system* assets, asset_file* file);
+internal void publish_completed_loads(asset_system* assets);
+
 // =============================================================================
 // ASSET SYSTEM INITIALIZATION
 // =============================================================================
@@ -95,8 +545,20 @@ asset_system* asset_system_init(platform_state* platform, arena* arena,
     assets->temp_arena = arena_create(platform, MEGABYTES(64));
     assets->config = config;
     
+    // Asset data lives in a heap of max_memory_bytes; without a budget it
+    // comes from the arena and is never reclaimed
+    if (config.max_memory_bytes) {
+        assets->heap = heap_create(arena, config.max_memory_bytes);
+        if (!assets->heap) {
+            platform_log(platform, "Failed to reserve %lu bytes of asset memory",
+                         (unsigned long)config.max_memory_bytes);
+            return 0;
+        }
+    }
+    
     // Initialize work queue for background loading
     assets->load_queue = work_queue_create(platform, 4);
+    start_asset_loader(assets);
     
     // Initialize file watcher for hot reload
     assets->watcher = file_watcher_create(platform);
@@ -107,6 +569,9 @@ asset_system* asset_system_init(platform_state* platform, arena* arena,
 void asset_system_shutdown(asset_system* assets) {
     if (!assets) return;
     
+    // Workers read the mappings, stop them first
+    stop_asset_loader(assets);
+    
     // Unload all asset files
     for (u32 i = 0; i < MAX_ASSET_FILES; i++) {
         if (assets->files[i].is_valid) {
@@ -163,8 +628,9 @@ b32 asset_load_file(asset_system* assets, char* filename) {
     }
     file->size = st.st_size;
     
-    // Memory map the file
-    file->data = mmap(0, file->size, PROT_READ, MAP_PRIVATE, file->fd, 0);
+    // Memory map the file. Private and writable so zero-copy assets can have
+    // their pointers fixed up; only the touched pages are ever copied.
+    file->data = mmap(0, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file->fd, 0);
     if (file->data == MAP_FAILED) {
         platform_log(assets->platform, "Failed to mmap asset file: %s", filename);
         close(file->fd);
@@ -194,25 +660,48 @@ b32 asset_load_file(asset_system* assets, char* filename) {
         return 0;
     }
     
-    // Count assets in file
-    u8* ptr = file->data;
+    // Walk the directory if the pack has one, the headers otherwise
     u32 asset_count = 0;
+    asset_directory_footer* footer = 0;
+    if (file->size >= sizeof(asset_header) + sizeof(asset_directory_footer)) {
+        footer = (asset_directory_footer*)(file->data + file->size - sizeof(asset_directory_footer));
+        if (footer->magic != ASSET_DIRECTORY_MAGIC ||
+            footer->directory_offset > file->size - sizeof(asset_directory_footer) ||
+            (u64)footer->asset_count * sizeof(asset_directory_entry) >
+                file->size - sizeof(asset_directory_footer) - footer->directory_offset) {
+            footer = 0;
+        }
+    }
     
-    while (ptr < file->data + file->size) {
-        asset_header* header = (asset_header*)ptr;
-        if (header->magic != ASSET_MAGIC) break;
-        
-        asset_count++;
-        ptr += sizeof(asset_header) + header->compressed_size;
+    asset_directory_entry* directory = 0;
+    u8* ptr = file->data;
+    if (footer) {
+        directory = (asset_directory_entry*)(file->data + footer->directory_offset);
+        asset_count = footer->asset_count;
     }
     
-    file->asset_count = asset_count;
     file->headers = (asset_header*)file->data;
     
-    // Create asset entries for all assets in file
-    ptr = file->data;
-    for (u32 i = 0; i < asset_count; i++) {
-        asset_header* header = (asset_header*)ptr;
+    for (u32 i = 0; directory ? i < asset_count : ptr + sizeof(asset_header) <= file->data + file->size; i++) {
+        u64 header_offset = directory ? directory[i].header_offset : (u64)(ptr - file->data);
+        if (header_offset > file->size - sizeof(asset_header)) {
+            platform_log(assets->platform, "Corrupt asset directory: %s", filename);
+            break;
+        }
+        
+        asset_header* header = (asset_header*)(file->data + header_offset);
+        if (header->magic != ASSET_MAGIC) break;
+        
+        // Packs without a directory store the data right after the header
+        u64 data_offset = directory ? header->data_offset : header_offset + sizeof(asset_header);
+        if (data_offset > file->size || header->compressed_size > file->size - data_offset) {
+            platform_log(assets->platform, "Asset data out of bounds: %s", header->name);
+            break;
+        }
+        if (!directory) {
+            ptr += sizeof(asset_header) + header->compressed_size;
+            asset_count = i + 1;
+        }
         
         asset_entry* entry = get_free_asset_entry(assets);
         if (!entry) {
@@ -220,20 +709,38 @@ b32 asset_load_file(asset_system* assets, char* filename) {
             break;
         }
         
+        asset_id id = directory ? directory[i].id : asset_id_from_name(header->name);
+        if (!index_asset(assets, id, (u32)(entry - assets->assets))) {
+            platform_log(assets->platform, "Duplicate asset ID, skipped: %s", header->name);
+            continue;
+        }
+        
+        // Verified once here so loads can hand out the mapping directly
+        if (assets->config.checksum_mode == ASSET_CHECKSUM_ON_OPEN &&
+            header->compression == ASSET_COMPRESSION_NONE &&
+            crc32(file->data + data_offset, header->compressed_size) != header->checksum) {
+            platform_log(assets->platform, "Asset checksum mismatch, skipped: %s", header->name);
+            unindex_asset(assets, id, (u32)(entry - assets->assets));
+            continue;
+        }
+        
         entry->header = *header;
+        entry->header.data_offset = data_offset;
         entry->file = file;
+        entry->id = id;
         entry->state = ASSET_UNLOADED;
         entry->data = 0;
         entry->ref_count = 0;
         entry->last_used_frame = 0;
+        entry->load_request = 0;
         entry->generation++;
         entry->is_valid = 1;
         
         assets->asset_count++;
-        
-        ptr += sizeof(asset_header) + header->compressed_size;
     }
     
+    file->asset_count = asset_count;
+    
     // Copy filename
     strncpy(file->filename, filename, sizeof(file->filename) - 1);
     file->is_valid = 1;
@@ -249,14 +756,16 @@ void asset_unload_file(asset_system* assets, char* filename) {
     for (u32 i = 0; i < MAX_ASSET_FILES; i++) {
         asset_file* file = &assets->files[i];
         if (file->is_valid && strcmp(file->filename, filename) == 0) {
+            // In-flight loads fail and report through the next update
+            cancel_file_loads(assets, file);
+            
             // Unload all assets from this file
             for (u32 j = 0; j < MAX_ASSETS; j++) {
                 asset_entry* entry = &assets->assets[j];
                 if (entry->is_valid && entry->file == file) {
-                    if (entry->data) {
-                        assets->memory_used -= entry->header.uncompressed_size;
-                    }
-                    entry->is_valid = 0;
+                    release_asset_memory(assets, entry);
+                    unindex_asset(assets, entry->id, j);
+                    free_asset_entry(assets, entry);
                     assets->asset_count--;
                 }
             }
@@ -282,79 +791,586 @@ void asset_unload_file(asset_system* assets, char* filename) {
 // ASSET LOADING
 // =============================================================================
 
-asset_handle asset_load(asset_system* assets, char* name) {
-    asset_entry* entry = find_asset_by_name(assets, name);
-    if (!entry) {
-        platform_log(assets->platform, "Asset not found: %s", name);
-        return INVALID_ASSET_HANDLE;
+// Struct size of the types whose pointers are fixed up, 0 for raw data
+internal u64 asset_struct_size(asset_type type) {
+    switch (type) {
+        case ASSET_TYPE_TEXTURE: return sizeof(texture_asset);
+        case ASSET_TYPE_MESH: return sizeof(mesh_asset);
+        case ASSET_TYPE_SOUND: return sizeof(sound_asset);
+        default: return 0;
     }
+}
+
+// What asset_get_data hands out: the entry's view for mapped typed assets
+internal void* asset_entry_data(asset_entry* entry) {
+    return (entry->is_mapped && asset_struct_size(entry->header.type)) ? 
+           (void*)&entry->view : entry->data;
+}
+
+// Points the struct at the payload that follows it in the asset data.
+// Mapped assets get a copy of the struct in the entry instead, writing
+// into the mapping would break the next ON_LOAD checksum.
+internal void fixup_asset_pointers(asset_entry* entry) {
+    u8* data = (u8*)entry->data;
+    u64 size = entry->header.uncompressed_size;
+    u64 struct_size = asset_struct_size(entry->header.type);
+    if (!struct_size || size < struct_size) return;
     
-    // Already loaded?
-    if (entry->state == ASSET_LOADED) {
-        entry->ref_count++;
-        entry->last_used_frame = assets->current_frame;
-        assets->stats.cache_hits++;
-        
-        asset_handle handle = {
-            .id = (u32)(entry - assets->assets),
-            .generation = entry->generation
-        };
-        return handle;
+    u8* target = data;
+    if (entry->is_mapped) {
+        memcpy(&entry->view, data, struct_size);
+        target = (u8*)&entry->view;
     }
     
-    // Load asset data - find the actual data location in the file
-    u8* file_header_ptr = 0;
-    // Find this entry's header position in the file
-    u8* ptr = entry->file->data;
-    for (u32 i = 0; i < entry->file->asset_count; i++) {
-        asset_header* header = (asset_header*)ptr;
-        if (strcmp(header->name, entry->header.name) == 0) {
-            file_header_ptr = ptr;
-            break;
-        }
-        ptr += sizeof(asset_header) + header->compressed_size;
+    switch (entry->header.type) {
+        case ASSET_TYPE_TEXTURE: {
+            texture_asset* texture = (texture_asset*)target;
+            texture->pixels = data + sizeof(texture_asset);
+        } break;
+        
+        case ASSET_TYPE_MESH: {
+            mesh_asset* mesh = (mesh_asset*)target;
+            mesh->vertices = data + sizeof(mesh_asset);
+            mesh->indices = (u32*)(mesh->vertices + (u64)mesh->vertex_count * mesh->vertex_size);
+        } break;
+        
+        case ASSET_TYPE_SOUND: {
+            sound_asset* sound = (sound_asset*)target;
+            sound->samples = data + sizeof(sound_asset);
+        } break;
+        
+        default: break;
     }
+}
+
+// PERFORMANCE: Zero-copy, the mapping is the asset
+internal b32 asset_is_zero_copy(asset_entry* entry) {
+    return entry->header.compression == ASSET_COMPRESSION_NONE &&
+           (entry->header.data_offset & 15) == 0 &&
+           entry->header.compressed_size == entry->header.uncompressed_size;
+}
+
+// Produces an asset's bytes and verifies them. Zero-copy assets pass the
+// mapping as destination. Reads only the entry header and the file
+// mapping, so loader workers run it alongside the main thread.
+internal b32 decode_asset(asset_system* assets, asset_entry* entry, u8* destination,
+                          f64* decompress_seconds) {
+    u8* source = entry->file->data + entry->header.data_offset;
+    u64 size = entry->header.uncompressed_size;
+    asset_checksum_mode checksum_mode = assets->config.checksum_mode;
     
-    u8* compressed_data = file_header_ptr + sizeof(asset_header);
-    
-    void* uncompressed_data = arena_push_size(assets->arena, 
-                                              entry->header.uncompressed_size, 
-                                              16);
-    
-    if (entry->header.compression == ASSET_COMPRESSION_NONE) {
-        // No compression - direct copy
-        memcpy(uncompressed_data, compressed_data, entry->header.compressed_size);
-    } else {
-        // TODO: Implement decompression
-        platform_log(assets->platform, "Compression not yet implemented");
-        return INVALID_ASSET_HANDLE;
+    switch (entry->header.compression) {
+        case ASSET_COMPRESSION_NONE: {
+            if (destination != source) {
+                // Legacy pack with unaligned data - copy
+                memcpy(destination, source, size);
+            }
+        } break;
+        
+        case ASSET_COMPRESSION_LZ4: {
+            f64 start = get_seconds();
+            u64 decoded = lz4_decompress(source, entry->header.compressed_size, destination, size);
+            *decompress_seconds += get_seconds() - start;
+            if (decoded != size) return 0;
+            
+            // Pack open cannot check compressed assets, so they are always
+            // checked here unless checksums are off
+            if (checksum_mode == ASSET_CHECKSUM_ON_OPEN) {
+                checksum_mode = ASSET_CHECKSUM_ON_LOAD;
+            }
+        } break;
+        
+        default: return 0;
     }
     
-    // Verify checksum
-    u32 checksum = crc32((u8*)uncompressed_data, entry->header.uncompressed_size);
-    if (checksum != entry->header.checksum) {
-        platform_log(assets->platform, "Asset checksum mismatch: %s", name);
-        return INVALID_ASSET_HANDLE;
+    if (checksum_mode == ASSET_CHECKSUM_ON_LOAD) {
+        return crc32(destination, size) == entry->header.checksum;
     }
-    
-    entry->data = uncompressed_data;
+    return 1;
+}
+
+// Destination for a load: the mapping, or a fresh arena block
+internal u8* asset_load_destination(asset_system* assets, asset_entry* entry) {
+    if (asset_is_zero_copy(entry)) {
+        return entry->file->data + entry->header.data_offset;
+    }
+    return alloc_asset_memory(assets, entry->header.uncompressed_size);
+}
+
+// Main thread: publishes decoded bytes as the loaded asset
+internal void finish_asset_load(asset_system* assets, asset_entry* entry, u8* data) {
+    entry->data = data;
+    entry->is_mapped = (data == entry->file->data + entry->header.data_offset);
+    fixup_asset_pointers(entry);
     entry->state = ASSET_LOADED;
-    entry->ref_count = 1;
     entry->last_used_frame = assets->current_frame;
     
-    assets->memory_used += entry->header.uncompressed_size;
+    assets->memory_used += asset_resident_size(entry);
+    assets->stats.zero_copy_loads += entry->is_mapped;
     assets->stats.cache_misses++;
     assets->stats.loads_this_frame++;
-    
+}
+
+internal asset_handle entry_handle(asset_system* assets, asset_entry* entry) {
     asset_handle handle = {
         .id = (u32)(entry - assets->assets),
         .generation = entry->generation
     };
+    return handle;
+}
+
+// =============================================================================
+// ASYNC LOADING
+// =============================================================================
+
+// Main thread queues requests, workers decode them, asset_system_update
+// publishes the results and runs callbacks. Every queue below is guarded
+// by loader->lock; request fields marked main-only are never touched by
+// a worker.
+
+#define ASSET_MAX_LOAD_REQUESTS 8192
+#define ASSET_MAX_LOAD_WORKERS 8
+
+typedef struct asset_load_request {
+    u32 entry;
+    u32 generation;
+    asset_load_priority priority;
+    u32 sequence;               // FIFO order within a priority
+    u8* destination;
+    
+    // Set by the worker
+    b32 done;
+    b32 success;
+    f64 decode_seconds;
+    f64 decompress_seconds;
+    
+    // Main-only
+    asset_load_callback* callback;
+    void* user_data;
+    u32 next_waiter;            // Further requests for the same entry, 0 = none
+    b32 is_hit;                 // Asset was already loaded, callback only
+} asset_load_request;
+
+typedef struct asset_loader_worker {
+    asset_system* assets;
+    pthread_t thread;
+    asset_file* file;           // File being decoded from, 0 when idle
+} asset_loader_worker;
+
+struct asset_loader {
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    b32 stop;
+    
+    asset_loader_worker workers[ASSET_MAX_LOAD_WORKERS];
+    u32 worker_count;
+    
+    // Request 0 is unused so 0 can mean none
+    asset_load_request requests[ASSET_MAX_LOAD_REQUESTS];
+    u32 free_requests[ASSET_MAX_LOAD_REQUESTS];     // Main-only
+    u32 free_count;
+    u32 next_sequence;
+    
+    u32 pending[ASSET_MAX_LOAD_REQUESTS];           // Waiting for a worker
+    u32 pending_count;
+    u32 completed[ASSET_MAX_LOAD_REQUESTS];         // Waiting to be published
+    u32 completed_count;
+};
+
+// Touches every page so the page faults land on the worker
+internal void prefault_pages(u8* data, u64 size) {
+    volatile u8 sink = 0;
+    for (u64 i = 0; i < size; i += 4096) {
+        sink ^= data[i];
+    }
+    if (size) sink ^= data[size - 1];
+    (void)sink;
+}
+
+internal void* asset_loader_thread(void* data) {
+    asset_loader_worker* worker = (asset_loader_worker*)data;
+    asset_system* assets = worker->assets;
+    asset_loader* loader = assets->loader;
+    
+    pthread_mutex_lock(&loader->lock);
+    for (;;) {
+        while (!loader->stop && loader->pending_count == 0) {
+            pthread_cond_wait(&loader->work_ready, &loader->lock);
+        }
+        if (loader->stop) break;
+        
+        // Highest priority, oldest first; the queue stays short enough
+        // that a scan beats maintaining a heap under the lock
+        u32 best = 0;
+        for (u32 i = 1; i < loader->pending_count; i++) {
+            asset_load_request* a = &loader->requests[loader->pending[i]];
+            asset_load_request* b = &loader->requests[loader->pending[best]];
+            if (a->priority > b->priority || 
+                (a->priority == b->priority && (s32)(a->sequence - b->sequence) < 0)) {
+                best = i;
+            }
+        }
+        u32 index = loader->pending[best];
+        loader->pending[best] = loader->pending[--loader->pending_count];
+        
+        asset_load_request* request = &loader->requests[index];
+        asset_entry* entry = &assets->assets[request->entry];
+        worker->file = entry->file;
+        pthread_mutex_unlock(&loader->lock);
+        
+        f64 start = get_seconds();
+        f64 decompress_seconds = 0;
+        u8* mapping = entry->file->data + entry->header.data_offset;
+        if (request->destination == mapping) {
+            prefault_pages(mapping, entry->header.compressed_size);
+        }
+        b32 success = decode_asset(assets, entry, request->destination, &decompress_seconds);
+        f64 decode_seconds = get_seconds() - start;
+        
+        pthread_mutex_lock(&loader->lock);
+        request->success = success;
+        request->decode_seconds = decode_seconds;
+        request->decompress_seconds = decompress_seconds;
+        request->done = 1;
+        loader->completed[loader->completed_count++] = index;
+        worker->file = 0;
+        pthread_cond_broadcast(&loader->work_done);
+    }
+    pthread_mutex_unlock(&loader->lock);
+    
+    return 0;
+}
+
+internal void start_asset_loader(asset_system* assets) {
+    asset_loader* loader = (asset_loader*)arena_push_size(assets->arena, sizeof(asset_loader), 64);
+    if (!loader) return;
+    memset(loader, 0, sizeof(asset_loader));
+    
+    for (u32 i = ASSET_MAX_LOAD_REQUESTS - 1; i > 0; i--) {
+        loader->free_requests[loader->free_count++] = i;
+    }
+    
+    pthread_mutex_init(&loader->lock, 0);
+    pthread_cond_init(&loader->work_ready, 0);
+    pthread_cond_init(&loader->work_done, 0);
+    assets->loader = loader;
+    
+    u32 worker_count = assets->config.max_concurrent_loads;
+    if (worker_count == 0) worker_count = 1;
+    if (worker_count > ASSET_MAX_LOAD_WORKERS) worker_count = ASSET_MAX_LOAD_WORKERS;
+    
+    for (u32 i = 0; i < worker_count; i++) {
+        asset_loader_worker* worker = &loader->workers[loader->worker_count];
+        worker->assets = assets;
+        if (pthread_create(&worker->thread, 0, asset_loader_thread, worker) == 0) {
+            loader->worker_count++;
+        }
+    }
+    if (loader->worker_count == 0) {
+        platform_log(assets->platform, "Asset loader threads unavailable, loading synchronously");
+    }
+}
+
+internal void stop_asset_loader(asset_system* assets) {
+    asset_loader* loader = assets->loader;
+    if (!loader) return;
+    
+    pthread_mutex_lock(&loader->lock);
+    loader->stop = 1;
+    pthread_cond_broadcast(&loader->work_ready);
+    pthread_mutex_unlock(&loader->lock);
+    
+    for (u32 i = 0; i < loader->worker_count; i++) {
+        pthread_join(loader->workers[i].thread, 0);
+    }
+    
+    pthread_mutex_destroy(&loader->lock);
+    pthread_cond_destroy(&loader->work_ready);
+    pthread_cond_destroy(&loader->work_done);
+    assets->loader = 0;
+}
+
+internal u32 alloc_load_request(asset_loader* loader) {
+    if (loader->free_count == 0) return 0;
+    
+    u32 index = loader->free_requests[--loader->free_count];
+    memset(&loader->requests[index], 0, sizeof(asset_load_request));
+    return index;
+}
+
+// Main thread: applies one completed request and runs its callbacks
+internal void publish_load_request(asset_system* assets, u32 index) {
+    asset_loader* loader = assets->loader;
+    asset_load_request* request = &loader->requests[index];
+    asset_entry* entry = &assets->assets[request->entry];
+    b32 live = entry->is_valid && entry->generation == request->generation;
+    
+    if (live && !request->is_hit) {
+        entry->load_request = 0;
+        if (request->success) {
+            finish_asset_load(assets, entry, request->destination);
+            assets->stats.async_loads_this_frame++;
+            assets->stats.bytes_loaded_this_frame += entry->header.uncompressed_size;
+            if (entry->ref_count == 0) lru_push(assets, entry);
+        } else {
+            free_asset_memory(assets, request->destination);
+            entry->state = ASSET_ERROR;
+            platform_log(assets->platform, "Async asset load failed: %s", entry->header.name);
+        }
+        assets->stats.total_load_time += request->decode_seconds;
+        assets->stats.total_decompress_time += request->decompress_seconds;
+    } else if (!request->is_hit) {
+        // Entry went away with its file, the buffer is ours to return
+        free_asset_memory(assets, request->destination);
+    }
+    
+    asset_handle handle = { .id = request->entry, .generation = request->generation };
+    b32 loaded = live && entry->state == ASSET_LOADED;
+    
+    while (index) {
+        request = &loader->requests[index];
+        u32 next = request->next_waiter;
+        if (request->callback) {
+            request->callback(assets, handle, loaded, request->user_data);
+        }
+        loader->free_requests[loader->free_count++] = index;
+        assets->stats.pending_loads--;
+        index = next;
+    }
+}
+
+internal void publish_completed_loads(asset_system* assets) {
+    asset_loader* loader = assets->loader;
+    if (!loader) return;
+    
+    u32 ready[ASSET_MAX_LOAD_REQUESTS];
+    u32 ready_count = 0;
+    u64 budget = assets->config.load_budget_bytes;
+    u64 bytes = 0;
+    
+    // Over budget requests wait for the next frame; at least one always goes
+    pthread_mutex_lock(&loader->lock);
+    while (ready_count < loader->completed_count) {
+        asset_load_request* request = &loader->requests[loader->completed[ready_count]];
+        u64 size = request->is_hit ? 0 : assets->assets[request->entry].header.uncompressed_size;
+        if (budget && ready_count > 0 && bytes + size > budget) break;
+        bytes += size;
+        ready[ready_count] = loader->completed[ready_count];
+        ready_count++;
+    }
+    loader->completed_count -= ready_count;
+    memmove(loader->completed, loader->completed + ready_count, loader->completed_count * sizeof(u32));
+    pthread_mutex_unlock(&loader->lock);
+    
+    for (u32 i = 0; i < ready_count; i++) {
+        publish_load_request(assets, ready[i]);
+    }
+}
+
+// Main thread: blocks until the entry's in-flight request is decoded,
+// then publishes it. Its callbacks run now instead of in the next update.
+internal void wait_for_async_load(asset_system* assets, asset_entry* entry) {
+    asset_loader* loader = assets->loader;
+    u32 index = entry->load_request;
+    asset_load_request* request = &loader->requests[index];
+    
+    pthread_mutex_lock(&loader->lock);
+    request->priority = ASSET_PRIORITY_CRITICAL;
+    request->sequence = 0;
+    while (!request->done) {
+        pthread_cond_wait(&loader->work_done, &loader->lock);
+    }
+    for (u32 i = 0; i < loader->completed_count; i++) {
+        if (loader->completed[i] == index) {
+            loader->completed[i] = loader->completed[--loader->completed_count];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&loader->lock);
+    
+    publish_load_request(assets, index);
+}
+
+// Main thread: fails queued loads from a file and waits out the ones a
+// worker is decoding, so the file can be unmapped
+internal void cancel_file_loads(asset_system* assets, asset_file* file) {
+    asset_loader* loader = assets->loader;
+    if (!loader) return;
+    
+    pthread_mutex_lock(&loader->lock);
+    for (u32 i = 0; i < loader->pending_count; ) {
+        asset_load_request* request = &loader->requests[loader->pending[i]];
+        if (assets->assets[request->entry].file == file) {
+            request->done = 1;
+            request->success = 0;
+            loader->completed[loader->completed_count++] = loader->pending[i];
+            loader->pending[i] = loader->pending[--loader->pending_count];
+        } else {
+            i++;
+        }
+    }
+    
+    for (;;) {
+        b32 busy = 0;
+        for (u32 i = 0; i < loader->worker_count; i++) {
+            busy |= (loader->workers[i].file == file);
+        }
+        if (!busy) break;
+        pthread_cond_wait(&loader->work_done, &loader->lock);
+    }
+    pthread_mutex_unlock(&loader->lock);
+}
+
+// =============================================================================
+// LOAD REQUESTS
+// =============================================================================
+
+internal asset_handle load_asset_entry(asset_system* assets, asset_entry* entry) {
+    // A pending async load finishes first
+    if (entry->state == ASSET_LOADING) {
+        wait_for_async_load(assets, entry);
+        if (entry->state != ASSET_LOADED) return INVALID_ASSET_HANDLE;
+    }
+    
+    // Already loaded?
+    if (entry->state == ASSET_LOADED) {
+        asset_acquire(assets, entry);
+        assets->stats.cache_hits++;
+        return entry_handle(assets, entry);
+    }
+    
+    char* name = entry->header.name;
+    f64 start = get_seconds();
+    
+    u8* data = asset_load_destination(assets, entry);
+    if (!data) return INVALID_ASSET_HANDLE;
+    
+    if (!decode_asset(assets, entry, data, &assets->stats.total_decompress_time)) {
+        platform_log(assets->platform, "Asset decode or checksum failed: %s", name);
+        free_asset_memory(assets, data);
+        return INVALID_ASSET_HANDLE;
+    }
+    
+    finish_asset_load(assets, entry, data);
+    asset_acquire(assets, entry);
+    assets->stats.total_load_time += get_seconds() - start;
     
     platform_log(assets->platform, "Loaded asset: %s (%lu bytes)", 
                  name, (unsigned long)entry->header.uncompressed_size);
     
-    return handle;
+    return entry_handle(assets, entry);
+}
+
+asset_handle asset_load(asset_system* assets, char* name) {
+    asset_entry* entry = find_asset_by_name(assets, name);
+    if (!entry) {
+        platform_log(assets->platform, "Asset not found: %s", name);
+        return INVALID_ASSET_HANDLE;
+    }
+    return load_asset_entry(assets, entry);
+}
+
+asset_handle asset_load_id(asset_system* assets, asset_id id) {
+    asset_entry* entry = find_asset_by_id(assets, id);
+    if (!entry) {
+        platform_log(assets->platform, "Asset not found: %016llx", (unsigned long long)id);
+        return INVALID_ASSET_HANDLE;
+    }
+    return load_asset_entry(assets, entry);
+}
+
+asset_handle asset_load_async(asset_system* assets, char* name) {
+    asset_entry* entry = find_asset_by_name(assets, name);
+    if (!entry) {
+        platform_log(assets->platform, "Asset not found: %s", name);
+        return INVALID_ASSET_HANDLE;
+    }
+    return asset_load_async_id(assets, entry->id, ASSET_PRIORITY_NORMAL, 0, 0);
+}
+
+// Returns at once; the handle is valid immediately and loaded once
+// asset_is_loaded says so. The callback runs from asset_system_update.
+asset_handle asset_load_async_id(asset_system* assets, asset_id id, asset_load_priority priority,
+                                 asset_load_callback* callback, void* user_data) {
+    asset_entry* entry = find_asset_by_id(assets, id);
+    if (!entry) {
+        platform_log(assets->platform, "Asset not found: %016llx", (unsigned long long)id);
+        return INVALID_ASSET_HANDLE;
+    }
+    
+    asset_loader* loader = assets->loader;
+    if (!loader || loader->worker_count == 0) {
+        asset_handle handle = load_asset_entry(assets, entry);
+        if (callback) callback(assets, handle, asset_handle_valid(handle), user_data);
+        return handle;
+    }
+    
+    u32 index = alloc_load_request(loader);
+    if (!index) {
+        platform_log(assets->platform, "Async load queue full: %s", entry->header.name);
+        return INVALID_ASSET_HANDLE;
+    }
+    
+    asset_load_request* request = &loader->requests[index];
+    request->entry = (u32)(entry - assets->assets);
+    request->generation = entry->generation;
+    request->priority = priority;
+    request->callback = callback;
+    request->user_data = user_data;
+    assets->stats.pending_loads++;
+    
+    asset_acquire(assets, entry);
+    
+    if (entry->state == ASSET_LOADED) {
+        // Nothing to decode, the callback still arrives via the update
+        assets->stats.cache_hits++;
+        request->is_hit = 1;
+        request->done = 1;
+        request->success = 1;
+        pthread_mutex_lock(&loader->lock);
+        loader->completed[loader->completed_count++] = index;
+        pthread_mutex_unlock(&loader->lock);
+    } else if (entry->state == ASSET_LOADING) {
+        // Ride along with the request already in flight
+        asset_load_request* head = &loader->requests[entry->load_request];
+        request->next_waiter = head->next_waiter;
+        head->next_waiter = index;
+        
+        pthread_mutex_lock(&loader->lock);
+        if (priority > head->priority) head->priority = priority;
+        pthread_mutex_unlock(&loader->lock);
+    } else {
+        request->destination = asset_load_destination(assets, entry);
+        if (!request->destination) {
+            entry->ref_count--;
+            assets->stats.pending_loads--;
+            loader->free_requests[loader->free_count++] = index;
+            return INVALID_ASSET_HANDLE;
+        }
+        
+        entry->state = ASSET_LOADING;
+        entry->load_request = index;
+        
+        pthread_mutex_lock(&loader->lock);
+        request->sequence = loader->next_sequence++;
+        loader->pending[loader->pending_count++] = index;
+        pthread_cond_signal(&loader->work_ready);
+        pthread_mutex_unlock(&loader->lock);
+    }
+    
+    return entry_handle(assets, entry);
+}
+
+// Starts paging in an asset's bytes ahead of asset_load
+void asset_prefetch(asset_system* assets, asset_id id) {
+    asset_entry* entry = find_asset_by_id(assets, id);
+    if (!entry || entry->state == ASSET_LOADED) return;
+    
+    u64 page_mask = (u64)sysconf(_SC_PAGESIZE) - 1;
+    u64 begin = entry->header.data_offset & ~page_mask;
+    u64 end = entry->header.data_offset + entry->header.compressed_size;
+    madvise(entry->file->data + begin, end - begin, MADV_WILLNEED);
 }
 
 void asset_unload(asset_system* assets, asset_handle handle) {
@@ -371,9 +1387,7 @@ void asset_unload(asset_system* assets, asset_handle handle) {
     
     // Unload if no references
     if (entry->ref_count == 0 && entry->state == ASSET_LOADED) {
-        assets->memory_used -= entry->header.uncompressed_size;
-        entry->data = 0;  // Data stays in arena until reset
-        entry->state = ASSET_UNLOADED;
+        release_asset_memory(assets, entry);
         assets->stats.unloads_this_frame++;
         
         platform_log(assets->platform, "Unloaded asset: %s", entry->header.name);
@@ -385,13 +1399,24 @@ void asset_retain(asset_system* assets, asset_handle handle) {
     
     asset_entry* entry = &assets->assets[handle.id];
     if (entry->is_valid && entry->generation == handle.generation) {
-        entry->ref_count++;
-        entry->last_used_frame = assets->current_frame;
+        asset_acquire(assets, entry);
     }
 }
 
+// Unlike asset_unload, the data stays resident once unreferenced and is
+// only evicted when the heap needs the space or asset_system_gc ages it out
 void asset_release(asset_system* assets, asset_handle handle) {
-    asset_unload(assets, handle);
+    if (!asset_handle_valid(handle)) return;
+    
+    asset_entry* entry = &assets->assets[handle.id];
+    if (!entry->is_valid || entry->generation != handle.generation) {
+        return;
+    }
+    
+    if (entry->ref_count > 0) {
+        entry->ref_count--;
+        if (entry->ref_count == 0) lru_push(assets, entry);
+    }
 }
 
 // =============================================================================
@@ -410,8 +1435,12 @@ void* asset_get_data(asset_system* assets, asset_handle handle) {
         return 0;
     }
     
+    // Unreferenced but touched, move to the young end of the LRU
+    if (entry->ref_count == 0 && entry->last_used_frame != assets->current_frame) {
+        lru_push(assets, entry);
+    }
     entry->last_used_frame = assets->current_frame;
-    return entry->data;
+    return asset_entry_data(entry);
 }
 
 texture_asset* asset_get_texture(asset_system* assets, asset_handle handle) {
@@ -488,9 +1517,11 @@ void asset_system_update(asset_system* assets) {
     // Reset frame stats
     assets->stats.loads_this_frame = 0;
     assets->stats.unloads_this_frame = 0;
+    assets->stats.async_loads_this_frame = 0;
+    assets->stats.bytes_loaded_this_frame = 0;
     
-    // Process background loading
-    // TODO: Implement async loading with work queue
+    // Publish finished background loads, config.load_budget_bytes per frame
+    publish_completed_loads(assets);
 }
 
 void asset_system_gc(asset_system* assets) {
@@ -509,9 +1540,7 @@ void asset_system_gc(asset_system* assets) {
         
         // Unload unused asset
         if (entry->state == ASSET_LOADED) {
-            assets->memory_used -= entry->header.uncompressed_size;
-            entry->data = 0;
-            entry->state = ASSET_UNLOADED;
+            release_asset_memory(assets, entry);
             assets->stats.unloads_this_frame++;
         }
     }
@@ -532,5 +1561,179 @@ void asset_system_print_stats(asset_system* assets) {
     printf("Cache misses: %u\n", assets->stats.cache_misses);
     printf("Loads this frame: %u\n", assets->stats.loads_this_frame);
     printf("Unloads this frame: %u\n", assets->stats.unloads_this_frame);
+    printf("Evictions: %u\n", assets->stats.evictions);
+    if (assets->heap) {
+        printf("Heap: %lu KB in blocks, largest free %lu KB\n",
+               (unsigned long)(assets->heap->used / 1024),
+               (unsigned long)(heap_largest_free(assets->heap) / 1024));
+    }
     printf("================================\n");
-}
\ No newline at end of file
+}
+// =============================================================================
+// ASSET COMPILER
+// =============================================================================
+
+asset_compiler* asset_compiler_create(arena* arena) {
+    asset_compiler* compiler = arena_push_struct(arena, asset_compiler);
+    if (!compiler) return 0;
+    
+    memset(compiler, 0, sizeof(asset_compiler));
+    compiler->arena = arena;
+    compiler->compression = ASSET_COMPRESSION_NONE;
+    compiler->items = (asset_compiler_item*)arena_push_size(arena, 
+                                                            MAX_ASSETS * sizeof(asset_compiler_item), 
+                                                            16);
+    if (!compiler->items) return 0;
+    
+    return compiler;
+}
+
+void asset_compiler_set_output(asset_compiler* compiler, char* path) {
+    strncpy(compiler->output_path, path, sizeof(compiler->output_path) - 1);
+}
+
+void asset_compiler_set_compression(asset_compiler* compiler, 
+                                   asset_compression compression, u32 level) {
+    compiler->compression = compression;
+    compiler->compression_level = level;
+}
+
+// Copies name and data, the caller's buffers can go away before the build
+b32 asset_compiler_add_data(asset_compiler* compiler, char* name, asset_type type,
+                            void* data, u64 size) {
+    if (compiler->item_count >= MAX_ASSETS) {
+        printf("Asset compiler: too many assets, skipped %s\n", name);
+        return 0;
+    }
+    if (strlen(name) >= sizeof(((asset_header*)0)->name)) {
+        printf("Asset compiler: name too long: %s\n", name);
+        return 0;
+    }
+    
+    u64 name_size = strlen(name) + 1;
+    asset_compiler_item* item = &compiler->items[compiler->item_count];
+    item->id = asset_id_from_name(name);
+    item->type = type;
+    item->size = size;
+    item->name = (char*)arena_push_size(compiler->arena, name_size, 1);
+    item->data = (u8*)arena_push_size(compiler->arena, size ? size : 1, 16);
+    if (!item->name || !item->data) return 0;
+    
+    memcpy(item->name, name, name_size);
+    memcpy(item->data, data, size);
+    compiler->item_count++;
+    return 1;
+}
+
+internal int compare_directory_entries(const void* a, const void* b) {
+    asset_id x = ((asset_directory_entry*)a)->id;
+    asset_id y = ((asset_directory_entry*)b)->id;
+    return (x > y) - (x < y);
+}
+
+// Pack layout: [header pad data pad]... in add order, every header and
+// payload ASSET_DATA_ALIGNMENT aligned, then the directory sorted by ID,
+// then the footer. With LZ4 an asset is stored compressed only if that
+// makes it smaller; stored ones stay zero-copy.
+b32 asset_compiler_build(asset_compiler* compiler) {
+    b32 use_lz4 = (compiler->compression == ASSET_COMPRESSION_LZ4);
+    if (compiler->compression != ASSET_COMPRESSION_NONE && !use_lz4) {
+        printf("Asset compiler: compression not supported, writing uncompressed\n");
+    }
+    
+    asset_directory_entry* directory = (asset_directory_entry*)arena_push_size(
+        compiler->arena, (compiler->item_count + 1) * sizeof(asset_directory_entry), 16);
+    if (!directory) return 0;
+    
+    u8* scratch = 0;
+    if (use_lz4) {
+        u64 largest = 0;
+        for (u32 i = 0; i < compiler->item_count; i++) {
+            if (compiler->items[i].size > largest) largest = compiler->items[i].size;
+        }
+        scratch = (u8*)arena_push_size(compiler->arena, lz4_compress_bound(largest), 16);
+        if (!scratch) return 0;
+    }
+    
+    FILE* out = fopen(compiler->output_path, "wb");
+    if (!out) {
+        printf("Asset compiler: failed to create %s\n", compiler->output_path);
+        return 0;
+    }
+    
+    static const u8 padding[ASSET_DATA_ALIGNMENT] = {0};
+    u64 offset = 0;
+    for (u32 i = 0; i < compiler->item_count; i++) {
+        asset_compiler_item* item = &compiler->items[i];
+        
+        // Headers and payloads both start aligned; the mapping is page
+        // aligned, so zero-copy loads get aligned pointers
+        u64 data_offset = (offset + sizeof(asset_header) + ASSET_DATA_ALIGNMENT - 1) & 
+                          ~(u64)(ASSET_DATA_ALIGNMENT - 1);
+        
+        u8* payload = item->data;
+        u64 payload_size = item->size;
+        asset_compression compression = ASSET_COMPRESSION_NONE;
+        if (use_lz4) {
+            u64 compressed_size = lz4_compress(item->data, item->size, scratch);
+            if (compressed_size < item->size) {
+                payload = scratch;
+                payload_size = compressed_size;
+                compression = ASSET_COMPRESSION_LZ4;
+            }
+        }
+        
+        asset_header header = {0};
+        header.magic = ASSET_MAGIC;
+        header.version = ASSET_VERSION;
+        header.type = item->type;
+        header.compression = compression;
+        header.uncompressed_size = item->size;
+        header.compressed_size = payload_size;
+        header.data_offset = data_offset;
+        header.checksum = crc32(item->data, item->size);
+        strncpy(header.name, item->name, sizeof(header.name) - 1);
+        
+        directory[i].id = item->id;
+        directory[i].header_offset = offset;
+        
+        u64 data_end = data_offset + payload_size;
+        u64 next_offset = (data_end + ASSET_DATA_ALIGNMENT - 1) & ~(u64)(ASSET_DATA_ALIGNMENT - 1);
+        
+        fwrite(&header, sizeof(asset_header), 1, out);
+        fwrite(padding, data_offset - offset - sizeof(asset_header), 1, out);
+        fwrite(payload, payload_size, 1, out);
+        fwrite(padding, next_offset - data_end, 1, out);
+        offset = next_offset;
+    }
+    
+    qsort(directory, compiler->item_count, sizeof(asset_directory_entry), compare_directory_entries);
+    for (u32 i = 1; i < compiler->item_count; i++) {
+        if (directory[i].id == directory[i - 1].id) {
+            printf("Asset compiler: duplicate asset ID %016llx\n", 
+                   (unsigned long long)directory[i].id);
+            fclose(out);
+            remove(compiler->output_path);
+            return 0;
+        }
+    }
+    
+    asset_directory_footer footer = {0};
+    footer.directory_offset = offset;
+    footer.asset_count = compiler->item_count;
+    footer.magic = ASSET_DIRECTORY_MAGIC;
+    
+    fwrite(directory, sizeof(asset_directory_entry), compiler->item_count, out);
+    fwrite(&footer, sizeof(asset_directory_footer), 1, out);
+    
+    b32 ok = !ferror(out);
+    fclose(out);
+    
+    printf("Asset compiler: wrote %u assets to %s\n", compiler->item_count, compiler->output_path);
+    return ok;
+}
+
+void asset_compiler_destroy(asset_compiler* compiler) {
+    // Everything lives in the compiler's arena
+    compiler->item_count = 0;
+}
@@ -26,6 +26,12 @@ typedef struct { f32 x, y, z, w; } v4;
 #define MAX_ASSET_FILES 256
 #define ASSET_MAGIC 0x53414D48  // "HMAS"
 #define ASSET_VERSION 1
+#define ASSET_DIRECTORY_MAGIC 0x52444D48  // "HMDR"
+#define ASSET_INDEX_SIZE (MAX_ASSETS * 2)  // Name index slots, power of two
+#define ASSET_DATA_ALIGNMENT 64            // asset_compiler_build aligns every payload
+
+// 64-bit asset ID: FNV-1a hash of the asset name, see asset_id_from_name
+typedef u64 asset_id;
 
 // Asset types
 typedef enum asset_type {
@@ -48,6 +54,21 @@ typedef enum asset_compression {
     ASSET_COMPRESSION_COUNT
 } asset_compression;
 
+// When asset checksums are verified
+typedef enum asset_checksum_mode {
+    ASSET_CHECKSUM_ON_OPEN = 0,  // Uncompressed assets once in asset_load_file
+    ASSET_CHECKSUM_ON_LOAD,      // Debug: every load, as data is produced
+    ASSET_CHECKSUM_NEVER
+} asset_checksum_mode;
+
+// Async load priority, higher is picked first
+typedef enum asset_load_priority {
+    ASSET_PRIORITY_LOW = 0,
+    ASSET_PRIORITY_NORMAL,
+    ASSET_PRIORITY_HIGH,
+    ASSET_PRIORITY_CRITICAL
+} asset_load_priority;
+
 // Asset load state
 typedef enum asset_load_state {
     ASSET_UNLOADED = 0,
@@ -64,12 +85,26 @@ typedef struct asset_header {
     asset_compression compression; // Compression method
     u64 uncompressed_size;      // Size after decompression
     u64 compressed_size;        // Size in file
-    u64 data_offset;            // Offset to data in file
+    u64 data_offset;            // Absolute offset to data in file
     u32 checksum;               // CRC32 of uncompressed data
     char name[256];             // Asset name/path
     u8 reserved[256];           // Future expansion
 } asset_header;
 
+// Pack directory, written after the last asset by asset_compiler_build.
+// Packs without one are indexed by walking the headers.
+typedef struct asset_directory_entry {
+    asset_id id;
+    u64 header_offset;          // Absolute offset of the asset_header
+} asset_directory_entry;
+
+// Last bytes of a pack with a directory
+typedef struct asset_directory_footer {
+    u64 directory_offset;       // Absolute offset of the entries, sorted by id
+    u32 asset_count;
+    u32 magic;                  // ASSET_DIRECTORY_MAGIC
+} asset_directory_footer;
+
 // Asset handle (opaque to users)
 typedef struct asset_handle {
     u32 id;                     // Asset ID
@@ -107,6 +142,14 @@ typedef struct sound_asset {
     u8* samples;                // Audio samples
 } sound_asset;
 
+// Typed struct of a mapped asset, with its pointers fixed up outside the
+// mapping so the checksummed bytes stay as they are in the pack
+typedef union asset_view {
+    texture_asset texture;
+    mesh_asset mesh;
+    sound_asset sound;
+} asset_view;
+
 // Asset file (memory-mapped .hma file)
 typedef struct asset_file {
     char filename[256];
@@ -122,13 +165,19 @@ typedef struct asset_file {
 
 // Asset entry (runtime state)
 typedef struct asset_entry {
-    asset_header header;        // Asset metadata
+    asset_header header;        // Asset metadata, data_offset resolved
     asset_file* file;           // Source file
+    asset_id id;                // Hashed name
     
     asset_load_state state;     // Current load state
     void* data;                 // Loaded asset data
+    b32 is_mapped;              // data points into the pack mapping, not the arena
+    asset_view view;            // Typed struct handed out for mapped assets
     u32 ref_count;              // Reference count
     u32 last_used_frame;        // For LRU eviction
+    u32 load_request;           // In-flight async request while ASSET_LOADING
+    u32 lru_prev;               // Eviction list links while unreferenced, 0 = none
+    u32 lru_next;
     
     u32 generation;             // Handle validation
     b32 is_valid;
@@ -136,15 +185,31 @@ typedef struct asset_entry {
 
 // Streaming control
 typedef struct streaming_config {
-    u64 max_memory_bytes;       // Total memory budget
-    u32 max_concurrent_loads;   // Max simultaneous loads
+    u64 max_memory_bytes;       // Total memory budget, size of the asset heap
+    u32 max_concurrent_loads;   // Loader worker threads
+    u64 load_budget_bytes;      // Bytes asset_system_update publishes per frame, 0 = no limit
     u32 frames_before_unload;   // LRU timeout
     f32 load_distance;          // Distance-based loading
     b32 enable_compression;     // Decompress on load
+    asset_checksum_mode checksum_mode;
 } streaming_config;
 
+// Open-addressed id -> entry index, entry 0 marks an empty slot
+typedef struct asset_index_slot {
+    asset_id id;
+    u32 entry;
+} asset_index_slot;
+
+typedef struct asset_system asset_system;
+typedef struct asset_loader asset_loader;
+typedef struct asset_heap asset_heap;
+
+// Called from asset_system_update once an async load finished or failed
+typedef void asset_load_callback(asset_system* assets, asset_handle handle, 
+                                 b32 loaded, void* user_data);
+
 // Asset system state
-typedef struct asset_system {
+struct asset_system {
     // Platform
     platform_state* platform;
     
@@ -157,10 +222,18 @@ typedef struct asset_system {
     asset_file files[MAX_ASSET_FILES];
     u32 asset_count;
     u32 file_count;
+    u32 first_free_entry;       // No free entry below this one
+    
+    // PERFORMANCE: O(1) name lookup, linear probing at load factor <= 0.5
+    asset_index_slot index[ASSET_INDEX_SIZE];
     
     // Streaming
     streaming_config config;
     work_queue* load_queue;     // Background loading
+    asset_loader* loader;       // Async load workers and request queues
+    asset_heap* heap;           // Reclaimable asset data, config.max_memory_bytes
+    u32 lru_head;               // Oldest unreferenced resident asset
+    u32 lru_tail;
     u64 memory_used;            // Current memory usage
     u32 current_frame;          // Frame counter
     
@@ -175,10 +248,17 @@ typedef struct asset_system {
         u32 unloads_this_frame;
         u32 cache_hits;
         u32 cache_misses;
+        u32 zero_copy_loads;    // Served straight from the mapping
+        u32 evictions;          // Unreferenced assets dropped to make room
         f64 total_load_time;
         f64 total_decompress_time;
+        
+        // Async loading
+        u32 pending_loads;      // Requested, not yet published
+        u32 async_loads_this_frame;
+        u64 bytes_loaded_this_frame;
     } stats;
-} asset_system;
+};
 
 // =============================================================================
 // ASSET SYSTEM API
@@ -196,10 +276,14 @@ void asset_reload_file(asset_system* assets, char* filename);
 
 // Asset loading
 asset_handle asset_load(asset_system* assets, char* name);
+asset_handle asset_load_id(asset_system* assets, asset_id id);
+void asset_prefetch(asset_system* assets, asset_id id);  // Hint an upcoming load
 asset_handle asset_load_async(asset_system* assets, char* name);
-void asset_unload(asset_system* assets, asset_handle handle);
+asset_handle asset_load_async_id(asset_system* assets, asset_id id, asset_load_priority priority,
+                                 asset_load_callback* callback, void* user_data);
+void asset_unload(asset_system* assets, asset_handle handle);    // Frees data at zero refs
 void asset_retain(asset_system* assets, asset_handle handle);
-void asset_release(asset_system* assets, asset_handle handle);
+void asset_release(asset_system* assets, asset_handle handle);   // Keeps data cached, evictable
 
 // Asset access
 void* asset_get_data(asset_system* assets, asset_handle handle);
@@ -231,11 +315,22 @@ void asset_system_debug_gui(asset_system* assets, gui_context* gui);
 // ASSET COMPILER API (for tools)
 // =============================================================================
 
+typedef struct asset_compiler_item {
+    asset_id id;
+    asset_type type;
+    char* name;
+    u8* data;
+    u64 size;
+} asset_compiler_item;
+
 typedef struct asset_compiler {
     arena* arena;
     char output_path[256];
     asset_compression compression;
     u32 compression_level;
+    
+    asset_compiler_item* items; // MAX_ASSETS, in pack order
+    u32 item_count;
 } asset_compiler;
 
 // Compiler functions
@@ -248,6 +343,8 @@ void asset_compiler_set_compression(asset_compiler* compiler,
 b32 asset_compiler_add_texture(asset_compiler* compiler, char* name, char* path);
 b32 asset_compiler_add_mesh(asset_compiler* compiler, char* name, char* path);
 b32 asset_compiler_add_sound(asset_compiler* compiler, char* name, char* path);
+b32 asset_compiler_add_data(asset_compiler* compiler, char* name, asset_type type,
+                            void* data, u64 size);
 
 // Build asset pack
 b32 asset_compiler_build(asset_compiler* compiler);
@@ -260,6 +357,16 @@ void asset_compiler_destroy(asset_compiler* compiler);
 // Invalid handle constant
 #define INVALID_ASSET_HANDLE ((asset_handle){0, 0})
 
+// Asset ID of a name, hash once and keep the ID for hot paths
+static inline asset_id asset_id_from_name(const char* name) {
+    u64 hash = 0xCBF29CE484222325ull;   // FNV-1a offset basis
+    while (*name) {
+        hash ^= (u8)*name++;
+        hash *= 0x100000001B3ull;       // FNV-1a prime
+    }
+    return hash;
+}
+
 // Handle validation
 static inline b32 asset_handle_valid(asset_handle handle) {
     return handle.id != 0;
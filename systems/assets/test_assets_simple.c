@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <time.h>
 
 // Mock platform and arena for testing
 typedef struct {
@@ -163,6 +164,24 @@ void create_test_asset() {
     printf("Created test asset: 64x64 checkerboard texture\n");
 }
 
+typedef struct async_test_results {
+    u32 callbacks;
+    u32 verified;
+} async_test_results;
+
+static void async_test_callback(asset_system* assets, asset_handle handle, 
+                                b32 loaded, void* user_data) {
+    async_test_results* results = (async_test_results*)user_data;
+    results->callbacks++;
+    
+    u32 index = 0;
+    u32* payload = loaded ? (u32*)asset_get_data(assets, handle) : 0;
+    if (payload && sscanf(asset_get_name(assets, handle), "streamed/chunk_%u", &index) == 1 &&
+        payload[0] == index * 31 && payload[1023] == 0xA5A5A5A5u) {
+        results->verified++;
+    }
+}
+
 int main() {
     printf("=== Handmade Asset System Test ===\n\n");
     
@@ -222,7 +241,7 @@ int main() {
         // Verify checkerboard pattern
         u8* pixels = texture->pixels;
         u8 first_pixel = pixels[0];
-        u8 corner_pixel = pixels[(8 * texture->width + 8) * 3];
+        u8 corner_pixel = pixels[8 * 3];  // First pixel of the next square
         
         printf("Checkerboard verification: first=%u, corner=%u %s\n",
                first_pixel, corner_pixel, 
@@ -242,9 +261,190 @@ int main() {
     
     asset_release(assets, handle);
     asset_release(assets, handle);
-    printf("Released remaining references, loaded: %s\n", 
+    printf("Released remaining references, cached: %s\n", 
            asset_is_loaded(assets, handle) ? "Yes" : "No");
     
+    asset_unload(assets, handle);
+    printf("Unloaded, loaded: %s\n", asset_is_loaded(assets, handle) ? "Yes" : "No");
+    
+    // Zero-copy reloads must still pass a per-load checksum
+    streaming_config verify_config = config;
+    verify_config.checksum_mode = ASSET_CHECKSUM_ON_LOAD;
+    verify_config.max_memory_bytes = (64 * 1024);
+    asset_system* verify = asset_system_init((platform_state*)&platform, main_arena, verify_config);
+    asset_load_file(verify, "test_texture.hma");
+    
+    u32 verified_loads = 0;
+    for (u32 i = 0; i < 2; i++) {
+        asset_handle h = asset_load(verify, "test_checkerboard");
+        texture_asset* t = asset_get_texture(verify, h);
+        verified_loads += (t && t->width == 64 && t->pixels[8 * 3] != t->pixels[0]);
+        asset_unload(verify, h);
+    }
+    printf("Zero-copy reload with ON_LOAD checksums: %s\n", 
+           (verified_loads == 2 && verify->stats.zero_copy_loads == 2) ? "PASS" : "FAIL");
+    asset_unload_file(verify, "test_texture.hma");
+    asset_system_shutdown(verify);
+    
+    // Test pack directory and ID lookup
+    printf("\n=== Pack Directory Test ===\n");
+    
+    asset_compiler* compiler = asset_compiler_create(main_arena);
+    asset_compiler_set_output(compiler, "test_pack.hma");
+    
+    char name[64];
+    for (u32 i = 0; i < 1000; i++) {
+        u32 payload[4] = {i, i * 3, i * 7, 0xA55E7000u + i};
+        sprintf(name, "level/prop_%u", i);
+        asset_compiler_add_data(compiler, name, ASSET_TYPE_MATERIAL, payload, sizeof(payload));
+    }
+    
+    if (!asset_compiler_build(compiler) || !asset_load_file(assets, "test_pack.hma")) {
+        printf("Failed to build test pack\n");
+        return 1;
+    }
+    
+    u32 found = 0;
+    u32 aligned = 0;
+    u32 zero_copy_before = assets->stats.zero_copy_loads;
+    for (u32 i = 0; i < 1000; i++) {
+        sprintf(name, "level/prop_%u", i);
+        asset_prefetch(assets, asset_id_from_name(name));
+        asset_handle prop = (i & 1) ? asset_load(assets, name) 
+                                    : asset_load_id(assets, asset_id_from_name(name));
+        u32* payload = (u32*)asset_get_data(assets, prop);
+        if (payload && payload[0] == i && payload[3] == 0xA55E7000u + i) {
+            found++;
+        }
+        if (((u64)payload & (ASSET_DATA_ALIGNMENT - 1)) == 0) {
+            aligned++;
+        }
+    }
+    printf("Resolved %u / 1000 pack assets by name and ID %s\n", 
+           found, (found == 1000) ? "PASS" : "FAIL");
+    printf("Zero-copy loads: %u, aligned: %u %s\n", 
+           assets->stats.zero_copy_loads - zero_copy_before, aligned,
+           (assets->stats.zero_copy_loads - zero_copy_before == 1000 && aligned == 1000) ? "PASS" : "FAIL");
+    
+    asset_handle missing = asset_load(assets, "level/prop_1000");
+    printf("Missing asset rejected: %s\n", asset_handle_valid(missing) ? "FAIL" : "PASS");
+    
+    asset_unload_file(assets, "test_pack.hma");
+    asset_handle unloaded = asset_load_id(assets, asset_id_from_name("level/prop_5"));
+    printf("Unloaded pack removed from index: %s\n", 
+           asset_handle_valid(unloaded) ? "FAIL" : "PASS");
+    
+    // Corrupt one payload byte; pack open must reject just that asset
+    FILE* pack = fopen("test_pack.hma", "r+b");
+    fseek(pack, ASSET_DATA_ALIGNMENT * 9 + 4, SEEK_SET);  // Inside level/prop_0
+    fputc(0xFF, pack);
+    fclose(pack);
+    
+    asset_load_file(assets, "test_pack.hma");
+    asset_handle corrupt = asset_load(assets, "level/prop_0");
+    asset_handle intact = asset_load(assets, "level/prop_1");
+    printf("Corrupt asset rejected at open: %s\n", 
+           (!asset_handle_valid(corrupt) && asset_handle_valid(intact)) ? "PASS" : "FAIL");
+    asset_unload_file(assets, "test_pack.hma");
+    
+    // Test LZ4 pack with async loads
+    printf("\n=== Async LZ4 Test ===\n");
+    
+    compiler = asset_compiler_create(main_arena);
+    asset_compiler_set_output(compiler, "test_lz4.hma");
+    asset_compiler_set_compression(compiler, ASSET_COMPRESSION_LZ4, 1);
+    
+    static u32 block[1024];
+    for (u32 i = 0; i < 256; i++) {
+        for (u32 j = 0; j < 1024; j++) {
+            block[j] = (j < 8) ? i * 31 + j : j / 64;
+        }
+        block[1023] = 0xA5A5A5A5u;
+        sprintf(name, "streamed/chunk_%u", i);
+        asset_compiler_add_data(compiler, name, ASSET_TYPE_MATERIAL, block, sizeof(block));
+    }
+    
+    // Larger than the whole heap of the eviction test
+    static u32 huge[32 * 1024];
+    asset_compiler_add_data(compiler, "streamed/huge", ASSET_TYPE_MATERIAL, huge, sizeof(huge));
+    
+    if (!asset_compiler_build(compiler) || !asset_load_file(assets, "test_lz4.hma")) {
+        printf("Failed to build LZ4 pack\n");
+        return 1;
+    }
+    
+    async_test_results results = {0};
+    u32 requested = 0;
+    for (u32 i = 0; i < 256; i++) {
+        sprintf(name, "streamed/chunk_%u", i);
+        asset_load_priority priority = (asset_load_priority)(i % 4);
+        asset_handle h = asset_load_async_id(assets, asset_id_from_name(name), priority,
+                                             async_test_callback, &results);
+        requested += asset_handle_valid(h);
+    }
+    
+    // Pump frames until every callback arrived, with a 10 second timeout
+    time_t deadline = time(0) + 10;
+    while (results.callbacks < requested && time(0) < deadline) {
+        asset_system_update(assets);
+    }
+    printf("Async loads: %u requested, %u callbacks, %u verified %s\n",
+           requested, results.callbacks, results.verified,
+           (requested == 256 && results.verified == 256) ? "PASS" : "FAIL");
+    
+    // Synchronous load of an LZ4 asset after the async ones
+    asset_handle lz4 = asset_load(assets, "streamed/chunk_7");
+    u32* chunk = (u32*)asset_get_data(assets, lz4);
+    printf("LZ4 sync load: %s\n", 
+           (chunk && chunk[8] == 0 && chunk[1023] == 0xA5A5A5A5u) ? "PASS" : "FAIL");
+    
+    asset_unload_file(assets, "test_lz4.hma");
+    
+    // Test eviction under a budget of sixteen 4 KB chunks
+    printf("\n=== Eviction Test ===\n");
+    
+    streaming_config small_config = config;
+    small_config.max_memory_bytes = (64 * 1024);
+    asset_system* small = asset_system_init((platform_state*)&platform, main_arena, small_config);
+    asset_load_file(small, "test_lz4.hma");
+    
+    u32 streamed = 0;
+    for (u32 pass = 0; pass < 2; pass++) {
+        for (u32 i = 0; i < 256; i++) {
+            sprintf(name, "streamed/chunk_%u", i);
+            asset_handle h = asset_load(small, name);
+            u32* data = (u32*)asset_get_data(small, h);
+            streamed += (data && data[0] == i * 31);
+            asset_release(small, h);
+        }
+    }
+    printf("Streamed %u chunks through 64 KB, %u evictions %s\n", streamed, small->stats.evictions,
+           (streamed == 512 && small->memory_used <= (64 * 1024)) ? "PASS" : "FAIL");
+    
+    u32 evictions_before = small->stats.evictions;
+    u64 resident_before = small->memory_used;
+    asset_handle huge_handle = asset_load(small, "streamed/huge");
+    printf("Oversized load rejected without evicting: %s\n",
+           (!asset_handle_valid(huge_handle) && small->stats.evictions == evictions_before &&
+            small->memory_used == resident_before) ? "PASS" : "FAIL");
+    
+    asset_handle held[17];
+    for (u32 i = 0; i < 17; i++) {
+        sprintf(name, "streamed/chunk_%u", 100 + i);
+        held[i] = asset_load(small, name);
+    }
+    printf("Referenced assets never evicted: %s\n",
+           (asset_is_loaded(small, held[0]) && !asset_handle_valid(held[16])) ? "PASS" : "FAIL");
+    
+    for (u32 i = 0; i < 16; i++) {
+        asset_unload(small, held[i]);
+    }
+    asset_system_gc(small);
+    asset_unload_file(small, "test_lz4.hma");
+    printf("Memory reclaimed: %s\n", small->memory_used == 0 ? "PASS" : "FAIL");
+    asset_system_print_stats(small);
+    asset_system_shutdown(small);
+    
     // Print statistics
     printf("\n");
     asset_system_print_stats(assets);
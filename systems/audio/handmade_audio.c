@@ -30,14 +30,27 @@
 #define AUDIO_ALIGN 32
 #define ALIGN_UP(x, align) (((x) + (align) - 1) & ~((align) - 1))
 
+/* Resampler configuration */
+#define AUDIO_SINC_TAPS 8          /* Source frames per output frame: 3 before, 4 after */
+#define AUDIO_SINC_PHASES 256      /* Fractional positions in the polyphase table */
+#define AUDIO_SINC_CUTOFF 0.92f    /* Fraction of Nyquist kept, the rest is the transition band */
+#define AUDIO_MIN_STEP (1.0f / 256.0f)
+#define AUDIO_SAMPLE_SCALE (1.0f / 32768.0f)
+
+/* Voice virtualization */
+#define AUDIO_INAUDIBLE_GAIN (1.0f / 32768.0f)  /* Below one LSB, never mixed */
+#define AUDIO_VIRTUAL_HYSTERESIS 1.1f           /* Score bonus for voices already mixed */
+
 /* Lock-free ring buffer macros */
 #define RING_BUFFER_MASK (AUDIO_RING_BUFFER_SIZE - 1)
 #define RING_BUFFER_INCREMENT(x) (((x) + 1) & RING_BUFFER_MASK)
 
 /* Forward declarations */
 static void *audio_thread_proc(void *data);
+static void audio_build_sinc_table(void);
 static void audio_mix_voices(audio_system *audio, int16_t *output, uint32_t frames);
-static void audio_apply_3d(audio_system *audio, audio_voice *voice, float *left_gain, float *right_gain);
+static void audio_apply_3d(audio_system *audio, audio_voice *voice, float *left_gain, float *right_gain,
+                           float *pitch);
 void audio_process_effects(audio_system *audio, float *buffer, uint32_t frames);  /* Defined in audio_dsp.c */
 static inline int16_t audio_clamp_sample(float sample);
 
@@ -54,6 +67,230 @@ static void *audio_arena_alloc(MemoryArena *arena, size_t size) {
     return ptr;
 }
 
+/* THREADING: Game thread -> audio thread. Only fails when the audio
+ * thread has fallen a whole queue behind. */
+static bool audio_command_queue_full(audio_system *audio) {
+    audio_command_queue *queue = audio->commands;
+    return queue->head - __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE) >= AUDIO_COMMAND_QUEUE_SIZE;
+}
+
+static bool audio_push_command(audio_system *audio, const audio_command *command) {
+    audio_command_queue *queue = audio->commands;
+    uint32_t head = queue->head;
+    if (audio_command_queue_full(audio)) {
+        audio->commands_dropped++;
+        return false;
+    }
+    
+    queue->commands[head & (AUDIO_COMMAND_QUEUE_SIZE - 1)] = *command;
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/* THREADING: Audio thread -> game thread. A dropped event leaves the slot
+ * busy until voice stealing reclaims it. */
+static void audio_push_finished(audio_system *audio, uint32_t voice_handle) {
+    audio_event_queue *queue = audio->events;
+    uint32_t head = queue->head;
+    uint32_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= AUDIO_EVENT_QUEUE_SIZE) return;
+    
+    queue->finished[head & (AUDIO_EVENT_QUEUE_SIZE - 1)] = voice_handle;
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/* Frees the slots of voices that played out since the last call */
+static void audio_drain_events(audio_system *audio) {
+    audio_event_queue *queue = audio->events;
+    uint32_t tail = queue->tail;
+    uint32_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    
+    for (; tail != head; tail++) {
+        uint32_t handle = queue->finished[tail & (AUDIO_EVENT_QUEUE_SIZE - 1)];
+        audio_voice_slot *slot = &audio->voice_slots[handle >> 16];
+        if (slot->busy && slot->generation == (handle & 0xFFFF)) {
+            slot->busy = false;
+        }
+    }
+    __atomic_store_n(&queue->tail, tail, __ATOMIC_RELEASE);
+}
+
+/* Slot of a live voice handle, NULL for stale or invalid handles */
+static audio_voice_slot *audio_find_slot(audio_system *audio, audio_handle voice_handle) {
+    if (voice_handle == AUDIO_INVALID_HANDLE) return NULL;
+    
+    uint32_t index = voice_handle >> 16;
+    uint32_t generation = voice_handle & 0xFFFF;
+    if (index >= AUDIO_MAX_VIRTUAL_VOICES) return NULL;
+    
+    audio_voice_slot *slot = &audio->voice_slots[index];
+    return (slot->busy && slot->generation == generation) ? slot : NULL;
+}
+
+static void audio_voice_command(audio_system *audio, audio_handle voice_handle, audio_command *command) {
+    if (!audio_find_slot(audio, voice_handle)) return;
+    command->voice = voice_handle;
+    audio_push_command(audio, command);
+}
+
+static void audio_send_listener(audio_system *audio) {
+    audio_command command = {.type = AUDIO_CMD_SET_LISTENER};
+    command.data.listener.position = audio->listener_position;
+    command.data.listener.forward = audio->listener_forward;
+    command.data.listener.velocity = audio->listener_velocity;
+    audio_push_command(audio, &command);
+}
+
+static void audio_send_master(audio_system *audio) {
+    audio_command command = {.type = AUDIO_CMD_SET_MASTER};
+    command.data.master.master = audio->master_volume;
+    command.data.master.sound = audio->sound_volume;
+    audio_push_command(audio, &command);
+}
+
+/* Allocates a voice slot on the game thread and queues the start */
+static audio_handle audio_start_voice(audio_system *audio, uint32_t sound_id, float volume, float pan,
+                                      uint32_t flags, audio_priority priority, audio_vec3 position) {
+    audio_drain_events(audio);
+    
+    /* Checked up front: a stolen slot must not change hands unless the
+     * audio thread is guaranteed to hear about it */
+    if (audio_command_queue_full(audio)) {
+        audio->commands_dropped++;
+        return AUDIO_INVALID_HANDLE;
+    }
+    
+    /* Find free voice */
+    int index = -1;
+    for (int i = 0; i < AUDIO_MAX_VIRTUAL_VOICES; i++) {
+        if (!audio->voice_slots[i].busy) {
+            index = i;
+            break;
+        }
+    }
+    
+    /* Voice stealing - find lowest priority voice */
+    if (index < 0) {
+        audio_priority lowest_priority = AUDIO_PRIORITY_CRITICAL;
+        for (int i = 0; i < AUDIO_MAX_VIRTUAL_VOICES; i++) {
+            if (audio->voice_slots[i].priority < lowest_priority) {
+                lowest_priority = audio->voice_slots[i].priority;
+                index = i;
+            }
+        }
+    }
+    if (index < 0) return AUDIO_INVALID_HANDLE;
+    
+    /* Generation 0 is skipped so a handle is never AUDIO_INVALID_HANDLE */
+    audio_voice_slot *slot = &audio->voice_slots[index];
+    slot->generation = (uint16_t)(slot->generation + 1);
+    if (slot->generation == 0) slot->generation = 1;
+    slot->sound_id = sound_id;
+    slot->priority = priority;
+    slot->busy = true;
+    
+    audio_handle handle = ((uint32_t)index << 16) | slot->generation;
+    
+    audio_command command = {.type = AUDIO_CMD_PLAY, .voice = handle};
+    command.data.play.sound_id = sound_id;
+    command.data.play.volume = volume;
+    command.data.play.pan = pan;
+    command.data.play.flags = flags;
+    command.data.play.priority = priority;
+    command.data.play.position = position;
+    audio_push_command(audio, &command);
+    
+    return handle;
+}
+
+/* Audio thread: voice addressed by a command, NULL once it was stopped,
+ * replaced or played out */
+static audio_voice *audio_command_voice(audio_system *audio, uint32_t voice_handle) {
+    audio_voice *voice = &audio->voices[voice_handle >> 16];
+    return (voice->active && voice->generation == (voice_handle & 0xFFFF)) ? voice : NULL;
+}
+
+/* Audio thread: applies everything the game thread queued since the last
+ * mix period, so voices never change mid-period */
+static void audio_apply_commands(audio_system *audio) {
+    audio_command_queue *queue = audio->commands;
+    uint32_t tail = queue->tail;
+    uint32_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    
+    for (; tail != head; tail++) {
+        audio_command *command = &queue->commands[tail & (AUDIO_COMMAND_QUEUE_SIZE - 1)];
+        audio_voice *voice = NULL;
+        
+        switch (command->type) {
+            case AUDIO_CMD_PLAY:
+                voice = &audio->voices[command->voice >> 16];
+                memset(voice, 0, sizeof(audio_voice));
+                voice->sound_id = command->data.play.sound_id;
+                voice->volume = command->data.play.volume;
+                voice->pan = command->data.play.pan;
+                voice->pitch = 1.0f;
+                voice->flags = command->data.play.flags;
+                voice->priority = command->data.play.priority;
+                voice->position_3d = command->data.play.position;
+                voice->min_distance = 1.0f;
+                voice->max_distance = 100.0f;
+                voice->generation = command->voice & 0xFFFF;
+                voice->active = true;
+                break;
+                
+            case AUDIO_CMD_STOP:
+                if ((voice = audio_command_voice(audio, command->voice))) voice->active = false;
+                break;
+                
+            case AUDIO_CMD_PAUSE:
+                if ((voice = audio_command_voice(audio, command->voice))) {
+                    if (command->data.pause) {
+                        voice->flags |= AUDIO_FLAG_PAUSED;
+                    } else {
+                        voice->flags &= ~AUDIO_FLAG_PAUSED;
+                    }
+                }
+                break;
+                
+            case AUDIO_CMD_SET_VOLUME:
+                if ((voice = audio_command_voice(audio, command->voice))) voice->volume = command->data.value;
+                break;
+                
+            case AUDIO_CMD_SET_PAN:
+                if ((voice = audio_command_voice(audio, command->voice))) voice->pan = command->data.value;
+                break;
+                
+            case AUDIO_CMD_SET_PITCH:
+                if ((voice = audio_command_voice(audio, command->voice))) voice->pitch = command->data.value;
+                break;
+                
+            case AUDIO_CMD_SET_POSITION_3D:
+                if ((voice = audio_command_voice(audio, command->voice))) voice->position_3d = command->data.vector;
+                break;
+                
+            case AUDIO_CMD_SET_VELOCITY:
+                if ((voice = audio_command_voice(audio, command->voice))) voice->velocity = command->data.vector;
+                break;
+                
+            case AUDIO_CMD_SET_LISTENER:
+                audio->mix_state.listener_position = command->data.listener.position;
+                audio->mix_state.listener_forward = command->data.listener.forward;
+                audio->mix_state.listener_velocity = command->data.listener.velocity;
+                break;
+                
+            case AUDIO_CMD_SET_MASTER:
+                audio->mix_state.master_volume = command->data.master.master;
+                audio->mix_state.sound_volume = command->data.master.sound;
+                break;
+                
+            case AUDIO_CMD_SET_RESAMPLE_QUALITY:
+                audio->mix_state.resample_quality = command->data.quality;
+                break;
+        }
+    }
+    __atomic_store_n(&queue->tail, tail, __ATOMIC_RELEASE);
+}
+
 /* Initialize audio system - HANDMADE: Arena-based allocation */
 bool audio_init(audio_system *audio, MemoryArena *arena) {
     memset(audio, 0, sizeof(audio_system));
@@ -75,11 +312,21 @@ bool audio_init(audio_system *audio, MemoryArena *arena) {
     audio->sounds = (audio_sound_buffer*)audio_arena_alloc(arena, 
         audio->max_sounds * sizeof(audio_sound_buffer));
     
+    /* Game <-> audio thread queues from arena */
+    audio->commands = (audio_command_queue*)audio_arena_alloc(arena, sizeof(audio_command_queue));
+    audio->events = (audio_event_queue*)audio_arena_alloc(arena, sizeof(audio_event_queue));
+    if (!audio->sounds || !audio->commands || !audio->events) {
+        return false;
+    }
+    memset(audio->commands, 0, sizeof(audio_command_queue));
+    memset(audio->events, 0, sizeof(audio_event_queue));
+    
     /* Initialize voices */
-    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+    for (int i = 0; i < AUDIO_MAX_VIRTUAL_VOICES; i++) {
         audio->voices[i].active = false;
         audio->voices[i].generation = 0;
     }
+    audio_build_sinc_table();
     
     /* Set default volumes */
     audio->master_volume = 1.0f;
@@ -90,6 +337,11 @@ bool audio_init(audio_system *audio, MemoryArena *arena) {
     audio->listener_forward = (audio_vec3){0, 0, -1};
     audio->listener_up = (audio_vec3){0, 1, 0};
     
+    /* Audio thread state starts out matching; the thread is not running yet */
+    audio->mix_state.listener_forward = audio->listener_forward;
+    audio->mix_state.master_volume = audio->master_volume;
+    audio->mix_state.sound_volume = audio->sound_volume;
+    
     /* Initialize ALSA */
     snd_pcm_t *pcm;
     int err;
@@ -222,44 +474,364 @@ static void *audio_thread_proc(void *data) {
     return NULL;
 }
 
-/* Mix all active voices - PERFORMANCE CRITICAL */
+/* Polyphase windowed-sinc coefficients, one row per fractional position.
+ * Stereo rows repeat each tap for the interleaved L/R pair. */
+static float audio_sinc_mono[AUDIO_SINC_PHASES + 1][AUDIO_SINC_TAPS] __attribute__((aligned(32)));
+static float audio_sinc_stereo[AUDIO_SINC_PHASES + 1][AUDIO_SINC_TAPS * 2] __attribute__((aligned(32)));
+static bool audio_sinc_ready = false;
+
+static void audio_build_sinc_table(void) {
+    if (audio_sinc_ready) return;
+    
+    for (int p = 0; p <= AUDIO_SINC_PHASES; p++) {
+        float frac = (float)p / AUDIO_SINC_PHASES;
+        float sum = 0.0f;
+        
+        for (int t = 0; t < AUDIO_SINC_TAPS; t++) {
+            /* Distance of tap t (frames -3..4) from the output position */
+            float x = (float)(t - 3) - frac;
+            float arg = (float)M_PI * x * AUDIO_SINC_CUTOFF;
+            float sinc = (fabsf(x) < 1e-6f) ? 1.0f : sinf(arg) / arg;
+            
+            /* Blackman window over the 8-frame span */
+            float w = 0.42f + 0.5f * cosf((float)M_PI * x / 4.0f) + 0.08f * cosf(2.0f * (float)M_PI * x / 4.0f);
+            if (fabsf(x) >= 4.0f) w = 0.0f;
+            
+            audio_sinc_mono[p][t] = sinc * w;
+            sum += sinc * w;
+        }
+        
+        /* Unity gain at DC */
+        for (int t = 0; t < AUDIO_SINC_TAPS; t++) {
+            audio_sinc_mono[p][t] /= sum;
+            audio_sinc_stereo[p][t * 2] = audio_sinc_mono[p][t];
+            audio_sinc_stereo[p][t * 2 + 1] = audio_sinc_mono[p][t];
+        }
+    }
+    
+    audio_sinc_ready = true;
+}
+
+/* Source sample with loop wrap, silence outside a one-shot sound */
+static inline float audio_fetch_sample(const audio_sound_buffer *sound, int64_t frame,
+                                       uint32_t channel, bool loop) {
+    int64_t count = sound->frame_count;
+    if (frame < 0 || frame >= count) {
+        if (!loop) return 0.0f;
+        frame %= count;
+        if (frame < 0) frame += count;
+    }
+    return sound->samples[frame * sound->channels + channel] * AUDIO_SAMPLE_SCALE;
+}
+
+/* One output frame near a loop or end boundary, where the SIMD kernels
+ * would read past the sample data */
+static void audio_resample_edge(const audio_sound_buffer *sound, int64_t frame, float frac,
+                                bool loop, audio_resample_quality quality, float *left, float *right) {
+    uint32_t right_channel = (sound->channels == 2) ? 1 : 0;
+    
+    if (quality == AUDIO_RESAMPLE_SINC) {
+        const float *taps = audio_sinc_mono[(int)(frac * AUDIO_SINC_PHASES + 0.5f)];
+        float l = 0.0f, r = 0.0f;
+        for (int t = 0; t < AUDIO_SINC_TAPS; t++) {
+            l += taps[t] * audio_fetch_sample(sound, frame + t - 3, 0, loop);
+            r += taps[t] * audio_fetch_sample(sound, frame + t - 3, right_channel, loop);
+        }
+        *left = l;
+        *right = r;
+    } else {
+        float l0 = audio_fetch_sample(sound, frame, 0, loop);
+        float r0 = audio_fetch_sample(sound, frame, right_channel, loop);
+        *left = l0 + (audio_fetch_sample(sound, frame + 1, 0, loop) - l0) * frac;
+        *right = r0 + (audio_fetch_sample(sound, frame + 1, right_channel, loop) - r0) * frac;
+    }
+}
+
+/* Linear interpolation of count frames starting at src, fractional read
+ * position phase + i * step. Every frame read must lie inside the sound. */
+static void audio_resample_linear(const audio_sound_buffer *sound, const int16_t *src, float phase,
+                                  float step, uint32_t count, float *left, float *right) {
+    __m256 lanes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 scale = _mm256_set1_ps(AUDIO_SAMPLE_SCALE);
+    uint32_t i = 0;
+    
+    if (sound->channels == 2) {
+        for (; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_fmadd_ps(_mm256_add_ps(_mm256_set1_ps((float)i), lanes),
+                                       _mm256_set1_ps(step), _mm256_set1_ps(phase));
+            __m256 xf = _mm256_floor_ps(x);
+            __m256 frac = _mm256_sub_ps(x, xf);
+            __m256i xi = _mm256_cvttps_epi32(xf);
+            
+            /* One 32-bit gather fetches a whole L/R frame */
+            __m256i a = _mm256_i32gather_epi32((const int *)src, xi, 4);
+            __m256i b = _mm256_i32gather_epi32((const int *)src + 1, xi, 4);
+            
+            __m256 al = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16));
+            __m256 ar = _mm256_cvtepi32_ps(_mm256_srai_epi32(a, 16));
+            __m256 bl = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16));
+            __m256 br = _mm256_cvtepi32_ps(_mm256_srai_epi32(b, 16));
+            
+            _mm256_storeu_ps(&left[i], _mm256_mul_ps(_mm256_fmadd_ps(_mm256_sub_ps(bl, al), frac, al), scale));
+            _mm256_storeu_ps(&right[i], _mm256_mul_ps(_mm256_fmadd_ps(_mm256_sub_ps(br, ar), frac, ar), scale));
+        }
+        for (; i < count; i++) {
+            float x = phase + i * step;
+            uint32_t xi = (uint32_t)x;
+            float frac = x - xi;
+            const int16_t *s = &src[xi * 2];
+            left[i] = (s[0] + (s[2] - s[0]) * frac) * AUDIO_SAMPLE_SCALE;
+            right[i] = (s[1] + (s[3] - s[1]) * frac) * AUDIO_SAMPLE_SCALE;
+        }
+    } else {
+        for (; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_fmadd_ps(_mm256_add_ps(_mm256_set1_ps((float)i), lanes),
+                                       _mm256_set1_ps(step), _mm256_set1_ps(phase));
+            __m256 xf = _mm256_floor_ps(x);
+            __m256 frac = _mm256_sub_ps(x, xf);
+            __m256i xi = _mm256_cvttps_epi32(xf);
+            
+            /* A 32-bit gather at 2-byte scale fetches a sample and its successor */
+            __m256i pair = _mm256_i32gather_epi32((const int *)src, xi, 2);
+            __m256 a = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(pair, 16), 16));
+            __m256 b = _mm256_cvtepi32_ps(_mm256_srai_epi32(pair, 16));
+            
+            _mm256_storeu_ps(&left[i], _mm256_mul_ps(_mm256_fmadd_ps(_mm256_sub_ps(b, a), frac, a), scale));
+        }
+        for (; i < count; i++) {
+            float x = phase + i * step;
+            uint32_t xi = (uint32_t)x;
+            float frac = x - xi;
+            left[i] = (src[xi] + (src[xi + 1] - src[xi]) * frac) * AUDIO_SAMPLE_SCALE;
+        }
+        memcpy(right, left, count * sizeof(float));
+    }
+}
+
+/* 8-tap polyphase sinc, same contract as audio_resample_linear. src must
+ * have 3 frames before and 4 after every read position. */
+static void audio_resample_sinc(const audio_sound_buffer *sound, const int16_t *src, float phase,
+                                float step, uint32_t count, float *left, float *right) {
+    for (uint32_t i = 0; i < count; i++) {
+        float x = phase + i * step;
+        uint32_t xi = (uint32_t)x;
+        int p = (int)((x - xi) * AUDIO_SINC_PHASES + 0.5f);
+        
+        if (sound->channels == 2) {
+            /* 8 interleaved frames in one load, taps duplicated per channel */
+            const int16_t *s = &src[((int64_t)xi - 3) * 2];
+            __m256i raw = _mm256_loadu_si256((const __m256i *)s);
+            __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(raw)));
+            __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(raw, 1)));
+            __m256 acc = _mm256_mul_ps(lo, _mm256_load_ps(&audio_sinc_stereo[p][0]));
+            acc = _mm256_fmadd_ps(hi, _mm256_load_ps(&audio_sinc_stereo[p][8]), acc);
+            
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            left[i] = _mm_cvtss_f32(sum) * AUDIO_SAMPLE_SCALE;
+            right[i] = _mm_cvtss_f32(_mm_shuffle_ps(sum, sum, 1)) * AUDIO_SAMPLE_SCALE;
+        } else {
+            const int16_t *s = &src[(int64_t)xi - 3];
+            __m256 v = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)s)));
+            __m256 acc = _mm256_mul_ps(v, _mm256_load_ps(audio_sinc_mono[p]));
+            
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+            left[i] = right[i] = _mm_cvtss_f32(sum) * AUDIO_SAMPLE_SCALE;
+        }
+    }
+}
+
+/* Resamples up to frames output frames of a voice into left/right.
+ * Loop wrap and end of sound are resolved once per segment; the kernels
+ * only see runs that stay inside the sample data. Returns the frames
+ * produced, fewer when a one-shot sound ends. */
+static uint32_t audio_resample_voice(audio_system *audio, audio_voice *voice, const audio_sound_buffer *sound,
+                                     float step, uint32_t frames, float *left, float *right) {
+    audio_resample_quality quality = audio->mix_state.resample_quality;
+    bool loop = (voice->flags & AUDIO_FLAG_LOOP) != 0;
+    int64_t before = (quality == AUDIO_RESAMPLE_SINC) ? 3 : 0;
+    int64_t after = (quality == AUDIO_RESAMPLE_SINC) ? 4 : 1;
+    
+    uint32_t position = voice->position;
+    double phase = voice->phase_accumulator;
+    uint32_t out = 0;
+    
+    while (out < frames) {
+        if (position >= sound->frame_count) {
+            if (!loop) {
+                voice->active = false;
+                break;
+            }
+            position %= sound->frame_count;
+        }
+        
+        /* Frames whose reads stay inside the sound; one frame of slack
+         * covers float rounding of the read position in the kernels */
+        uint32_t run = 0;
+        int64_t last = (int64_t)sound->frame_count - 2 - after - position;
+        if ((int64_t)position >= before && last >= 0) {
+            double fit = ((double)last + 1.0 - phase) / step;
+            run = (fit > 0.0) ? (uint32_t)fmin(fit, (double)(frames - out)) : 0;
+        }
+        
+        if (run > 0) {
+            const int16_t *src = sound->samples + (size_t)position * sound->channels;
+            if (quality == AUDIO_RESAMPLE_SINC) {
+                audio_resample_sinc(sound, src, (float)phase, step, run, &left[out], &right[out]);
+            } else {
+                audio_resample_linear(sound, src, (float)phase, step, run, &left[out], &right[out]);
+            }
+        } else {
+            audio_resample_edge(sound, position, (float)phase, loop, quality, &left[out], &right[out]);
+            run = 1;
+        }
+        
+        out += run;
+        phase += (double)run * step;
+        uint32_t advance = (uint32_t)phase;
+        position += advance;
+        phase -= advance;
+    }
+    
+    voice->position = position;
+    voice->phase_accumulator = (float)phase;
+    return out;
+}
+
+/* mix += source * gain, gains ramping linearly per frame. AVX2 handles 8
+ * frames per step and interleaves them into the stereo mix buffer. */
+static void audio_accumulate(float *mix, const float *left, const float *right, uint32_t count,
+                             float gain_left, float step_left, float gain_right, float step_right) {
+    __m256 lanes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    uint32_t i = 0;
+    
+    for (; i + 8 <= count; i += 8) {
+        __m256 frame = _mm256_add_ps(_mm256_set1_ps((float)i), lanes);
+        __m256 gl = _mm256_fmadd_ps(frame, _mm256_set1_ps(step_left), _mm256_set1_ps(gain_left));
+        __m256 gr = _mm256_fmadd_ps(frame, _mm256_set1_ps(step_right), _mm256_set1_ps(gain_right));
+        __m256 l = _mm256_mul_ps(_mm256_loadu_ps(&left[i]), gl);
+        __m256 r = _mm256_mul_ps(_mm256_loadu_ps(&right[i]), gr);
+        
+        /* [l0 r0 l1 r1 | l4 r4 l5 r5] and [l2 r2 l3 r3 | l6 r6 l7 r7] */
+        __m256 lo = _mm256_unpacklo_ps(l, r);
+        __m256 hi = _mm256_unpackhi_ps(l, r);
+        __m256 first = _mm256_permute2f128_ps(lo, hi, 0x20);
+        __m256 second = _mm256_permute2f128_ps(lo, hi, 0x31);
+        
+        _mm256_storeu_ps(&mix[i * 2], _mm256_add_ps(_mm256_loadu_ps(&mix[i * 2]), first));
+        _mm256_storeu_ps(&mix[i * 2 + 8], _mm256_add_ps(_mm256_loadu_ps(&mix[i * 2 + 8]), second));
+    }
+    for (; i < count; i++) {
+        mix[i * 2] += left[i] * (gain_left + i * step_left);
+        mix[i * 2 + 1] += right[i] * (gain_right + i * step_right);
+    }
+}
+
+/* Audibility multiplier per audio_priority: a critical voice outranks any
+ * audible lower-priority one */
+static const float audio_priority_weight[4] = { 0.25f, 1.0f, 4.0f, 1000000.0f };
+
+/* Virtual voices keep time without touching sample data, so promotion
+ * resumes exactly where the sound would have been */
+static void audio_advance_virtual(audio_voice *voice, const audio_sound_buffer *sound, float step,
+                                  uint32_t frames) {
+    double phase = voice->phase_accumulator + (double)step * frames;
+    uint64_t advance = (uint64_t)phase;
+    uint64_t position = voice->position + advance;
+    voice->phase_accumulator = (float)(phase - (double)advance);
+    
+    if (position >= sound->frame_count) {
+        if (!(voice->flags & AUDIO_FLAG_LOOP)) {
+            voice->active = false;
+            return;
+        }
+        position %= sound->frame_count;
+    }
+    voice->position = (uint32_t)position;
+}
+
+/* Playing voice considered for this period */
+typedef struct {
+    float score;       /* Audibility weighted by priority, 0 = inaudible */
+    uint32_t voice;
+    float left_gain;
+    float right_gain;
+    float step;        /* Source frames per output frame */
+} audio_mix_candidate;
+
+/* Moves the keep highest scores to the front, quickselect */
+static void audio_select_audible(audio_mix_candidate *candidates, uint32_t count, uint32_t keep) {
+    uint32_t lo = 0, hi = count - 1;
+    
+    while (lo < hi) {
+        float pivot = candidates[lo + (hi - lo) / 2].score;
+        uint32_t i = lo, j = hi;
+        while (i <= j) {
+            while (candidates[i].score > pivot) i++;
+            while (candidates[j].score < pivot) j--;
+            if (i <= j) {
+                audio_mix_candidate t = candidates[i];
+                candidates[i] = candidates[j];
+                candidates[j] = t;
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
+        
+        if (keep <= j) {
+            hi = j;
+        } else if (keep >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+}
+
+/* Mix the most audible voices, advance the rest - PERFORMANCE CRITICAL */
 static void audio_mix_voices(audio_system *audio, int16_t *output, uint32_t frames) {
     /* PERFORMANCE: Hot path - 90% of audio thread time
-     * CACHE: Process voices sequentially for cache locality
-     * SIMD: Use SSE2 for mixing operations */
+     * CACHE: Each voice is resampled into an L1-sized scratch block, then
+     *        accumulated; no per-sample wrap, modulo or end checks
+     * SIMD: AVX2 gathers for resampling, 8-frame accumulate and convert */
     
-    /* Clear output buffer using SIMD */
-    __m128i zero = _mm_setzero_si128();
-    for (uint32_t i = 0; i < frames * AUDIO_CHANNELS / 8; i++) {
-        _mm_store_si128((__m128i*)&output[i * 8], zero);
-    }
+    /* Game thread changes since the last period */
+    audio_apply_commands(audio);
     
-    /* Temporary float buffer for mixing */
+    /* Temporary float buffers for mixing */
     float *mix_buffer = (float*)alloca(frames * AUDIO_CHANNELS * sizeof(float));
+    float *voice_left = (float*)alloca(frames * sizeof(float));
+    float *voice_right = (float*)alloca(frames * sizeof(float));
     memset(mix_buffer, 0, frames * AUDIO_CHANNELS * sizeof(float));
     
-    uint32_t active_count = 0;
+    audio_mix_candidate *candidates = (audio_mix_candidate*)alloca(
+        AUDIO_MAX_VIRTUAL_VOICES * sizeof(audio_mix_candidate));
+    uint32_t candidate_count = 0;
+    float volume_scale = audio->mix_state.master_volume * audio->mix_state.sound_volume;
     
-    /* Mix each active voice */
-    for (int v = 0; v < AUDIO_MAX_VOICES; v++) {
+    /* Gains and audibility of every playing voice */
+    for (uint32_t v = 0; v < AUDIO_MAX_VIRTUAL_VOICES; v++) {
         audio_voice *voice = &audio->voices[v];
         if (!voice->active) continue;
         if (voice->flags & AUDIO_FLAG_PAUSED) continue;  /* Skip paused voices */
         
-        active_count++;
-        
         audio_sound_buffer *sound = &audio->sounds[voice->sound_id];
-        if (!sound->is_loaded) {
+        if (!__atomic_load_n(&sound->is_loaded, __ATOMIC_ACQUIRE) || sound->frame_count == 0) {
             voice->active = false;
+            audio_push_finished(audio, (v << 16) | voice->generation);
             continue;
         }
         
         /* Calculate 3D audio gains if needed */
         float left_gain = voice->volume;
         float right_gain = voice->volume;
+        float pitch = voice->pitch;
         
         if (voice->flags & AUDIO_FLAG_3D) {
-            audio_apply_3d(audio, voice, &left_gain, &right_gain);
+            audio_apply_3d(audio, voice, &left_gain, &right_gain, &pitch);
         } else {
             /* Apply panning for 2D sounds */
             float pan = voice->pan;
@@ -268,83 +840,128 @@ static void audio_mix_voices(audio_system *audio, int16_t *output, uint32_t fram
         }
         
         /* Apply master volumes */
-        float volume_scale = audio->master_volume * audio->sound_volume;
         left_gain *= volume_scale;
         right_gain *= volume_scale;
         
-        /* Mix voice into buffer with resampling */
-        float pitch = voice->pitch;
-        float phase = voice->phase_accumulator;
+        /* Source frames per output frame */
+        float step = pitch * (float)sound->sample_rate / AUDIO_SAMPLE_RATE;
+        if (!(step >= AUDIO_MIN_STEP)) step = AUDIO_MIN_STEP;
         
-        for (uint32_t i = 0; i < frames; i++) {
-            /* Get source sample with linear interpolation */
-            uint32_t pos = voice->position;
-            if (pos >= sound->frame_count) {
-                if (voice->flags & AUDIO_FLAG_LOOP) {
-                    voice->position = 0;
-                    pos = 0;
-                } else {
-                    voice->active = false;
-                    break;
-                }
-            }
-            
-            /* Linear interpolation for pitch shifting */
-            float frac = phase - floorf(phase);
-            uint32_t next_pos = (pos + 1) % sound->frame_count;
-            
-            if (sound->channels == 2) {
-                /* Stereo source */
-                float left = sound->samples[pos * 2] * (1.0f - frac) + 
-                            sound->samples[next_pos * 2] * frac;
-                float right = sound->samples[pos * 2 + 1] * (1.0f - frac) + 
-                             sound->samples[next_pos * 2 + 1] * frac;
-                
-                mix_buffer[i * 2] += left * left_gain;
-                mix_buffer[i * 2 + 1] += right * right_gain;
-            } else {
-                /* Mono source */
-                float sample = sound->samples[pos] * (1.0f - frac) + 
-                              sound->samples[next_pos] * frac;
-                
-                mix_buffer[i * 2] += sample * left_gain;
-                mix_buffer[i * 2 + 1] += sample * right_gain;
-            }
+        /* Voices already mixed get a bonus so near-equal voices do not
+         * swap places every period */
+        float audible = left_gain + right_gain;  /* Independent of pan */
+        float score = 0.0f;
+        if (audible > AUDIO_INAUDIBLE_GAIN) {
+            score = audible * audio_priority_weight[voice->priority & 3];
+            if (!voice->is_virtual && voice->gain_primed) score *= AUDIO_VIRTUAL_HYSTERESIS;
+        }
+        
+        audio_mix_candidate *candidate = &candidates[candidate_count++];
+        candidate->score = score;
+        candidate->voice = v;
+        candidate->left_gain = left_gain;
+        candidate->right_gain = right_gain;
+        candidate->step = step;
+    }
+    
+    /* Only the AUDIO_MAX_VOICES most audible are mixed */
+    uint32_t mix_budget = candidate_count;
+    if (candidate_count > AUDIO_MAX_VOICES) {
+        audio_select_audible(candidates, candidate_count, AUDIO_MAX_VOICES);
+        mix_budget = AUDIO_MAX_VOICES;
+    }
+    
+    uint32_t active_count = 0;
+    uint32_t virtual_count = 0;
+    
+    for (uint32_t c = 0; c < candidate_count; c++) {
+        audio_mix_candidate *candidate = &candidates[c];
+        audio_voice *voice = &audio->voices[candidate->voice];
+        audio_sound_buffer *sound = &audio->sounds[voice->sound_id];
+        
+        bool audible = c < mix_budget && candidate->score > 0.0f;
+        bool was_audible = !voice->is_virtual && voice->gain_primed;
+        float left_gain = candidate->left_gain;
+        float right_gain = candidate->right_gain;
+        
+        if (audible) {
+            voice->is_virtual = false;
+        } else if (was_audible) {
+            /* Demoted: one last period fading to silence */
+            left_gain = 0.0f;
+            right_gain = 0.0f;
+            voice->is_virtual = true;
+        } else {
+            /* Virtual: promotion later ramps up from silence */
+            audio_advance_virtual(voice, sound, candidate->step, frames);
+            voice->is_virtual = true;
+            voice->gain_left = 0.0f;
+            voice->gain_right = 0.0f;
+            voice->gain_primed = true;
+            virtual_count++;
             
-            /* Advance position with pitch */
-            phase += pitch;
-            while (phase >= 1.0f) {
-                voice->position++;
-                phase -= 1.0f;
+            if (!voice->active) {
+                audio_push_finished(audio, (candidate->voice << 16) | voice->generation);
             }
+            continue;
+        }
+        
+        active_count++;
+        
+        /* Ramp from last period's gains so volume, pan and distance changes
+         * do not step (zipper noise). A new voice starts at its target. */
+        if (!voice->gain_primed) {
+            voice->gain_left = left_gain;
+            voice->gain_right = right_gain;
+            voice->gain_primed = true;
         }
+        float step_left = (left_gain - voice->gain_left) / frames;
+        float step_right = (right_gain - voice->gain_right) / frames;
         
-        voice->phase_accumulator = phase;
+        uint32_t produced = audio_resample_voice(audio, voice, sound, candidate->step, frames,
+                                                 voice_left, voice_right);
+        audio_accumulate(mix_buffer, voice_left, voice_right, produced,
+                         voice->gain_left, step_left, voice->gain_right, step_right);
+        
+        voice->gain_left = left_gain;
+        voice->gain_right = right_gain;
+        
+        /* One-shot sound played out */
+        if (!voice->active) {
+            audio_push_finished(audio, (candidate->voice << 16) | voice->generation);
+        }
     }
     
-    audio->active_voices = active_count;
+    __atomic_store_n(&audio->active_voices, active_count, __ATOMIC_RELAXED);
+    __atomic_store_n(&audio->virtual_voices, virtual_count, __ATOMIC_RELAXED);
     
     /* Apply effects to mix buffer */
     if (active_count > 0) {
         audio_process_effects(audio, mix_buffer, frames);
     }
     
-    /* Convert float mix to int16 output with clamping using SIMD */
-    for (uint32_t i = 0; i < frames * AUDIO_CHANNELS; i += 4) {
-        __m128 samples = _mm_load_ps(&mix_buffer[i]);
-        __m128 scaled = _mm_mul_ps(samples, _mm_set1_ps(32767.0f));
-        __m128i integers = _mm_cvtps_epi32(scaled);
+    /* Convert float mix to int16 output with saturation, 16 samples at a time */
+    __m256 full_scale = _mm256_set1_ps(32767.0f);
+    uint32_t samples = frames * AUDIO_CHANNELS;
+    uint32_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&mix_buffer[i]), full_scale));
+        __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(&mix_buffer[i + 8]), full_scale));
         
-        /* Pack and saturate to int16 */
-        __m128i packed = _mm_packs_epi32(integers, integers);
-        _mm_storel_epi64((__m128i*)&output[i], packed);
+        /* packs works per 128-bit lane, the permute restores sample order */
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        _mm256_storeu_si256((__m256i*)&output[i], packed);
+    }
+    for (; i < samples; i++) {
+        output[i] = audio_clamp_sample(mix_buffer[i] * 32767.0f);
     }
 }
 
-/* Apply 3D audio calculations */
-static void audio_apply_3d(audio_system *audio, audio_voice *voice, float *left_gain, float *right_gain) {
+/* Apply 3D audio calculations, Doppler scales this period's pitch only */
+static void audio_apply_3d(audio_system *audio, audio_voice *voice, float *left_gain, float *right_gain,
+                           float *pitch) {
     /* Calculate distance attenuation */
-    float dist = audio_vec3_distance(voice->position_3d, audio->listener_position);
+    float dist = audio_vec3_distance(voice->position_3d, audio->mix_state.listener_position);
     
     float attenuation = 1.0f;
     if (dist > voice->min_distance) {
@@ -359,17 +976,17 @@ static void audio_apply_3d(audio_system *audio, audio_voice *voice, float *left_
     
     /* Calculate stereo panning based on position */
     audio_vec3 to_sound = {
-        voice->position_3d.x - audio->listener_position.x,
-        voice->position_3d.y - audio->listener_position.y,
-        voice->position_3d.z - audio->listener_position.z
+        voice->position_3d.x - audio->mix_state.listener_position.x,
+        voice->position_3d.y - audio->mix_state.listener_position.y,
+        voice->position_3d.z - audio->mix_state.listener_position.z
     };
     to_sound = audio_vec3_normalize(to_sound);
     
     /* Simple left/right panning based on listener orientation */
     audio_vec3 right = {
-        audio->listener_forward.z, 
+        audio->mix_state.listener_forward.z, 
         0, 
-        -audio->listener_forward.x
+        -audio->mix_state.listener_forward.x
     };
     right = audio_vec3_normalize(right);
     
@@ -377,15 +994,15 @@ static void audio_apply_3d(audio_system *audio, audio_voice *voice, float *left_
     float pan = dot_right;  /* -1 to 1 */
     
     /* Apply panning */
-    *left_gain = voice->volume * attenuation * (1.0f - pan) * 0.5f + 0.5f;
-    *right_gain = voice->volume * attenuation * (1.0f + pan) * 0.5f + 0.5f;
+    *left_gain = voice->volume * attenuation * ((1.0f - pan) * 0.5f + 0.5f);
+    *right_gain = voice->volume * attenuation * ((1.0f + pan) * 0.5f + 0.5f);
     
     /* Apply simple Doppler effect if velocities are significant */
     float speed_of_sound = 343.0f;  /* m/s */
     audio_vec3 relative_velocity = {
-        voice->velocity.x - audio->listener_velocity.x,
-        voice->velocity.y - audio->listener_velocity.y,
-        voice->velocity.z - audio->listener_velocity.z
+        voice->velocity.x - audio->mix_state.listener_velocity.x,
+        voice->velocity.y - audio->mix_state.listener_velocity.y,
+        voice->velocity.z - audio->mix_state.listener_velocity.z
     };
     
     float velocity_towards = -(relative_velocity.x * to_sound.x + 
@@ -395,7 +1012,7 @@ static void audio_apply_3d(audio_system *audio, audio_voice *voice, float *left_
     /* Doppler pitch shift */
     float doppler_factor = 1.0f + (velocity_towards / speed_of_sound);
     doppler_factor = fmaxf(0.5f, fminf(2.0f, doppler_factor));  /* Clamp to reasonable range */
-    voice->pitch *= doppler_factor;
+    *pitch *= doppler_factor;
 }
 
 /* Clamp floating point sample to int16 range */
@@ -504,133 +1121,79 @@ audio_handle audio_play_sound(audio_system *audio, audio_handle sound_handle, fl
         return AUDIO_INVALID_HANDLE;
     }
     
-    uint32_t sound_id = sound_handle - 1;
-    
-    /* Find free voice */
-    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
-        audio_voice *voice = &audio->voices[i];
-        if (!voice->active) {
-            voice->sound_id = sound_id;
-            voice->position = 0;
-            voice->volume = volume;
-            voice->pan = pan;
-            voice->pitch = 1.0f;
-            voice->flags = 0;
-            voice->priority = AUDIO_PRIORITY_NORMAL;
-            voice->phase_accumulator = 0;
-            voice->generation++;
-            voice->active = true;
-            
-            return (i << 16) | voice->generation;  /* Encode voice index and generation */
-        }
-    }
-    
-    /* Voice stealing - find lowest priority voice */
-    int steal_index = -1;
-    audio_priority lowest_priority = AUDIO_PRIORITY_CRITICAL;
-    
-    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
-        if (audio->voices[i].priority < lowest_priority) {
-            lowest_priority = audio->voices[i].priority;
-            steal_index = i;
-        }
-    }
-    
-    if (steal_index >= 0) {
-        audio_voice *voice = &audio->voices[steal_index];
-        voice->sound_id = sound_id;
-        voice->position = 0;
-        voice->volume = volume;
-        voice->pan = pan;
-        voice->pitch = 1.0f;
-        voice->flags = 0;
-        voice->priority = AUDIO_PRIORITY_NORMAL;
-        voice->phase_accumulator = 0;
-        voice->generation++;
-        voice->active = true;
-        
-        return (steal_index << 16) | voice->generation;
-    }
-    
-    return AUDIO_INVALID_HANDLE;
+    return audio_start_voice(audio, sound_handle - 1, volume, pan, 0, AUDIO_PRIORITY_NORMAL,
+                             (audio_vec3){0, 0, 0});
 }
 
 /* Play 3D sound */
 audio_handle audio_play_sound_3d(audio_system *audio, audio_handle sound_handle, 
                                  audio_vec3 pos, float volume) {
-    audio_handle voice = audio_play_sound(audio, sound_handle, volume, 0);
-    if (voice != AUDIO_INVALID_HANDLE) {
-        uint32_t index = voice >> 16;
-        audio->voices[index].flags |= AUDIO_FLAG_3D;
-        audio->voices[index].position_3d = pos;
-        audio->voices[index].min_distance = 1.0f;
-        audio->voices[index].max_distance = 100.0f;
+    if (sound_handle == AUDIO_INVALID_HANDLE || sound_handle > audio->sound_count) {
+        return AUDIO_INVALID_HANDLE;
     }
-    return voice;
+    
+    return audio_start_voice(audio, sound_handle - 1, volume, 0, AUDIO_FLAG_3D, AUDIO_PRIORITY_NORMAL, pos);
 }
 
-/* Stop playing sound */
+/* Stop playing sound - the slot is free for reuse right away, commands
+ * reach the audio thread in order */
 void audio_stop_sound(audio_system *audio, audio_handle voice_handle) {
-    if (voice_handle == AUDIO_INVALID_HANDLE) return;
+    audio_voice_slot *slot = audio_find_slot(audio, voice_handle);
+    if (!slot) return;
     
-    uint32_t index = voice_handle >> 16;
-    uint32_t generation = voice_handle & 0xFFFF;
-    
-    if (index < AUDIO_MAX_VOICES && audio->voices[index].generation == generation) {
-        audio->voices[index].active = false;
+    audio_command command = {.type = AUDIO_CMD_STOP, .voice = voice_handle};
+    if (audio_push_command(audio, &command)) {
+        slot->busy = false;
     }
 }
 
 /* Set voice volume */
 void audio_set_voice_volume(audio_system *audio, audio_handle voice_handle, float volume) {
-    if (voice_handle == AUDIO_INVALID_HANDLE) return;
-    
-    uint32_t index = voice_handle >> 16;
-    uint32_t generation = voice_handle & 0xFFFF;
-    
-    if (index < AUDIO_MAX_VOICES && audio->voices[index].generation == generation) {
-        audio->voices[index].volume = volume;
-    }
+    audio_command command = {.type = AUDIO_CMD_SET_VOLUME};
+    command.data.value = volume;
+    audio_voice_command(audio, voice_handle, &command);
 }
 
 /* Set voice pitch */
 void audio_set_voice_pitch(audio_system *audio, audio_handle voice_handle, float pitch) {
-    if (voice_handle == AUDIO_INVALID_HANDLE) return;
-    
-    uint32_t index = voice_handle >> 16;
-    uint32_t generation = voice_handle & 0xFFFF;
-    
-    if (index < AUDIO_MAX_VOICES && audio->voices[index].generation == generation) {
-        audio->voices[index].pitch = pitch;
-    }
+    audio_command command = {.type = AUDIO_CMD_SET_PITCH};
+    command.data.value = pitch;
+    audio_voice_command(audio, voice_handle, &command);
 }
 
 /* Set 3D position */
 void audio_set_voice_position_3d(audio_system *audio, audio_handle voice_handle, audio_vec3 pos) {
-    if (voice_handle == AUDIO_INVALID_HANDLE) return;
-    
-    uint32_t index = voice_handle >> 16;
-    uint32_t generation = voice_handle & 0xFFFF;
-    
-    if (index < AUDIO_MAX_VOICES && audio->voices[index].generation == generation) {
-        audio->voices[index].position_3d = pos;
-    }
+    audio_command command = {.type = AUDIO_CMD_SET_POSITION_3D};
+    command.data.vector = pos;
+    audio_voice_command(audio, voice_handle, &command);
 }
 
 /* Set listener position */
 void audio_set_listener_position(audio_system *audio, audio_vec3 pos) {
     audio->listener_position = pos;
+    audio_send_listener(audio);
 }
 
 /* Set listener orientation */
 void audio_set_listener_orientation(audio_system *audio, audio_vec3 forward, audio_vec3 up) {
     audio->listener_forward = audio_vec3_normalize(forward);
     audio->listener_up = audio_vec3_normalize(up);
+    audio_send_listener(audio);
+}
+
+/* Select the resampler for pitched and off-rate voices */
+void audio_set_resample_quality(audio_system *audio, audio_resample_quality quality) {
+    audio->resample_quality = quality;
+    
+    audio_command command = {.type = AUDIO_CMD_SET_RESAMPLE_QUALITY};
+    command.data.quality = quality;
+    audio_push_command(audio, &command);
 }
 
 /* Set master volume */
 void audio_set_master_volume(audio_system *audio, float volume) {
     audio->master_volume = fmaxf(0.0f, fminf(1.0f, volume));
+    audio_send_master(audio);
 }
 
 /* Get CPU usage */
@@ -640,7 +1203,12 @@ float audio_get_cpu_usage(audio_system *audio) {
 
 /* Get active voice count */
 uint32_t audio_get_active_voices(audio_system *audio) {
-    return audio->active_voices;
+    return __atomic_load_n(&audio->active_voices, __ATOMIC_RELAXED);
+}
+
+/* Get playing voices that are not being mixed */
+uint32_t audio_get_virtual_voices(audio_system *audio) {
+    return __atomic_load_n(&audio->virtual_voices, __ATOMIC_RELAXED);
 }
 
 /* Vector utilities */
@@ -708,27 +1276,9 @@ void audio_play_music_layer(audio_system *audio, uint32_t layer, audio_handle so
     music->is_active = true;
     music->fade_speed = 0.0f;
     
-    /* Start playing the sound looped */
-    audio_voice *voice = NULL;
-    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
-        if (!audio->voices[i].active) {
-            voice = &audio->voices[i];
-            break;
-        }
-    }
-    
-    if (voice) {
-        voice->sound_id = music->sound_id;
-        voice->position = 0;
-        voice->volume = volume * audio->music_volume;
-        voice->pan = 0;
-        voice->pitch = 1.0f;
-        voice->flags = AUDIO_FLAG_LOOP;  /* Music always loops */
-        voice->priority = AUDIO_PRIORITY_HIGH;
-        voice->phase_accumulator = 0;
-        voice->generation++;
-        voice->active = true;
-    }
+    /* Start playing the sound looped - music always loops */
+    music->voice = audio_start_voice(audio, music->sound_id, volume * audio->music_volume, 0,
+                                     AUDIO_FLAG_LOOP, AUDIO_PRIORITY_HIGH, (audio_vec3){0, 0, 0});
 }
 
 void audio_stop_music_layer(audio_system *audio, uint32_t layer) {
@@ -737,14 +1287,9 @@ void audio_stop_music_layer(audio_system *audio, uint32_t layer) {
     audio_music_layer *music = &audio->music_layers[layer];
     music->is_active = false;
     
-    /* Stop any voices playing this music */
-    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
-        if (audio->voices[i].active && 
-            audio->voices[i].sound_id == music->sound_id &&
-            (audio->voices[i].flags & AUDIO_FLAG_LOOP)) {
-            audio->voices[i].active = false;
-        }
-    }
+    /* Stop the voice playing this music */
+    audio_stop_sound(audio, music->voice);
+    music->voice = AUDIO_INVALID_HANDLE;
 }
 
 void audio_set_music_intensity(audio_system *audio, float intensity) {
@@ -754,14 +1299,7 @@ void audio_set_music_intensity(audio_system *audio, float intensity) {
     for (int i = 0; i < 8; i++) {
         if (audio->music_layers[i].is_active) {
             float target_volume = audio->music_layers[i].volume * audio->music_intensity;
-            /* Find and update the voice playing this layer */
-            for (int v = 0; v < AUDIO_MAX_VOICES; v++) {
-                if (audio->voices[v].active && 
-                    audio->voices[v].sound_id == audio->music_layers[i].sound_id) {
-                    audio->voices[v].volume = target_volume * audio->music_volume;
-                    break;
-                }
-            }
+            audio_set_voice_volume(audio, audio->music_layers[i].voice, target_volume * audio->music_volume);
         }
     }
 }
@@ -780,52 +1318,41 @@ uint64_t audio_get_underrun_count(audio_system *audio) {
 
 /* Pause/unpause sound */
 void audio_pause_sound(audio_system *audio, audio_handle voice_handle, bool pause) {
-    if (voice_handle == AUDIO_INVALID_HANDLE) return;
-    
-    uint32_t index = voice_handle >> 16;
-    uint32_t generation = voice_handle & 0xFFFF;
-    
-    if (index < AUDIO_MAX_VOICES && audio->voices[index].generation == generation) {
-        if (pause) {
-            audio->voices[index].flags |= AUDIO_FLAG_PAUSED;
-        } else {
-            audio->voices[index].flags &= ~AUDIO_FLAG_PAUSED;
-        }
-    }
+    audio_command command = {.type = AUDIO_CMD_PAUSE};
+    command.data.pause = pause;
+    audio_voice_command(audio, voice_handle, &command);
+}
+
+/* True until the voice is stopped or has played out */
+bool audio_is_voice_playing(audio_system *audio, audio_handle voice_handle) {
+    audio_drain_events(audio);
+    return audio_find_slot(audio, voice_handle) != NULL;
 }
 
 /* Set voice pan */
 void audio_set_voice_pan(audio_system *audio, audio_handle voice_handle, float pan) {
-    if (voice_handle == AUDIO_INVALID_HANDLE) return;
-    
-    uint32_t index = voice_handle >> 16;
-    uint32_t generation = voice_handle & 0xFFFF;
-    
-    if (index < AUDIO_MAX_VOICES && audio->voices[index].generation == generation) {
-        audio->voices[index].pan = fmaxf(-1.0f, fminf(1.0f, pan));
-    }
+    audio_command command = {.type = AUDIO_CMD_SET_PAN};
+    command.data.value = fmaxf(-1.0f, fminf(1.0f, pan));
+    audio_voice_command(audio, voice_handle, &command);
 }
 
 /* Set voice velocity */
 void audio_set_voice_velocity(audio_system *audio, audio_handle voice_handle, audio_vec3 vel) {
-    if (voice_handle == AUDIO_INVALID_HANDLE) return;
-    
-    uint32_t index = voice_handle >> 16;
-    uint32_t generation = voice_handle & 0xFFFF;
-    
-    if (index < AUDIO_MAX_VOICES && audio->voices[index].generation == generation) {
-        audio->voices[index].velocity = vel;
-    }
+    audio_command command = {.type = AUDIO_CMD_SET_VELOCITY};
+    command.data.vector = vel;
+    audio_voice_command(audio, voice_handle, &command);
 }
 
 /* Set listener velocity */
 void audio_set_listener_velocity(audio_system *audio, audio_vec3 vel) {
     audio->listener_velocity = vel;
+    audio_send_listener(audio);
 }
 
 /* Set sound volume */
 void audio_set_sound_volume(audio_system *audio, float volume) {
     audio->sound_volume = fmaxf(0.0f, fminf(1.0f, volume));
+    audio_send_master(audio);
 }
 
 /* Set music volume */
@@ -838,18 +1365,23 @@ void audio_unload_sound(audio_system *audio, audio_handle sound) {
     if (sound == AUDIO_INVALID_HANDLE || sound > audio->sound_count) return;
     
     uint32_t sound_id = sound - 1;
-    audio->sounds[sound_id].is_loaded = false;
     
     /* Stop all voices using this sound */
-    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
-        if (audio->voices[i].active && audio->voices[i].sound_id == sound_id) {
-            audio->voices[i].active = false;
+    for (uint32_t i = 0; i < AUDIO_MAX_VIRTUAL_VOICES; i++) {
+        audio_voice_slot *slot = &audio->voice_slots[i];
+        if (slot->busy && slot->sound_id == sound_id) {
+            audio_stop_sound(audio, (i << 16) | slot->generation);
         }
     }
+    
+    __atomic_store_n(&audio->sounds[sound_id].is_loaded, false, __ATOMIC_RELEASE);
 }
 
 /* Update function (for fading, etc) */
 void audio_update(audio_system *audio, float dt) {
+    /* Reclaim slots of voices that played out */
+    audio_drain_events(audio);
+    
     /* Update music layer fades */
     for (int i = 0; i < 8; i++) {
         audio_music_layer *layer = &audio->music_layers[i];
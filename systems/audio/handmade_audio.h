@@ -26,9 +26,12 @@
 #define AUDIO_CHANNELS 2
 #define AUDIO_BITS_PER_SAMPLE 16
 #define AUDIO_BUFFER_FRAMES 512  /* ~10.6ms latency at 48kHz */
-#define AUDIO_MAX_VOICES 128
+#define AUDIO_MAX_VOICES 128           /* Voices actually mixed per period */
+#define AUDIO_MAX_VIRTUAL_VOICES 1024  /* Playing voices, the least audible are virtual */
 #define AUDIO_MAX_EFFECTS 8
 #define AUDIO_RING_BUFFER_SIZE (AUDIO_BUFFER_FRAMES * 4)
+#define AUDIO_COMMAND_QUEUE_SIZE 1024  /* Game -> audio thread, power of two */
+#define AUDIO_EVENT_QUEUE_SIZE 1024    /* Audio -> game thread, power of two */
 
 /* Fixed-point math for performance */
 #define AUDIO_FIXED_SHIFT 16
@@ -55,6 +58,12 @@ typedef enum {
     AUDIO_EFFECT_FLANGER
 } audio_effect_type;
 
+/* Resampler used for voices whose pitch or source rate differs from output */
+typedef enum {
+    AUDIO_RESAMPLE_LINEAR = 0,  /* 2-tap linear interpolation */
+    AUDIO_RESAMPLE_SINC         /* 8-tap windowed-sinc polyphase filter */
+} audio_resample_quality;
+
 /* Sound priority for voice stealing */
 typedef enum {
     AUDIO_PRIORITY_LOW = 0,
@@ -107,6 +116,10 @@ typedef struct {
     
     /* Internal state */
     float phase_accumulator;  /* For resampling */
+    float gain_left;          /* Gains reached by the last mix period, */
+    float gain_right;         /* new targets are ramped to from here */
+    bool gain_primed;         /* False until the first period sets the gains */
+    bool is_virtual;          /* Not mixed, position advances by time only */
     bool active;
     uint32_t generation;      /* For handle validation */
 } audio_voice;
@@ -149,9 +162,79 @@ typedef struct {
     void *state;
 } audio_effect;
 
+/* Commands from the game thread, applied at the start of a mix period */
+typedef enum {
+    AUDIO_CMD_PLAY,
+    AUDIO_CMD_STOP,
+    AUDIO_CMD_PAUSE,
+    AUDIO_CMD_SET_VOLUME,
+    AUDIO_CMD_SET_PAN,
+    AUDIO_CMD_SET_PITCH,
+    AUDIO_CMD_SET_POSITION_3D,
+    AUDIO_CMD_SET_VELOCITY,
+    AUDIO_CMD_SET_LISTENER,
+    AUDIO_CMD_SET_MASTER,
+    AUDIO_CMD_SET_RESAMPLE_QUALITY
+} audio_command_type;
+
+typedef struct {
+    audio_command_type type;
+    uint32_t voice;  /* Voice handle for per-voice commands */
+    
+    union {
+        struct {
+            uint32_t sound_id;
+            float volume;
+            float pan;
+            uint32_t flags;
+            audio_priority priority;
+            audio_vec3 position;
+        } play;
+        
+        struct {
+            audio_vec3 position;
+            audio_vec3 forward;
+            audio_vec3 velocity;
+        } listener;
+        
+        struct {
+            float master;
+            float sound;
+        } master;
+        
+        float value;
+        bool pause;
+        audio_vec3 vector;
+        audio_resample_quality quality;
+    } data;
+} audio_command;
+
+/* Single-producer single-consumer rings. Each index is written by one
+ * side only and lives on its own cache line. */
+typedef struct {
+    audio_command commands[AUDIO_COMMAND_QUEUE_SIZE];
+    uint32_t head __attribute__((aligned(64)));  /* Game thread */
+    uint32_t tail __attribute__((aligned(64)));  /* Audio thread */
+} audio_command_queue;
+
+typedef struct {
+    uint32_t finished[AUDIO_EVENT_QUEUE_SIZE];   /* Handles of voices that played out */
+    uint32_t head __attribute__((aligned(64)));  /* Audio thread */
+    uint32_t tail __attribute__((aligned(64)));  /* Game thread */
+} audio_event_queue;
+
+/* Game thread's view of a voice slot */
+typedef struct {
+    uint32_t sound_id;
+    uint16_t generation;
+    audio_priority priority;
+    bool busy;
+} audio_voice_slot;
+
 /* Music layer for dynamic music */
 typedef struct {
     uint32_t sound_id;
+    uint32_t voice;  /* Handle of the looping voice */
     float volume;
     float fade_speed;
     bool is_active;
@@ -174,10 +257,27 @@ typedef struct {
     uint32_t max_sounds;
     uint32_t sound_count;
     
-    /* Voice pool */
-    audio_voice voices[AUDIO_MAX_VOICES];
+    /* Voice pool - voices[] belongs to the audio thread, the game thread
+     * allocates through voice_slots[] and talks to it via the queues */
+    audio_voice voices[AUDIO_MAX_VIRTUAL_VOICES];
+    audio_voice_slot voice_slots[AUDIO_MAX_VIRTUAL_VOICES];
     uint32_t voice_generation;
     
+    /* THREADING: Lock-free game <-> audio thread queues */
+    audio_command_queue *commands;
+    audio_event_queue *events;
+    uint64_t commands_dropped;
+    
+    /* Audio thread's copy of the listener and master gains */
+    struct {
+        audio_vec3 listener_position;
+        audio_vec3 listener_forward;
+        audio_vec3 listener_velocity;
+        float master_volume;
+        float sound_volume;
+        audio_resample_quality resample_quality;
+    } mix_state;
+    
     /* Effects rack */
     audio_effect effects[AUDIO_MAX_EFFECTS];
     
@@ -195,6 +295,7 @@ typedef struct {
     float master_volume;
     float sound_volume;
     float music_volume;
+    audio_resample_quality resample_quality;
     
     /* Threading */
     void *audio_thread;
@@ -204,7 +305,8 @@ typedef struct {
     uint64_t frames_processed;
     uint64_t underruns;
     float cpu_usage;
-    uint32_t active_voices;
+    uint32_t active_voices;   /* Mixed last period */
+    uint32_t virtual_voices;  /* Playing but inaudible or over budget */
     
     /* Memory pools */
     void *memory_pool;
@@ -233,6 +335,7 @@ audio_handle audio_play_sound(audio_system *audio, audio_handle sound, float vol
 audio_handle audio_play_sound_3d(audio_system *audio, audio_handle sound, audio_vec3 pos, float volume);
 void audio_stop_sound(audio_system *audio, audio_handle voice);
 void audio_pause_sound(audio_system *audio, audio_handle voice, bool pause);
+bool audio_is_voice_playing(audio_system *audio, audio_handle voice);
 
 /* Voice control */
 void audio_set_voice_volume(audio_system *audio, audio_handle voice, float volume);
@@ -259,6 +362,9 @@ void audio_set_listener_position(audio_system *audio, audio_vec3 pos);
 void audio_set_listener_orientation(audio_system *audio, audio_vec3 forward, audio_vec3 up);
 void audio_set_listener_velocity(audio_system *audio, audio_vec3 vel);
 
+/* Resampling */
+void audio_set_resample_quality(audio_system *audio, audio_resample_quality quality);
+
 /* Master volume control */
 void audio_set_master_volume(audio_system *audio, float volume);
 void audio_set_sound_volume(audio_system *audio, float volume);
@@ -267,6 +373,7 @@ void audio_set_music_volume(audio_system *audio, float volume);
 /* Performance monitoring */
 float audio_get_cpu_usage(audio_system *audio);
 uint32_t audio_get_active_voices(audio_system *audio);
+uint32_t audio_get_virtual_voices(audio_system *audio);
 uint64_t audio_get_underrun_count(audio_system *audio);
 
 /* Utility functions */
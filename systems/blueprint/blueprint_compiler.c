@@ -10,6 +10,17 @@
 // COMPILER DATA STRUCTURES
 // ============================================================================
 
+// Per-node facts gathered with the adjacency
+#define COMPILER_NODE_PURE (1 << 0)        // No execution pins, inlined where read
+#define COMPILER_NODE_EXEC_INPUT (1 << 1)  // Execution flows into it
+#define COMPILER_NODE_READ (1 << 2)        // Some output is connected
+
+// Node and pin slot on the other end of a connection
+typedef struct compiler_edge {
+    u32 node;   // Node index
+    u32 slot;   // Pin slot - inputs first, then outputs
+} compiler_edge;
+
 // Compilation context
 typedef struct compiler_context {
     blueprint_context* bp_ctx;
@@ -20,10 +31,25 @@ typedef struct compiler_context {
     u32 bytecode_capacity;
     u32 bytecode_count;
     
-    // Constant pool
-    blueprint_value* constants;
+    // Register allocation - output pins first, then input constants
+    blueprint_value* register_image;
+    u8* register_types;
+    u32 register_count;
+    u32 register_capacity;
     u32 constant_count;
     
+    // Pin adjacency - CSR over every pin slot in the graph, built once per
+    // compile. Input slots list their sources, output slots their targets
+    // PERFORMANCE: O(nodes + connections) instead of a connection scan per pin
+    u32* pin_base;          // First slot of each node, by node index
+    u32* edge_offsets;      // Slot s owns edges [edge_offsets[s], edge_offsets[s + 1])
+    compiler_edge* edges;
+    u8* node_info;          // COMPILER_NODE_* by node index
+    
+    // Pure node emission - pure nodes are inlined into each block that reads them
+    u32* emit_stamp;        // Block that last emitted each node, by node index
+    u32 block_id;
+    
     // Variable mapping
     u32* variable_indices;  // Maps graph variable indices to VM indices
     
@@ -32,20 +58,22 @@ typedef struct compiler_context {
     u32 compiled_node_count;
     b32* node_visited;      // For topological sorting
     b32* node_in_progress;  // For cycle detection
+    u32* order;             // Execution order as node indices
+    u32 order_count;
+    
+    // Incremental compilation - nodes whose code is regenerated
+    b32 incremental;
+    u8* node_affected;      // By node index
+    u32* replaced_address;  // Previous block address of each regenerated node
+    u32 sink_block_address;
     
-    // Jump patching
+    // Jump patching - targets are node indices
     struct {
         u32 instruction_index;
-        node_id target_node;
-    } pending_jumps[1024];
+        u32 target_node;
+    } *pending_jumps;
     u32 pending_jump_count;
-    
-    // Node address mapping - maps node_id to bytecode address
-    struct {
-        node_id node;
-        u32 address;
-    } node_addresses[BLUEPRINT_MAX_NODES];
-    u32 node_address_count;
+    u32 pending_jump_capacity;
     
     // Error reporting
     char error_buffer[512];
@@ -72,52 +100,38 @@ static void emit_instruction(compiler_context* ctx, bp_opcode opcode, u32 op1, u
     inst->operand3 = op3;
 }
 
-// Add constant to pool and return index
-static u32 add_constant(compiler_context* ctx, blueprint_value value) {
-    if (ctx->constant_count >= BLUEPRINT_MAX_CONSTANTS) {
+#define BP_INVALID_REGISTER 0xFFFFFFFF
+#define BP_INVALID_ADDRESS 0xFFFFFFFF
+
+// Allocate a register holding an initial value
+static u32 alloc_register(compiler_context* ctx, blueprint_type type, blueprint_value value) {
+    if (ctx->register_count >= ctx->register_capacity) {
         ctx->has_error = true;
-        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Constant pool overflow");
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), 
+                "Register file overflow at %u registers", ctx->register_count);
         return 0;
     }
     
-    // Check if constant already exists to avoid duplicates
-    for (u32 i = 0; i < ctx->constant_count; i++) {
-        // Simple memcmp for now - could be optimized per type
-        if (memcmp(&ctx->constants[i], &value, sizeof(blueprint_value)) == 0) {
-            return i;
-        }
-    }
-    
-    ctx->constants[ctx->constant_count] = value;
-    return ctx->constant_count++;
+    ctx->register_image[ctx->register_count] = value;
+    ctx->register_types[ctx->register_count] = (u8)type;
+    return ctx->register_count++;
 }
 
-// Map node ID to bytecode address
-static void set_node_address(compiler_context* ctx, node_id node, u32 address) {
-    if (ctx->node_address_count >= BLUEPRINT_MAX_NODES) {
+// Unconnected inputs read a constant register initialized from the pin
+static u32 add_constant(compiler_context* ctx, blueprint_pin* pin) {
+    if (ctx->constant_count >= BLUEPRINT_MAX_CONSTANTS) {
         ctx->has_error = true;
-        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Node address table overflow");
-        return;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Constant pool overflow");
+        return 0;
     }
     
-    ctx->node_addresses[ctx->node_address_count].node = node;
-    ctx->node_addresses[ctx->node_address_count].address = address;
-    ctx->node_address_count++;
-}
-
-// Get bytecode address for node
-static u32 get_node_address(compiler_context* ctx, node_id node) {
-    for (u32 i = 0; i < ctx->node_address_count; i++) {
-        if (ctx->node_addresses[i].node == node) {
-            return ctx->node_addresses[i].address;
-        }
-    }
-    return 0xFFFFFFFF; // Invalid address
+    ctx->constant_count++;
+    return alloc_register(ctx, pin->type, pin->current_value);
 }
 
 // Add pending jump to be patched later
-static void add_pending_jump(compiler_context* ctx, u32 instruction_index, node_id target_node) {
-    if (ctx->pending_jump_count >= 1024) {
+static void add_pending_jump(compiler_context* ctx, u32 instruction_index, u32 target_node) {
+    if (ctx->pending_jump_count >= ctx->pending_jump_capacity) {
         ctx->has_error = true;
         snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Too many pending jumps");
         return;
@@ -128,182 +142,423 @@ static void add_pending_jump(compiler_context* ctx, u32 instruction_index, node_
     ctx->pending_jump_count++;
 }
 
-// Patch all pending jumps
+// Patch all pending jumps - blocks not regenerated keep their address
 static void patch_jumps(compiler_context* ctx) {
     for (u32 i = 0; i < ctx->pending_jump_count; i++) {
         u32 inst_index = ctx->pending_jumps[i].instruction_index;
-        node_id target = ctx->pending_jumps[i].target_node;
-        u32 target_address = get_node_address(ctx, target);
+        blueprint_node* target = &ctx->graph->nodes[ctx->pending_jumps[i].target_node];
         
-        if (target_address == 0xFFFFFFFF) {
+        if (target->bytecode_address == BP_INVALID_ADDRESS) {
             ctx->has_error = true;
             snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), 
-                    "Cannot resolve jump target node %u", target);
+                    "Cannot resolve jump target node %u", target->id);
             return;
         }
         
-        ctx->bytecode[inst_index].operand1 = target_address;
+        ctx->bytecode[inst_index].operand1 = target->bytecode_address;
     }
 }
 
+// ============================================================================
+// PIN ADJACENCY
+// ============================================================================
+
+// Pure nodes have no execution pins, they run wherever their outputs are read
+static b32 node_is_pure(blueprint_node* node) {
+    for (u32 i = 0; i < node->input_pin_count; i++) {
+        if (node->input_pins[i].type == BP_TYPE_EXEC) return false;
+    }
+    for (u32 i = 0; i < node->output_pin_count; i++) {
+        if (node->output_pins[i].type == BP_TYPE_EXEC) return false;
+    }
+    return true;
+}
+
+static u32 get_node_index(compiler_context* ctx, blueprint_node* node) {
+    return (u32)(node - ctx->graph->nodes);
+}
+
+static blueprint_pin* get_slot_pin(blueprint_node* node, u32 slot) {
+    return slot < node->input_pin_count ? &node->input_pins[slot] :
+        &node->output_pins[slot - node->input_pin_count];
+}
+
+static u32 find_pin_slot(blueprint_node* node, pin_id id) {
+    for (u32 i = 0; i < node->input_pin_count; i++) {
+        if (node->input_pins[i].id == id) return i;
+    }
+    for (u32 i = 0; i < node->output_pin_count; i++) {
+        if (node->output_pins[i].id == id) return node->input_pin_count + i;
+    }
+    return BP_INVALID_ADDRESS;
+}
+
+// Connections on one pin slot of a node
+static compiler_edge* get_slot_edges(compiler_context* ctx, u32 node_index, u32 slot, u32* count) {
+    u32 s = ctx->pin_base[node_index] + slot;
+    *count = ctx->edge_offsets[s + 1] - ctx->edge_offsets[s];
+    return &ctx->edges[ctx->edge_offsets[s]];
+}
+
+// Bucket both ends of every connection by pin slot, in connection order
+static void build_adjacency(compiler_context* ctx) {
+    blueprint_graph* graph = ctx->graph;
+    
+    ctx->pin_base = (u32*)calloc(graph->node_count + 1, sizeof(u32));
+    ctx->node_info = (u8*)calloc(graph->node_count + 1, sizeof(u8));
+    if (!ctx->pin_base || !ctx->node_info) {
+        ctx->has_error = true;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Failed to allocate adjacency arrays");
+        return;
+    }
+    
+    for (u32 i = 0; i < graph->node_count; i++) {
+        blueprint_node* node = &graph->nodes[i];
+        ctx->pin_base[i + 1] = ctx->pin_base[i] + node->input_pin_count + node->output_pin_count;
+        ctx->node_info[i] = node_is_pure(node) ? COMPILER_NODE_PURE : 0;
+    }
+    
+    // Resolved ends per connection: from node, from slot, to node, to slot
+    u32 slot_count = ctx->pin_base[graph->node_count];
+    u32* ends = (u32*)malloc((graph->connection_count + 1) * 4 * sizeof(u32));
+    ctx->edge_offsets = (u32*)calloc(slot_count + 2, sizeof(u32));
+    ctx->edges = (compiler_edge*)malloc((graph->connection_count * 2 + 1) * sizeof(compiler_edge));
+    
+    if (!ends || !ctx->edge_offsets || !ctx->edges) {
+        ctx->has_error = true;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Failed to allocate adjacency arrays");
+        free(ends);
+        return;
+    }
+    
+    for (u32 i = 0; i < graph->connection_count; i++) {
+        blueprint_connection* conn = &graph->connections[i];
+        blueprint_node* from_node = blueprint_get_node(graph, conn->from_node);
+        blueprint_node* to_node = blueprint_get_node(graph, conn->to_node);
+        u32* end = &ends[i * 4];
+        
+        end[0] = BP_INVALID_ADDRESS;
+        if (!from_node || !to_node) continue;
+        
+        u32 from_slot = find_pin_slot(from_node, conn->from_pin);
+        u32 to_slot = find_pin_slot(to_node, conn->to_pin);
+        if (from_slot == BP_INVALID_ADDRESS || to_slot == BP_INVALID_ADDRESS) continue;
+        
+        end[0] = get_node_index(ctx, from_node);
+        end[1] = from_slot;
+        end[2] = get_node_index(ctx, to_node);
+        end[3] = to_slot;
+        
+        ctx->node_info[end[0]] |= COMPILER_NODE_READ;
+        if (get_slot_pin(to_node, to_slot)->type == BP_TYPE_EXEC) {
+            ctx->node_info[end[2]] |= COMPILER_NODE_EXEC_INPUT;
+        }
+        
+        // Counted two ahead so the fill below leaves the start offsets
+        ctx->edge_offsets[ctx->pin_base[end[0]] + end[1] + 2]++;
+        ctx->edge_offsets[ctx->pin_base[end[2]] + end[3] + 2]++;
+    }
+    
+    for (u32 s = 2; s < slot_count + 2; s++) {
+        ctx->edge_offsets[s] += ctx->edge_offsets[s - 1];
+    }
+    
+    for (u32 i = 0; i < graph->connection_count; i++) {
+        u32* end = &ends[i * 4];
+        if (end[0] == BP_INVALID_ADDRESS) continue;
+        
+        u32 from = ctx->pin_base[end[0]] + end[1];
+        u32 to = ctx->pin_base[end[2]] + end[3];
+        ctx->edges[ctx->edge_offsets[from + 1]++] = (compiler_edge){end[2], end[3]};
+        ctx->edges[ctx->edge_offsets[to + 1]++] = (compiler_edge){end[0], end[1]};
+    }
+    
+    free(ends);
+}
+
 // ============================================================================
 // NODE COMPILATION
 // ============================================================================
 
-// Get execution pin from node
-static blueprint_pin* get_exec_output_pin(blueprint_node* node) {
+// Slot of the first execution output pin
+static u32 get_exec_output_slot(blueprint_node* node) {
     for (u32 i = 0; i < node->output_pin_count; i++) {
         if (node->output_pins[i].type == BP_TYPE_EXEC) {
-            return &node->output_pins[i];
+            return node->input_pin_count + i;
         }
     }
-    return NULL;
+    return BP_INVALID_ADDRESS;
+}
+
+static b32 is_pure_node(compiler_context* ctx, u32 node_index) {
+    return (ctx->node_info[node_index] & COMPILER_NODE_PURE) != 0;
 }
 
-// Get all execution pins that connect to this node
-static u32 get_exec_input_connections(compiler_context* ctx, node_id node_id, blueprint_connection** out_connections, u32 max_connections) {
-    u32 count = 0;
+// Node an execution output pin flows into. Only an execution input of an
+// impure node gets a block; wires into data pins or pure nodes are no successor.
+static u32 get_exec_target(compiler_context* ctx, blueprint_node* node, u32 slot) {
+    if (slot == BP_INVALID_ADDRESS) return BP_INVALID_ADDRESS;
     
-    for (u32 i = 0; i < ctx->graph->connection_count && count < max_connections; i++) {
-        blueprint_connection* conn = &ctx->graph->connections[i];
+    u32 count;
+    compiler_edge* edges = get_slot_edges(ctx, get_node_index(ctx, node), slot, &count);
+    for (u32 i = 0; i < count; i++) {
+        blueprint_node* target = &ctx->graph->nodes[edges[i].node];
+        if (is_pure_node(ctx, edges[i].node) || edges[i].slot >= target->input_pin_count) continue;
+        if (get_slot_pin(target, edges[i].slot)->type == BP_TYPE_EXEC) {
+            return edges[i].node;
+        }
+    }
+    return BP_INVALID_ADDRESS;
+}
+
+// Whether any execution flows into this node
+static b32 has_exec_input(compiler_context* ctx, u32 node_index) {
+    return (ctx->node_info[node_index] & COMPILER_NODE_EXEC_INPUT) != 0;
+}
+
+// Changed since the last compile, or new
+static b32 node_is_dirty(blueprint_graph* graph, u32 node_index) {
+    return node_index >= graph->compiled_node_count || (graph->nodes[node_index].flags & NODE_FLAG_DIRTY);
+}
+
+// Register of the index-th data input, skipping execution pins
+static u32 get_input_register(blueprint_node* node, u32 index) {
+    for (u32 i = 0; i < node->input_pin_count; i++) {
+        if (node->input_pins[i].type == BP_TYPE_EXEC) continue;
+        if (index-- == 0) return node->input_pins[i].register_index;
+    }
+    return BP_INVALID_REGISTER;
+}
+
+// Register of the index-th data output, skipping execution pins
+static u32 get_output_register(blueprint_node* node, u32 index) {
+    for (u32 i = 0; i < node->output_pin_count; i++) {
+        if (node->output_pins[i].type == BP_TYPE_EXEC) continue;
+        if (index-- == 0) return node->output_pins[i].register_index;
+    }
+    return BP_INVALID_REGISTER;
+}
+
+// Outputs own a temporary
+static void assign_output_registers(compiler_context* ctx, blueprint_node* node) {
+    for (u32 p = 0; p < node->output_pin_count; p++) {
+        blueprint_pin* pin = &node->output_pins[p];
+        blueprint_value zero = {0};
+        pin->register_index = (pin->type == BP_TYPE_EXEC) ? BP_INVALID_REGISTER :
+            alloc_register(ctx, pin->type, zero);
+    }
+}
+
+// Connected inputs share the source output's register, unconnected inputs
+// get a constant or keep the one they have
+static void assign_input_registers(compiler_context* ctx, u32 node_index, b32 new_constants) {
+    blueprint_node* node = &ctx->graph->nodes[node_index];
+    
+    for (u32 p = 0; p < node->input_pin_count && !ctx->has_error; p++) {
+        blueprint_pin* pin = &node->input_pins[p];
+        if (pin->type == BP_TYPE_EXEC) {
+            pin->register_index = BP_INVALID_REGISTER;
+            continue;
+        }
         
-        if (conn->to_node == node_id) {
-            // Check if this is an execution connection
-            blueprint_node* from_node = blueprint_get_node(ctx->graph, conn->from_node);
-            if (from_node) {
-                blueprint_pin* from_pin = blueprint_get_pin(from_node, conn->from_pin);
-                if (from_pin && from_pin->type == BP_TYPE_EXEC) {
-                    out_connections[count++] = conn;
-                }
-            }
+        u32 count;
+        compiler_edge* edges = get_slot_edges(ctx, node_index, p, &count);
+        if (count) {
+            blueprint_node* source = &ctx->graph->nodes[edges[0].node];
+            pin->register_index = get_slot_pin(source, edges[0].slot)->register_index;
+        } else if (new_constants) {
+            pin->register_index = add_constant(ctx, pin);
         }
     }
+}
+
+// Assign a register to every data pin
+static void assign_registers(compiler_context* ctx) {
+    blueprint_graph* graph = ctx->graph;
     
-    return count;
+    for (u32 i = 0; i < graph->node_count; i++) {
+        // Pure nodes are inlined and keep no address of their own
+        graph->nodes[i].bytecode_address = BP_INVALID_ADDRESS;
+        assign_output_registers(ctx, &graph->nodes[i]);
+    }
+    
+    for (u32 i = 0; i < graph->node_count && !ctx->has_error; i++) {
+        assign_input_registers(ctx, i, true);
+    }
 }
 
-// Compile a single node to bytecode
-static void compile_node(compiler_context* ctx, blueprint_node* node) {
-    if (ctx->has_error) return;
+// Dirty nodes get fresh registers, so everything reading their outputs is
+// rebound too. Pure readers are inlined into their own readers' blocks, so
+// the walk continues through them up to the first execution node
+static void mark_affected_nodes(compiler_context* ctx) {
+    blueprint_graph* graph = ctx->graph;
+    u32* stack = (u32*)malloc((graph->node_count + 1) * sizeof(u32));
+    u32 top = 0;
     
-    // Mark current bytecode position as node address
-    set_node_address(ctx, node->id, ctx->bytecode_count);
+    if (!stack) {
+        ctx->has_error = true;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Failed to allocate dirty tracking");
+        return;
+    }
     
-    switch (node->type) {
-        case NODE_TYPE_BEGIN_PLAY: {
-            // BeginPlay is entry point - no special bytecode needed
-            // The VM will start execution here
-            break;
+    for (u32 i = 0; i < graph->node_count; i++) {
+        if (node_is_dirty(graph, i)) {
+            ctx->node_affected[i] = true;
+            stack[top++] = i;
         }
+    }
+    
+    while (top > 0) {
+        u32 index = stack[--top];
+        blueprint_node* node = &graph->nodes[index];
         
-        case NODE_TYPE_TICK: {
-            // Tick node - called every frame
-            // For now, just continue execution
-            break;
+        for (u32 p = 0; p < node->output_pin_count; p++) {
+            if (node->output_pins[p].type == BP_TYPE_EXEC) continue;
+            
+            u32 count;
+            compiler_edge* edges = get_slot_edges(ctx, index, node->input_pin_count + p, &count);
+            for (u32 e = 0; e < count; e++) {
+                u32 reader = edges[e].node;
+                if (ctx->node_affected[reader]) continue;
+                
+                ctx->node_affected[reader] = true;
+                if (is_pure_node(ctx, reader)) {
+                    stack[top++] = reader;
+                }
+            }
         }
-        
-        case NODE_TYPE_ADD: {
-            // Math operation: pop two values, add, push result
-            // Assumes input pins are already loaded to stack
-            emit_instruction(ctx, BP_OP_ADD, 0, 0, 0);
-            break;
+    }
+    
+    free(stack);
+}
+
+// Rebind registers of the affected nodes, appended behind the current file
+static void reassign_registers(compiler_context* ctx) {
+    blueprint_graph* graph = ctx->graph;
+    
+    for (u32 i = 0; i < graph->node_count && !ctx->has_error; i++) {
+        blueprint_node* node = &graph->nodes[i];
+        if (i >= graph->compiled_node_count) {
+            node->bytecode_address = BP_INVALID_ADDRESS;
         }
-        
-        case NODE_TYPE_MULTIPLY: {
-            emit_instruction(ctx, BP_OP_MUL, 0, 0, 0);
+        if (node_is_dirty(graph, i)) {
+            assign_output_registers(ctx, node);
+        }
+    }
+    
+    for (u32 i = 0; i < graph->node_count && !ctx->has_error; i++) {
+        if (ctx->node_affected[i]) {
+            assign_input_registers(ctx, i, node_is_dirty(graph, i));
+        }
+    }
+}
+
+// Find variable index by node name
+static u32 find_variable_index(compiler_context* ctx, blueprint_node* node) {
+    for (u32 i = 0; i < ctx->graph->variable_count; i++) {
+        if (strcmp(ctx->graph->variables[i].name, node->name) == 0) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+// Emit the node's own operation on its pin registers
+static void compile_node_operation(compiler_context* ctx, blueprint_node* node) {
+    switch (node->type) {
+        case NODE_TYPE_BEGIN_PLAY:
+        case NODE_TYPE_TICK:
+        case NODE_TYPE_BRANCH: {
+            // Entry points need no bytecode, branches are pure control flow
             break;
         }
         
-        case NODE_TYPE_SUBTRACT: {
-            emit_instruction(ctx, BP_OP_SUB, 0, 0, 0);
+        case NODE_TYPE_ADD:
+        case NODE_TYPE_SUBTRACT:
+        case NODE_TYPE_MULTIPLY:
+        case NODE_TYPE_DIVIDE:
+        case NODE_TYPE_EQUALS:
+        case NODE_TYPE_NOT_EQUALS:
+        case NODE_TYPE_LESS:
+        case NODE_TYPE_LESS_EQUAL:
+        case NODE_TYPE_GREATER:
+        case NODE_TYPE_GREATER_EQUAL:
+        case NODE_TYPE_AND:
+        case NODE_TYPE_OR: {
+            bp_opcode opcode = BP_OP_NOP;
+            switch (node->type) {
+                case NODE_TYPE_ADD: opcode = BP_OP_ADD; break;
+                case NODE_TYPE_SUBTRACT: opcode = BP_OP_SUB; break;
+                case NODE_TYPE_MULTIPLY: opcode = BP_OP_MUL; break;
+                case NODE_TYPE_DIVIDE: opcode = BP_OP_DIV; break;
+                case NODE_TYPE_EQUALS: opcode = BP_OP_EQUALS; break;
+                case NODE_TYPE_NOT_EQUALS: opcode = BP_OP_NOT_EQUALS; break;
+                case NODE_TYPE_LESS: opcode = BP_OP_LESS; break;
+                case NODE_TYPE_LESS_EQUAL: opcode = BP_OP_LESS_EQUAL; break;
+                case NODE_TYPE_GREATER: opcode = BP_OP_GREATER; break;
+                case NODE_TYPE_GREATER_EQUAL: opcode = BP_OP_GREATER_EQUAL; break;
+                case NODE_TYPE_AND: opcode = BP_OP_AND; break;
+                case NODE_TYPE_OR: opcode = BP_OP_OR; break;
+                default: break;
+            }
+            
+            u32 dst = get_output_register(node, 0);
+            u32 a = get_input_register(node, 0);
+            u32 b = get_input_register(node, 1);
+            if (dst == BP_INVALID_REGISTER || a == BP_INVALID_REGISTER || b == BP_INVALID_REGISTER) {
+                emit_instruction(ctx, BP_OP_NOP, 0, 0, 0);
+                break;
+            }
+            emit_instruction(ctx, opcode, dst, a, b);
             break;
         }
         
-        case NODE_TYPE_DIVIDE: {
-            emit_instruction(ctx, BP_OP_DIV, 0, 0, 0);
+        case NODE_TYPE_NOT:
+        case NODE_TYPE_CAST: {
+            u32 dst = get_output_register(node, 0);
+            u32 src = get_input_register(node, 0);
+            if (dst == BP_INVALID_REGISTER || src == BP_INVALID_REGISTER) {
+                emit_instruction(ctx, BP_OP_NOP, 0, 0, 0);
+                break;
+            }
+            // Cast target type is the output register type
+            emit_instruction(ctx, node->type == NODE_TYPE_NOT ? BP_OP_NOT : BP_OP_CAST, dst, src, 0);
             break;
         }
         
-        case NODE_TYPE_BRANCH: {
-            // Conditional branch - pop condition, jump based on result
-            // Operand1 will be patched with target address
-            u32 branch_inst = ctx->bytecode_count;
-            emit_instruction(ctx, BP_OP_JUMP_IF_FALSE, 0, 0, 0);
-            
-            // Find the "False" execution output and add pending jump
-            // Look for connections from the "False" output pin
-            for (u32 i = 0; i < ctx->graph->connection_count; i++) {
-                blueprint_connection* conn = &ctx->graph->connections[i];
-                
-                // Check if this is the False branch output (usually pin index 1)
-                if (conn->from_node == node->id && conn->from_pin == 1 && 
-                    conn->data_type == BP_TYPE_EXEC) {
-                    // Add pending jump for false branch
-                    add_pending_jump(ctx, branch_inst, conn->to_node);
-                    break;
-                }
-            }
-            
-            // Find the "True" execution output for fall-through
-            for (u32 i = 0; i < ctx->graph->connection_count; i++) {
-                blueprint_connection* conn = &ctx->graph->connections[i];
-                
-                // Check if this is the True branch output (usually pin index 0)
-                if (conn->from_node == node->id && conn->from_pin == 0 && 
-                    conn->data_type == BP_TYPE_EXEC) {
-                    // Continue to true branch node
-                    compile_node(ctx, conn->to_node);
-                    break;
-                }
+        case NODE_TYPE_SIN:
+        case NODE_TYPE_COS: {
+            u32 dst = get_output_register(node, 0);
+            u32 src = get_input_register(node, 0);
+            if (dst == BP_INVALID_REGISTER || src == BP_INVALID_REGISTER) {
+                emit_instruction(ctx, BP_OP_NOP, 0, 0, 0);
+                break;
             }
-            
+            emit_instruction(ctx, BP_OP_CALL_NATIVE, node->type == NODE_TYPE_SIN ? 1 : 2, dst, src);
             break;
         }
         
         case NODE_TYPE_PRINT: {
-            // Debug print - for now emit a breakpoint
-            emit_instruction(ctx, BP_OP_BREAK, node->id, 0, 0);
+            u32 src = get_input_register(node, 0);
+            if (src != BP_INVALID_REGISTER) {
+                emit_instruction(ctx, BP_OP_CALL_NATIVE, 0, 0, src);
+            }
             break;
         }
         
         case NODE_TYPE_GET_VARIABLE: {
-            // Load variable value to stack
-            // Find variable index by node name
-            u32 var_index = 0;
-            for (u32 i = 0; i < ctx->graph->variable_count; i++) {
-                if (strcmp(ctx->graph->variables[i].name, node->name) == 0) {
-                    var_index = i;
-                    break;
-                }
+            u32 dst = get_output_register(node, 0);
+            if (dst != BP_INVALID_REGISTER) {
+                emit_instruction(ctx, BP_OP_LOAD_VAR, dst, find_variable_index(ctx, node), 0);
             }
-            emit_instruction(ctx, BP_OP_LOAD_VAR, var_index, 0, 0);
             break;
         }
         
         case NODE_TYPE_SET_VARIABLE: {
-            // Store stack top to variable
-            // Find variable index by node name
-            u32 var_index = 0;
-            for (u32 i = 0; i < ctx->graph->variable_count; i++) {
-                if (strcmp(ctx->graph->variables[i].name, node->name) == 0) {
-                    var_index = i;
-                    break;
-                }
+            u32 src = get_input_register(node, 0);
+            if (src != BP_INVALID_REGISTER) {
+                emit_instruction(ctx, BP_OP_STORE_VAR, find_variable_index(ctx, node), src, 0);
             }
-            emit_instruction(ctx, BP_OP_STORE_VAR, var_index, 0, 0);
-            break;
-        }
-        
-        case NODE_TYPE_CAST: {
-            // Type casting - determine target type from output pin
-            blueprint_type target_type = BP_TYPE_FLOAT;
-            
-            // Get the output pin type
-            if (node->output_pin_count > 0) {
-                target_type = node->output_pins[0].type;
-            }
-            
-            emit_instruction(ctx, BP_OP_CAST, (u32)target_type, 0, 0);
             break;
         }
         
@@ -313,41 +568,129 @@ static void compile_node(compiler_context* ctx, blueprint_node* node) {
             break;
         }
     }
+}
+
+static void compile_pure_node(compiler_context* ctx, blueprint_node* node);
+
+// Emit the pure nodes feeding this node's inputs, sources first
+static void compile_pure_inputs(compiler_context* ctx, blueprint_node* node) {
+    u32 index = get_node_index(ctx, node);
     
-    // Load input pin values to stack before node execution
-    // This happens in reverse order so first pin ends up on top
-    for (i32 i = (i32)node->input_pin_count - 1; i >= 0; i--) {
-        blueprint_pin* pin = &node->input_pins[i];
+    for (u32 p = 0; p < node->input_pin_count && !ctx->has_error; p++) {
+        if (node->input_pins[p].type == BP_TYPE_EXEC) continue;
         
-        if (pin->type == BP_TYPE_EXEC) continue; // Skip execution pins
-        
-        if (pin->has_connection) {
-            // Value will be provided by connected output
-            // For now, just load the current value
-            u32 const_index = add_constant(ctx, pin->current_value);
-            emit_instruction(ctx, BP_OP_LOAD_CONST, const_index, 0, 0);
-        } else {
-            // Use default value
-            u32 const_index = add_constant(ctx, pin->default_value);
-            emit_instruction(ctx, BP_OP_LOAD_CONST, const_index, 0, 0);
+        u32 count;
+        compiler_edge* edges = get_slot_edges(ctx, index, p, &count);
+        for (u32 e = 0; e < count; e++) {
+            if (is_pure_node(ctx, edges[e].node)) {
+                compile_pure_node(ctx, &ctx->graph->nodes[edges[e].node]);
+            }
         }
     }
+}
+
+// Pure nodes are emitted at most once per block, after their own inputs
+static void compile_pure_node(compiler_context* ctx, blueprint_node* node) {
+    u32 index = get_node_index(ctx, node);
     
-    // Follow execution flow to next nodes
-    blueprint_pin* exec_pin = get_exec_output_pin(node);
-    if (exec_pin && exec_pin->has_connection) {
-        // Find connected node and add jump
-        for (u32 i = 0; i < ctx->graph->connection_count; i++) {
-            blueprint_connection* conn = &ctx->graph->connections[i];
-            if (conn->from_node == node->id && conn->from_pin == exec_pin->id) {
-                // Add unconditional jump to next node
-                u32 jump_inst = ctx->bytecode_count;
-                emit_instruction(ctx, BP_OP_JUMP, 0, 0, 0);
-                add_pending_jump(ctx, jump_inst, conn->to_node);
+    if (ctx->emit_stamp[index] == ctx->block_id) {
+        return; // Already computed in this block
+    }
+    
+    if (ctx->node_in_progress[index]) {
+        ctx->has_error = true;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), 
+                "Circular data dependency detected involving node %u", node->id);
+        return;
+    }
+    
+    ctx->node_in_progress[index] = true;
+    compile_pure_inputs(ctx, node);
+    ctx->node_in_progress[index] = false;
+    
+    ctx->emit_stamp[index] = ctx->block_id;
+    compile_node_operation(ctx, node);
+}
+
+// Jump to the next node in execution flow, or return to the entry
+// dispatcher at the end of the chain
+static void compile_exec_flow(compiler_context* ctx, u32 target) {
+    if (target != BP_INVALID_ADDRESS) {
+        u32 jump_inst = ctx->bytecode_count;
+        emit_instruction(ctx, BP_OP_JUMP, 0, 0, 0);
+        add_pending_jump(ctx, jump_inst, target);
+    } else {
+        emit_instruction(ctx, BP_OP_RETURN, 0, 0, 0);
+    }
+}
+
+// Entry points are execution nodes nothing flows into
+static b32 node_is_entry(compiler_context* ctx, u32 node_index) {
+    return !is_pure_node(ctx, node_index) && !has_exec_input(ctx, node_index);
+}
+
+// Pure nodes whose outputs nobody reads
+static b32 node_is_sink(compiler_context* ctx, u32 node_index) {
+    return (ctx->node_info[node_index] & (COMPILER_NODE_PURE | COMPILER_NODE_READ)) == COMPILER_NODE_PURE;
+}
+
+// Compile an execution node to a block: its pure inputs, its operation,
+// then the jump to the next node in execution flow
+static void compile_node(compiler_context* ctx, blueprint_node* node) {
+    if (ctx->has_error) return;
+    
+    // Mark current bytecode position as node address
+    node->bytecode_address = ctx->bytecode_count;
+    
+    ctx->block_id++;
+    compile_pure_inputs(ctx, node);
+    compile_node_operation(ctx, node);
+    
+    if (node->type == NODE_TYPE_BRANCH) {
+        // Outputs are True then False; the condition is the bool input
+        u32 exec_slots[2] = {BP_INVALID_ADDRESS, BP_INVALID_ADDRESS};
+        u32 exec_slot_count = 0;
+        for (u32 i = 0; i < node->output_pin_count && exec_slot_count < 2; i++) {
+            if (node->output_pins[i].type == BP_TYPE_EXEC) {
+                exec_slots[exec_slot_count++] = node->input_pin_count + i;
+            }
+        }
+        
+        u32 condition = BP_INVALID_REGISTER;
+        for (u32 i = 0; i < node->input_pin_count; i++) {
+            if (node->input_pins[i].type == BP_TYPE_BOOL) {
+                condition = node->input_pins[i].register_index;
                 break;
             }
         }
+        
+        // Without a terminator the VM would run off the end of the block
+        if (condition == BP_INVALID_REGISTER) {
+            ctx->has_error = true;
+            snprintf(ctx->error_buffer, sizeof(ctx->error_buffer),
+                    "Branch node %u has no boolean condition input", node->id);
+            return;
+        }
+        
+        u32 true_target = get_exec_target(ctx, node, exec_slots[0]);
+        u32 false_target = get_exec_target(ctx, node, exec_slots[1]);
+        
+        u32 branch_inst = ctx->bytecode_count;
+        emit_instruction(ctx, BP_OP_JUMP_IF_FALSE, 0, condition, 0);
+        
+        compile_exec_flow(ctx, true_target);
+        
+        if (false_target != BP_INVALID_ADDRESS) {
+            add_pending_jump(ctx, branch_inst, false_target);
+        } else if (!ctx->has_error) {
+            ctx->bytecode[branch_inst].operand1 = ctx->bytecode_count;
+            compile_exec_flow(ctx, BP_INVALID_ADDRESS);
+        }
+        return;
     }
+    
+    // Follow execution flow to next nodes
+    compile_exec_flow(ctx, get_exec_target(ctx, node, get_exec_output_slot(node)));
 }
 
 // ============================================================================
@@ -355,33 +698,16 @@ static void compile_node(compiler_context* ctx, blueprint_node* node) {
 // ============================================================================
 
 // Depth-first search for topological sorting
-static void topological_sort_dfs(compiler_context* ctx, node_id node_id) {
+static void topological_sort_dfs(compiler_context* ctx, u32 node_index) {
     if (ctx->has_error) return;
     
-    u32 node_index = 0;
-    blueprint_node* node = NULL;
-    
-    // Find node index in graph arrays
-    for (u32 i = 0; i < ctx->graph->node_count; i++) {
-        if (ctx->graph->node_ids[i] == node_id) {
-            node_index = i;
-            node = &ctx->graph->nodes[i];
-            break;
-        }
-    }
-    
-    if (!node) {
-        ctx->has_error = true;
-        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), 
-                "Node %u not found during topological sort", node_id);
-        return;
-    }
+    blueprint_node* node = &ctx->graph->nodes[node_index];
     
     if (ctx->node_in_progress[node_index]) {
         // Cycle detected
         ctx->has_error = true;
         snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), 
-                "Circular dependency detected involving node %u", node_id);
+                "Circular dependency detected involving node %u", node->id);
         return;
     }
     
@@ -391,13 +717,14 @@ static void topological_sort_dfs(compiler_context* ctx, node_id node_id) {
     
     ctx->node_in_progress[node_index] = true;
     
-    // Visit all nodes that this node depends on (via execution flow)
-    for (u32 i = 0; i < ctx->graph->connection_count; i++) {
-        blueprint_connection* conn = &ctx->graph->connections[i];
+    // Nodes that pass execution to this one come first
+    for (u32 p = 0; p < node->input_pin_count; p++) {
+        if (node->input_pins[p].type != BP_TYPE_EXEC) continue;
         
-        // If this node receives execution from another node, process that first
-        if (conn->to_node == node_id && conn->data_type == BP_TYPE_EXEC) {
-            topological_sort_dfs(ctx, conn->from_node);
+        u32 count;
+        compiler_edge* edges = get_slot_edges(ctx, node_index, p, &count);
+        for (u32 e = 0; e < count; e++) {
+            topological_sort_dfs(ctx, edges[e].node);
         }
     }
     
@@ -406,49 +733,44 @@ static void topological_sort_dfs(compiler_context* ctx, node_id node_id) {
     
     // Add to execution order
     if (ctx->graph->execution_order_count < ctx->graph->node_capacity) {
-        ctx->graph->execution_order[ctx->graph->execution_order_count++] = node_id;
+        ctx->graph->execution_order[ctx->graph->execution_order_count++] = node->id;
+        ctx->order[ctx->order_count++] = node_index;
     }
 }
 
 // Build execution order using topological sorting
 static void build_execution_order(compiler_context* ctx) {
     // Initialize tracking arrays
-    ctx->node_visited = (b32*)calloc(ctx->graph->node_count, sizeof(b32));
-    ctx->node_in_progress = (b32*)calloc(ctx->graph->node_count, sizeof(b32));
+    ctx->node_visited = (b32*)calloc(ctx->graph->node_count + 1, sizeof(b32));
+    ctx->node_in_progress = (b32*)calloc(ctx->graph->node_count + 1, sizeof(b32));
+    
+    ctx->order = (u32*)malloc((ctx->graph->node_count + 1) * sizeof(u32));
     
-    if (!ctx->node_visited || !ctx->node_in_progress) {
+    if (!ctx->node_visited || !ctx->node_in_progress || !ctx->order) {
         ctx->has_error = true;
         snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Failed to allocate sorting arrays");
+        free(ctx->node_visited);
+        free(ctx->node_in_progress);
+        ctx->node_visited = NULL;
+        ctx->node_in_progress = NULL;
         return;
     }
     
     // Reset execution order
     ctx->graph->execution_order_count = 0;
+    ctx->order_count = 0;
     
-    // Find entry points (nodes with no incoming execution connections)
+    // Entry points first - nodes with no incoming execution connections
     for (u32 i = 0; i < ctx->graph->node_count; i++) {
-        node_id current_id = ctx->graph->node_ids[i];
-        
-        // Check if this node has incoming execution connections
-        b32 has_incoming_exec = false;
-        for (u32 j = 0; j < ctx->graph->connection_count; j++) {
-            blueprint_connection* conn = &ctx->graph->connections[j];
-            if (conn->to_node == current_id && conn->data_type == BP_TYPE_EXEC) {
-                has_incoming_exec = true;
-                break;
-            }
-        }
-        
-        // If no incoming execution, this is an entry point
-        if (!has_incoming_exec) {
-            topological_sort_dfs(ctx, current_id);
+        if (!has_exec_input(ctx, i)) {
+            topological_sort_dfs(ctx, i);
         }
     }
     
     // Process any remaining unvisited nodes (isolated components)
     for (u32 i = 0; i < ctx->graph->node_count; i++) {
         if (!ctx->node_visited[i]) {
-            topological_sort_dfs(ctx, ctx->graph->node_ids[i]);
+            topological_sort_dfs(ctx, i);
         }
     }
     
@@ -462,87 +784,291 @@ static void build_execution_order(compiler_context* ctx) {
 // MAIN COMPILATION FUNCTION
 // ============================================================================
 
-void blueprint_compile_graph(blueprint_context* bp_ctx, blueprint_graph* graph) {
-    if (!bp_ctx || !graph) return;
-    
-    blueprint_begin_profile();
+// Regenerated blocks are appended and the replaced ones left behind as
+// garbage. Once the program doubles past the last full compile, compact it
+// by compiling from scratch
+static b32 can_compile_incrementally(blueprint_graph* graph) {
+    if (!graph->bytecode || graph->bytecode_size == 0 || graph->needs_full_recompile) {
+        return false;
+    }
+    if (graph->node_count < graph->compiled_node_count) {
+        return false;
+    }
     
-    compiler_context ctx = {0};
-    ctx.bp_ctx = bp_ctx;
-    ctx.graph = graph;
+    u32 instruction_count = graph->bytecode_size / sizeof(bp_instruction);
+    return instruction_count <= graph->full_bytecode_count * 2 &&
+           graph->register_count <= graph->full_register_count * 2;
+}
+
+static void free_compiler_context(compiler_context* ctx) {
+    free(ctx->register_image);
+    free(ctx->register_types);
+    free(ctx->pin_base);
+    free(ctx->edge_offsets);
+    free(ctx->edges);
+    free(ctx->node_info);
+    free(ctx->order);
+    free(ctx->emit_stamp);
+    free(ctx->node_in_progress);
+    free(ctx->node_affected);
+    free(ctx->replaced_address);
+    free(ctx->pending_jumps);
+}
+
+// One compile of the graph. Incremental passes leave everything before the
+// current end of the bytecode untouched until they succeed
+static void compile_pass(compiler_context* ctx) {
+    blueprint_graph* graph = ctx->graph;
     
-    // Allocate bytecode buffer
-    ctx.bytecode_capacity = BLUEPRINT_MAX_BYTECODE / sizeof(bp_instruction);
-    ctx.bytecode = (bp_instruction*)blueprint_alloc(bp_ctx, 
-        sizeof(bp_instruction) * ctx.bytecode_capacity);
+    // Reuse the graph's bytecode buffer across recompiles
+    ctx->bytecode_capacity = BLUEPRINT_MAX_BYTECODE / sizeof(bp_instruction);
+    ctx->bytecode = (bp_instruction*)graph->bytecode;
+    if (!ctx->bytecode) {
+        ctx->bytecode = (bp_instruction*)blueprint_alloc(ctx->bp_ctx, 
+            sizeof(bp_instruction) * ctx->bytecode_capacity);
+        graph->bytecode = (u8*)ctx->bytecode;
+        graph->bytecode_size = 0;
+    }
     
-    if (!ctx.bytecode) {
-        blueprint_log_debug(bp_ctx, "Failed to allocate bytecode buffer for graph '%s'", graph->name);
+    if (!ctx->bytecode) {
+        ctx->has_error = true;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Failed to allocate bytecode buffer");
         return;
     }
     
-    // Allocate constant pool
-    ctx.constants = (blueprint_value*)blueprint_alloc(bp_ctx,
-        sizeof(blueprint_value) * BLUEPRINT_MAX_CONSTANTS);
+    // Size the register file - at most one register per pin, per changed
+    // pin when appending
+    u32 pin_count = 0;
+    for (u32 i = 0; i < graph->node_count; i++) {
+        blueprint_node* node = &graph->nodes[i];
+        if (!ctx->incremental || node_is_dirty(graph, i)) {
+            pin_count += node->input_pin_count + node->output_pin_count;
+        }
+    }
     
-    if (!ctx.constants) {
-        blueprint_log_debug(bp_ctx, "Failed to allocate constant pool for graph '%s'", graph->name);
+    u32 base_registers = ctx->incremental ? graph->register_count : 0;
+    if (base_registers + pin_count > BLUEPRINT_MAX_REGISTERS) {
+        if (ctx->incremental) {
+            ctx->has_error = true;
+            snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Register file full");
+            return;
+        }
+        pin_count = BLUEPRINT_MAX_REGISTERS;
+    }
+    ctx->register_capacity = base_registers + pin_count;
+    
+    ctx->register_image = (blueprint_value*)calloc(ctx->register_capacity + 1, sizeof(blueprint_value));
+    ctx->register_types = (u8*)calloc(ctx->register_capacity + 1, sizeof(u8));
+    ctx->emit_stamp = (u32*)calloc(graph->node_count + 1, sizeof(u32));
+    ctx->node_affected = (u8*)calloc(graph->node_count + 1, sizeof(u8));
+    ctx->replaced_address = (u32*)malloc((graph->node_count + 1) * sizeof(u32));
+    
+    // At most one jump per execution connection and one call per node
+    ctx->pending_jump_capacity = graph->connection_count + graph->node_count + 1;
+    ctx->pending_jumps = calloc(ctx->pending_jump_capacity, sizeof(*ctx->pending_jumps));
+    
+    if (!ctx->register_image || !ctx->register_types || !ctx->emit_stamp ||
+        !ctx->node_affected || !ctx->replaced_address || !ctx->pending_jumps) {
+        ctx->has_error = true;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Failed to allocate compiler tables");
         return;
     }
     
-    blueprint_log_debug(bp_ctx, "Compiling graph '%s' with %u nodes, %u connections", 
-                       graph->name, graph->node_count, graph->connection_count);
+    if (ctx->incremental) {
+        memcpy(ctx->register_image, graph->register_image, base_registers * sizeof(blueprint_value));
+        memcpy(ctx->register_types, graph->register_types, base_registers);
+        ctx->register_count = base_registers;
+    }
+    
+    build_adjacency(ctx);
+    if (ctx->has_error) return;
+    
+    if (ctx->incremental) {
+        mark_affected_nodes(ctx);
+        if (!ctx->has_error) reassign_registers(ctx);
+    } else {
+        assign_registers(ctx);
+    }
     
     // Build execution order using topological sorting
-    build_execution_order(&ctx);
-    if (ctx.has_error) {
-        blueprint_log_debug(bp_ctx, "Compilation failed: %s", ctx.error_buffer);
+    if (!ctx->has_error) {
+        build_execution_order(ctx);
+    }
+    if (ctx->has_error) return;
+    
+    blueprint_log_debug(ctx->bp_ctx, "Execution order built with %u nodes", graph->execution_order_count);
+    
+    ctx->node_in_progress = (b32*)calloc(graph->node_count + 1, sizeof(b32));
+    if (!ctx->node_in_progress) {
+        ctx->has_error = true;
+        snprintf(ctx->error_buffer, sizeof(ctx->error_buffer), "Failed to allocate emission arrays");
         return;
     }
     
-    blueprint_log_debug(bp_ctx, "Execution order built with %u nodes", graph->execution_order_count);
+    // Pure nodes whose outputs nobody reads run first, from a block of their
+    // own. It is kept across incremental passes unless a sink changed or a
+    // dirty pure node may have joined or left the set
+    b32 has_sinks = false;
+    b32 sinks_changed = !ctx->incremental;
+    for (u32 i = 0; i < graph->node_count; i++) {
+        if (node_is_sink(ctx, i)) {
+            has_sinks = true;
+            sinks_changed |= ctx->node_affected[i];
+        } else if (is_pure_node(ctx, i) && ctx->incremental && node_is_dirty(graph, i)) {
+            sinks_changed = true;
+        }
+    }
+    
+    // Entry dispatcher - the sinks, then each execution chain in turn. Every
+    // call ends with a return
+    u32 dispatcher = ctx->incremental ? graph->bytecode_size / sizeof(bp_instruction) : 0;
+    ctx->bytecode_count = dispatcher;
+    ctx->sink_block_address = has_sinks ? graph->sink_block_address : BP_INVALID_ADDRESS;
+    
+    u32 sink_call = ctx->bytecode_count;
+    if (has_sinks) {
+        emit_instruction(ctx, BP_OP_CALL, ctx->sink_block_address, 0, 0);
+    }
+    
+    for (u32 i = 0; i < ctx->order_count && !ctx->has_error; i++) {
+        if (node_is_entry(ctx, ctx->order[i])) {
+            u32 call_inst = ctx->bytecode_count;
+            emit_instruction(ctx, BP_OP_CALL, 0, 0, 0);
+            add_pending_jump(ctx, call_inst, ctx->order[i]);
+        }
+    }
+    emit_instruction(ctx, BP_OP_HALT, 0, 0, 0);
     
-    // Compile nodes in execution order
-    for (u32 i = 0; i < graph->execution_order_count; i++) {
-        node_id current_id = graph->execution_order[i];
-        blueprint_node* node = blueprint_get_node(graph, current_id);
+    if (has_sinks && sinks_changed && !ctx->has_error) {
+        ctx->sink_block_address = ctx->bytecode_count;
+        ctx->bytecode[sink_call].operand1 = ctx->sink_block_address;
         
-        if (node) {
-            compile_node(&ctx, node);
-            if (ctx.has_error) {
-                blueprint_log_debug(bp_ctx, "Compilation failed at node '%s': %s", 
-                                   node->name, ctx.error_buffer);
-                return;
+        for (u32 i = 0; i < graph->node_count && !ctx->has_error; i++) {
+            if (node_is_sink(ctx, i)) {
+                ctx->block_id++;
+                compile_pure_node(ctx, &graph->nodes[i]);
             }
         }
+        emit_instruction(ctx, BP_OP_RETURN, 0, 0, 0);
+    }
+    
+    // Compile execution nodes in execution order - when appending, only
+    // those whose code changed
+    for (u32 i = 0; i < ctx->order_count && !ctx->has_error; i++) {
+        u32 index = ctx->order[i];
+        if (is_pure_node(ctx, index)) continue;
+        if (ctx->incremental && !ctx->node_affected[index]) continue;
+        
+        blueprint_node* node = &graph->nodes[index];
+        ctx->replaced_address[index] = (ctx->incremental && index < graph->compiled_node_count) ?
+            node->bytecode_address : BP_INVALID_ADDRESS;
+        compile_node(ctx, node);
     }
     
     // Patch all pending jumps
-    patch_jumps(&ctx);
+    if (!ctx->has_error) {
+        patch_jumps(ctx);
+    }
+    if (ctx->has_error || !ctx->incremental) return;
+    
+    // Commit - execution starts at the new dispatcher and each replaced
+    // block forwards to its regenerated copy
+    ctx->bytecode[0] = (bp_instruction){BP_OP_JUMP, dispatcher, 0, 0};
+    for (u32 i = 0; i < graph->node_count; i++) {
+        if (!ctx->node_affected[i] || is_pure_node(ctx, i)) continue;
+        
+        u32 replaced = ctx->replaced_address[i];
+        if (replaced != BP_INVALID_ADDRESS && replaced < dispatcher) {
+            ctx->bytecode[replaced] = (bp_instruction){BP_OP_JUMP, graph->nodes[i].bytecode_address, 0, 0};
+        }
+    }
+}
+
+void blueprint_compile_graph(blueprint_context* bp_ctx, blueprint_graph* graph) {
+    if (!bp_ctx || !graph) return;
+    
+    blueprint_begin_profile();
+    
+    compiler_context ctx = {0};
+    ctx.bp_ctx = bp_ctx;
+    ctx.graph = graph;
+    ctx.incremental = can_compile_incrementally(graph);
+    
+    blueprint_log_debug(bp_ctx, "Compiling graph '%s' with %u nodes, %u connections%s",
+                       graph->name, graph->node_count, graph->connection_count,
+                       ctx.incremental ? " (incremental)" : "");
+    
+    compile_pass(&ctx);
+    
+    // A failed incremental pass has changed nothing the VM reads, retry
+    // from scratch
+    if (ctx.has_error && ctx.incremental) {
+        blueprint_log_debug(bp_ctx, "Incremental compilation failed: %s", ctx.error_buffer);
+        free_compiler_context(&ctx);
+        
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.bp_ctx = bp_ctx;
+        ctx.graph = graph;
+        compile_pass(&ctx);
+    }
+    
+    // Keep the register image in graph storage, reallocated only when it grows
+    if (!ctx.has_error && ctx.register_count > graph->register_capacity) {
+        // Headroom for incremental passes appending registers
+        u32 capacity = ctx.register_count + ctx.register_count / 2;
+        graph->register_image = (blueprint_value*)blueprint_alloc(bp_ctx, 
+            sizeof(blueprint_value) * capacity);
+        graph->register_types = (u8*)blueprint_alloc(bp_ctx, capacity);
+        graph->register_capacity = graph->register_image && graph->register_types ? capacity : 0;
+        
+        if (!graph->register_capacity) {
+            ctx.has_error = true;
+            snprintf(ctx.error_buffer, sizeof(ctx.error_buffer), "Failed to allocate register file");
+        }
+    }
+    
     if (ctx.has_error) {
-        blueprint_log_debug(bp_ctx, "Jump patching failed: %s", ctx.error_buffer);
+        blueprint_log_debug(bp_ctx, "Compilation failed: %s", ctx.error_buffer);
+        free_compiler_context(&ctx);
+        
+        // The buffer was partially overwritten, nothing runs until the
+        // graph compiles again
+        graph->bytecode_size = 0;
+        graph->register_count = 0;
+        graph->needs_full_recompile = true;
         return;
     }
     
-    // Add halt instruction at the end
-    emit_instruction(&ctx, BP_OP_HALT, 0, 0, 0);
+    memcpy(graph->register_image, ctx.register_image, ctx.register_count * sizeof(blueprint_value));
+    memcpy(graph->register_types, ctx.register_types, ctx.register_count);
+    graph->register_count = ctx.register_count;
     
     // Store compiled bytecode in graph
-    graph->bytecode = (u8*)ctx.bytecode;
     graph->bytecode_size = ctx.bytecode_count * sizeof(bp_instruction);
     
-    // Copy constants to VM
-    if (bp_ctx->vm.constants && ctx.constant_count > 0) {
-        memcpy(bp_ctx->vm.constants, ctx.constants, 
-               ctx.constant_count * sizeof(blueprint_value));
-        bp_ctx->vm.constant_count = ctx.constant_count;
+    if (!ctx.incremental) {
+        graph->full_bytecode_count = ctx.bytecode_count;
+        graph->full_register_count = ctx.register_count;
     }
+    graph->compiled_node_count = graph->node_count;
+    graph->sink_block_address = ctx.sink_block_address;
+    graph->needs_full_recompile = false;
+    
+    u32 blocks = 0;
+    for (u32 i = 0; i < graph->node_count; i++) {
+        if (ctx.node_affected[i]) blocks++;
+        graph->nodes[i].flags &= ~NODE_FLAG_DIRTY;
+    }
+    free_compiler_context(&ctx);
     
     f64 compile_time = blueprint_end_profile();
     
     blueprint_log_debug(bp_ctx, "Graph '%s' compiled successfully:", graph->name);
+    if (ctx.incremental) {
+        blueprint_log_debug(bp_ctx, "  - %u nodes regenerated", blocks);
+    }
     blueprint_log_debug(bp_ctx, "  - %u instructions generated", ctx.bytecode_count);
-    blueprint_log_debug(bp_ctx, "  - %u constants", ctx.constant_count);
+    blueprint_log_debug(bp_ctx, "  - %u registers (%u constants)", ctx.register_count, ctx.constant_count);
     blueprint_log_debug(bp_ctx, "  - %u bytes bytecode", graph->bytecode_size);
     blueprint_log_debug(bp_ctx, "  - Compilation time: %.2f ms", compile_time);
     
@@ -847,7 +847,7 @@ void blueprint_show_debug_panel(blueprint_context* ctx, b32* p_open) {
         gui_text(gui, "Running: %s", vm->is_running ? "Yes" : "No");
         gui_text(gui, "Paused: %s", vm->is_paused ? "Yes" : "No");
         gui_text(gui, "PC: %u", vm->program_counter);
-        gui_text(gui, "Stack: %u/%u", vm->value_stack_top, vm->value_stack_size);
+        gui_text(gui, "Registers: %u/%u", vm->register_count, vm->register_capacity);
         gui_text(gui, "Instructions: %llu", vm->instructions_executed);
         gui_text(gui, "Execution Time: %.2f ms", vm->execution_time);
         
@@ -866,7 +866,6 @@ void blueprint_show_debug_panel(blueprint_context* ctx, b32* p_open) {
         
         if (gui_button(gui, "Reset")) {
             vm->program_counter = 0;
-            vm->value_stack_top = 0;
             vm->call_stack_top = 0;
             vm->is_running = false;
             vm->is_paused = false;
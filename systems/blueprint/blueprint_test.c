@@ -297,6 +297,45 @@ static void test_compilation(blueprint_context* ctx, test_suite* suite) {
                passed ? NULL : "Failed to compile graph");
 }
 
+// An execution wire into a data pin of a pure node is no successor
+static void test_exec_into_data_pin(blueprint_context* ctx, test_suite* suite) {
+    f64 start_time = get_time_ms();
+    
+    blueprint_graph* graph = blueprint_create_graph(ctx, "ExecIntoDataGraph");
+    blueprint_init_standard_nodes(ctx);
+    
+    node_id begin_id = blueprint_create_node_from_template(graph, ctx, NODE_TYPE_BEGIN_PLAY, (v2){0, 0})->id;
+    node_id add_id = blueprint_create_node_from_template(graph, ctx, NODE_TYPE_ADD, (v2){200, 0})->id;
+    node_id print_id = blueprint_create_node_from_template(graph, ctx, NODE_TYPE_PRINT, (v2){400, 0})->id;
+    blueprint_node* begin_node = blueprint_get_node(graph, begin_id);
+    
+    // The data pin comes first, the real successor must still be found
+    connection_id stray = blueprint_create_connection(graph, begin_id, begin_node->output_pins[0].id,
+                                                     add_id, blueprint_get_node(graph, add_id)->input_pins[0].id);
+    blueprint_create_connection(graph, begin_id, begin_node->output_pins[0].id,
+                               print_id, blueprint_get_node(graph, print_id)->input_pins[0].id);
+    
+    blueprint_compile_graph(ctx, graph);
+    b32 passed = (graph->bytecode != NULL && graph->bytecode_size > 0 && !graph->needs_recompile);
+    
+    // Same instruction count as the graph without the stray wire
+    u64 with_wire = 0;
+    if (passed) {
+        blueprint_execute_graph(ctx, graph);
+        with_wire = ctx->vm.instructions_executed;
+        
+        blueprint_destroy_connection(graph, stray);
+        graph->needs_full_recompile = true;
+        blueprint_compile_graph(ctx, graph);
+        blueprint_execute_graph(ctx, graph);
+        passed = (with_wire > 0 && with_wire == ctx->vm.instructions_executed);
+    }
+    
+    f64 end_time = get_time_ms();
+    test_record(suite, "Exec Wire Into Data Pin", passed, end_time - start_time,
+               passed ? NULL : "Execution wire into a data pin broke compilation");
+}
+
 // ============================================================================
 // EXECUTION TESTS
 // ============================================================================
@@ -343,6 +382,218 @@ static void test_vm_execution(blueprint_context* ctx, test_suite* suite) {
                passed ? NULL : "Failed VM execution test");
 }
 
+// BeginPlay -> Branch(A < B), True sets local 0 to 1, False sets it to 2.
+// A pure Add(2, 4) -> Multiply(x, 10) chain sits beside the flow. The pool
+// never frees graphs, so the tests below share one and reset its constants.
+typedef struct branch_test_graph {
+    blueprint_graph* graph;
+    node_id begin, branch, less, set_true, set_false, add, mul;
+    connection_id false_wire;
+} branch_test_graph;
+
+static branch_test_graph branch_test;
+
+static node_id create_set_variable(blueprint_graph* graph) {
+    blueprint_node* node = blueprint_create_node(graph, NODE_TYPE_SET_VARIABLE, (v2){0, 0});
+    blueprint_add_input_pin(node, "Exec", BP_TYPE_EXEC, PIN_FLAG_NONE);
+    blueprint_add_input_pin(node, "Value", BP_TYPE_INT, PIN_FLAG_NONE);
+    blueprint_add_output_pin(node, "Exec", BP_TYPE_EXEC, PIN_FLAG_NONE);
+    return node->id;
+}
+
+static void create_branch_test_graph(blueprint_context* ctx, branch_test_graph* t) {
+    blueprint_init_standard_nodes(ctx);
+    blueprint_graph* graph = blueprint_create_graph(ctx, "BranchTestGraph");
+    t->graph = graph;
+    
+    t->begin = blueprint_create_node_from_template(graph, ctx, NODE_TYPE_BEGIN_PLAY, (v2){0, 0})->id;
+    t->branch = blueprint_create_node_from_template(graph, ctx, NODE_TYPE_BRANCH, (v2){200, 0})->id;
+    
+    blueprint_node* less = blueprint_create_node(graph, NODE_TYPE_LESS, (v2){0, 200});
+    blueprint_add_input_pin(less, "A", BP_TYPE_INT, PIN_FLAG_NONE);
+    blueprint_add_input_pin(less, "B", BP_TYPE_INT, PIN_FLAG_NONE);
+    blueprint_add_output_pin(less, "Result", BP_TYPE_BOOL, PIN_FLAG_NONE);
+    t->less = less->id;
+    
+    t->set_true = create_set_variable(graph);
+    t->set_false = create_set_variable(graph);
+    t->add = blueprint_create_node_from_template(graph, ctx, NODE_TYPE_ADD, (v2){0, 400})->id;
+    t->mul = blueprint_create_node_from_template(graph, ctx, NODE_TYPE_MULTIPLY, (v2){200, 400})->id;
+    
+    blueprint_node* begin = blueprint_get_node(graph, t->begin);
+    blueprint_node* branch = blueprint_get_node(graph, t->branch);
+    blueprint_create_connection(graph, t->begin, begin->output_pins[0].id, t->branch, branch->input_pins[0].id);
+    blueprint_create_connection(graph, t->less, blueprint_get_node(graph, t->less)->output_pins[0].id,
+                               t->branch, branch->input_pins[1].id);
+    blueprint_create_connection(graph, t->branch, branch->output_pins[0].id,
+                               t->set_true, blueprint_get_node(graph, t->set_true)->input_pins[0].id);
+    t->false_wire = blueprint_create_connection(graph, t->branch, branch->output_pins[1].id,
+                                               t->set_false, blueprint_get_node(graph, t->set_false)->input_pins[0].id);
+    blueprint_create_connection(graph, t->add, blueprint_get_node(graph, t->add)->output_pins[0].id,
+                               t->mul, blueprint_get_node(graph, t->mul)->input_pins[0].id);
+}
+
+// Shared graph with Branch comparing A < B, fully recompiled
+static branch_test_graph* get_branch_test_graph(blueprint_context* ctx, i32 a, i32 b) {
+    branch_test_graph* t = &branch_test;
+    if (!t->graph) create_branch_test_graph(ctx, t);
+    blueprint_graph* graph = t->graph;
+    
+    blueprint_get_node(graph, t->less)->input_pins[0].current_value.int_val = a;
+    blueprint_get_node(graph, t->less)->input_pins[1].current_value.int_val = b;
+    blueprint_get_node(graph, t->set_true)->input_pins[1].current_value.int_val = 1;
+    blueprint_get_node(graph, t->set_false)->input_pins[1].current_value.int_val = 2;
+    blueprint_get_node(graph, t->add)->input_pins[0].current_value.float_val = 2.0f;
+    blueprint_get_node(graph, t->add)->input_pins[1].current_value.float_val = 4.0f;
+    blueprint_get_node(graph, t->mul)->input_pins[1].current_value.float_val = 10.0f;
+    
+    graph->needs_full_recompile = true;
+    blueprint_compile_graph(ctx, graph);
+    return t;
+}
+
+// Value Branch left in local 0, 0 when neither path ran
+static i32 run_branch_test_graph(blueprint_context* ctx, branch_test_graph* t) {
+    ctx->vm.locals[0].int_val = 0;
+    blueprint_execute_graph(ctx, t->graph);
+    return ctx->vm.locals[0].int_val;
+}
+
+// What a run leaves in local 0 and the pure chain registers
+typedef struct branch_test_results {
+    i32 local;
+    f32 sum;
+    f32 product;
+} branch_test_results;
+
+static branch_test_results run_branch_test_results(blueprint_context* ctx, branch_test_graph* t) {
+    branch_test_results r;
+    r.local = run_branch_test_graph(ctx, t);
+    r.sum = ctx->vm.registers[blueprint_get_node(t->graph, t->add)->output_pins[0].register_index].float_val;
+    r.product = ctx->vm.registers[blueprint_get_node(t->graph, t->mul)->output_pins[0].register_index].float_val;
+    return r;
+}
+
+static void test_register_results(blueprint_context* ctx, test_suite* suite) {
+    f64 start_time = get_time_ms();
+    
+    branch_test_graph* t = get_branch_test_graph(ctx, 1, 3);
+    b32 passed = (t->graph->bytecode != NULL);
+    if (passed) {
+        branch_test_results r = run_branch_test_results(ctx, t);
+        passed = (r.sum == 6.0f && r.product == 60.0f);
+    }
+    
+    f64 end_time = get_time_ms();
+    test_record(suite, "Register Results", passed, end_time - start_time,
+               passed ? NULL : "Arithmetic result missing from the register file");
+}
+
+static void test_branch_paths(blueprint_context* ctx, test_suite* suite) {
+    f64 start_time = get_time_ms();
+    
+    branch_test_graph* t = get_branch_test_graph(ctx, 1, 3);
+    b32 passed = (t->graph->bytecode != NULL && run_branch_test_graph(ctx, t) == 1);
+    
+    t = get_branch_test_graph(ctx, 5, 3);
+    passed = passed && (t->graph->bytecode != NULL && run_branch_test_graph(ctx, t) == 2);
+    
+    f64 end_time = get_time_ms();
+    test_record(suite, "Branch Paths", passed, end_time - start_time,
+               passed ? NULL : "Branch took the wrong execution path");
+}
+
+static void test_breakpoints(blueprint_context* ctx, test_suite* suite) {
+    f64 start_time = get_time_ms();
+    
+    branch_test_graph* t = get_branch_test_graph(ctx, 1, 3);
+    blueprint_graph* graph = t->graph;
+    blueprint_vm* vm = &ctx->vm;
+    
+    u8 original[64 * sizeof(bp_instruction)];
+    b32 passed = (graph->bytecode != NULL && graph->bytecode_size <= sizeof(original));
+    if (passed) {
+        memcpy(original, graph->bytecode, graph->bytecode_size);
+        
+        // Pauses on the trap, before the node's first instruction runs
+        blueprint_set_breakpoint(ctx, t->set_true);
+        i32 value = run_branch_test_graph(ctx, t);
+        passed = (vm->is_paused && value == 0 &&
+                  vm->program_counter == blueprint_get_node(graph, t->set_true)->bytecode_address);
+        
+        // The trap is gone once the run returns
+        passed = passed && memcmp(original, graph->bytecode, graph->bytecode_size) == 0;
+        
+        // Single step runs exactly one instruction
+        vm->single_step = true;
+        blueprint_execute_graph(ctx, graph);
+        passed = passed && (vm->is_paused && vm->instructions_executed == 1);
+        vm->single_step = false;
+        
+        // Cleared, the run goes through
+        blueprint_clear_breakpoint(ctx, t->set_true);
+        value = run_branch_test_graph(ctx, t);
+        passed = passed && (!vm->is_paused && value == 1);
+        passed = passed && memcmp(original, graph->bytecode, graph->bytecode_size) == 0;
+    }
+    
+    f64 end_time = get_time_ms();
+    test_record(suite, "Breakpoints", passed, end_time - start_time,
+               passed ? NULL : "Breakpoint did not pause, step or restore the bytecode");
+}
+
+// Compile incrementally, then fully, and compare what both runs produce
+static b32 incremental_matches_full(blueprint_context* ctx, branch_test_graph* t) {
+    u32 full_count = t->graph->full_bytecode_count;
+    blueprint_compile_graph(ctx, t->graph);
+    b32 incremental = (t->graph->full_bytecode_count == full_count &&
+                       ((bp_instruction*)t->graph->bytecode)[0].opcode == BP_OP_JUMP);
+    branch_test_results a = run_branch_test_results(ctx, t);
+    
+    t->graph->needs_full_recompile = true;
+    blueprint_compile_graph(ctx, t->graph);
+    branch_test_results b = run_branch_test_results(ctx, t);
+    
+    return incremental && a.local == b.local && a.sum == b.sum && a.product == b.product;
+}
+
+static void test_incremental_compile(blueprint_context* ctx, test_suite* suite) {
+    f64 start_time = get_time_ms();
+    
+    branch_test_graph* t = get_branch_test_graph(ctx, 5, 3);
+    blueprint_graph* graph = t->graph;
+    b32 passed = (graph->bytecode != NULL && run_branch_test_graph(ctx, t) == 2);
+    
+    // Constant edit on an impure node
+    if (passed) {
+        blueprint_get_node(graph, t->set_false)->input_pins[1].current_value.int_val = 7;
+        blueprint_mark_node_dirty(graph, t->set_false);
+        passed = incremental_matches_full(ctx, t) && run_branch_test_graph(ctx, t) == 7;
+    }
+    
+    // Pure node edits, the Branch now takes its true path
+    if (passed) {
+        blueprint_get_node(graph, t->less)->input_pins[0].current_value.int_val = 1;
+        blueprint_get_node(graph, t->add)->input_pins[1].current_value.float_val = 8.0f;
+        blueprint_mark_node_dirty(graph, t->less);
+        blueprint_mark_node_dirty(graph, t->add);
+        passed = incremental_matches_full(ctx, t);
+        branch_test_results r = run_branch_test_results(ctx, t);
+        passed = passed && (r.local == 1 && r.product == 100.0f);
+    }
+    
+    // Disconnected execution wire, the detached SetVariable becomes an entry
+    // point of its own and runs after BeginPlay
+    if (passed) {
+        blueprint_destroy_connection(graph, t->false_wire);
+        passed = incremental_matches_full(ctx, t) && run_branch_test_graph(ctx, t) == 7;
+    }
+    
+    f64 end_time = get_time_ms();
+    test_record(suite, "Incremental Compile", passed, end_time - start_time,
+               passed ? NULL : "Incremental recompile differs from a full compile");
+}
+
 // ============================================================================
 // PERFORMANCE TESTS
 // ============================================================================
@@ -597,7 +848,12 @@ static void run_all_tests(blueprint_context* ctx) {
     
     // Compilation and execution tests
     test_compilation(ctx, &suite);
+    test_exec_into_data_pin(ctx, &suite);
     test_vm_execution(ctx, &suite);
+    test_register_results(ctx, &suite);
+    test_branch_paths(ctx, &suite);
+    test_breakpoints(ctx, &suite);
+    test_incremental_compile(ctx, &suite);
     
     // Type system tests
     test_type_casting(ctx, &suite);
@@ -11,36 +11,6 @@
 // VM EXECUTION HELPERS
 // ============================================================================
 
-// Stack operations - PERFORMANCE: Inline for zero-call overhead
-static inline void vm_push(blueprint_vm* vm, blueprint_value value) {
-    if (vm->value_stack_top >= vm->value_stack_size) {
-        // Stack overflow - should be caught during compilation
-        vm->is_running = false;
-        return;
-    }
-    vm->value_stack[vm->value_stack_top++] = value;
-}
-
-static inline blueprint_value vm_pop(blueprint_vm* vm) {
-    if (vm->value_stack_top == 0) {
-        // Stack underflow
-        vm->is_running = false;
-        blueprint_value zero = {0};
-        return zero;
-    }
-    return vm->value_stack[--vm->value_stack_top];
-}
-
-static inline blueprint_value vm_peek(blueprint_vm* vm, u32 offset) {
-    u32 index = vm->value_stack_top - 1 - offset;
-    if (index >= vm->value_stack_size) {
-        vm->is_running = false;
-        blueprint_value zero = {0};
-        return zero;
-    }
-    return vm->value_stack[index];
-}
-
 // Call stack operations
 static inline void vm_push_frame(blueprint_vm* vm, node_id return_node, u32 local_base, u32 pin_base) {
     if (vm->call_stack_top >= vm->call_stack_size) {
@@ -63,254 +33,441 @@ static inline bp_stack_frame* vm_pop_frame(blueprint_vm* vm) {
     return &vm->call_stack[--vm->call_stack_top];
 }
 
-// Breakpoint checking
-static inline b32 vm_is_breakpoint(blueprint_vm* vm, u32 pc) {
-    for (u32 i = 0; i < vm->breakpoint_count; i++) {
-        if (vm->breakpoints[i] == pc) {
-            return true;
-        }
-    }
-    return false;
-}
-
 // ============================================================================
 // ARITHMETIC OPERATIONS WITH SIMD OPTIMIZATION
 // ============================================================================
 
-// PERFORMANCE: SIMD arithmetic operations for vector types
-static void vm_execute_add(blueprint_vm* vm) {
-    blueprint_value b = vm_pop(vm);
-    blueprint_value a = vm_pop(vm);
-    blueprint_value result;
-    
-    // Type-specific addition - could be optimized with SIMD
-    // For now, detect the most common cases
-    if (a.float_val != 0.0f || b.float_val != 0.0f) {
-        // Assume float operation
-        result.float_val = a.float_val + b.float_val;
-    } else if (a.int_val != 0 || b.int_val != 0) {
-        // Assume int operation
-        result.int_val = a.int_val + b.int_val;
-    } else {
-        // Vector operations - could use SIMD here
-        // Simple case: assume vec3 addition
-        result.vec3_val.x = a.vec3_val.x + b.vec3_val.x;
-        result.vec3_val.y = a.vec3_val.y + b.vec3_val.y;
-        result.vec3_val.z = a.vec3_val.z + b.vec3_val.z;
-    }
-    
-    vm_push(vm, result);
-}
-
-static void vm_execute_subtract(blueprint_vm* vm) {
-    blueprint_value b = vm_pop(vm);
-    blueprint_value a = vm_pop(vm);
-    blueprint_value result;
+// Arithmetic is typed by the destination register
+// PERFORMANCE: Vector types run as four float lanes - the unused lanes of
+// vec2/vec3 registers are carried along and ignored by readers
+static void vm_execute_arithmetic(blueprint_vm* vm, bp_instruction* inst) {
+    blueprint_value* a = &vm->registers[inst->operand2];
+    blueprint_value* b = &vm->registers[inst->operand3];
+    blueprint_value result = {0};
     
-    // Similar to add, but subtraction
-    if (a.float_val != 0.0f || b.float_val != 0.0f) {
-        result.float_val = a.float_val - b.float_val;
-    } else if (a.int_val != 0 || b.int_val != 0) {
-        result.int_val = a.int_val - b.int_val;
-    } else {
-        result.vec3_val.x = a.vec3_val.x - b.vec3_val.x;
-        result.vec3_val.y = a.vec3_val.y - b.vec3_val.y;
-        result.vec3_val.z = a.vec3_val.z - b.vec3_val.z;
+    switch (vm->register_types[inst->operand1]) {
+        case BP_TYPE_INT: {
+            i32 x = a->int_val, y = b->int_val;
+            switch (inst->opcode) {
+                case BP_OP_ADD: result.int_val = x + y; break;
+                case BP_OP_SUB: result.int_val = x - y; break;
+                case BP_OP_MUL: result.int_val = x * y; break;
+                // Division by zero yields zero
+                case BP_OP_DIV: result.int_val = y ? x / y : 0; break;
+                case BP_OP_MOD: result.int_val = y ? x % y : 0; break;
+                default: break;
+            }
+            break;
+        }
+        
+        case BP_TYPE_FLOAT: {
+            f32 x = a->float_val, y = b->float_val;
+            switch (inst->opcode) {
+                case BP_OP_ADD: result.float_val = x + y; break;
+                case BP_OP_SUB: result.float_val = x - y; break;
+                case BP_OP_MUL: result.float_val = x * y; break;
+                case BP_OP_DIV: result.float_val = (y != 0.0f) ? x / y : 0.0f; break;
+                case BP_OP_MOD: result.float_val = (y != 0.0f) ? fmodf(x, y) : 0.0f; break;
+                default: break;
+            }
+            break;
+        }
+        
+        case BP_TYPE_VEC2:
+        case BP_TYPE_VEC3:
+        case BP_TYPE_VEC4:
+        case BP_TYPE_QUAT: {
+            for (u32 lane = 0; lane < 4; lane++) {
+                f32 x = a->vec4_val.e[lane], y = b->vec4_val.e[lane];
+                f32 r = 0.0f;
+                switch (inst->opcode) {
+                    case BP_OP_ADD: r = x + y; break;
+                    case BP_OP_SUB: r = x - y; break;
+                    case BP_OP_MUL: r = x * y; break;
+                    case BP_OP_DIV: r = (y != 0.0f) ? x / y : 0.0f; break;
+                    default: break;
+                }
+                result.vec4_val.e[lane] = r;
+            }
+            break;
+        }
+        
+        default: {
+            break;
+        }
     }
     
-    vm_push(vm, result);
+    vm->registers[inst->operand1] = result;
 }
 
-static void vm_execute_multiply(blueprint_vm* vm) {
-    blueprint_value b = vm_pop(vm);
-    blueprint_value a = vm_pop(vm);
-    blueprint_value result;
+static void vm_execute_negate(blueprint_vm* vm, bp_instruction* inst) {
+    blueprint_value* a = &vm->registers[inst->operand2];
+    blueprint_value result = {0};
     
-    if (a.float_val != 0.0f || b.float_val != 0.0f) {
-        result.float_val = a.float_val * b.float_val;
-    } else if (a.int_val != 0 || b.int_val != 0) {
-        result.int_val = a.int_val * b.int_val;
-    } else {
-        result.vec3_val.x = a.vec3_val.x * b.vec3_val.x;
-        result.vec3_val.y = a.vec3_val.y * b.vec3_val.y;
-        result.vec3_val.z = a.vec3_val.z * b.vec3_val.z;
+    switch (vm->register_types[inst->operand1]) {
+        case BP_TYPE_INT: result.int_val = -a->int_val; break;
+        case BP_TYPE_FLOAT: result.float_val = -a->float_val; break;
+        case BP_TYPE_VEC2:
+        case BP_TYPE_VEC3:
+        case BP_TYPE_VEC4:
+        case BP_TYPE_QUAT: {
+            for (u32 lane = 0; lane < 4; lane++) {
+                result.vec4_val.e[lane] = -a->vec4_val.e[lane];
+            }
+            break;
+        }
+        default: break;
     }
     
-    vm_push(vm, result);
+    vm->registers[inst->operand1] = result;
 }
 
-static void vm_execute_divide(blueprint_vm* vm) {
-    blueprint_value b = vm_pop(vm);
-    blueprint_value a = vm_pop(vm);
-    blueprint_value result;
-    
-    // Check for division by zero
-    if (b.float_val == 0.0f && b.int_val == 0) {
-        // Division by zero - push zero result
-        memset(&result, 0, sizeof(result));
-        vm_push(vm, result);
-        return;
+// ============================================================================
+// COMPARISON OPERATIONS
+// ============================================================================
+
+// Comparisons are typed by the first source register
+static void vm_execute_compare(blueprint_vm* vm, bp_instruction* inst) {
+    blueprint_type type = (blueprint_type)vm->register_types[inst->operand2];
+    blueprint_value* a = &vm->registers[inst->operand2];
+    blueprint_value* b = &vm->registers[inst->operand3];
+    
+    // Ordering: -1, 0, 1 - or 2 when the type has no ordering
+    i32 order = 2;
+    switch (type) {
+        case BP_TYPE_BOOL:
+        case BP_TYPE_INT: {
+            order = (a->int_val < b->int_val) ? -1 : (a->int_val > b->int_val);
+            break;
+        }
+        
+        case BP_TYPE_FLOAT: {
+            order = (a->float_val < b->float_val) ? -1 : (a->float_val > b->float_val);
+            break;
+        }
+        
+        case BP_TYPE_STRING: {
+            i32 c = strcmp(vm->strings + a->string_index, vm->strings + b->string_index);
+            order = (c < 0) ? -1 : (c > 0);
+            break;
+        }
+        
+        case BP_TYPE_MATRIX: {
+            if (memcmp(&vm->matrices[a->matrix_index], &vm->matrices[b->matrix_index], sizeof(mat4)) == 0) {
+                order = 0;
+            }
+            break;
+        }
+        
+        default: {
+            // Compare only the bytes the type occupies, vec3 padding is undefined
+            if (memcmp(a, b, blueprint_type_size(type)) == 0) {
+                order = 0;
+            }
+            break;
+        }
     }
     
-    if (a.float_val != 0.0f || b.float_val != 0.0f) {
-        result.float_val = a.float_val / b.float_val;
-    } else if (a.int_val != 0 || b.int_val != 0) {
-        result.int_val = a.int_val / b.int_val;
-    } else {
-        result.vec3_val.x = a.vec3_val.x / b.vec3_val.x;
-        result.vec3_val.y = a.vec3_val.y / b.vec3_val.y;
-        result.vec3_val.z = a.vec3_val.z / b.vec3_val.z;
+    b32 result = false;
+    switch (inst->opcode) {
+        case BP_OP_EQUALS: result = (order == 0); break;
+        case BP_OP_NOT_EQUALS: result = (order != 0); break;
+        case BP_OP_LESS: result = (order == -1); break;
+        case BP_OP_LESS_EQUAL: result = (order == -1 || order == 0); break;
+        case BP_OP_GREATER: result = (order == 1); break;
+        case BP_OP_GREATER_EQUAL: result = (order == 1 || order == 0); break;
+        default: break;
     }
     
-    vm_push(vm, result);
+    blueprint_value value = {0};
+    value.bool_val = result;
+    vm->registers[inst->operand1] = value;
 }
 
 // ============================================================================
-// COMPARISON OPERATIONS
+// TYPE CASTING
 // ============================================================================
 
-static void vm_execute_equals(blueprint_vm* vm) {
-    blueprint_value b = vm_pop(vm);
-    blueprint_value a = vm_pop(vm);
-    blueprint_value result;
-    
-    // For now, simple memory comparison
-    b32 equal = (memcmp(&a, &b, sizeof(blueprint_value)) == 0);
-    result.bool_val = equal;
-    
-    vm_push(vm, result);
+static void vm_execute_cast(blueprint_vm* vm, bp_instruction* inst) {
+    blueprint_value value = vm->registers[inst->operand2];
+    blueprint_cast_value(&value,
+                         (blueprint_type)vm->register_types[inst->operand2],
+                         (blueprint_type)vm->register_types[inst->operand1]);
+    vm->registers[inst->operand1] = value;
+}
+
+// ============================================================================
+// NATIVE FUNCTIONS
+// ============================================================================
+
+static void vm_print_register(blueprint_vm* vm, u32 reg) {
+    blueprint_value* val = &vm->registers[reg];
+    switch (vm->register_types[reg]) {
+        case BP_TYPE_INT:
+            printf("Blueprint: %d\n", val->int_val);
+            break;
+        case BP_TYPE_FLOAT:
+            printf("Blueprint: %.2f\n", val->float_val);
+            break;
+        case BP_TYPE_BOOL:
+            printf("Blueprint: %s\n", val->bool_val ? "true" : "false");
+            break;
+        case BP_TYPE_STRING:
+            printf("Blueprint: %s\n", vm->strings + val->string_index);
+            break;
+        case BP_TYPE_VEC3:
+            printf("Blueprint: (%.2f, %.2f, %.2f)\n",
+                   val->vec3_val.x, val->vec3_val.y, val->vec3_val.z);
+            break;
+        default:
+            printf("Blueprint: <unknown>\n");
+            break;
+    }
+}
+
+// Call native function by index: operand2 receives the result of operand3
+static void vm_call_native(blueprint_vm* vm, bp_instruction* inst) {
+    u32 dst = inst->operand2;
+    u32 arg = inst->operand3;
+    
+    switch (inst->operand1) {
+        case 0: { // Print function
+            vm_print_register(vm, arg);
+            break;
+        }
+        
+        case 1: { // Math.sin
+            blueprint_value result = {0};
+            result.float_val = sinf(vm->registers[arg].float_val);
+            vm->registers[dst] = result;
+            break;
+        }
+        
+        case 2: { // Math.cos
+            blueprint_value result = {0};
+            result.float_val = cosf(vm->registers[arg].float_val);
+            vm->registers[dst] = result;
+            break;
+        }
+        
+        default:
+            // Unknown function - no effect
+            break;
+    }
 }
 
-static void vm_execute_less(blueprint_vm* vm) {
-    blueprint_value b = vm_pop(vm);
-    blueprint_value a = vm_pop(vm);
-    blueprint_value result;
+// ============================================================================
+// BREAKPOINTS
+// ============================================================================
+
+// Breakpoints are patched over the first instruction of their node's block,
+// so only a trap costs anything - nothing is looked up per instruction.
+// Returns the number of traps placed in this graph's bytecode.
+static u32 vm_patch_breakpoints(blueprint_context* ctx, blueprint_graph* graph) {
+    blueprint_vm* vm = &ctx->vm;
+    u32 patched = 0;
     
-    // Assume numeric comparison for now
-    b32 less = false;
-    if (a.float_val != 0.0f || b.float_val != 0.0f) {
-        less = a.float_val < b.float_val;
-    } else {
-        less = a.int_val < b.int_val;
+    for (u32 i = 0; i < vm->breakpoint_count; i++) {
+        vm->breakpoint_addresses[i] = 0xFFFFFFFF;
+        
+        blueprint_node* node = blueprint_get_node(graph, vm->breakpoints[i]);
+        if (!node || graph->needs_recompile || node->bytecode_address >= vm->bytecode_size) {
+            continue; // Pure nodes are inlined and have no block of their own
+        }
+        
+        bp_instruction* inst = &vm->bytecode[node->bytecode_address];
+        if (inst->opcode == BP_OP_BREAKPOINT) {
+            continue; // Same node listed twice
+        }
+        
+        vm->breakpoint_displaced[i] = *inst;
+        vm->breakpoint_addresses[i] = node->bytecode_address;
+        inst->opcode = BP_OP_BREAKPOINT;
+        inst->operand1 = i;
+        patched++;
     }
     
-    result.bool_val = less;
-    vm_push(vm, result);
+    return patched;
+}
+
+static void vm_unpatch_breakpoints(blueprint_vm* vm) {
+    for (u32 i = 0; i < vm->breakpoint_count; i++) {
+        u32 address = vm->breakpoint_addresses[i];
+        if (address < vm->bytecode_size) {
+            vm->bytecode[address] = vm->breakpoint_displaced[i];
+        }
+    }
 }
 
 // ============================================================================
-// TYPE CASTING
+// INSTRUCTION EXECUTION
 // ============================================================================
 
-static void vm_execute_cast(blueprint_vm* vm, blueprint_type target_type) {
-    blueprint_value value = vm_pop(vm);
-    blueprint_value result = {0};
-    
-    switch (target_type) {
-        case BP_TYPE_BOOL: {
-            // Any non-zero value becomes true
-            result.bool_val = (value.int_val != 0 || value.float_val != 0.0f);
+#define VM_INSTRUCTION_LIMIT 1000000
+
+// Pins live in registers assigned by the compiler, which never emits the pin
+// opcodes. Hand-built bytecode using them stops the run instead of silently
+// dropping the load or store.
+static void vm_pin_access_error(blueprint_context* ctx, bp_instruction* inst, u32 pc) {
+    blueprint_log_debug(ctx, "Unsupported pin access opcode %u at PC %u", inst->opcode, pc);
+}
+
+// Execute one instruction - the debug loop steps through this
+static void vm_execute_instruction(blueprint_context* ctx, blueprint_vm* vm, bp_instruction* inst) {
+    switch (inst->opcode) {
+        case BP_OP_NOP: {
+            // Do nothing
             break;
         }
         
-        case BP_TYPE_INT: {
-            if (value.bool_val) {
-                result.int_val = value.bool_val ? 1 : 0;
-            } else if (value.float_val != 0.0f) {
-                result.int_val = (i32)value.float_val;
+        case BP_OP_MOVE: {
+            vm->registers[inst->operand1] = vm->registers[inst->operand2];
+            break;
+        }
+        
+        case BP_OP_LOAD_VAR: {
+            if (inst->operand2 < vm->local_count) {
+                vm->registers[inst->operand1] = vm->locals[inst->operand2];
             } else {
-                result.int_val = value.int_val;
+                vm->is_running = false;
             }
             break;
         }
         
-        case BP_TYPE_FLOAT: {
-            if (value.bool_val) {
-                result.float_val = value.bool_val ? 1.0f : 0.0f;
-            } else if (value.int_val != 0) {
-                result.float_val = (f32)value.int_val;
+        case BP_OP_STORE_VAR: {
+            if (inst->operand1 < vm->local_count) {
+                vm->locals[inst->operand1] = vm->registers[inst->operand2];
             } else {
-                result.float_val = value.float_val;
+                vm->is_running = false;
             }
             break;
         }
         
-        case BP_TYPE_VEC2: {
-            // Convert scalar to vec2
-            if (value.float_val != 0.0f) {
-                result.vec2_val.x = value.float_val;
-                result.vec2_val.y = value.float_val;
-            } else if (value.int_val != 0) {
-                result.vec2_val.x = (f32)value.int_val;
-                result.vec2_val.y = (f32)value.int_val;
-            } else {
-                result.vec2_val = value.vec2_val;
+        case BP_OP_LOAD_PIN:
+        case BP_OP_STORE_PIN: {
+            vm_pin_access_error(ctx, inst, vm->program_counter - 1);
+            vm->is_running = false;
+            break;
+        }
+        
+        case BP_OP_CALL: {
+            // Function call - push return address
+            vm_push_frame(vm, vm->program_counter, 0, 0);
+            vm->program_counter = inst->operand1;
+            break;
+        }
+        
+        case BP_OP_CALL_NATIVE: {
+            vm_call_native(vm, inst);
+            break;
+        }
+        
+        case BP_OP_JUMP: {
+            vm->program_counter = inst->operand1;
+            break;
+        }
+        
+        case BP_OP_JUMP_IF_FALSE: {
+            if (!vm->registers[inst->operand2].bool_val) {
+                vm->program_counter = inst->operand1;
             }
             break;
         }
         
-        case BP_TYPE_VEC3: {
-            if (value.float_val != 0.0f) {
-                result.vec3_val.x = value.float_val;
-                result.vec3_val.y = value.float_val;
-                result.vec3_val.z = value.float_val;
-            } else if (value.int_val != 0) {
-                result.vec3_val.x = (f32)value.int_val;
-                result.vec3_val.y = (f32)value.int_val;
-                result.vec3_val.z = (f32)value.int_val;
+        case BP_OP_RETURN: {
+            bp_stack_frame* frame = vm_pop_frame(vm);
+            if (frame) {
+                vm->program_counter = frame->return_node;
             } else {
-                result.vec3_val = value.vec3_val;
+                vm->is_running = false;
             }
             break;
         }
         
+        // Arithmetic operations
+        case BP_OP_ADD:
+        case BP_OP_SUB:
+        case BP_OP_MUL:
+        case BP_OP_DIV:
+        case BP_OP_MOD: {
+            vm_execute_arithmetic(vm, inst);
+            break;
+        }
+        
+        case BP_OP_NEG: {
+            vm_execute_negate(vm, inst);
+            break;
+        }
+        
+        // Comparison operations
+        case BP_OP_EQUALS:
+        case BP_OP_NOT_EQUALS:
+        case BP_OP_LESS:
+        case BP_OP_LESS_EQUAL:
+        case BP_OP_GREATER:
+        case BP_OP_GREATER_EQUAL: {
+            vm_execute_compare(vm, inst);
+            break;
+        }
+        
+        // Logical operations
+        case BP_OP_AND: {
+            blueprint_value result = {0};
+            result.bool_val = vm->registers[inst->operand2].bool_val && 
+                              vm->registers[inst->operand3].bool_val;
+            vm->registers[inst->operand1] = result;
+            break;
+        }
+        
+        case BP_OP_OR: {
+            blueprint_value result = {0};
+            result.bool_val = vm->registers[inst->operand2].bool_val || 
+                              vm->registers[inst->operand3].bool_val;
+            vm->registers[inst->operand1] = result;
+            break;
+        }
+        
+        case BP_OP_NOT: {
+            blueprint_value result = {0};
+            result.bool_val = !vm->registers[inst->operand2].bool_val;
+            vm->registers[inst->operand1] = result;
+            break;
+        }
+        
+        case BP_OP_CAST: {
+            vm_execute_cast(vm, inst);
+            break;
+        }
+        
+        case BP_OP_BREAK: {
+            // Debug breakpoint - log node ID and pause
+            blueprint_log_debug(ctx, "Debug breakpoint at node %u", inst->operand1);
+            vm->is_paused = true;
+            break;
+        }
+        
+        case BP_OP_HALT: {
+            vm->is_running = false;
+            break;
+        }
+        
         default: {
-            // No conversion, just copy
-            result = value;
+            blueprint_log_debug(ctx, "Unknown opcode %u at PC %u", 
+                               inst->opcode, vm->program_counter - 1);
+            vm->is_running = false;
             break;
         }
     }
-    
-    vm_push(vm, result);
 }
 
 // ============================================================================
 // MAIN EXECUTION LOOP
 // ============================================================================
 
-void blueprint_execute_graph(blueprint_context* ctx, blueprint_graph* graph) {
-    if (!ctx || !graph || !graph->bytecode) {
-        blueprint_log_debug(ctx, "Cannot execute graph: invalid parameters");
-        return;
-    }
-    
-    blueprint_vm* vm = &ctx->vm;
-    
-    // Initialize VM state
-    vm->bytecode = (bp_instruction*)graph->bytecode;
-    vm->bytecode_size = graph->bytecode_size / sizeof(bp_instruction);
-    vm->program_counter = 0;
-    vm->value_stack_top = 0;
-    vm->call_stack_top = 0;
-    vm->is_running = true;
-    vm->is_paused = false;
-    vm->instructions_executed = 0;
-    
-    f64 execution_start = blueprint_begin_profile();
-    
-    // Main execution loop - PERFORMANCE: Tight loop with minimal branching
+// Debug loop - single stepping and breakpoint traps
+static void vm_run_debug(blueprint_context* ctx, blueprint_vm* vm) {
     while (vm->is_running && vm->program_counter < vm->bytecode_size) {
         
-        // Check for breakpoints
-        if (vm_is_breakpoint(vm, vm->program_counter)) {
-            vm->is_paused = true;
-            blueprint_log_debug(ctx, "Breakpoint hit at PC %u", vm->program_counter);
-            
-            if (!vm->single_step) {
-                break; // Stop execution for debugging
-            }
-        }
-        
         // Single step mode
         if (vm->single_step && vm->instructions_executed > 0) {
             vm->is_paused = true;
@@ -318,312 +475,304 @@ void blueprint_execute_graph(blueprint_context* ctx, blueprint_graph* graph) {
         }
         
         bp_instruction* inst = &vm->bytecode[vm->program_counter];
-        vm->program_counter++;
-        vm->instructions_executed++;
         
-        // Instruction dispatch - PERFORMANCE: Jump table would be faster
-        switch (inst->opcode) {
-            case BP_OP_NOP: {
-                // Do nothing
-                break;
-            }
-            
-            case BP_OP_LOAD_CONST: {
-                if (inst->operand1 < vm->constant_count) {
-                    vm_push(vm, vm->constants[inst->operand1]);
-                } else {
-                    vm->is_running = false;
-                }
-                break;
-            }
-            
-            case BP_OP_LOAD_VAR: {
-                if (inst->operand1 < vm->local_count) {
-                    vm_push(vm, vm->locals[inst->operand1]);
-                } else {
-                    vm->is_running = false;
-                }
-                break;
-            }
-            
-            case BP_OP_STORE_VAR: {
-                if (inst->operand1 < vm->local_count) {
-                    vm->locals[inst->operand1] = vm_pop(vm);
-                } else {
-                    vm->is_running = false;
-                }
-                break;
-            }
-            
-            case BP_OP_LOAD_PIN: {
-                // TODO: Load pin value from graph
-                blueprint_value zero = {0};
-                vm_push(vm, zero);
-                break;
-            }
-            
-            case BP_OP_STORE_PIN: {
-                // TODO: Store value to pin
-                vm_pop(vm);
-                break;
-            }
-            
-            case BP_OP_CALL: {
-                // Function call - push return address
-                vm_push_frame(vm, vm->program_counter, 0, 0);
-                vm->program_counter = inst->operand1;
-                break;
-            }
-            
-            case BP_OP_CALL_NATIVE: {
-                // Call native function by index
-                u32 func_index = inst->operand1;
-                u32 arg_count = inst->operand2;
-                
-                // Built-in native functions
-                switch (func_index) {
-                    case 0: { // Print function
-                        if (arg_count > 0 && vm->value_stack_top >= arg_count) {
-                            blueprint_value val = vm->value_stack[vm->value_stack_top - 1];
-                            switch (val.type) {
-                                case BP_TYPE_INT:
-                                    printf("Blueprint: %d\n", val.int_val);
-                                    break;
-                                case BP_TYPE_FLOAT:
-                                    printf("Blueprint: %.2f\n", val.float_val);
-                                    break;
-                                case BP_TYPE_BOOL:
-                                    printf("Blueprint: %s\n", val.bool_val ? "true" : "false");
-                                    break;
-                                default:
-                                    printf("Blueprint: <unknown>\n");
-                                    break;
-                            }
-                            vm->value_stack_top -= arg_count;
-                        }
-                        break;
-                    }
-                    
-                    case 1: { // Math.sin
-                        if (arg_count == 1 && vm->value_stack_top >= 1) {
-                            blueprint_value val = vm_pop(vm);
-                            blueprint_value result = {
-                                .type = BP_TYPE_FLOAT,
-                                .float_val = sinf(val.float_val)
-                            };
-                            vm_push(vm, result);
-                        }
-                        break;
-                    }
-                    
-                    case 2: { // Math.cos
-                        if (arg_count == 1 && vm->value_stack_top >= 1) {
-                            blueprint_value val = vm_pop(vm);
-                            blueprint_value result = {
-                                .type = BP_TYPE_FLOAT,
-                                .float_val = cosf(val.float_val)
-                            };
-                            vm_push(vm, result);
-                        }
-                        break;
-                    }
-                    
-                    default:
-                        // Unknown function - just pop arguments
-                        if (vm->value_stack_top >= arg_count) {
-                            vm->value_stack_top -= arg_count;
-                        }
-                        break;
-                }
-                break;
-            }
-            
-            case BP_OP_JUMP: {
-                vm->program_counter = inst->operand1;
-                break;
-            }
-            
-            case BP_OP_JUMP_IF_FALSE: {
-                blueprint_value condition = vm_pop(vm);
-                if (!condition.bool_val) {
-                    vm->program_counter = inst->operand1;
-                }
-                break;
-            }
-            
-            case BP_OP_RETURN: {
-                bp_stack_frame* frame = vm_pop_frame(vm);
-                if (frame) {
-                    vm->program_counter = frame->return_node;
-                } else {
-                    vm->is_running = false;
-                }
-                break;
-            }
-            
-            // Arithmetic operations
-            case BP_OP_ADD: {
-                vm_execute_add(vm);
-                break;
-            }
-            
-            case BP_OP_SUB: {
-                vm_execute_subtract(vm);
-                break;
-            }
-            
-            case BP_OP_MUL: {
-                vm_execute_multiply(vm);
-                break;
-            }
-            
-            case BP_OP_DIV: {
-                vm_execute_divide(vm);
-                break;
-            }
-            
-            case BP_OP_MOD: {
-                blueprint_value b = vm_pop(vm);
-                blueprint_value a = vm_pop(vm);
-                blueprint_value result;
-                result.int_val = a.int_val % b.int_val;
-                vm_push(vm, result);
-                break;
-            }
-            
-            case BP_OP_NEG: {
-                blueprint_value a = vm_pop(vm);
-                blueprint_value result;
-                if (a.float_val != 0.0f) {
-                    result.float_val = -a.float_val;
-                } else {
-                    result.int_val = -a.int_val;
-                }
-                vm_push(vm, result);
-                break;
-            }
-            
-            // Comparison operations
-            case BP_OP_EQUALS: {
-                vm_execute_equals(vm);
-                break;
-            }
-            
-            case BP_OP_NOT_EQUALS: {
-                vm_execute_equals(vm);
-                blueprint_value result = vm_pop(vm);
-                result.bool_val = !result.bool_val;
-                vm_push(vm, result);
-                break;
-            }
-            
-            case BP_OP_LESS: {
-                vm_execute_less(vm);
-                break;
-            }
-            
-            case BP_OP_LESS_EQUAL: {
-                blueprint_value b = vm_pop(vm);
-                blueprint_value a = vm_pop(vm);
-                blueprint_value result;
-                
-                b32 less_equal = false;
-                if (a.float_val != 0.0f || b.float_val != 0.0f) {
-                    less_equal = a.float_val <= b.float_val;
-                } else {
-                    less_equal = a.int_val <= b.int_val;
-                }
-                
-                result.bool_val = less_equal;
-                vm_push(vm, result);
-                break;
-            }
-            
-            case BP_OP_GREATER: {
-                // Greater is just inverted less
-                vm_execute_less(vm);
-                blueprint_value result = vm_pop(vm);
-                result.bool_val = !result.bool_val;
-                vm_push(vm, result);
-                break;
-            }
-            
-            case BP_OP_GREATER_EQUAL: {
-                blueprint_value b = vm_pop(vm);
-                blueprint_value a = vm_pop(vm);
-                blueprint_value result;
-                
-                b32 greater_equal = false;
-                if (a.float_val != 0.0f || b.float_val != 0.0f) {
-                    greater_equal = a.float_val >= b.float_val;
-                } else {
-                    greater_equal = a.int_val >= b.int_val;
-                }
-                
-                result.bool_val = greater_equal;
-                vm_push(vm, result);
-                break;
-            }
-            
-            // Logical operations
-            case BP_OP_AND: {
-                blueprint_value b = vm_pop(vm);
-                blueprint_value a = vm_pop(vm);
-                blueprint_value result;
-                result.bool_val = a.bool_val && b.bool_val;
-                vm_push(vm, result);
-                break;
-            }
-            
-            case BP_OP_OR: {
-                blueprint_value b = vm_pop(vm);
-                blueprint_value a = vm_pop(vm);
-                blueprint_value result;
-                result.bool_val = a.bool_val || b.bool_val;
-                vm_push(vm, result);
-                break;
-            }
-            
-            case BP_OP_NOT: {
-                blueprint_value a = vm_pop(vm);
-                blueprint_value result;
-                result.bool_val = !a.bool_val;
-                vm_push(vm, result);
-                break;
-            }
-            
-            case BP_OP_CAST: {
-                vm_execute_cast(vm, (blueprint_type)inst->operand1);
-                break;
-            }
-            
-            case BP_OP_BREAK: {
-                // Debug breakpoint - log node ID and pause
-                blueprint_log_debug(ctx, "Debug breakpoint at node %u", inst->operand1);
-                vm->is_paused = true;
-                break;
-            }
+        if (inst->opcode == BP_OP_BREAKPOINT) {
+            vm->is_paused = true;
+            blueprint_log_debug(ctx, "Breakpoint hit on node %u at PC %u", 
+                               vm->breakpoints[inst->operand1], vm->program_counter);
             
-            case BP_OP_HALT: {
-                vm->is_running = false;
-                break;
+            if (!vm->single_step) {
+                break; // Stop execution for debugging
             }
             
-            default: {
-                blueprint_log_debug(ctx, "Unknown opcode %u at PC %u", 
-                                   inst->opcode, vm->program_counter - 1);
-                vm->is_running = false;
-                break;
-            }
+            inst = &vm->breakpoint_displaced[inst->operand1];
         }
         
+        vm->program_counter++;
+        vm->instructions_executed++;
+        vm_execute_instruction(ctx, vm, inst);
+        
         // Safety check - prevent infinite loops
-        if (vm->instructions_executed > 1000000) {
+        if (vm->instructions_executed > VM_INSTRUCTION_LIMIT) {
             blueprint_log_debug(ctx, "VM execution limit reached - possible infinite loop");
             vm->is_running = false;
             break;
         }
     }
+}
+
+// Release loop - no breakpoint or single-step checks
+// PERFORMANCE: Threaded dispatch with GCC/Clang labels as values - every
+// handler ends in its own indirect jump, so the branch predictor sees one
+// site per opcode instead of a single shared switch. The compiler ends every
+// block in a jump, return or halt, so the program counter is only validated
+// where control transfers, together with the instruction limit.
+#if defined(__GNUC__) || defined(__clang__)
+#define VM_THREADED_DISPATCH 1
+#else
+#define VM_THREADED_DISPATCH 0
+#endif
+
+static void vm_run_release(blueprint_context* ctx, blueprint_vm* vm) {
+    bp_instruction* code = vm->bytecode;
+    blueprint_value* registers = vm->registers;
+    u32 size = vm->bytecode_size;
+    u32 pc = vm->program_counter;
+    u64 executed = vm->instructions_executed;
+    bp_instruction* inst;
+    
+#if VM_THREADED_DISPATCH
+    // Out-of-range opcodes dispatch through the trap slot to op_unknown
+    static void* dispatch[BP_OP_COUNT] = {
+        [BP_OP_NOP] = &&op_NOP,
+        [BP_OP_MOVE] = &&op_MOVE,
+        [BP_OP_LOAD_VAR] = &&op_LOAD_VAR,
+        [BP_OP_STORE_VAR] = &&op_STORE_VAR,
+        [BP_OP_LOAD_PIN] = &&op_LOAD_PIN,
+        [BP_OP_STORE_PIN] = &&op_STORE_PIN,
+        [BP_OP_CALL] = &&op_CALL,
+        [BP_OP_CALL_NATIVE] = &&op_CALL_NATIVE,
+        [BP_OP_JUMP] = &&op_JUMP,
+        [BP_OP_JUMP_IF_FALSE] = &&op_JUMP_IF_FALSE,
+        [BP_OP_RETURN] = &&op_RETURN,
+        [BP_OP_ADD] = &&op_ARITHMETIC,
+        [BP_OP_SUB] = &&op_ARITHMETIC,
+        [BP_OP_MUL] = &&op_ARITHMETIC,
+        [BP_OP_DIV] = &&op_ARITHMETIC,
+        [BP_OP_MOD] = &&op_ARITHMETIC,
+        [BP_OP_NEG] = &&op_NEG,
+        [BP_OP_EQUALS] = &&op_COMPARE,
+        [BP_OP_NOT_EQUALS] = &&op_COMPARE,
+        [BP_OP_LESS] = &&op_COMPARE,
+        [BP_OP_LESS_EQUAL] = &&op_COMPARE,
+        [BP_OP_GREATER] = &&op_COMPARE,
+        [BP_OP_GREATER_EQUAL] = &&op_COMPARE,
+        [BP_OP_AND] = &&op_AND,
+        [BP_OP_OR] = &&op_OR,
+        [BP_OP_NOT] = &&op_NOT,
+        [BP_OP_CAST] = &&op_CAST,
+        [BP_OP_BREAK] = &&op_BREAK,
+        [BP_OP_HALT] = &&op_HALT,
+        [BP_OP_BREAKPOINT] = &&op_unknown,  // Only patched in for the debug loop
+    };
+    
+    #define VM_OP(name) op_##name:
+    #define VM_UNKNOWN() op_unknown:
+    #define VM_NEXT() do { \
+        inst = &code[pc++]; \
+        executed++; \
+        goto *dispatch[(u32)inst->opcode < BP_OP_COUNT ? inst->opcode : BP_OP_BREAKPOINT]; \
+    } while (0)
+    
+    VM_NEXT();
+#else
+    #define VM_OP(name) case BP_OP_##name:
+    #define VM_UNKNOWN() default:
+    #define VM_NEXT() continue
+    
+    for (;;) {
+    inst = &code[pc++];
+    executed++;
+    switch (inst->opcode) {
+    case BP_OP_ADD: case BP_OP_SUB: case BP_OP_MUL: case BP_OP_DIV: case BP_OP_MOD:
+        goto op_ARITHMETIC;
+    case BP_OP_EQUALS: case BP_OP_NOT_EQUALS: case BP_OP_LESS: 
+    case BP_OP_LESS_EQUAL: case BP_OP_GREATER: case BP_OP_GREATER_EQUAL:
+        goto op_COMPARE;
+#endif
+    
+    // Control transfers check the target and the instruction limit
+    #define VM_TRANSFER(target) do { \
+        pc = (target); \
+        if (pc >= size || executed > VM_INSTRUCTION_LIMIT) goto transfer_failed; \
+    } while (0)
+    
+    VM_OP(NOP) {
+        VM_NEXT();
+    }
+    
+    VM_OP(MOVE) {
+        registers[inst->operand1] = registers[inst->operand2];
+        VM_NEXT();
+    }
+    
+    VM_OP(LOAD_VAR) {
+        if (inst->operand2 >= vm->local_count) goto stop;
+        registers[inst->operand1] = vm->locals[inst->operand2];
+        VM_NEXT();
+    }
+    
+    VM_OP(STORE_VAR) {
+        if (inst->operand1 >= vm->local_count) goto stop;
+        vm->locals[inst->operand1] = registers[inst->operand2];
+        VM_NEXT();
+    }
+    
+    VM_OP(LOAD_PIN) {
+        vm_pin_access_error(ctx, inst, pc - 1);
+        goto stop;
+    }
+    
+    VM_OP(STORE_PIN) {
+        vm_pin_access_error(ctx, inst, pc - 1);
+        goto stop;
+    }
+    
+    VM_OP(CALL) {
+        vm_push_frame(vm, pc, 0, 0);
+        if (!vm->is_running) goto stop;
+        VM_TRANSFER(inst->operand1);
+        VM_NEXT();
+    }
+    
+    VM_OP(CALL_NATIVE) {
+        vm_call_native(vm, inst);
+        VM_NEXT();
+    }
+    
+    VM_OP(JUMP) {
+        VM_TRANSFER(inst->operand1);
+        VM_NEXT();
+    }
+    
+    VM_OP(JUMP_IF_FALSE) {
+        if (!registers[inst->operand2].bool_val) {
+            VM_TRANSFER(inst->operand1);
+        }
+        VM_NEXT();
+    }
+    
+    VM_OP(RETURN) {
+        bp_stack_frame* frame = vm_pop_frame(vm);
+        if (!frame) goto stop;
+        VM_TRANSFER(frame->return_node);
+        VM_NEXT();
+    }
+    
+    op_ARITHMETIC: {
+        vm_execute_arithmetic(vm, inst);
+        VM_NEXT();
+    }
+    
+    VM_OP(NEG) {
+        vm_execute_negate(vm, inst);
+        VM_NEXT();
+    }
+    
+    op_COMPARE: {
+        vm_execute_compare(vm, inst);
+        VM_NEXT();
+    }
+    
+    VM_OP(AND) {
+        blueprint_value result = {0};
+        result.bool_val = registers[inst->operand2].bool_val && registers[inst->operand3].bool_val;
+        registers[inst->operand1] = result;
+        VM_NEXT();
+    }
+    
+    VM_OP(OR) {
+        blueprint_value result = {0};
+        result.bool_val = registers[inst->operand2].bool_val || registers[inst->operand3].bool_val;
+        registers[inst->operand1] = result;
+        VM_NEXT();
+    }
+    
+    VM_OP(NOT) {
+        blueprint_value result = {0};
+        result.bool_val = !registers[inst->operand2].bool_val;
+        registers[inst->operand1] = result;
+        VM_NEXT();
+    }
+    
+    VM_OP(CAST) {
+        vm_execute_cast(vm, inst);
+        VM_NEXT();
+    }
+    
+    VM_OP(BREAK) {
+        // Compiled debug node - log node ID and pause
+        blueprint_log_debug(ctx, "Debug breakpoint at node %u", inst->operand1);
+        vm->is_paused = true;
+        VM_NEXT();
+    }
+    
+    VM_OP(HALT) {
+        goto stop;
+    }
+    
+    VM_UNKNOWN() {
+        blueprint_log_debug(ctx, "Unknown opcode %u at PC %u", inst->opcode, pc - 1);
+        goto stop;
+    }
+    
+#if !VM_THREADED_DISPATCH
+    }
+    }
+#endif
+    
+transfer_failed:
+    if (executed > VM_INSTRUCTION_LIMIT) {
+        blueprint_log_debug(ctx, "VM execution limit reached - possible infinite loop");
+    }
+    
+stop:
+    vm->is_running = false;
+    vm->program_counter = pc;
+    vm->instructions_executed = executed;
+    
+    #undef VM_OP
+    #undef VM_UNKNOWN
+    #undef VM_NEXT
+    #undef VM_TRANSFER
+}
+
+void blueprint_execute_graph(blueprint_context* ctx, blueprint_graph* graph) {
+    if (!ctx || !graph || !graph->bytecode) {
+        blueprint_log_debug(ctx, "Cannot execute graph: invalid parameters");
+        return;
+    }
+    
+    blueprint_vm* vm = &ctx->vm;
+    
+    if (graph->register_count > vm->register_capacity) {
+        blueprint_log_debug(ctx, "Cannot execute graph '%s': %u registers exceed VM capacity %u",
+                           graph->name, graph->register_count, vm->register_capacity);
+        return;
+    }
+    
+    // Initialize VM state
+    vm->bytecode = (bp_instruction*)graph->bytecode;
+    vm->bytecode_size = graph->bytecode_size / sizeof(bp_instruction);
+    vm->program_counter = 0;
+    vm->call_stack_top = 0;
+    vm->is_running = true;
+    vm->is_paused = false;
+    vm->instructions_executed = 0;
+    
+    // Load the register file - constants in place, temporaries zeroed
+    // PERFORMANCE: One 16-byte copy per register instead of a push per operand
+    if (graph->register_count > 0) {
+        memcpy(vm->registers, graph->register_image, 
+               graph->register_count * sizeof(blueprint_value));
+    }
+    vm->register_types = graph->register_types;
+    vm->register_count = graph->register_count;
+    
+    f64 execution_start = blueprint_begin_profile();
+    
+    // Only pay for the debugger when it is in use
+    u32 patched = (vm->breakpoint_count > 0) ? vm_patch_breakpoints(ctx, graph) : 0;
+    
+    if (patched > 0 || vm->single_step) {
+        vm_run_debug(ctx, vm);
+    } else if (vm->bytecode_size > 0) {
+        vm_run_release(ctx, vm);
+    }
+    
+    if (patched > 0) {
+        vm_unpatch_breakpoints(vm);
+    }
     
     vm->execution_time = blueprint_end_profile() - execution_start;
     
@@ -661,6 +810,50 @@ void blueprint_execute_node(blueprint_context* ctx, blueprint_node* node) {
     blueprint_log_debug(ctx, "Node '%s' executed in %.2f ms", node->name, node_time);
 }
 
+// ============================================================================
+// SIDE POOLS
+// ============================================================================
+
+// Matrices and strings do not fit a 16-byte register, registers hold an index.
+// MEMORY: Append-only for the lifetime of the context, like the memory pool
+
+u32 blueprint_vm_add_matrix(blueprint_context* ctx, const mat4* matrix) {
+    blueprint_vm* vm = &ctx->vm;
+    
+    if (vm->matrix_count >= vm->matrix_capacity) {
+        blueprint_log_debug(ctx, "Matrix pool exhausted");
+        return 0; // Identity
+    }
+    
+    vm->matrices[vm->matrix_count] = *matrix;
+    return vm->matrix_count++;
+}
+
+mat4* blueprint_vm_get_matrix(blueprint_context* ctx, u32 index) {
+    blueprint_vm* vm = &ctx->vm;
+    return &vm->matrices[index < vm->matrix_count ? index : 0];
+}
+
+u32 blueprint_vm_add_string(blueprint_context* ctx, const char* str) {
+    blueprint_vm* vm = &ctx->vm;
+    u32 length = (u32)strlen(str) + 1;
+    
+    if (vm->string_used + length > vm->string_capacity) {
+        blueprint_log_debug(ctx, "String pool exhausted");
+        return 0; // Empty string
+    }
+    
+    u32 index = vm->string_used;
+    memcpy(vm->strings + index, str, length);
+    vm->string_used += length;
+    return index;
+}
+
+const char* blueprint_vm_get_string(blueprint_context* ctx, u32 index) {
+    blueprint_vm* vm = &ctx->vm;
+    return vm->strings + (index < vm->string_used ? index : 0);
+}
+
 // ============================================================================
 // DEBUG FUNCTIONS
 // ============================================================================
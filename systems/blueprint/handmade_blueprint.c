@@ -40,7 +40,7 @@ static void blueprint_init_type_system(blueprint_context* ctx) {
         .is_primitive = true, .is_numeric = true
     };
     types[BP_TYPE_STRING] = (blueprint_type_info){
-        .type = BP_TYPE_STRING, .size = sizeof(char*), .alignment = 8,
+        .type = BP_TYPE_STRING, .size = sizeof(u32), .alignment = 4,
         .is_primitive = false, .is_numeric = false
     };
     
@@ -62,7 +62,7 @@ static void blueprint_init_type_system(blueprint_context* ctx) {
         .is_primitive = true, .is_numeric = true
     };
     types[BP_TYPE_MATRIX] = (blueprint_type_info){
-        .type = BP_TYPE_MATRIX, .size = sizeof(mat4), .alignment = 16,
+        .type = BP_TYPE_MATRIX, .size = sizeof(u32), .alignment = 4,
         .is_primitive = true, .is_numeric = true
     };
     
@@ -172,6 +172,17 @@ static void blueprint_sort_nodes(blueprint_graph* graph) {
     // TODO: Implement quicksort for larger arrays
 }
 
+// Drops one connection from a pin's count when a connection goes away
+static void blueprint_release_pin_connection(blueprint_graph* graph, node_id node, pin_id pin) {
+    blueprint_node* owner = blueprint_get_node(graph, node);
+    blueprint_pin* connected = owner ? blueprint_get_pin(owner, pin) : NULL;
+    
+    if (connected && connected->connection_count > 0) {
+        connected->connection_count--;
+        connected->has_connection = (connected->connection_count > 0);
+    }
+}
+
 // ============================================================================
 // CORE SYSTEM IMPLEMENTATION
 // ============================================================================
@@ -203,11 +214,31 @@ void blueprint_init(blueprint_context* ctx, gui_context* gui, renderer* r, platf
     
     // Initialize VM
     blueprint_vm* vm = &ctx->vm;
-    vm->value_stack_size = 4096;
-    vm->value_stack = (blueprint_value*)blueprint_pool_alloc(ctx,
-        sizeof(blueprint_value) * vm->value_stack_size,
+    vm->register_capacity = BLUEPRINT_MAX_REGISTERS;
+    vm->registers = (blueprint_value*)blueprint_pool_alloc(ctx,
+        sizeof(blueprint_value) * vm->register_capacity,
         alignof(blueprint_value));
     
+    // Side pools - slot 0 is the identity matrix and the empty string so
+    // zeroed registers are always valid references
+    vm->matrix_capacity = BLUEPRINT_MAX_MATRICES;
+    vm->matrices = (mat4*)blueprint_pool_alloc(ctx,
+        sizeof(mat4) * vm->matrix_capacity,
+        alignof(mat4));
+    if (vm->matrices) {
+        memset(&vm->matrices[0], 0, sizeof(mat4));
+        vm->matrices[0].m[0] = vm->matrices[0].m[5] = 1.0f;
+        vm->matrices[0].m[10] = vm->matrices[0].m[15] = 1.0f;
+        vm->matrix_count = 1;
+    }
+    
+    vm->string_capacity = BLUEPRINT_STRING_POOL_SIZE;
+    vm->strings = (char*)blueprint_pool_alloc(ctx, vm->string_capacity, 1);
+    if (vm->strings) {
+        vm->strings[0] = '\0';
+        vm->string_used = 1;
+    }
+    
     vm->call_stack_size = BLUEPRINT_MAX_STACK_DEPTH;
     vm->call_stack = (bp_stack_frame*)blueprint_pool_alloc(ctx,
         sizeof(bp_stack_frame) * vm->call_stack_size,
@@ -218,15 +249,16 @@ void blueprint_init(blueprint_context* ctx, gui_context* gui, renderer* r, platf
         sizeof(blueprint_value) * vm->local_count,
         alignof(blueprint_value));
     
-    vm->constant_count = BLUEPRINT_MAX_CONSTANTS;
-    vm->constants = (blueprint_value*)blueprint_pool_alloc(ctx,
-        sizeof(blueprint_value) * vm->constant_count,
-        alignof(blueprint_value));
-    
     vm->breakpoint_count = 0;
     vm->breakpoints = (u32*)blueprint_pool_alloc(ctx,
         sizeof(u32) * BLUEPRINT_MAX_BREAKPOINTS,
         alignof(u32));
+    vm->breakpoint_displaced = (bp_instruction*)blueprint_pool_alloc(ctx,
+        sizeof(bp_instruction) * BLUEPRINT_MAX_BREAKPOINTS,
+        alignof(bp_instruction));
+    vm->breakpoint_addresses = (u32*)blueprint_pool_alloc(ctx,
+        sizeof(u32) * BLUEPRINT_MAX_BREAKPOINTS,
+        alignof(u32));
     
     // Initialize editor state
     editor_state* editor = &ctx->editor;
@@ -418,6 +450,7 @@ blueprint_node* blueprint_create_node(blueprint_graph* graph, node_type type, v2
     strcpy(node->display_name, node->name);
     
     // Mark graph for recompilation
+    node->flags |= NODE_FLAG_DIRTY;
     graph->needs_recompile = true;
     
     // Re-sort nodes to maintain sorted order for fast lookup
@@ -444,6 +477,9 @@ void blueprint_destroy_node(blueprint_graph* graph, node_id id) {
     for (u32 i = 0; i < graph->connection_count; ) {
         blueprint_connection* conn = &graph->connections[i];
         if (conn->from_node == id || conn->to_node == id) {
+            blueprint_release_pin_connection(graph, conn->from_node, conn->from_pin);
+            blueprint_release_pin_connection(graph, conn->to_node, conn->to_pin);
+            
             // Move last connection to this position
             if (i < graph->connection_count - 1) {
                 graph->connections[i] = graph->connections[graph->connection_count - 1];
@@ -475,7 +511,9 @@ void blueprint_destroy_node(blueprint_graph* graph, node_id id) {
     // Re-sort to maintain order
     blueprint_sort_nodes(graph);
     
+    // Node indices moved, nothing compiled can be kept
     graph->needs_recompile = true;
+    graph->needs_full_recompile = true;
 }
 
 blueprint_node* blueprint_get_node(blueprint_graph* graph, node_id id) {
@@ -493,6 +531,16 @@ void blueprint_move_node(blueprint_graph* graph, node_id id, v2 new_position) {
     }
 }
 
+// Pin value and pin edits outside the connection API must call this so the
+// next compile regenerates the node
+void blueprint_mark_node_dirty(blueprint_graph* graph, node_id id) {
+    blueprint_node* node = blueprint_get_node(graph, id);
+    if (node) {
+        node->flags |= NODE_FLAG_DIRTY;
+    }
+    graph->needs_recompile = true;
+}
+
 // ============================================================================
 // PIN MANAGEMENT
 // ============================================================================
@@ -578,15 +626,37 @@ connection_id blueprint_create_connection(blueprint_graph* graph, node_id from_n
     conn->thickness = 2.0f;
     conn->is_valid = true;
     
-    // TODO: Validate connection and set data_type
+    // The connection carries the source pin type - the compiler splits
+    // execution flow from data flow on it
+    // TODO: Validate connection
+    blueprint_node* source = blueprint_get_node(graph, from_node);
+    blueprint_node* target = blueprint_get_node(graph, to_node);
+    blueprint_pin* source_pin = source ? blueprint_get_pin(source, from_pin) : NULL;
+    blueprint_pin* target_pin = target ? blueprint_get_pin(target, to_pin) : NULL;
+    
+    if (source_pin) {
+        conn->data_type = source_pin->type;
+        source_pin->has_connection = true;
+        source_pin->connection_count++;
+    }
+    if (target_pin) {
+        target_pin->has_connection = true;
+        target_pin->connection_count++;
+    }
     
-    graph->needs_recompile = true;
+    blueprint_mark_node_dirty(graph, from_node);
+    blueprint_mark_node_dirty(graph, to_node);
     return conn->id;
 }
 
 void blueprint_destroy_connection(blueprint_graph* graph, connection_id id) {
     for (u32 i = 0; i < graph->connection_count; i++) {
         if (graph->connections[i].id == id) {
+            blueprint_release_pin_connection(graph, graph->connections[i].from_node, graph->connections[i].from_pin);
+            blueprint_release_pin_connection(graph, graph->connections[i].to_node, graph->connections[i].to_pin);
+            blueprint_mark_node_dirty(graph, graph->connections[i].from_node);
+            blueprint_mark_node_dirty(graph, graph->connections[i].to_node);
+            
             // Move last connection to this position
             if (i < graph->connection_count - 1) {
                 graph->connections[i] = graph->connections[graph->connection_count - 1];
@@ -685,12 +755,12 @@ u32 blueprint_type_size(blueprint_type type) {
         case BP_TYPE_BOOL: return sizeof(b32);
         case BP_TYPE_INT: return sizeof(i32);
         case BP_TYPE_FLOAT: return sizeof(f32);
-        case BP_TYPE_STRING: return sizeof(char*);
+        case BP_TYPE_STRING: return sizeof(u32);  // Index into the string pool
         case BP_TYPE_VEC2: return sizeof(v2);
         case BP_TYPE_VEC3: return sizeof(v3);
         case BP_TYPE_VEC4: return sizeof(v4);
         case BP_TYPE_QUAT: return sizeof(quat);
-        case BP_TYPE_MATRIX: return sizeof(mat4);
+        case BP_TYPE_MATRIX: return sizeof(u32);  // Index into the matrix pool
         case BP_TYPE_ENTITY: return sizeof(void*);
         case BP_TYPE_COMPONENT: return sizeof(void*);
         case BP_TYPE_TRANSFORM: return sizeof(void*);
@@ -34,6 +34,9 @@ typedef u32 color32;
 typedef struct mat4 { f32 m[16]; } mat4;
 #define BLUEPRINT_MAX_CONSTANTS 16384
 #define BLUEPRINT_MAX_LOCALS 1024
+#define BLUEPRINT_MAX_REGISTERS 65536
+#define BLUEPRINT_MAX_MATRICES 4096
+#define BLUEPRINT_STRING_POOL_SIZE 262144  // 256KB string pool
 
 // ============================================================================
 // TYPE SYSTEM
@@ -78,21 +81,24 @@ typedef struct blueprint_type_info {
 } blueprint_type_info;
 
 // Value storage - union for different types
-// PERFORMANCE: 64-byte aligned for SIMD operations
+// PERFORMANCE: 16 bytes, one VM register slot. Scalars and vectors live inline,
+// matrices and strings live in the VM side pools and are referenced by index
 typedef union blueprint_value {
     b32 bool_val;
     i32 int_val;
     f32 float_val;
-    char* string_val;
+    u32 string_index;    // Offset into vm.strings
     v2 vec2_val;
     v3 vec3_val;
     v4 vec4_val;
     quat quat_val;
-    mat4 matrix_val;
+    u32 matrix_index;    // Index into vm.matrices
     void* ptr_val;       // For entity/component references
-    u64 raw[8];          // Raw data for SIMD processing
+    u64 raw[2];          // Raw data for SIMD processing
 } blueprint_value;
 
+typedef char blueprint_value_size_check[(sizeof(blueprint_value) == 16) ? 1 : -1];
+
 // ============================================================================
 // PIN SYSTEM
 // ============================================================================
@@ -130,6 +136,7 @@ typedef struct blueprint_pin {
     blueprint_value current_value;
     b32 has_connection;
     u32 connection_count;
+    u32 register_index;  // VM register assigned by the compiler
 } blueprint_pin;
 
 // ============================================================================
@@ -231,6 +238,7 @@ typedef enum node_flags {
     NODE_FLAG_SELECTED = (1 << 6),    // Selected in editor
     NODE_FLAG_ERROR = (1 << 7),       // Has validation error
     NODE_FLAG_VARIADIC_INPUTS = (1 << 8),  // Can have variable input count
+    NODE_FLAG_DIRTY = (1 << 9),       // Changed since the last compile
 } node_flags;
 
 typedef u32 node_id;
@@ -261,6 +269,7 @@ typedef struct blueprint_node {
     // Execution
     node_exec_func execute;
     void* user_data;
+    u32 bytecode_address;  // Start of the node's block, assigned by the compiler
     
     // Validation
     char error_message[256];
@@ -358,6 +367,20 @@ typedef struct blueprint_graph {
     u8* bytecode;
     u32 bytecode_size;
     
+    // Incremental compilation - edits flag nodes NODE_FLAG_DIRTY and only
+    // the code reading them is regenerated, appended behind the program
+    b32 needs_full_recompile;
+    u32 compiled_node_count;   // Nodes present at the last compile
+    u32 full_bytecode_count;   // Instructions after the last full compile
+    u32 full_register_count;
+    u32 sink_block_address;    // Unread pure nodes, called before the entries
+    
+    // Register file image - constants in place, temporaries zeroed
+    blueprint_value* register_image;
+    u8* register_types;  // blueprint_type per register
+    u32 register_count;
+    u32 register_capacity;
+    
     // Performance tracking
     f64 last_execution_time;
     u64 total_executions;
@@ -367,37 +390,40 @@ typedef struct blueprint_graph {
 // VIRTUAL MACHINE
 // ============================================================================
 
-// Bytecode instruction set
+// Bytecode instruction set - three-address register form, operands are
+// register indices unless noted. Arithmetic is typed by the destination
+// register, comparisons by the first source register.
 typedef enum bp_opcode {
     BP_OP_NOP = 0,
-    BP_OP_LOAD_CONST,     // Load constant to stack
-    BP_OP_LOAD_VAR,       // Load variable to stack
-    BP_OP_STORE_VAR,      // Store stack top to variable
-    BP_OP_LOAD_PIN,       // Load pin value to stack
-    BP_OP_STORE_PIN,      // Store stack top to pin
-    BP_OP_CALL,           // Call function
-    BP_OP_CALL_NATIVE,    // Call native function
-    BP_OP_JUMP,           // Unconditional jump
-    BP_OP_JUMP_IF_FALSE,  // Conditional jump
+    BP_OP_MOVE,           // dst, src
+    BP_OP_LOAD_VAR,       // dst, variable index
+    BP_OP_STORE_VAR,      // variable index, src
+    BP_OP_LOAD_PIN,       // dst, pin
+    BP_OP_STORE_PIN,      // pin, src
+    BP_OP_CALL,           // Call function at address
+    BP_OP_CALL_NATIVE,    // native index, dst, arg
+    BP_OP_JUMP,           // address
+    BP_OP_JUMP_IF_FALSE,  // address, condition
     BP_OP_RETURN,         // Return from function
-    BP_OP_ADD,            // Arithmetic operations
+    BP_OP_ADD,            // Arithmetic operations: dst, a, b
     BP_OP_SUB,
     BP_OP_MUL,
     BP_OP_DIV,
     BP_OP_MOD,
-    BP_OP_NEG,
-    BP_OP_EQUALS,         // Comparison operations
+    BP_OP_NEG,            // dst, a
+    BP_OP_EQUALS,         // Comparison operations: dst, a, b
     BP_OP_NOT_EQUALS,
     BP_OP_LESS,
     BP_OP_LESS_EQUAL,
     BP_OP_GREATER,
     BP_OP_GREATER_EQUAL,
-    BP_OP_AND,            // Logical operations
+    BP_OP_AND,            // Logical operations: dst, a, b
     BP_OP_OR,
-    BP_OP_NOT,
-    BP_OP_CAST,           // Type casting
+    BP_OP_NOT,            // dst, a
+    BP_OP_CAST,           // dst, src - types from the register types
     BP_OP_BREAK,          // Debug breakpoint
     BP_OP_HALT,           // Stop execution
+    BP_OP_BREAKPOINT,     // Patched-in trap: breakpoint slot holding the displaced instruction
     
     BP_OP_COUNT
 } bp_opcode;
@@ -421,10 +447,20 @@ typedef struct blueprint_vm {
     u32 bytecode_size;
     u32 program_counter;
     
-    // Stack for values
-    blueprint_value* value_stack;
-    u32 value_stack_size;
-    u32 value_stack_top;
+    // Register file - one slot per output pin and input constant
+    // PERFORMANCE: Operands are addressed in place, no push/pop copies
+    blueprint_value* registers;
+    u8* register_types;       // Owned by the executing graph
+    u32 register_count;
+    u32 register_capacity;
+    
+    // Side pools for values that do not fit a register
+    mat4* matrices;
+    u32 matrix_count;
+    u32 matrix_capacity;
+    char* strings;
+    u32 string_used;
+    u32 string_capacity;
     
     // Call stack
     bp_stack_frame* call_stack;
@@ -435,18 +471,17 @@ typedef struct blueprint_vm {
     blueprint_value* locals;
     u32 local_count;
     
-    // Constants
-    blueprint_value* constants;
-    u32 constant_count;
-    
     // Execution control
     b32 is_running;
     b32 is_paused;
     b32 single_step;
     
-    // Breakpoints
+    // Breakpoints - node IDs, patched into the bytecode as traps while the
+    // debug loop runs
     u32* breakpoints;
     u32 breakpoint_count;
+    bp_instruction* breakpoint_displaced;  // Instruction under each trap
+    u32* breakpoint_addresses;             // Patched address per breakpoint
     
     // Performance counters
     u64 instructions_executed;
@@ -588,9 +623,16 @@ b32 blueprint_can_connect_pins(blueprint_pin* from_pin, blueprint_pin* to_pin);
 
 // Execution
 void blueprint_compile_graph(blueprint_context* ctx, blueprint_graph* graph);
+void blueprint_mark_node_dirty(blueprint_graph* graph, node_id id);
 void blueprint_execute_graph(blueprint_context* ctx, blueprint_graph* graph);
 void blueprint_execute_node(blueprint_context* ctx, blueprint_node* node);
 
+// VM side pools - values referenced by index from a register
+u32 blueprint_vm_add_matrix(blueprint_context* ctx, const mat4* matrix);
+mat4* blueprint_vm_get_matrix(blueprint_context* ctx, u32 index);
+u32 blueprint_vm_add_string(blueprint_context* ctx, const char* str);
+const char* blueprint_vm_get_string(blueprint_context* ctx, u32 index);
+
 // Validation
 b32 blueprint_validate_graph(blueprint_graph* graph, char* error_buffer, u32 buffer_size);
 b32 blueprint_validate_node(blueprint_node* node, char* error_buffer, u32 buffer_size);
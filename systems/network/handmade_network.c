@@ -15,6 +15,8 @@
 #include <stddef.h>
 #include <math.h>
 
+#include <pthread.h>
+
 #ifdef PLATFORM_LINUX
 #include <sys/epoll.h>
 #include <poll.h>
@@ -64,6 +66,7 @@ bool net_init(network_context_t* ctx, uint16_t port, bool is_server) {
     ctx->port = port;
     ctx->is_server = is_server;
     ctx->current_time = net_get_time_ms();
+    ctx->simulated_loss_seed = (uint32_t)ctx->current_time ^ ((uint32_t)port << 16);
     ctx->enable_prediction = true;
     ctx->enable_interpolation = true;
     ctx->enable_compression = true;
@@ -121,6 +124,8 @@ bool net_init(network_context_t* ctx, uint16_t port, bool is_server) {
 
 // Shutdown network
 void net_shutdown(network_context_t* ctx) {
+    net_server_stop_workers(ctx);
+    
     if (ctx->socket != INVALID_SOCKET_VALUE) {
         // Send disconnect to all connections
         for (uint32_t i = 0; i < NET_MAX_PLAYERS; i++) {
@@ -139,10 +144,156 @@ void net_shutdown(network_context_t* ctx) {
     }
 }
 
+// Wrap-aware sequence comparison (a is newer than b)
+static inline bool sequence_greater_than(uint16_t a, uint16_t b) {
+    return ((a > b) && (a - b <= 32768)) ||
+           ((a < b) && (b - a > 32768));
+}
+
+// Reset sequence rings, reliable pool and retransmit wheel
+static void connection_reset_reliability(connection_t* conn, uint64_t current_time) {
+    for (uint32_t i = 0; i < NET_MAX_PENDING_RELIABLE; i++) {
+        conn->pending_reliable[i].in_use = false;
+        conn->pending_reliable[i].generation = 0;
+        conn->pending_reliable[i].wheel_slot = 0xFF;
+        conn->pending_reliable[i].next = (i + 1 < NET_MAX_PENDING_RELIABLE) ?
+                                         (uint16_t)(i + 1) : NET_INVALID_INDEX;
+    }
+    conn->pending_free_head = 0;
+    conn->pending_reliable_count = 0;
+    
+    for (uint32_t i = 0; i < NET_SEQUENCE_BUFFER_SIZE; i++) {
+        conn->sent_packets[i].index = NET_INVALID_INDEX;
+        conn->received_sequences[i] = UINT32_MAX;
+        conn->received_messages[i] = UINT32_MAX;
+    }
+    conn->next_message_id = 0;
+    
+    for (uint32_t i = 0; i < NET_RETRANSMIT_WHEEL_SLOTS; i++) {
+        conn->retransmit_wheel[i] = NET_INVALID_INDEX;
+    }
+    conn->retransmit_wheel_tick = current_time / NET_RETRANSMIT_WHEEL_TICK_MS;
+    conn->srtt_ms = 0;
+    conn->rttvar_ms = 0;
+    conn->rto_ms = NET_RTO_INITIAL_MS;
+}
+
+// Schedule pending packet for retransmit at due_time
+// Due times past the wheel horizon are clamped to the last slot
+static void wheel_insert(connection_t* conn, uint16_t index, uint64_t due_time) {
+    uint64_t due_tick = due_time / NET_RETRANSMIT_WHEEL_TICK_MS;
+    if (due_tick <= conn->retransmit_wheel_tick) {
+        due_tick = conn->retransmit_wheel_tick + 1;
+    }
+    if (due_tick - conn->retransmit_wheel_tick >= NET_RETRANSMIT_WHEEL_SLOTS) {
+        due_tick = conn->retransmit_wheel_tick + NET_RETRANSMIT_WHEEL_SLOTS - 1;
+    }
+    
+    uint8_t slot = (uint8_t)(due_tick % NET_RETRANSMIT_WHEEL_SLOTS);
+    reliable_packet_t* packet = &conn->pending_reliable[index];
+    packet->wheel_slot = slot;
+    packet->prev = NET_INVALID_INDEX;
+    packet->next = conn->retransmit_wheel[slot];
+    if (packet->next != NET_INVALID_INDEX) {
+        conn->pending_reliable[packet->next].prev = index;
+    }
+    conn->retransmit_wheel[slot] = index;
+}
+
+static void wheel_remove(connection_t* conn, uint16_t index) {
+    reliable_packet_t* packet = &conn->pending_reliable[index];
+    if (packet->wheel_slot == 0xFF) {
+        return;
+    }
+    
+    if (packet->prev != NET_INVALID_INDEX) {
+        conn->pending_reliable[packet->prev].next = packet->next;
+    } else {
+        conn->retransmit_wheel[packet->wheel_slot] = packet->next;
+    }
+    if (packet->next != NET_INVALID_INDEX) {
+        conn->pending_reliable[packet->next].prev = packet->prev;
+    }
+    packet->wheel_slot = 0xFF;
+}
+
+static uint16_t reliable_alloc(connection_t* conn) {
+    uint16_t index = conn->pending_free_head;
+    if (index == NET_INVALID_INDEX) {
+        return NET_INVALID_INDEX;
+    }
+    
+    reliable_packet_t* packet = &conn->pending_reliable[index];
+    conn->pending_free_head = packet->next;
+    conn->pending_reliable_count++;
+    packet->in_use = true;
+    packet->retry_count = 0;
+    packet->wheel_slot = 0xFF;
+    return index;
+}
+
+static void reliable_release(connection_t* conn, uint16_t index) {
+    reliable_packet_t* packet = &conn->pending_reliable[index];
+    wheel_remove(conn, index);
+    
+    // Ring entries of every earlier transmission go stale with the generation
+    packet->generation++;
+    packet->in_use = false;
+    packet->next = conn->pending_free_head;
+    conn->pending_free_head = index;
+    conn->pending_reliable_count--;
+}
+
+// RFC 6298 style smoothed RTT in integer milliseconds
+static void update_retransmit_timeout(connection_t* conn, uint32_t rtt) {
+    if (conn->srtt_ms == 0) {
+        conn->srtt_ms = rtt;
+        conn->rttvar_ms = rtt / 2;
+    } else {
+        uint32_t delta = (conn->srtt_ms > rtt) ? conn->srtt_ms - rtt : rtt - conn->srtt_ms;
+        conn->rttvar_ms = (3 * conn->rttvar_ms + delta) / 4;
+        conn->srtt_ms = (7 * conn->srtt_ms + rtt) / 8;
+    }
+    
+    uint32_t variance = 4 * conn->rttvar_ms;
+    if (variance < NET_RETRANSMIT_WHEEL_TICK_MS) {
+        variance = NET_RETRANSMIT_WHEEL_TICK_MS;
+    }
+    
+    uint32_t rto = conn->srtt_ms + variance;
+    if (rto < NET_RTO_MIN_MS) rto = NET_RTO_MIN_MS;
+    if (rto > NET_RTO_MAX_MS) rto = NET_RTO_MAX_MS;
+    conn->rto_ms = rto;
+}
+
+// Handle ack for one of our sequences
+// PERFORMANCE: O(1) lookup through the sent sequence ring
+static void reliable_ack(network_context_t* ctx, connection_t* conn, uint16_t sequence) {
+    sent_packet_t* sent = &conn->sent_packets[sequence % NET_SEQUENCE_BUFFER_SIZE];
+    if (sent->index == NET_INVALID_INDEX || sent->sequence != sequence) {
+        return;
+    }
+    
+    reliable_packet_t* packet = &conn->pending_reliable[sent->index];
+    if (!packet->in_use || packet->generation != sent->generation) {
+        return;  // Already acked through another transmission
+    }
+    
+    conn->stats.packets_acked++;
+    
+    // Karn's rule: only the latest transmission gives an unambiguous sample
+    if (packet->sequence == sequence) {
+        uint64_t rtt = ctx->current_time - packet->send_time;
+        conn->rtt_samples[conn->rtt_sample_index % 32] = rtt;
+        conn->rtt_sample_index++;
+        update_retransmit_timeout(conn, (uint32_t)rtt);
+    }
+    
+    reliable_release(conn, sent->index);
+}
+
 // Find or create connection for address
-static uint32_t find_or_create_connection(network_context_t* ctx,
-                                         struct sockaddr_in* addr) {
-    // Look for existing connection
+static uint32_t find_connection(network_context_t* ctx, struct sockaddr_in* addr) {
     for (uint32_t i = 0; i < NET_MAX_PLAYERS; i++) {
         if (ctx->connections[i].state != CONN_DISCONNECTED &&
             ctx->connections[i].address.sin_addr.s_addr == addr->sin_addr.s_addr &&
@@ -151,6 +302,17 @@ static uint32_t find_or_create_connection(network_context_t* ctx,
         }
     }
     
+    return UINT32_MAX;
+}
+
+static uint32_t find_or_create_connection(network_context_t* ctx,
+                                         struct sockaddr_in* addr) {
+    // Look for existing connection
+    uint32_t existing = find_connection(ctx, addr);
+    if (existing != UINT32_MAX) {
+        return existing;
+    }
+    
     // Create new connection
     for (uint32_t i = 0; i < NET_MAX_PLAYERS; i++) {
         if (ctx->connections[i].state == CONN_DISCONNECTED) {
@@ -160,6 +322,8 @@ static uint32_t find_or_create_connection(network_context_t* ctx,
             conn->state = CONN_CONNECTING;
             conn->connect_time = ctx->current_time;
             conn->last_received_time = ctx->current_time;
+            conn->last_bandwidth_time = ctx->current_time;
+            connection_reset_reliability(conn, ctx->current_time);
             ctx->connection_count++;
             return i;
         }
@@ -168,6 +332,22 @@ static uint32_t find_or_create_connection(network_context_t* ctx,
     return UINT32_MAX;  // No space for new connection
 }
 
+// Per-connection xorshift for simulated loss
+// THREADING: Only the worker owning conn calls this, unlike rand()
+static uint32_t connection_loss_random(network_context_t* ctx, connection_t* conn) {
+    uint32_t x = conn->loss_random;
+    if (x == 0) {
+        uint32_t index = (uint32_t)(conn - ctx->connections);
+        x = ctx->simulated_loss_seed ^ ((index + 1) * 0x9E3779B9u);
+        if (x == 0) x = 0x9E3779B9u;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    conn->loss_random = x;
+    return x;
+}
+
 // Send raw packet
 static bool send_packet(network_context_t* ctx, connection_t* conn,
                        packet_header_t* header, const void* data) {
@@ -179,6 +359,9 @@ static bool send_packet(network_context_t* ctx, connection_t* conn,
     header->ack = conn->remote_sequence;
     header->ack_bits = conn->remote_ack_bits;
     
+    // Reclaim the sent ring slot; reliable senders re-point it after sending
+    conn->sent_packets[header->sequence % NET_SEQUENCE_BUFFER_SIZE].index = NET_INVALID_INDEX;
+    
     // Copy header and data
     memcpy(packet, header, sizeof(packet_header_t));
     if (data && header->payload_size > 0) {
@@ -194,7 +377,7 @@ static bool send_packet(network_context_t* ctx, connection_t* conn,
     
     // Simulate packet loss if configured
     if (ctx->simulated_packet_loss > 0) {
-        if ((rand() % 100) < (int)(ctx->simulated_packet_loss * 100)) {
+        if ((connection_loss_random(ctx, conn) % 100) < (uint32_t)(ctx->simulated_packet_loss * 100)) {
             conn->stats.packets_lost++;
             return true;  // Pretend we sent it
         }
@@ -241,10 +424,63 @@ bool net_send_unreliable(network_context_t* ctx, uint32_t player_id,
     return send_packet(ctx, conn, &header, data);
 }
 
+// Send (or resend) a pooled reliable packet under a fresh sequence
+// Old transmissions keep their ring entries, so acks for any of them count
+static bool reliable_transmit(network_context_t* ctx, connection_t* conn,
+                              uint16_t index) {
+    reliable_packet_t* packet = &conn->pending_reliable[index];
+    
+    packet_header_t header = {0};
+    header.type = packet->type;
+    header.fragment_id = packet->fragment_id;
+    header.fragment_count = packet->fragment_count;
+    header.fragment_index = packet->fragment_index;
+    header.payload_size = packet->size;
+    header.message_id = packet->message_id;
+    bool sent = send_packet(ctx, conn, &header, packet->data);
+    
+    packet->sequence = header.sequence;
+    packet->send_time = ctx->current_time;
+    
+    sent_packet_t* entry = &conn->sent_packets[header.sequence % NET_SEQUENCE_BUFFER_SIZE];
+    entry->sequence = header.sequence;
+    entry->index = index;
+    entry->generation = packet->generation;
+    
+    return sent;
+}
+
+// Copy one message (or fragment) into a pool slot, send it and schedule
+// its retransmit one RTO from now
+static bool reliable_queue(network_context_t* ctx, connection_t* conn,
+                           const void* data, uint16_t size, uint8_t type,
+                           uint8_t fragment_id, uint8_t fragment_count,
+                           uint8_t fragment_index) {
+    uint16_t index = reliable_alloc(conn);
+    if (index == NET_INVALID_INDEX) {
+        return false;  // Queue full
+    }
+    
+    reliable_packet_t* packet = &conn->pending_reliable[index];
+    memcpy(packet->data, data, size);
+    packet->size = size;
+    packet->type = type;
+    packet->fragment_id = fragment_id;
+    packet->fragment_count = fragment_count;
+    packet->fragment_index = fragment_index;
+    packet->message_id = conn->next_message_id++;
+    
+    bool sent = reliable_transmit(ctx, conn, index);
+    wheel_insert(conn, index, ctx->current_time + conn->rto_ms);
+    return sent;
+}
+
 // Send reliable packet
+// Messages above NET_MAX_FRAGMENT_SIZE go out as fragments, each one a
+// separately acked and retransmitted pool entry
 bool net_send_reliable(network_context_t* ctx, uint32_t player_id,
                       const void* data, uint16_t size) {
-    if (player_id >= NET_MAX_PLAYERS || size > NET_MAX_PAYLOAD_SIZE) {
+    if (player_id >= NET_MAX_PLAYERS || size > NET_MAX_MESSAGE_SIZE) {
         return false;
     }
     
@@ -253,64 +489,34 @@ bool net_send_reliable(network_context_t* ctx, uint32_t player_id,
         return false;
     }
     
-    // Check if we need to fragment
-    if (size > NET_MAX_FRAGMENT_SIZE) {
-        uint8_t fragment_count = (size + NET_MAX_FRAGMENT_SIZE - 1) / NET_MAX_FRAGMENT_SIZE;
-        if (fragment_count > NET_MAX_FRAGMENTS) {
-            return false;
-        }
-        
-        static uint8_t fragment_id = 0;
-        fragment_id++;
-        
-        const uint8_t* bytes = (const uint8_t*)data;
-        for (uint8_t i = 0; i < fragment_count; i++) {
-            uint16_t fragment_size = (i == fragment_count - 1) ?
-                                    (size % NET_MAX_FRAGMENT_SIZE) :
-                                    NET_MAX_FRAGMENT_SIZE;
-            
-            packet_header_t header = {0};
-            header.type = PACKET_FRAGMENT;
-            header.fragment_id = fragment_id;
-            header.fragment_count = fragment_count;
-            header.fragment_index = i;
-            header.payload_size = fragment_size;
-            
-            if (!send_packet(ctx, conn, &header, bytes + i * NET_MAX_FRAGMENT_SIZE)) {
-                return false;
-            }
-        }
-        
-        return true;
+    if (size <= NET_MAX_FRAGMENT_SIZE) {
+        return reliable_queue(ctx, conn, data, size, PACKET_RELIABLE_ORDERED, 0, 0, 0);
     }
     
-    // Add to pending reliable queue
-    if (conn->pending_reliable_count >= NET_MAX_PENDING_RELIABLE) {
+    uint8_t fragment_count = (size + NET_MAX_FRAGMENT_SIZE - 1) / NET_MAX_FRAGMENT_SIZE;
+    
+    // All or nothing: a message missing fragments could never be reassembled
+    if (NET_MAX_PENDING_RELIABLE - conn->pending_reliable_count < fragment_count) {
         return false;  // Queue full
     }
     
-    uint32_t index = conn->pending_reliable_count++;
-    conn->pending_reliable[index].sequence = conn->local_sequence;
-    conn->pending_reliable[index].size = size;
-    conn->pending_reliable[index].send_time = ctx->current_time;
-    conn->pending_reliable[index].retry_count = 0;
+    uint8_t fragment_id = conn->next_fragment_id++;
+    const uint8_t* bytes = (const uint8_t*)data;
+    bool sent = true;
     
-    // Allocate from memory pool
-    if (ctx->packet_memory_used + size > sizeof(ctx->packet_memory_pool)) {
-        conn->pending_reliable_count--;
-        return false;  // Out of memory
+    for (uint8_t i = 0; i < fragment_count; i++) {
+        uint16_t fragment_size = (i == fragment_count - 1) ?
+                                (uint16_t)(size - i * NET_MAX_FRAGMENT_SIZE) :
+                                NET_MAX_FRAGMENT_SIZE;
+        
+        if (!reliable_queue(ctx, conn, bytes + i * NET_MAX_FRAGMENT_SIZE,
+                            fragment_size, PACKET_FRAGMENT,
+                            fragment_id, fragment_count, i)) {
+            sent = false;
+        }
     }
     
-    conn->pending_reliable[index].data = ctx->packet_memory_pool + ctx->packet_memory_used;
-    memcpy(conn->pending_reliable[index].data, data, size);
-    ctx->packet_memory_used += size;
-    
-    // Send immediately
-    packet_header_t header = {0};
-    header.type = PACKET_RELIABLE_ORDERED;
-    header.payload_size = size;
-    
-    return send_packet(ctx, conn, &header, data);
+    return sent;
 }
 
 // Broadcast to all connected players
@@ -328,45 +534,128 @@ bool net_broadcast(network_context_t* ctx, const void* data, uint16_t size) {
     return success;
 }
 
+// Copy into receive ring, wrapping at the end of the buffer
+static void recv_buffer_write(connection_t* conn, const void* data, uint32_t size) {
+    uint32_t index = conn->recv_head % NET_RECV_BUFFER_SIZE;
+    uint32_t first = NET_RECV_BUFFER_SIZE - index;
+    if (first > size) {
+        first = size;
+    }
+    
+    memcpy(conn->recv_buffer + index, data, first);
+    memcpy(conn->recv_buffer, (const uint8_t*)data + first, size - first);
+    conn->recv_head += size;
+}
+
+// Check space for a message and write its size prefix
+static bool recv_buffer_reserve(connection_t* conn, uint16_t size) {
+    uint32_t space = NET_RECV_BUFFER_SIZE - (conn->recv_head - conn->recv_tail);
+    if (space < size + sizeof(uint16_t)) {
+        return false;
+    }
+    
+    recv_buffer_write(conn, &size, sizeof(uint16_t));
+    return true;
+}
+
+// Store fragment and deliver message once its group is complete
+// Groups live in slot fragment_id % NET_MAX_FRAGMENT_GROUPS, so several
+// fragmented messages can be in flight at once
+static void process_fragment(network_context_t* ctx, connection_t* conn,
+                             packet_header_t* header, const void* data) {
+    if (header->fragment_count == 0 ||
+        header->fragment_count > NET_MAX_FRAGMENTS ||
+        header->fragment_index >= header->fragment_count ||
+        header->payload_size > NET_MAX_FRAGMENT_SIZE) {
+        return;
+    }
+    
+    fragment_assembly_t* group =
+        &conn->fragment_assembly[header->fragment_id % NET_MAX_FRAGMENT_GROUPS];
+    
+    if (!group->active ||
+        group->fragment_id != header->fragment_id ||
+        group->total_fragments != header->fragment_count) {
+        // New group claims the slot, dropping any stale partial message
+        group->active = true;
+        group->fragment_id = header->fragment_id;
+        group->total_fragments = header->fragment_count;
+        group->received_mask = 0;
+        group->timestamp = ctx->current_time;
+    }
+    
+    uint16_t bit = (uint16_t)(1u << header->fragment_index);
+    if (group->received_mask & bit) {
+        return;  // Duplicate fragment
+    }
+    
+    memcpy(group->fragments[header->fragment_index], data, header->payload_size);
+    group->fragment_sizes[header->fragment_index] = header->payload_size;
+    group->received_mask |= bit;
+    
+    // Check if all fragments received
+    if (group->received_mask != (uint16_t)((1u << group->total_fragments) - 1)) {
+        return;
+    }
+    
+    // Reassemble straight into the receive ring
+    uint32_t total_size = 0;
+    for (uint8_t i = 0; i < group->total_fragments; i++) {
+        total_size += group->fragment_sizes[i];
+    }
+    
+    if (recv_buffer_reserve(conn, (uint16_t)total_size)) {
+        for (uint8_t i = 0; i < group->total_fragments; i++) {
+            recv_buffer_write(conn, group->fragments[i], group->fragment_sizes[i]);
+        }
+    }
+    
+    group->active = false;
+}
+
 // Process received packet
-static void process_packet(network_context_t* ctx, uint32_t player_id,
+// Returns false for duplicates, which carry nothing new for the application
+static bool process_packet(network_context_t* ctx, uint32_t player_id,
                           packet_header_t* header, const void* data) {
     connection_t* conn = &ctx->connections[player_id];
-    
-    // Update sequence tracking
-    conn->remote_sequence = header->sequence;
     conn->last_received_time = ctx->current_time;
     
-    // Track received sequences for duplicate detection
-    conn->received_sequences[conn->sequence_index % NET_SEQUENCE_BUFFER_SIZE] = header->sequence;
-    conn->sequence_index++;
+    // Drop duplicates (sequence already recorded in its ring slot)
+    uint32_t slot = header->sequence % NET_SEQUENCE_BUFFER_SIZE;
+    if (conn->received_sequences[slot] == header->sequence) {
+        return false;
+    }
+    conn->received_sequences[slot] = header->sequence;
     
-    // Update ack bits
-    if (header->sequence > conn->remote_sequence) {
+    // Update ack bits relative to newest remote sequence
+    if (sequence_greater_than(header->sequence, conn->remote_sequence)) {
         uint16_t diff = header->sequence - conn->remote_sequence;
+        conn->remote_ack_bits = (diff < 32) ? (conn->remote_ack_bits << diff) | 1 : 1;
+        conn->remote_sequence = header->sequence;
+    } else {
+        uint16_t diff = conn->remote_sequence - header->sequence;
         if (diff < 32) {
-            conn->remote_ack_bits <<= diff;
-            conn->remote_ack_bits |= 1;
+            conn->remote_ack_bits |= 1u << diff;
         }
     }
     
     // Process acks for our sent packets
-    for (uint32_t i = 0; i < conn->pending_reliable_count; i++) {
-        if (conn->pending_reliable[i].sequence == header->ack ||
-            (header->ack_bits & (1 << (header->ack - conn->pending_reliable[i].sequence)))) {
-            // Packet was acked, remove from pending
-            conn->stats.packets_acked++;
-            
-            // Calculate RTT
-            uint64_t rtt = ctx->current_time - conn->pending_reliable[i].send_time;
-            conn->rtt_samples[conn->rtt_sample_index % 32] = rtt;
-            conn->rtt_sample_index++;
-            
-            // Remove from pending (swap with last)
-            conn->pending_reliable[i] = conn->pending_reliable[conn->pending_reliable_count - 1];
-            conn->pending_reliable_count--;
-            i--;
+    // PERFORMANCE: At most 32 ring lookups, independent of pending count
+    uint32_t ack_bits = header->ack_bits;
+    while (ack_bits) {
+        uint32_t bit = (uint32_t)__builtin_ctz(ack_bits);
+        reliable_ack(ctx, conn, (uint16_t)(header->ack - bit));
+        ack_bits &= ack_bits - 1;
+    }
+    
+    // A resend whose original was delivered but not yet acked arrives under
+    // a new sequence; its message id has already been recorded
+    if (header->type == PACKET_RELIABLE_ORDERED || header->type == PACKET_FRAGMENT) {
+        uint32_t message_slot = header->message_id % NET_SEQUENCE_BUFFER_SIZE;
+        if (conn->received_messages[message_slot] == header->message_id) {
+            return false;
         }
+        conn->received_messages[message_slot] = header->message_id;
     }
     
     // Handle packet based on type
@@ -395,7 +684,7 @@ static void process_packet(network_context_t* ctx, uint32_t player_id,
             
         case PACKET_DISCONNECT:
             conn->state = CONN_DISCONNECTED;
-            ctx->connection_count--;
+            __atomic_fetch_sub(&ctx->connection_count, 1, __ATOMIC_RELAXED);
             break;
             
         case PACKET_HEARTBEAT:
@@ -403,42 +692,7 @@ static void process_packet(network_context_t* ctx, uint32_t player_id,
             break;
             
         case PACKET_FRAGMENT:
-            // Assemble fragments
-            if (header->fragment_id != conn->fragment_assembly.fragment_id) {
-                // New fragment group
-                memset(&conn->fragment_assembly, 0, sizeof(fragment_assembly_t));
-                conn->fragment_assembly.fragment_id = header->fragment_id;
-                conn->fragment_assembly.total_fragments = header->fragment_count;
-                conn->fragment_assembly.timestamp = ctx->current_time;
-            }
-            
-            if (header->fragment_index < NET_MAX_FRAGMENTS) {
-                memcpy(conn->fragment_assembly.fragments[header->fragment_index],
-                       data, header->payload_size);
-                conn->fragment_assembly.fragment_sizes[header->fragment_index] = header->payload_size;
-                conn->fragment_assembly.received_mask |= (1 << header->fragment_index);
-                
-                // Check if all fragments received
-                if (conn->fragment_assembly.received_mask == 
-                    ((1 << conn->fragment_assembly.total_fragments) - 1)) {
-                    // Reassemble
-                    uint8_t reassembled[NET_MAX_FRAGMENTS * NET_MAX_FRAGMENT_SIZE];
-                    uint16_t total_size = 0;
-                    
-                    for (uint8_t i = 0; i < conn->fragment_assembly.total_fragments; i++) {
-                        memcpy(reassembled + total_size,
-                               conn->fragment_assembly.fragments[i],
-                               conn->fragment_assembly.fragment_sizes[i]);
-                        total_size += conn->fragment_assembly.fragment_sizes[i];
-                    }
-                    
-                    // Process reassembled packet
-                    // (Would call appropriate handler here)
-                    
-                    // Clear assembly buffer
-                    memset(&conn->fragment_assembly, 0, sizeof(fragment_assembly_t));
-                }
-            }
+            process_fragment(ctx, conn, header, data);
             break;
             
         case PACKET_INPUT:
@@ -449,22 +703,22 @@ static void process_packet(network_context_t* ctx, uint32_t player_id,
                 cmd.player_id = player_id;
                 memcpy(&cmd.input, data, sizeof(player_input_t));
                 
-                uint32_t index = ctx->input_head % NET_INPUT_BUFFER_SIZE;
-                ctx->input_buffer[index] = cmd;
-                ctx->input_head++;
+                // Server workers decode connections concurrently
+                uint32_t slot = __atomic_fetch_add(&ctx->input_head, 1, __ATOMIC_RELAXED);
+                ctx->input_buffer[slot % NET_INPUT_BUFFER_SIZE] = cmd;
             }
             break;
             
         case PACKET_SNAPSHOT:
         case PACKET_DELTA_SNAPSHOT:
-            // Store snapshot for rollback
-            if (header->payload_size <= sizeof(game_snapshot_t)) {
+            // Store snapshot for rollback (server is authoritative)
+            if (!ctx->is_server && header->payload_size <= sizeof(game_snapshot_t)) {
                 uint32_t index = ctx->snapshot_head % NET_SNAPSHOT_BUFFER_SIZE;
                 memcpy(&ctx->snapshots[index], data, header->payload_size);
                 ctx->snapshot_head++;
                 
                 // Update confirmed tick
-                game_snapshot_t* snap = (game_snapshot_t*)data;
+                game_snapshot_t* snap = &ctx->snapshots[index];
                 if (snap->tick > ctx->confirmed_tick) {
                     ctx->confirmed_tick = snap->tick;
                 }
@@ -495,36 +749,22 @@ static void process_packet(network_context_t* ctx, uint32_t player_id,
     // Add to receive buffer for application
     if (header->type == PACKET_UNRELIABLE || 
         header->type == PACKET_RELIABLE_ORDERED) {
-        uint32_t space = NET_RECV_BUFFER_SIZE - 
-                        (conn->recv_head - conn->recv_tail);
-        if (space >= header->payload_size + sizeof(uint16_t)) {
-            // Store size then data
-            uint32_t index = conn->recv_head % NET_RECV_BUFFER_SIZE;
-            memcpy(conn->recv_buffer + index, &header->payload_size, sizeof(uint16_t));
-            index = (index + sizeof(uint16_t)) % NET_RECV_BUFFER_SIZE;
-            memcpy(conn->recv_buffer + index, data, header->payload_size);
-            conn->recv_head += sizeof(uint16_t) + header->payload_size;
+        if (recv_buffer_reserve(conn, header->payload_size)) {
+            recv_buffer_write(conn, data, header->payload_size);
         }
     }
+    
+    return true;
 }
 
-// Receive packets
-bool net_receive(network_context_t* ctx, void* buffer, uint16_t* size,
-                uint32_t* from_player_id) {
-    uint8_t packet[NET_MAX_PACKET_SIZE];
-    struct sockaddr_in from_addr;
-    socklen_t addr_len = sizeof(from_addr);
-    
-    int received = recvfrom(ctx->socket, packet, sizeof(packet), 0,
-                          (struct sockaddr*)&from_addr, &addr_len);
-    
+// Validate protocol id and size of a received datagram
+static bool packet_header_valid(const uint8_t* packet, int received) {
     if (received < (int)sizeof(packet_header_t)) {
         return false;  // No packet or too small
     }
     
-    packet_header_t* header = (packet_header_t*)packet;
+    const packet_header_t* header = (const packet_header_t*)packet;
     
-    // Validate packet
     if (header->protocol_id != PROTOCOL_ID) {
         return false;  // Wrong protocol
     }
@@ -534,14 +774,35 @@ bool net_receive(network_context_t* ctx, void* buffer, uint16_t* size,
         return false;  // Invalid size
     }
     
-    // Verify checksum
+    return true;
+}
+
+// Verify CRC of a header-validated datagram
+static bool packet_checksum_valid(uint8_t* packet, int received) {
+    packet_header_t* header = (packet_header_t*)packet;
     uint16_t received_checksum = header->checksum;
     header->checksum = 0;
-    uint16_t calculated_checksum = net_checksum(packet, received);
-    if (received_checksum != calculated_checksum) {
-        return false;  // Corrupted packet
-    }
+    uint16_t calculated_checksum = net_checksum(packet, (uint16_t)received);
     header->checksum = received_checksum;
+    return received_checksum == calculated_checksum;
+}
+
+// Receive packets
+bool net_receive(network_context_t* ctx, void* buffer, uint16_t* size,
+                uint32_t* from_player_id) {
+    uint8_t packet[NET_MAX_PACKET_SIZE];
+    struct sockaddr_in from_addr;
+    socklen_t addr_len = sizeof(from_addr);
+    
+    int received = recvfrom(ctx->socket, packet, sizeof(packet), 0,
+                          (struct sockaddr*)&from_addr, &addr_len);
+    
+    if (!packet_header_valid(packet, received) ||
+        !packet_checksum_valid(packet, received)) {
+        return false;
+    }
+    
+    packet_header_t* header = (packet_header_t*)packet;
     
     // Find or create connection
     uint32_t player_id = find_or_create_connection(ctx, &from_addr);
@@ -553,13 +814,14 @@ bool net_receive(network_context_t* ctx, void* buffer, uint16_t* size,
     ctx->connections[player_id].stats.packets_received++;
     ctx->connections[player_id].stats.bytes_received += received;
     
-    // Process packet
-    process_packet(ctx, player_id, header, packet + sizeof(packet_header_t));
+    // Process packet; duplicates are consumed but return no data
+    bool fresh = process_packet(ctx, player_id, header, packet + sizeof(packet_header_t));
+    uint16_t payload_size = fresh ? header->payload_size : 0;
     
     // Return data to application
     if (from_player_id) *from_player_id = player_id;
-    if (size) *size = header->payload_size;
-    if (buffer && header->payload_size > 0) {
+    if (size) *size = payload_size;
+    if (buffer && payload_size > 0) {
         memcpy(buffer, packet + sizeof(packet_header_t), header->payload_size);
     }
     
@@ -617,6 +879,130 @@ void net_disconnect(network_context_t* ctx, uint32_t player_id) {
     ctx->connection_count--;
 }
 
+// Advance retransmit wheel to current time
+// PERFORMANCE: Only visits packets whose timers expired
+static void process_retransmits(network_context_t* ctx, connection_t* conn) {
+    uint64_t target_tick = ctx->current_time / NET_RETRANSMIT_WHEEL_TICK_MS;
+    uint32_t steps = 0;
+    
+    while (conn->retransmit_wheel_tick < target_tick) {
+        // After a stall longer than the horizon every slot has been visited
+        if (steps++ == NET_RETRANSMIT_WHEEL_SLOTS) {
+            conn->retransmit_wheel_tick = target_tick;
+            break;
+        }
+        
+        conn->retransmit_wheel_tick++;
+        uint32_t slot = conn->retransmit_wheel_tick % NET_RETRANSMIT_WHEEL_SLOTS;
+        uint16_t index = conn->retransmit_wheel[slot];
+        conn->retransmit_wheel[slot] = NET_INVALID_INDEX;
+        
+        while (index != NET_INVALID_INDEX) {
+            reliable_packet_t* packet = &conn->pending_reliable[index];
+            uint16_t next = packet->next;
+            packet->wheel_slot = 0xFF;
+            
+            if (packet->retry_count >= NET_MAX_RETRIES) {
+                // Give up
+                reliable_release(conn, index);
+            } else {
+                // Resend under a new sequence, same message id
+                packet->retry_count++;
+                reliable_transmit(ctx, conn, index);
+                
+                // Exponential backoff, clamped to the wheel horizon
+                uint64_t timeout = (uint64_t)conn->rto_ms << packet->retry_count;
+                if (timeout > NET_RTO_MAX_MS) timeout = NET_RTO_MAX_MS;
+                wheel_insert(conn, index, ctx->current_time + timeout);
+            }
+            
+            index = next;
+        }
+    }
+}
+
+// Timeouts, heartbeats, retransmits and stats for one connection
+// THREADING: Touches only this connection (and atomic context counters)
+static void update_connection(network_context_t* ctx, connection_t* conn) {
+    // Check for timeout
+    if (ctx->current_time - conn->last_received_time > NET_TIMEOUT_MS) {
+        conn->state = CONN_DISCONNECTED;
+        __atomic_fetch_sub(&ctx->connection_count, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    
+    // Send heartbeat if needed
+    if (ctx->current_time - conn->last_sent_time > NET_HEARTBEAT_INTERVAL_MS) {
+        packet_header_t header = {0};
+        header.type = PACKET_HEARTBEAT;
+        header.payload_size = 0;
+        send_packet(ctx, conn, &header, NULL);
+    }
+    
+    // Retry reliable packets whose timers expired
+    process_retransmits(ctx, conn);
+    
+    // Expire partially received fragment groups
+    for (uint32_t j = 0; j < NET_MAX_FRAGMENT_GROUPS; j++) {
+        fragment_assembly_t* group = &conn->fragment_assembly[j];
+        if (group->active &&
+            ctx->current_time - group->timestamp > NET_FRAGMENT_TIMEOUT_MS) {
+            group->active = false;
+        }
+    }
+    
+    // Update statistics
+    if (conn->rtt_sample_index > 0) {
+        uint64_t total_rtt = 0;
+        uint32_t count = (conn->rtt_sample_index < 32) ? 
+                       conn->rtt_sample_index : 32;
+        
+        for (uint32_t j = 0; j < count; j++) {
+            total_rtt += conn->rtt_samples[j];
+        }
+        
+        conn->stats.rtt_ms = (float)total_rtt / count;
+        
+        // Calculate jitter
+        float avg_rtt = conn->stats.rtt_ms;
+        float jitter_sum = 0;
+        for (uint32_t j = 0; j < count; j++) {
+            float diff = (float)conn->rtt_samples[j] - avg_rtt;
+            jitter_sum += diff * diff;
+        }
+        conn->stats.jitter_ms = sqrtf(jitter_sum / count);
+    }
+    
+    // Calculate packet loss
+    if (conn->stats.packets_sent > 0) {
+        conn->stats.packet_loss_percent = 
+            (float)conn->stats.packets_lost / conn->stats.packets_sent * 100.0f;
+    }
+    
+    // Calculate bandwidth
+    if (ctx->current_time - conn->last_bandwidth_time > 1000) {
+        conn->stats.bandwidth_up_kbps = 
+            (float)conn->stats.bytes_sent * 8.0f / 1024.0f;
+        conn->stats.bandwidth_down_kbps = 
+            (float)conn->stats.bytes_received * 8.0f / 1024.0f;
+        
+        // Reset counters
+        conn->stats.bytes_sent = 0;
+        conn->stats.bytes_received = 0;
+        conn->last_bandwidth_time = ctx->current_time;
+    }
+}
+
+static void advance_tick(network_context_t* ctx) {
+    if (ctx->current_time - ctx->last_tick_time >= NET_TICK_MS) {
+        ctx->current_tick++;
+        ctx->last_tick_time += NET_TICK_MS;
+        
+        // Process inputs for this tick
+        // (Game simulation would happen here)
+    }
+}
+
 // Update network state
 void net_update(network_context_t* ctx, uint64_t current_time_ms) {
     ctx->current_time = current_time_ms;
@@ -636,99 +1022,259 @@ void net_update(network_context_t* ctx, uint64_t current_time_ms) {
     for (uint32_t i = 0; i < NET_MAX_PLAYERS; i++) {
         connection_t* conn = &ctx->connections[i];
         
+        if (conn->state != CONN_DISCONNECTED) {
+            update_connection(ctx, conn);
+        }
+    }
+    
+    // Update simulation tick
+    advance_tick(ctx);
+}
+
+// Server worker pool
+// Connections are sharded statically (player_id % worker_count), so each
+// connection is only ever touched by one worker and results are deterministic.
+// Stages per tick:
+//   1. Caller thread drains the socket into per-connection inboxes
+//   2. Workers verify and decode their inboxes, run connection upkeep,
+//      then pack and send replication through the replicate callback
+typedef struct {
+    uint8_t packets[NET_WORKER_INBOX_PACKETS][NET_MAX_PACKET_SIZE];
+    uint16_t sizes[NET_WORKER_INBOX_PACKETS];
+    uint32_t count;
+} net_inbox_t;
+
+typedef struct {
+    struct net_server_workers* pool;
+    uint32_t index;
+} net_worker_arg_t;
+
+struct net_server_workers {
+    network_context_t* ctx;
+    pthread_t threads[NET_MAX_WORKERS];
+    net_worker_arg_t args[NET_MAX_WORKERS];
+    uint32_t worker_count;
+    
+    pthread_mutex_t mutex;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    uint32_t generation;
+    uint32_t workers_done;
+    bool shutting_down;
+    
+    // Current tick job
+    net_replicate_fn replicate;
+    void* user_data;
+    
+    net_inbox_t inboxes[NET_MAX_PLAYERS];
+    uint64_t inbox_dropped;
+};
+
+static void worker_process_connection(struct net_server_workers* pool,
+                                      uint32_t worker_index, uint32_t player_id) {
+    network_context_t* ctx = pool->ctx;
+    connection_t* conn = &ctx->connections[player_id];
+    net_inbox_t* inbox = &pool->inboxes[player_id];
+    
+    // Decode stage
+    for (uint32_t i = 0; i < inbox->count; i++) {
+        uint8_t* packet = inbox->packets[i];
+        int received = inbox->sizes[i];
+        
         if (conn->state == CONN_DISCONNECTED) {
-            continue;
+            break;
+        }
+        if (!packet_checksum_valid(packet, received)) {
+            continue;  // Corrupted packet
         }
         
-        // Check for timeout
-        if (ctx->current_time - conn->last_received_time > NET_TIMEOUT_MS) {
-            conn->state = CONN_DISCONNECTED;
-            ctx->connection_count--;
-            continue;
+        conn->stats.packets_received++;
+        conn->stats.bytes_received += received;
+        process_packet(ctx, player_id, (packet_header_t*)packet,
+                       packet + sizeof(packet_header_t));
+    }
+    inbox->count = 0;
+    
+    if (conn->state == CONN_DISCONNECTED) {
+        return;
+    }
+    
+    update_connection(ctx, conn);
+    
+    // Pack and send stage
+    if (conn->state == CONN_CONNECTED && pool->replicate) {
+        pool->replicate(ctx, player_id, worker_index, pool->user_data);
+    }
+}
+
+static void* server_worker_proc(void* arg) {
+    net_worker_arg_t* worker = (net_worker_arg_t*)arg;
+    struct net_server_workers* pool = worker->pool;
+    uint32_t seen_generation = 0;
+    
+    while (true) {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->generation == seen_generation && !pool->shutting_down) {
+            pthread_cond_wait(&pool->start_cond, &pool->mutex);
         }
+        if (pool->shutting_down) {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+        seen_generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
         
-        // Send heartbeat if needed
-        if (ctx->current_time - conn->last_sent_time > NET_HEARTBEAT_INTERVAL_MS) {
-            packet_header_t header = {0};
-            header.type = PACKET_HEARTBEAT;
-            header.payload_size = 0;
-            send_packet(ctx, conn, &header, NULL);
+        for (uint32_t p = worker->index; p < NET_MAX_PLAYERS; p += pool->worker_count) {
+            worker_process_connection(pool, worker->index, p);
         }
         
-        // Retry reliable packets
-        for (uint32_t j = 0; j < conn->pending_reliable_count; j++) {
-            if (ctx->current_time - conn->pending_reliable[j].send_time > 100) {
-                // Retry after 100ms
-                conn->pending_reliable[j].send_time = ctx->current_time;
-                conn->pending_reliable[j].retry_count++;
-                
-                if (conn->pending_reliable[j].retry_count > 10) {
-                    // Give up after 10 retries
-                    conn->pending_reliable[j] = 
-                        conn->pending_reliable[conn->pending_reliable_count - 1];
-                    conn->pending_reliable_count--;
-                    j--;
-                } else {
-                    // Resend
-                    packet_header_t header = {0};
-                    header.type = PACKET_RELIABLE_ORDERED;
-                    header.payload_size = conn->pending_reliable[j].size;
-                    send_packet(ctx, conn, &header, conn->pending_reliable[j].data);
-                }
-            }
+        pthread_mutex_lock(&pool->mutex);
+        if (++pool->workers_done == pool->worker_count) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    
+    return NULL;
+}
+
+// Start server workers
+// MEMORY: Allocated once here; the per-tick path does not allocate
+bool net_server_start_workers(network_context_t* ctx, uint32_t worker_count) {
+    if (!ctx->is_server || ctx->workers) {
+        return false;
+    }
+    if (worker_count == 0) worker_count = 1;
+    if (worker_count > NET_MAX_WORKERS) worker_count = NET_MAX_WORKERS;
+    
+    struct net_server_workers* pool = calloc(1, sizeof(struct net_server_workers));
+    if (!pool) {
+        return false;
+    }
+    
+    pool->ctx = ctx;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    
+    for (uint32_t i = 0; i < worker_count; i++) {
+        pool->args[i].pool = pool;
+        pool->args[i].index = i;
+        if (pthread_create(&pool->threads[i], NULL, server_worker_proc, &pool->args[i]) != 0) {
+            break;
+        }
+        pool->worker_count++;
+    }
+    
+    if (pool->worker_count == 0) {
+        pthread_mutex_destroy(&pool->mutex);
+        pthread_cond_destroy(&pool->start_cond);
+        pthread_cond_destroy(&pool->done_cond);
+        free(pool);
+        return false;
+    }
+    
+    ctx->workers = pool;
+    return true;
+}
+
+void net_server_stop_workers(network_context_t* ctx) {
+    struct net_server_workers* pool = ctx->workers;
+    if (!pool) {
+        return;
+    }
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutting_down = true;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->start_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    free(pool);
+    ctx->workers = NULL;
+}
+
+// Drain socket into per-connection inboxes (receive stage)
+// Only header checks run here; CRC and decode happen on the owning worker.
+// Unknown senders are verified here since they allocate a connection.
+static void server_drain_socket(network_context_t* ctx, struct net_server_workers* pool) {
+    while (true) {
+        uint8_t packet[NET_MAX_PACKET_SIZE];
+        struct sockaddr_in from_addr;
+        socklen_t addr_len = sizeof(from_addr);
+        
+        int received = recvfrom(ctx->socket, packet, sizeof(packet), 0,
+                              (struct sockaddr*)&from_addr, &addr_len);
+        if (received < 0) {
+            break;  // No more packets
+        }
+        if (!packet_header_valid(packet, received)) {
+            continue;
         }
         
-        // Update statistics
-        if (conn->rtt_sample_index > 0) {
-            uint64_t total_rtt = 0;
-            uint32_t count = (conn->rtt_sample_index < 32) ? 
-                           conn->rtt_sample_index : 32;
-            
-            for (uint32_t j = 0; j < count; j++) {
-                total_rtt += conn->rtt_samples[j];
+        uint32_t player_id = find_connection(ctx, &from_addr);
+        if (player_id == UINT32_MAX) {
+            if (!packet_checksum_valid(packet, received)) {
+                continue;
             }
-            
-            conn->stats.rtt_ms = (float)total_rtt / count;
-            
-            // Calculate jitter
-            float avg_rtt = conn->stats.rtt_ms;
-            float jitter_sum = 0;
-            for (uint32_t j = 0; j < count; j++) {
-                float diff = (float)conn->rtt_samples[j] - avg_rtt;
-                jitter_sum += diff * diff;
+            player_id = find_or_create_connection(ctx, &from_addr);
+            if (player_id == UINT32_MAX) {
+                continue;  // No space for connection
             }
-            conn->stats.jitter_ms = sqrtf(jitter_sum / count);
         }
         
-        // Calculate packet loss
-        if (conn->stats.packets_sent > 0) {
-            conn->stats.packet_loss_percent = 
-                (float)conn->stats.packets_lost / conn->stats.packets_sent * 100.0f;
+        net_inbox_t* inbox = &pool->inboxes[player_id];
+        if (inbox->count >= NET_WORKER_INBOX_PACKETS) {
+            pool->inbox_dropped++;
+            continue;
         }
         
-        // Calculate bandwidth
-        static uint64_t last_bandwidth_calc = 0;
-        if (ctx->current_time - last_bandwidth_calc > 1000) {
-            conn->stats.bandwidth_up_kbps = 
-                (float)conn->stats.bytes_sent * 8.0f / 1024.0f;
-            conn->stats.bandwidth_down_kbps = 
-                (float)conn->stats.bytes_received * 8.0f / 1024.0f;
-            
-            // Reset counters
-            conn->stats.bytes_sent = 0;
-            conn->stats.bytes_received = 0;
-            last_bandwidth_calc = ctx->current_time;
+        memcpy(inbox->packets[inbox->count], packet, received);
+        inbox->sizes[inbox->count] = (uint16_t)received;
+        inbox->count++;
+    }
+}
+
+// Server tick with connection work sharded across workers
+// Falls back to net_update plus serial replication without workers
+void net_server_tick(network_context_t* ctx, uint64_t current_time_ms,
+                     net_replicate_fn replicate, void* user_data) {
+    struct net_server_workers* pool = ctx->workers;
+    
+    if (!pool) {
+        net_update(ctx, current_time_ms);
+        if (replicate) {
+            for (uint32_t i = 0; i < NET_MAX_PLAYERS; i++) {
+                if (ctx->connections[i].state == CONN_CONNECTED) {
+                    replicate(ctx, i, 0, user_data);
+                }
+            }
         }
+        return;
     }
     
-    // Update simulation tick
-    if (ctx->current_time - ctx->last_tick_time >= NET_TICK_MS) {
-        ctx->current_tick++;
-        ctx->last_tick_time += NET_TICK_MS;
-        
-        // Process inputs for this tick
-        // (Game simulation would happen here)
+    ctx->current_time = current_time_ms;
+    server_drain_socket(ctx, pool);
+    
+    // Kick workers and wait for every shard
+    pthread_mutex_lock(&pool->mutex);
+    pool->replicate = replicate;
+    pool->user_data = user_data;
+    pool->workers_done = 0;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start_cond);
+    while (pool->workers_done < pool->worker_count) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
     }
+    pthread_mutex_unlock(&pool->mutex);
+    
+    advance_tick(ctx);
 }
 
 // Send player input
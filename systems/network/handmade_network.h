@@ -44,12 +44,12 @@
 // Configuration constants
 #define NET_MAX_PLAYERS 32
 #define NET_MAX_PACKET_SIZE 1400  // Below MTU to avoid fragmentation
-#define NET_PACKET_HEADER_SIZE 20  // Our custom header
+#define NET_PACKET_HEADER_SIZE 22  // Our custom header
 #define NET_MAX_PAYLOAD_SIZE (NET_MAX_PACKET_SIZE - NET_PACKET_HEADER_SIZE)
 #define NET_SEND_BUFFER_SIZE (64 * 1024)  // 64KB per connection
 #define NET_RECV_BUFFER_SIZE (64 * 1024)
 #define NET_MAX_PENDING_RELIABLE 256  // Max unacked reliable packets
-#define NET_SEQUENCE_BUFFER_SIZE 1024  // For detecting duplicates
+#define NET_SEQUENCE_BUFFER_SIZE 1024  // Sequence-indexed rings (sequence % size)
 #define NET_SNAPSHOT_BUFFER_SIZE 60  // 1 second of snapshots at 60Hz
 #define NET_INPUT_BUFFER_SIZE 120  // 2 seconds of input at 60Hz
 #define NET_TICK_RATE 60  // Simulation tick rate
@@ -58,6 +58,23 @@
 #define NET_TIMEOUT_MS 5000
 #define NET_MAX_FRAGMENT_SIZE 1024
 #define NET_MAX_FRAGMENTS 16
+#define NET_MAX_FRAGMENT_GROUPS 4  // Concurrent fragmented messages per connection
+#define NET_FRAGMENT_TIMEOUT_MS 1000
+#define NET_MAX_MESSAGE_SIZE (NET_MAX_FRAGMENTS * NET_MAX_FRAGMENT_SIZE)
+
+// Retransmit scheduling
+// PERFORMANCE: Timer wheel makes net_update O(expired) instead of O(pending)
+#define NET_RETRANSMIT_WHEEL_SLOTS 64
+#define NET_RETRANSMIT_WHEEL_TICK_MS 8  // 512ms scheduling horizon
+#define NET_RTO_INITIAL_MS 100
+#define NET_RTO_MIN_MS 30
+#define NET_RTO_MAX_MS (NET_RETRANSMIT_WHEEL_SLOTS * NET_RETRANSMIT_WHEEL_TICK_MS - NET_RETRANSMIT_WHEEL_TICK_MS)
+#define NET_MAX_RETRIES 10
+#define NET_INVALID_INDEX 0xFFFF
+
+// Server worker mode
+#define NET_MAX_WORKERS 16
+#define NET_WORKER_INBOX_PACKETS 64  // Datagrams queued per connection per tick
 
 // Packet types
 typedef enum {
@@ -86,18 +103,19 @@ typedef enum {
     CONN_DISCONNECTING,
 } connection_state_t;
 
-// Packet header (20 bytes)
+// Packet header (22 bytes)
 // CACHE: Fits in single cache line with room for payload start
 typedef struct {
     uint32_t protocol_id;     // Magic number for our protocol
     uint16_t sequence;         // Packet sequence number
     uint16_t ack;             // Latest received sequence
-    uint32_t ack_bits;        // Bitfield of received packets
+    uint32_t ack_bits;        // Bit i set = (ack - i) received
     uint8_t type;             // packet_type_t
     uint8_t fragment_id;      // For fragmented packets
     uint8_t fragment_count;   // Total fragments
     uint8_t fragment_index;   // Current fragment index
     uint16_t payload_size;    // Size of payload
+    uint16_t message_id;      // Reliable message id, kept across resends
     uint16_t checksum;        // CRC16 of header + payload
 } __attribute__((packed)) packet_header_t;
 
@@ -124,38 +142,78 @@ typedef struct {
 } net_stats_t;
 
 // Fragment assembly buffer
+// Slot chosen by fragment_id % NET_MAX_FRAGMENT_GROUPS
 typedef struct {
     uint8_t fragments[NET_MAX_FRAGMENTS][NET_MAX_FRAGMENT_SIZE];
     uint16_t fragment_sizes[NET_MAX_FRAGMENTS];
-    uint8_t received_mask;  // Bitfield of received fragments
+    uint16_t received_mask;  // Bitfield of received fragments
     uint8_t total_fragments;
     uint8_t fragment_id;
+    bool active;
     uint64_t timestamp;
 } fragment_assembly_t;
 
+// Unacked reliable packet (a whole message or one fragment of one)
+// Lives in a fixed pool; found by sequence through connection_t.sent_packets
+// and linked into one retransmit wheel slot (or the free list) via next/prev
+// MEMORY: Payload is stored in the slot, so releasing a slot frees its bytes
+typedef struct {
+    uint8_t data[NET_MAX_FRAGMENT_SIZE];
+    uint16_t size;
+    uint16_t sequence;        // Sequence of the latest transmission
+    uint16_t message_id;
+    uint16_t generation;      // Bumped on release, invalidates old ring entries
+    uint64_t send_time;       // Time of the latest transmission
+    int retry_count;
+    uint16_t next;
+    uint16_t prev;
+    uint8_t type;             // PACKET_RELIABLE_ORDERED or PACKET_FRAGMENT
+    uint8_t fragment_id;
+    uint8_t fragment_count;
+    uint8_t fragment_index;
+    uint8_t wheel_slot;
+    bool in_use;
+} reliable_packet_t;
+
+// Sent sequence ring entry
+// Every transmission of a reliable packet keeps its own entry, so an ack
+// for an earlier transmission still releases the packet
+typedef struct {
+    uint16_t sequence;
+    uint16_t index;           // pending_reliable index (NET_INVALID_INDEX if unreliable)
+    uint16_t generation;      // pending_reliable generation when sent
+} sent_packet_t;
+
 // Connection info
 typedef struct {
     struct sockaddr_in address;
     connection_state_t state;
     uint16_t local_sequence;   // Our sequence number
     uint16_t remote_sequence;  // Their latest sequence
-    uint32_t remote_ack_bits;  // Their ack bitfield
+    uint32_t remote_ack_bits;  // Bit i set = remote_sequence - i received
     uint64_t last_received_time;
     uint64_t last_sent_time;
     uint64_t connect_time;
     
     // Reliability
-    struct {
-        uint16_t sequence;
-        uint8_t* data;
-        uint16_t size;
-        uint64_t send_time;
-        int retry_count;
-    } pending_reliable[NET_MAX_PENDING_RELIABLE];
+    reliable_packet_t pending_reliable[NET_MAX_PENDING_RELIABLE];
     uint16_t pending_reliable_count;
+    uint16_t pending_free_head;
+    
+    // Sent sequence -> pending_reliable transmission
+    sent_packet_t sent_packets[NET_SEQUENCE_BUFFER_SIZE];
+    uint16_t next_message_id;
+    
+    // Retransmit timer wheel (heads of per-slot lists)
+    uint16_t retransmit_wheel[NET_RETRANSMIT_WHEEL_SLOTS];
+    uint64_t retransmit_wheel_tick;  // Last processed tick (time / tick ms)
+    uint32_t srtt_ms;                // Smoothed RTT
+    uint32_t rttvar_ms;              // RTT variance
+    uint32_t rto_ms;                 // Current retransmit timeout
     
     // Fragment assembly
-    fragment_assembly_t fragment_assembly;
+    fragment_assembly_t fragment_assembly[NET_MAX_FRAGMENT_GROUPS];
+    uint8_t next_fragment_id;
     
     // Ring buffers for send/recv
     uint8_t send_buffer[NET_SEND_BUFFER_SIZE];
@@ -168,12 +226,21 @@ typedef struct {
     
     // Statistics
     net_stats_t stats;
+    uint64_t last_bandwidth_time;
     uint64_t rtt_samples[32];
     uint32_t rtt_sample_index;
     
-    // Sequence number tracking for duplicate detection
-    uint16_t received_sequences[NET_SEQUENCE_BUFFER_SIZE];
-    uint32_t sequence_index;
+    // Received sequence ring for duplicate detection
+    // Slot sequence % size holds that sequence, or UINT32_MAX if empty
+    uint32_t received_sequences[NET_SEQUENCE_BUFFER_SIZE];
+    
+    // Received reliable message ring; drops resends that arrive under a
+    // new sequence after the original was already delivered
+    uint32_t received_messages[NET_SEQUENCE_BUFFER_SIZE];
+    
+    // Simulated loss xorshift state (0 = unseeded), owned by the worker
+    // that owns this connection so no shared generator is touched
+    uint32_t loss_random;
 } connection_t;
 
 // Game snapshot for rollback
@@ -203,6 +270,9 @@ typedef struct {
     uint32_t player_id;
 } input_command_t;
 
+// Server worker pool (opaque, see net_server_start_workers)
+struct net_server_workers;
+
 // Network context
 typedef struct {
     socket_t socket;
@@ -230,18 +300,24 @@ typedef struct {
     uint32_t input_head;
     uint32_t input_tail;
     
-    // Memory pools
-    uint8_t packet_memory_pool[256 * 1024];  // 256KB for packets
-    uint32_t packet_memory_used;
-    
     // Configuration
     float simulated_latency_ms;
     float simulated_packet_loss;
+    uint32_t simulated_loss_seed;  // Seeds each connection's loss generator
     bool enable_prediction;
     bool enable_interpolation;
     bool enable_compression;
+    
+    // Server worker mode (NULL = single threaded)
+    struct net_server_workers* workers;
 } network_context_t;
 
+// Per-connection replication callback for the server tick
+// THREADING: Runs on the worker owning player_id; may only touch that
+// connection and data indexed by player_id or worker_index
+typedef void (*net_replicate_fn)(network_context_t* ctx, uint32_t player_id,
+                                 uint32_t worker_index, void* user_data);
+
 // Core networking functions
 bool net_init(network_context_t* ctx, uint16_t port, bool is_server);
 void net_shutdown(network_context_t* ctx);
@@ -249,6 +325,12 @@ bool net_connect(network_context_t* ctx, const char* address, uint16_t port);
 void net_disconnect(network_context_t* ctx, uint32_t player_id);
 void net_update(network_context_t* ctx, uint64_t current_time_ms);
 
+// Server worker mode
+bool net_server_start_workers(network_context_t* ctx, uint32_t worker_count);
+void net_server_stop_workers(network_context_t* ctx);
+void net_server_tick(network_context_t* ctx, uint64_t current_time_ms,
+                     net_replicate_fn replicate, void* user_data);
+
 // Packet sending
 bool net_send_unreliable(network_context_t* ctx, uint32_t player_id, 
                          const void* data, uint16_t size);
@@ -10,6 +10,7 @@
 
 // Forward declarations for functions from other modules
 extern void net_send_entity_updates(network_context_t* ctx, uint32_t player_id);
+extern void net_server_replicate_tick(network_context_t* ctx, uint64_t current_time_ms);
 extern void net_interpolate_entities(network_context_t* ctx, float alpha);
 
 #include <stdio.h>
@@ -472,21 +473,14 @@ static void* server_thread(void* arg) {
     while (game->running) {
         uint64_t start_time = net_get_time_ms();
         
-        // Process network
-        net_update(game->net_ctx, start_time);
+        // Process network and send entity updates (sharded across workers)
+        net_server_replicate_tick(game->net_ctx, start_time);
         
         // Send snapshots to clients
         if (game->net_ctx->current_tick % 2 == 0) {  // Every other tick
             net_send_snapshot(game->net_ctx);
         }
         
-        // Send entity updates
-        for (uint32_t i = 0; i < NET_MAX_PLAYERS; i++) {
-            if (game->net_ctx->connections[i].state == CONN_CONNECTED) {
-                net_send_entity_updates(game->net_ctx, i);
-            }
-        }
-        
         game->network_time_total += net_get_time_ms() - start_time;
         
         // Sleep to maintain tick rate
@@ -520,6 +514,12 @@ static bool init_game(game_state_t* game, bool is_server, uint16_t port) {
         return false;
     }
     
+    // Shard connection work across cores, leaving one for the game loop
+    if (is_server) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        net_server_start_workers(game->net_ctx, cores > 1 ? (uint32_t)(cores - 1) : 1);
+    }
+    
     // Create local player
     if (!is_server) {
         game->local_player_id = 0;  // Will be assigned by server
@@ -641,10 +641,12 @@ int main(int argc, char* argv[]) {
         // Update physics
         update_physics(&g_game, dt);
         
-        // Network update
-        uint64_t net_start = net_get_time_ms();
-        net_update(g_game.net_ctx, current_time);
-        g_game.network_time_total += net_get_time_ms() - net_start;
+        // Network update (server thread owns the server context)
+        if (!g_game.is_server) {
+            uint64_t net_start = net_get_time_ms();
+            net_update(g_game.net_ctx, current_time);
+            g_game.network_time_total += net_get_time_ms() - net_start;
+        }
         
         // Interpolate entities
         net_interpolate_entities(g_game.net_ctx, dt);
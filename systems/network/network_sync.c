@@ -92,11 +92,38 @@ typedef struct {
     // Delta compression state
     network_entity_t last_sent_state[NET_MAX_PLAYERS][NET_MAX_PLAYERS * 64];
     uint32_t last_sent_tick[NET_MAX_PLAYERS];
+    
+    // Per-client replication tick (parallel server path)
+    uint32_t client_replicated_tick[NET_MAX_PLAYERS][NET_MAX_PLAYERS * 64];
 } entity_manager_t;
 
 // Global entity manager (normally in context)
 static entity_manager_t g_entity_manager;
 
+// Immutable per-tick copy of the world read by replication workers
+// THREADING: Written on the server thread before workers are kicked
+typedef struct {
+    network_entity_t entities[NET_MAX_PLAYERS * 64];
+    uint32_t entity_count;
+    uint32_t viewer_index[NET_MAX_PLAYERS];  // UINT32_MAX = no player entity
+    uint32_t tick;
+} replication_snapshot_t;
+
+// Relevance-sorted candidate, scored per client
+typedef struct {
+    float score;
+    uint32_t index;
+} replication_candidate_t;
+
+// Per-worker priority queues
+typedef struct {
+    replication_candidate_t queues[PRIORITY_LEVELS][NET_MAX_PLAYERS * 64];
+    uint32_t counts[PRIORITY_LEVELS];
+} replication_scratch_t;
+
+static replication_snapshot_t g_replication_snapshot;
+static replication_scratch_t g_replication_scratch[NET_MAX_WORKERS];
+
 // Spatial hash functions
 static uint32_t spatial_hash_key(float x, float y, float z) {
     int32_t cx = (int32_t)(x / SPATIAL_CELL_SIZE);
@@ -185,8 +212,9 @@ static uint32_t find_entities_in_range(spatial_hash_t* hash,
 
 // Calculate entity relevance score
 // OPTIMIZATION: Branchless score calculation
-static float calculate_relevance(network_entity_t* entity, 
-                                network_entity_t* viewer) {
+static float calculate_relevance(const network_entity_t* entity, 
+                                const network_entity_t* viewer,
+                                uint32_t ticks_since_update) {
     // Distance factor
     float dx = entity->x - viewer->x;
     float dy = entity->y - viewer->y;
@@ -217,8 +245,6 @@ static float calculate_relevance(network_entity_t* entity,
     }
     
     // Time since last update (stale entities need updates)
-    uint32_t ticks_since_update = viewer->last_replicated_tick - 
-                                 entity->last_replicated_tick;
     float staleness_score = ticks_since_update * 10.0f;
     
     return distance_score + velocity_score + view_score + 
@@ -241,8 +267,8 @@ static int entity_priority_compare(const void* a, const void* b) {
 
 // Pack entity update into buffer
 // PERFORMANCE: Bit packing for minimal size
-static uint32_t pack_entity_update(network_entity_t* entity,
-                                  network_entity_t* baseline,
+static uint32_t pack_entity_update(const network_entity_t* entity,
+                                  const network_entity_t* baseline,
                                   uint8_t* buffer, uint32_t max_size) {
     if (max_size < 64) return 0;  // Need minimum space
     
@@ -495,7 +521,8 @@ static void build_priority_queues(network_entity_t* viewer, uint32_t current_tic
                           entity->x, entity->y, entity->z);
         
         // Calculate relevance
-        entity->relevance_score = calculate_relevance(entity, viewer);
+        entity->relevance_score = calculate_relevance(entity, viewer,
+            viewer->last_replicated_tick - entity->last_replicated_tick);
         
         // Check if update needed
         uint32_t ticks_since_update = current_tick - entity->last_replicated_tick;
@@ -599,6 +626,143 @@ void net_send_entity_updates(network_context_t* ctx, uint32_t player_id) {
     }
 }
 
+// Higher score first, index breaks ties so output is deterministic
+static int replication_candidate_compare(const void* a, const void* b) {
+    const replication_candidate_t* ca = (const replication_candidate_t*)a;
+    const replication_candidate_t* cb = (const replication_candidate_t*)b;
+    
+    if (ca->score > cb->score) return -1;
+    if (ca->score < cb->score) return 1;
+    return (ca->index > cb->index) - (ca->index < cb->index);
+}
+
+// Copy world state for this tick's replication
+static void build_replication_snapshot(uint32_t current_tick) {
+    replication_snapshot_t* snap = &g_replication_snapshot;
+    
+    snap->tick = current_tick;
+    snap->entity_count = g_entity_manager.entity_count;
+    memcpy(snap->entities, g_entity_manager.entities,
+           snap->entity_count * sizeof(network_entity_t));
+    
+    for (uint32_t p = 0; p < NET_MAX_PLAYERS; p++) {
+        snap->viewer_index[p] = UINT32_MAX;
+    }
+    
+    for (uint32_t i = snap->entity_count; i-- > 0;) {
+        network_entity_t* entity = &snap->entities[i];
+        if (entity->type == ENTITY_PLAYER && entity->owner_id < NET_MAX_PLAYERS) {
+            snap->viewer_index[entity->owner_id] = i;  // First match wins
+        }
+    }
+}
+
+// Pack and send updates for one client from the tick snapshot
+// THREADING: Safe on any worker; writes only player_id rows and worker scratch
+static void replicate_from_snapshot(network_context_t* ctx, uint32_t player_id,
+                                    uint32_t worker_index, void* user_data) {
+    (void)user_data;
+    const replication_snapshot_t* snap = &g_replication_snapshot;
+    
+    uint32_t viewer_index = snap->viewer_index[player_id];
+    if (viewer_index == UINT32_MAX) {
+        return;  // No viewer entity
+    }
+    
+    const network_entity_t* viewer = &snap->entities[viewer_index];
+    replication_scratch_t* scratch = &g_replication_scratch[worker_index];
+    uint32_t* replicated_tick = g_entity_manager.client_replicated_tick[player_id];
+    
+    // Build priority queues
+    memset(scratch->counts, 0, sizeof(scratch->counts));
+    
+    for (uint32_t i = 0; i < snap->entity_count; i++) {
+        const network_entity_t* entity = &snap->entities[i];
+        
+        uint32_t ticks_since_update = snap->tick - replicated_tick[i];
+        if (ticks_since_update < entity->update_frequency && 
+            entity->dirty_mask == 0) {
+            continue;  // No update needed yet
+        }
+        
+        replication_candidate_t* candidate =
+            &scratch->queues[entity->priority][scratch->counts[entity->priority]++];
+        candidate->score = calculate_relevance(entity, viewer, ticks_since_update);
+        candidate->index = i;
+    }
+    
+    for (uint32_t p = 0; p < PRIORITY_LEVELS; p++) {
+        qsort(scratch->queues[p], scratch->counts[p],
+              sizeof(replication_candidate_t), replication_candidate_compare);
+    }
+    
+    // Prepare update packet
+    uint8_t packet[NET_MAX_PAYLOAD_SIZE];
+    uint32_t packet_pos = 0;
+    
+    memcpy(packet + packet_pos, &snap->tick, sizeof(uint32_t));
+    packet_pos += 4;
+    
+    uint32_t count_pos = packet_pos;
+    packet_pos += 4;
+    
+    uint32_t entities_sent = 0;
+    uint32_t bandwidth_used = 0;
+    const uint32_t max_bandwidth = 1024;  // 1KB per update
+    
+    for (uint32_t p = 0; p < PRIORITY_LEVELS && bandwidth_used < max_bandwidth; p++) {
+        for (uint32_t i = 0; i < scratch->counts[p] && bandwidth_used < max_bandwidth; i++) {
+            uint32_t entity_index = scratch->queues[p][i].index;
+            const network_entity_t* entity = &snap->entities[entity_index];
+            
+            // Get baseline for delta compression
+            network_entity_t* baseline = NULL;
+            if (g_entity_manager.last_sent_tick[player_id] > 0) {
+                baseline = &g_entity_manager.last_sent_state[player_id][entity_index];
+            }
+            
+            uint32_t update_size = pack_entity_update(entity, baseline,
+                                                     packet + packet_pos,
+                                                     NET_MAX_PAYLOAD_SIZE - packet_pos);
+            if (update_size == 0) {
+                break;  // No more space
+            }
+            
+            packet_pos += update_size;
+            bandwidth_used += update_size;
+            entities_sent++;
+            
+            g_entity_manager.last_sent_state[player_id][entity_index] = *entity;
+            replicated_tick[entity_index] = snap->tick;
+        }
+    }
+    
+    memcpy(packet + count_pos, &entities_sent, sizeof(uint32_t));
+    g_entity_manager.last_sent_tick[player_id] = snap->tick;
+    
+    if (entities_sent > 0) {
+        net_send_unreliable(ctx, player_id, packet, packet_pos);
+    }
+}
+
+// Full server tick: receive, decode, replicate and send for every client
+// PERFORMANCE: Per-client packing runs on the worker pool when started with
+// net_server_start_workers; the world is read from an immutable snapshot
+void net_server_replicate_tick(network_context_t* ctx, uint64_t current_time_ms) {
+    if (!ctx->is_server) {
+        net_update(ctx, current_time_ms);
+        return;
+    }
+    
+    build_replication_snapshot(ctx->current_tick);
+    net_server_tick(ctx, current_time_ms, replicate_from_snapshot, NULL);
+    
+    // Every client has seen this tick's changes
+    for (uint32_t i = 0; i < g_entity_manager.entity_count; i++) {
+        g_entity_manager.entities[i].dirty_mask = 0;
+    }
+}
+
 // Receive entity updates (client)
 void net_receive_entity_updates(network_context_t* ctx, const uint8_t* data, uint32_t size) {
     if (ctx->is_server) {
@@ -143,6 +143,17 @@ else
     echo "Performance test build failed!"
 fi
 
+# Build executor tests
+echo ""
+echo "Building executor tests..."
+$CC $CFLAGS $INCLUDES -o build/nodes_test nodes_test.c build/libnodes.a $LIBS
+
+if [ $? -eq 0 ]; then
+    echo "Built: build/nodes_test"
+else
+    echo "Executor test build failed!"
+fi
+
 # Generate documentation
 echo ""
 echo "Generating documentation..."
@@ -211,6 +222,7 @@ node_graph_execute(graph, &ctx);
 ## Running Tests
 
 ```bash
+./build/nodes_test
 ./build/perf_test
 ./build/nodes_demo
 ```
@@ -223,6 +235,11 @@ echo ""
 echo "Running tests..."
 echo "=================="
 
+if [ -f "build/nodes_test" ]; then
+    echo "Executor tests:"
+    ./build/nodes_test
+fi
+
 if [ -f "build/perf_test" ]; then
     echo "Performance test:"
     ./build/perf_test
@@ -234,6 +251,7 @@ echo ""
 echo "Files created:"
 echo "  - build/libnodes.a       (static library)"
 echo "  - build/nodes_demo        (interactive demo)"
+echo "  - build/nodes_test       (executor tests)"
 echo "  - build/perf_test        (performance test)"
 echo "  - build/README.md        (documentation)"
 echo ""
@@ -26,15 +26,19 @@ static struct {
 
 // Memory allocation from pool
 static void* pool_alloc(memory_index size) {
-    // PERFORMANCE: Align to cache line for better performance
+    // PERFORMANCE: Align to cache line for better performance. The pool
+    // itself may come from malloc, so align the address, not the offset -
+    // CACHE_ALIGN types are copied with aligned vector stores
+    memory_index base = (memory_index)g_nodes.memory_pool;
+    memory_index offset = AlignCacheLine(base + g_nodes.pool_used) - base;
     size = AlignCacheLine(size);
     
-    if (g_nodes.pool_used + size > g_nodes.pool_size) {
+    if (offset + size > g_nodes.pool_size) {
         return NULL;  // Out of memory
     }
     
-    void *result = (u8*)g_nodes.memory_pool + g_nodes.pool_used;
-    g_nodes.pool_used += size;
+    void *result = (u8*)g_nodes.memory_pool + offset;
+    g_nodes.pool_used = offset + size;
     
     // Zero the memory
     memset(result, 0, size);
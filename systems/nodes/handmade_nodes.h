@@ -114,6 +114,18 @@ typedef struct node_pin_t {
     #define PIN_FLAG_CONSTANT    0x08
 } node_pin_t;
 
+// Batch lanes - one value per batch item for every pin of a node
+// Lanes are packed at the pin type's own size: a float pin is an f32 array,
+// an int pin an i32 array, a vector pin 2-4 f32 per item, and so on.
+// CACHE: A pin's items are contiguous, items never share node->outputs
+typedef struct node_batch_lanes_t {
+    void *inputs[MAX_PINS_PER_NODE/2];          // inputs[pin] -> item values
+    void *outputs[MAX_PINS_PER_NODE/2];         // outputs[pin] -> item values
+    u8 input_strides[MAX_PINS_PER_NODE/2];      // Bytes per item
+    u8 output_strides[MAX_PINS_PER_NODE/2];
+    void **contexts;                            // Execution context per item
+} node_batch_lanes_t;
+
 // Node type definition - shared by all instances
 typedef struct node_type_t {
     char name[MAX_NODE_NAME_LENGTH];
@@ -134,6 +146,11 @@ typedef struct node_type_t {
     // Execution function
     void (*execute)(struct node_t *node, void *context);
     
+    // Optional batch function - every item of a batch in one call.
+    // NULL, or returning false for lanes it does not handle, runs execute
+    // once per item
+    bool (*execute_batch)(struct node_t *node, node_batch_lanes_t *lanes, i32 count);
+    
     // Optional callbacks
     void (*on_create)(struct node_t *node);
     void (*on_destroy)(struct node_t *node);
@@ -193,7 +210,7 @@ typedef struct node_t {
     u8 padding[CACHE_LINE_SIZE - ((sizeof(i32)*4 + sizeof(void*) + sizeof(f32)*4 + 
                                    sizeof(node_pin_t)*MAX_PINS_PER_NODE + 
                                    256 + sizeof(bool)*3 + sizeof(f32) + 128 + sizeof(bool)) % CACHE_LINE_SIZE)];
-} node_t CACHE_ALIGN;
+} CACHE_ALIGN node_t;
 
 // Connection between pins
 typedef struct node_connection_t {
@@ -358,6 +375,21 @@ void node_graph_execute(node_graph_t *graph, node_execution_context_t *context);
 void node_graph_compile(node_graph_t *graph);  // Topological sort
 void node_execute_single(node_t *node, node_execution_context_t *context);
 
+// Parallel execution - independent nodes across worker threads (nodes_executor.c)
+void executor_execute_parallel(node_graph_t *graph, node_execution_context_t *context);
+bool executor_start_workers(i32 worker_count);
+void executor_stop_workers(void);
+
+// Batch execution - one graph pass for many items
+void executor_batch_execute(node_graph_t *graph, void **contexts, i32 batch_size);
+void* executor_batch_get_output(i32 node_id, i32 pin_index);  // Packed like node_batch_lanes_t
+u32 executor_pin_value_size(pin_type_e type);
+
+// SIMD lane helpers for batch functions - count floats, 8 per AVX op
+void executor_simd_add_f32(const f32 *a, const f32 *b, f32 *result, i32 count);
+void executor_simd_mul_f32(const f32 *a, const f32 *b, f32 *result, i32 count);
+void executor_simd_lerp_f32(const f32 *a, const f32 *b, const f32 *t, f32 *result, i32 count);
+
 // Type registry
 void node_register_type(node_type_t *type);
 node_type_t* node_find_type(const char *name);
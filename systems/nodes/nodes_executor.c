@@ -2,11 +2,22 @@
 // PERFORMANCE: Stack-based execution, parallel evaluation, caching
 // CACHE: Sequential node access in execution order
 
+#define _DEFAULT_SOURCE  // sysconf
 #include "handmade_nodes.h"
+#include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
 #include <immintrin.h>  // For SIMD
 
+#define EXECUTOR_MAX_WORKERS 15         // Plus the calling thread
+#define EXECUTOR_PARALLEL_MIN_NODES 64  // Smaller graphs run sequentially
+#define EXECUTOR_CACHE_SIZE 1024        // Power of two
+#define EXECUTOR_CACHE_PROBE 8          // Slots searched per lookup
+
 // Execution stack for control flow
 typedef struct {
     i32 nodes[MAX_STACK_SIZE];
@@ -15,194 +26,442 @@ typedef struct {
 
 // Cache for unchanged paths
 typedef struct {
-    u64 hash;               // Hash of inputs
-    pin_value_t outputs[MAX_PINS_PER_NODE/2];
+    i32 node_id;
     i32 output_count;
     u64 last_access_frame;
+    pin_value_t outputs[MAX_PINS_PER_NODE/2];
 } execution_cache_entry_t;
 
 typedef struct {
-    execution_cache_entry_t entries[1024];  // Fixed size cache
+    // Open addressing on (node id, input hash), 0 marks an empty slot
+    // CACHE: Keys are probed without touching the entries
+    u64 keys[EXECUTOR_CACHE_SIZE];
+    execution_cache_entry_t entries[EXECUTOR_CACHE_SIZE];
     i32 entry_count;
     u64 current_frame;
     
+    // Dirty propagation, indexed by node id
+    node_graph_t *graph;                            // Graph the node state belongs to
+    u64 changed_frame[MAX_NODES_PER_GRAPH];         // Last frame the outputs changed
+    u64 last_run_frame[MAX_NODES_PER_GRAPH];        // Last frame a pure node was brought up to date
+    u64 binding_hash[MAX_NODES_PER_GRAPH];          // Sources and constants last run with
+    i32 execution_count[MAX_NODES_PER_GRAPH];       // Matches the node while outputs are valid
+    
     // Performance stats
     u64 cache_hits;
     u64 cache_misses;
 } execution_cache_t;
 
+// Ready nodes of one participant. The owner pushes and pops at the tail,
+// thieves take the oldest node from the head.
+typedef struct {
+    volatile i32 lock;
+    i32 head;
+    i32 tail;
+    i32 nodes[MAX_NODES_PER_GRAPH];  // Every node is pushed at most once per run
+} work_queue_t;
+
 // Thread pool for parallel execution
 typedef struct {
-    i32 thread_count;
-    i32 work_queue[MAX_NODES_PER_GRAPH];
-    i32 queue_head;
-    i32 queue_tail;
-    volatile i32 nodes_completed;
+    i32 thread_count;               // Participants, including the caller
+    pthread_t threads[EXECUTOR_MAX_WORKERS];
+    i32 worker_index[EXECUTOR_MAX_WORKERS];
+    
+    // THREADING: mutex guards generation, pending and shutdown
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    u32 generation;
+    i32 pending;
+    bool shutdown;
+    
+    // Current run, written before workers are woken
+    node_graph_t *graph;
+    node_execution_context_t *context;
+    volatile i32 nodes_remaining;
+    i32 pending_inputs[MAX_NODES_PER_GRAPH];  // Unfinished dependencies per node
+    work_queue_t queues[EXECUTOR_MAX_WORKERS + 1];
+    
+    // Performance stats
+    u64 steals;
 } thread_pool_t;
 
+// Input whose source lane is packed at a different size (ANY pins),
+// copied item by item just before its node runs
+typedef struct {
+    i32 node_id;
+    i32 pin;
+    u8 *source;
+    u32 source_stride;
+} batch_conversion_t;
+
+// Batch execution - lanes of the last batch, indexed by node id
+typedef struct {
+    u8 *storage;                    // Grown on demand, reused across batches
+    memory_index capacity;          // In bytes
+    i32 batch_size;
+    u32 generation;                 // Bumped per batch
+    u32 bound[MAX_NODES_PER_GRAPH]; // Generation a node's lanes belong to
+    node_batch_lanes_t lanes[MAX_NODES_PER_GRAPH];
+    
+    // In execution order
+    batch_conversion_t conversions[MAX_CONNECTIONS_PER_GRAPH];
+    i32 conversion_count;
+} batch_state_t;
+
 // Global execution state
 static struct {
     execution_stack_t stack;
     execution_cache_t cache;
     thread_pool_t thread_pool;
+    batch_state_t batch;
     
-    // Dependency tracking for parallel execution
-    i32 dependencies[MAX_NODES_PER_GRAPH][MAX_NODES_PER_GRAPH];
-    i32 dependency_count[MAX_NODES_PER_GRAPH];
-    i32 dependents[MAX_NODES_PER_GRAPH][MAX_NODES_PER_GRAPH];
+    // Dependency tracking for parallel execution, indexed by node id.
+    // Dependents are packed per source node in execution order.
+    i32 order_index[MAX_NODES_PER_GRAPH];        // -1 if not scheduled
+    i32 dependency_count[MAX_NODES_PER_GRAPH];   // Nodes that must finish first
+    i32 dependent_start[MAX_NODES_PER_GRAPH];
     i32 dependent_count[MAX_NODES_PER_GRAPH];
+    i32 dependents[MAX_CONNECTIONS_PER_GRAPH + MAX_NODES_PER_GRAPH];
     
     // Performance tracking
     u64 total_cycles;
     u64 node_cycles[MAX_NODES_PER_GRAPH];
 } g_exec;
 
-// Initialize execution engine
+// Initialize execution engine - one worker per additional core
 void executor_init(void) {
+    executor_stop_workers();
+    free(g_exec.batch.storage);
     memset(&g_exec, 0, sizeof(g_exec));
-    g_exec.thread_pool.thread_count = 1;  // Single-threaded for now
+    g_exec.thread_pool.thread_count = 1;
+    
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores > 1) {
+        executor_start_workers((i32)cores - 1);
+    }
 }
 
-// Hash inputs for caching
-static u64 hash_inputs(node_t *node) {
-    // FNV-1a hash
-    u64 hash = 14695981039346656037ULL;
+// Bytes of a pin value that carry data, the rest of the union is stale
+static const u8 g_pin_value_size[PIN_TYPE_COUNT] = {
+    [PIN_TYPE_EXECUTION] = sizeof(bool),
+    [PIN_TYPE_BOOL] = sizeof(bool),
+    [PIN_TYPE_INT] = sizeof(i32),
+    [PIN_TYPE_FLOAT] = sizeof(f32),
+    [PIN_TYPE_VECTOR2] = 2 * sizeof(f32),
+    [PIN_TYPE_VECTOR3] = 3 * sizeof(f32),
+    [PIN_TYPE_VECTOR4] = 4 * sizeof(f32),
+    [PIN_TYPE_STRING] = sizeof(void*),
+    [PIN_TYPE_ENTITY] = sizeof(void*),
+    [PIN_TYPE_OBJECT] = sizeof(void*),
+    [PIN_TYPE_COLOR] = 4,
+    [PIN_TYPE_MATRIX] = sizeof(pin_value_t),
+    [PIN_TYPE_ARRAY] = sizeof(void*),
+    [PIN_TYPE_ANY] = sizeof(pin_value_t),
+};
+
+// Bytes a value of the type occupies - what hashing and batch lanes look at
+u32 executor_pin_value_size(pin_type_e type) {
+    return (type >= 0 && type < PIN_TYPE_COUNT) ? g_pin_value_size[type] : sizeof(pin_value_t);
+}
+
+static u64 mix_hash(u64 hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// PERFORMANCE: A word at a time, only the bytes the pin type uses
+static u64 hash_value(u64 hash, pin_value_t *value, pin_type_e type) {
+    i32 size = (i32)executor_pin_value_size(type);
+    u64 *words = (u64*)value;
     
-    for (i32 i = 0; i < node->input_count; ++i) {
-        pin_value_t *val = &node->inputs[i].value;
-        u8 *bytes = (u8*)val;
-        
-        for (i32 j = 0; j < sizeof(pin_value_t); ++j) {
-            hash ^= bytes[j];
-            hash *= 1099511628211ULL;
-        }
+    i32 full_words = size / 8;
+    for (i32 i = 0; i < full_words; ++i) {
+        hash = (hash ^ words[i]) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
     }
     
-    // Include node type in hash
-    hash ^= node->type_id;
-    hash *= 1099511628211ULL;
+    if (size % 8) {
+        u64 mask = (1ULL << ((size % 8) * 8)) - 1;
+        hash = (hash ^ (words[full_words] & mask)) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
+    }
     
     return hash;
 }
 
-// Check cache for node results
-static bool check_cache(node_t *node) {
-    if (!node->type || (node->type->flags & NODE_TYPE_FLAG_PURE) == 0) {
-        return false;  // Only cache pure functions
+// Cache key - input values of one node in one graph, never 0
+static u64 hash_inputs(node_graph_t *graph, node_t *node) {
+    u64 hash = ((u64)(u32)graph->id << 32) | (u32)node->id;
+    
+    for (i32 i = 0; i < node->input_count; ++i) {
+        hash = hash_value(hash, &node->inputs[i].value, node->inputs[i].type);
     }
     
-    u64 hash = hash_inputs(node);
+    hash = mix_hash(hash ^ (u64)node->type_id);
+    return hash ? hash : 1;
+}
+
+// What a node reads from, without its inputs' values: the source of each
+// connected input and the value of each unconnected one
+static u64 hash_bindings(node_graph_t *graph, node_t *node) {
+    u64 hash = (u64)node->type_id;
     
-    // Linear search in cache
-    for (i32 i = 0; i < g_exec.cache.entry_count; ++i) {
-        execution_cache_entry_t *entry = &g_exec.cache.entries[i];
+    for (i32 i = 0; i < node->input_count; ++i) {
+        node_pin_t *input = &node->inputs[i];
         
-        if (entry->hash == hash && entry->output_count == node->output_count) {
-            // Cache hit - copy outputs
-            for (i32 j = 0; j < node->output_count; ++j) {
-                node->outputs[j].value = entry->outputs[j];
-            }
-            
-            entry->last_access_frame = g_exec.cache.current_frame;
-            g_exec.cache.cache_hits++;
-            return true;
+        if (input->connection_count > 0) {
+            node_connection_t *conn = &graph->connections[input->connections[0]];
+            hash = mix_hash(hash ^ (((u64)(u32)conn->source_node << 32) | (u32)conn->source_pin));
+        } else {
+            hash = hash_value(hash, &input->value, input->type);
         }
     }
     
-    g_exec.cache.cache_misses++;
-    return false;
+    return mix_hash(hash);
 }
 
-// Store node results in cache
-static void update_cache(node_t *node) {
-    if (!node->type || (node->type->flags & NODE_TYPE_FLAG_PURE) == 0) {
-        return;  // Only cache pure functions
+// A pure node is clean when it still holds the outputs of its last run,
+// reads from the same places and none of its sources changed since then.
+// Frames can stop early (step breakpoints), so "since then" is not always
+// "this frame".
+// PERFORMANCE: No input values are hashed for clean nodes
+static bool node_is_clean(node_graph_t *graph, node_t *node, u64 binding_hash) {
+    execution_cache_t *cache = &g_exec.cache;
+    
+    if (cache->execution_count[node->id] != node->execution_count) return false;
+    if (cache->binding_hash[node->id] != binding_hash) return false;
+    
+    for (i32 i = 0; i < node->input_count; ++i) {
+        node_pin_t *input = &node->inputs[i];
+        if (input->connection_count == 0) continue;
+        
+        i32 source = graph->connections[input->connections[0]].source_node;
+        if (cache->changed_frame[source] > cache->last_run_frame[node->id]) return false;
     }
     
-    u64 hash = hash_inputs(node);
+    return true;
+}
+
+// Node state is per graph - switching graphs makes every node dirty
+static void prepare_cache(node_graph_t *graph) {
+    execution_cache_t *cache = &g_exec.cache;
+    cache->current_frame++;
     
-    // Find slot to update or add new entry
-    execution_cache_entry_t *entry = NULL;
+    if (cache->graph != graph) {
+        memset(cache->changed_frame, 0, sizeof(cache->changed_frame));
+        memset(cache->last_run_frame, 0, sizeof(cache->last_run_frame));
+        memset(cache->execution_count, 0xFF, sizeof(cache->execution_count));
+        cache->graph = graph;
+    }
+}
+
+// Check cache for node results
+static bool check_cache(node_t *node, u64 key) {
+    execution_cache_t *cache = &g_exec.cache;
+    u32 slot = (u32)key & (EXECUTOR_CACHE_SIZE - 1);
     
-    // Look for existing entry
-    for (i32 i = 0; i < g_exec.cache.entry_count; ++i) {
-        if (g_exec.cache.entries[i].hash == hash) {
-            entry = &g_exec.cache.entries[i];
-            break;
+    // Entries are never removed one by one, so an empty slot ends the probe
+    for (i32 probe = 0; probe < EXECUTOR_CACHE_PROBE; ++probe) {
+        u32 index = (slot + probe) & (EXECUTOR_CACHE_SIZE - 1);
+        if (cache->keys[index] == 0) break;
+        if (cache->keys[index] != key) continue;
+        
+        execution_cache_entry_t *entry = &cache->entries[index];
+        if (entry->node_id != node->id || entry->output_count != node->output_count) break;
+        
+        // Cache hit - copy outputs
+        for (i32 j = 0; j < node->output_count; ++j) {
+            node->outputs[j].value = entry->outputs[j];
         }
+        
+        entry->last_access_frame = cache->current_frame;
+        return true;
     }
     
-    // Add new entry if not found
-    if (!entry && g_exec.cache.entry_count < 1024) {
-        entry = &g_exec.cache.entries[g_exec.cache.entry_count++];
-    } else if (!entry) {
-        // Cache full - evict oldest entry
-        u64 oldest_frame = g_exec.cache.current_frame;
-        i32 oldest_index = 0;
+    return false;
+}
+
+// Store node results in cache
+static void update_cache(node_t *node, u64 key) {
+    execution_cache_t *cache = &g_exec.cache;
+    u32 slot = (u32)key & (EXECUTOR_CACHE_SIZE - 1);
+    u32 victim = slot;
+    
+    // First empty slot, else evict the least recently used in the window
+    for (i32 probe = 0; probe < EXECUTOR_CACHE_PROBE; ++probe) {
+        u32 index = (slot + probe) & (EXECUTOR_CACHE_SIZE - 1);
         
-        for (i32 i = 0; i < 1024; ++i) {
-            if (g_exec.cache.entries[i].last_access_frame < oldest_frame) {
-                oldest_frame = g_exec.cache.entries[i].last_access_frame;
-                oldest_index = i;
-            }
+        if (cache->keys[index] == 0) {
+            victim = index;
+            cache->entry_count++;
+            break;
+        }
+        if (cache->entries[index].last_access_frame < cache->entries[victim].last_access_frame) {
+            victim = index;
         }
-        
-        entry = &g_exec.cache.entries[oldest_index];
     }
     
-    // Update entry
-    entry->hash = hash;
+    execution_cache_entry_t *entry = &cache->entries[victim];
+    cache->keys[victim] = key;
+    entry->node_id = node->id;
     entry->output_count = node->output_count;
     for (i32 i = 0; i < node->output_count; ++i) {
         entry->outputs[i] = node->outputs[i].value;
     }
-    entry->last_access_frame = g_exec.cache.current_frame;
+    entry->last_access_frame = cache->current_frame;
 }
 
 // Build dependency graph for parallel execution
+// Impure nodes are also chained in execution order, so their side effects
+// happen in the same order as in sequential execution.
 static void build_dependencies(node_graph_t *graph) {
-    // Clear dependency info
-    memset(g_exec.dependencies, 0, sizeof(g_exec.dependencies));
-    memset(g_exec.dependency_count, 0, sizeof(g_exec.dependency_count));
-    memset(g_exec.dependents, 0, sizeof(g_exec.dependents));
-    memset(g_exec.dependent_count, 0, sizeof(g_exec.dependent_count));
+    memset(g_exec.order_index, 0xFF, sizeof(g_exec.order_index));
+    
+    for (i32 n = 0; n < graph->execution_order_count; ++n) {
+        i32 node_id = graph->execution_order[n];
+        if (!graph->nodes[node_id].type) continue;
+        
+        g_exec.order_index[node_id] = n;
+        g_exec.dependency_count[node_id] = 0;
+        g_exec.dependent_count[node_id] = 0;
+    }
     
-    // Build dependency graph from connections
-    for (i32 i = 0; i < graph->connection_count; ++i) {
-        node_connection_t *conn = &graph->connections[i];
-        if (conn->id == 0) continue;
+    // Two passes over the pin connection lists - count, then fill
+    for (i32 pass = 0; pass < 2; ++pass) {
+        i32 previous_impure = -1;
         
-        i32 source = conn->source_node;
-        i32 target = conn->target_node;
+        for (i32 n = 0; n < graph->execution_order_count; ++n) {
+            i32 target = graph->execution_order[n];
+            if (g_exec.order_index[target] < 0) continue;
+            
+            node_t *node = &graph->nodes[target];
+            
+            for (i32 j = 0; j < node->input_count; ++j) {
+                node_pin_t *input = &node->inputs[j];
+                
+                for (i32 k = 0; k < input->connection_count; ++k) {
+                    i32 source = graph->connections[input->connections[k]].source_node;
+                    if (source < 0 || source >= MAX_NODES_PER_GRAPH) continue;
+                    if (g_exec.order_index[source] < 0) continue;
+                    
+                    // Target depends on source, source has target as dependent
+                    if (pass == 0) {
+                        g_exec.dependency_count[target]++;
+                    } else {
+                        g_exec.dependents[g_exec.dependent_start[source] + g_exec.dependent_count[source]] = target;
+                    }
+                    g_exec.dependent_count[source]++;
+                }
+            }
+            
+            if ((node->type->flags & NODE_TYPE_FLAG_PURE) == 0) {
+                if (previous_impure >= 0) {
+                    if (pass == 0) {
+                        g_exec.dependency_count[target]++;
+                    } else {
+                        g_exec.dependents[g_exec.dependent_start[previous_impure] + g_exec.dependent_count[previous_impure]] = target;
+                    }
+                    g_exec.dependent_count[previous_impure]++;
+                }
+                previous_impure = target;
+            }
+        }
         
-        // Target depends on source
-        g_exec.dependencies[target][g_exec.dependency_count[target]++] = source;
+        if (pass == 0) {
+            // Prefix sum into dependent_start, counts restart for the fill
+            i32 offset = 0;
+            for (i32 n = 0; n < graph->execution_order_count; ++n) {
+                i32 node_id = graph->execution_order[n];
+                if (g_exec.order_index[node_id] < 0) continue;
+                
+                g_exec.dependent_start[node_id] = offset;
+                offset += g_exec.dependent_count[node_id];
+                g_exec.dependent_count[node_id] = 0;
+            }
+        }
+    }
+}
+
+// Copy connected outputs into a node's inputs
+// PERFORMANCE: Reads the pin's connection list, no scan over all connections
+static void transfer_inputs(node_graph_t *graph, node_t *node) {
+    for (i32 j = 0; j < node->input_count; ++j) {
+        node_pin_t *input = &node->inputs[j];
+        if (input->connection_count == 0) continue;
         
-        // Source has target as dependent
-        g_exec.dependents[source][g_exec.dependent_count[source]++] = target;
+        // Only one connection per input
+        node_connection_t *conn = &graph->connections[input->connections[0]];
+        node_t *source_node = &graph->nodes[conn->source_node];
+        if (source_node->type && conn->source_pin < source_node->output_count) {
+            // PERFORMANCE: Direct memory copy for value transfer
+            input->value = source_node->outputs[conn->source_pin].value;
+        }
     }
 }
 
-// Execute single node with SIMD optimization where possible
-static void execute_node_optimized(node_t *node, node_execution_context_t *context) {
+// Execute single node, pure nodes through dirty propagation and the cache.
+// Worker threads pass use_cache = false - the cache is shared, node state
+// is only written by the thread running the node.
+static void execute_node_optimized(node_graph_t *graph, node_t *node,
+                                   node_execution_context_t *context, bool use_cache) {
+    execution_cache_t *cache = &g_exec.cache;
     u64 start = ReadCPUTimer();
     
-    // Check cache first
-    if (check_cache(node)) {
-        node->last_execution_cycles = ReadCPUTimer() - start;
-        return;
-    }
+    bool pure = (node->type->flags & NODE_TYPE_FLAG_PURE) != 0;
+    u64 binding_hash = pure ? hash_bindings(graph, node) : 0;
     
-    // Transfer input values from connections
-    // PERFORMANCE: This is done in the main execution loop now
+    node->state = NODE_STATE_EXECUTING;
     
-    // Execute based on node type
-    if (node->type && node->type->execute) {
-        node->type->execute(node, context);
+    if (pure && node_is_clean(graph, node, binding_hash)) {
+        // Outputs of the last run are still valid
+        __atomic_add_fetch(&cache->cache_hits, 1, __ATOMIC_RELAXED);
+    } else {
+        // PERFORMANCE: Do this just before execution for cache locality
+        transfer_inputs(graph, node);
+        
+        pin_value_t previous[MAX_PINS_PER_NODE/2];
+        for (i32 i = 0; i < node->output_count; ++i) {
+            previous[i] = node->outputs[i].value;
+        }
+        
+        u64 key = (pure && use_cache) ? hash_inputs(graph, node) : 0;
+        
+        if (key && check_cache(node, key)) {
+            __atomic_add_fetch(&cache->cache_hits, 1, __ATOMIC_RELAXED);
+        } else {
+            if (pure) {
+                __atomic_add_fetch(&cache->cache_misses, 1, __ATOMIC_RELAXED);
+            }
+            
+            if (node->type->execute) {
+                node->type->execute(node, context);
+            }
+            
+            if (key) {
+                update_cache(node, key);
+            }
+        }
+        
+        // Dependents only go dirty when an output actually changed
+        for (i32 i = 0; i < node->output_count; ++i) {
+            if (memcmp(&previous[i], &node->outputs[i].value, sizeof(pin_value_t)) != 0) {
+                cache->changed_frame[node->id] = cache->current_frame;
+                break;
+            }
+        }
     }
     
-    // Update cache with results
-    update_cache(node);
+    node->state = NODE_STATE_COMPLETED;
+    node->execution_count++;
+    
+    if (pure) {
+        cache->binding_hash[node->id] = binding_hash;
+        cache->execution_count[node->id] = node->execution_count;
+        cache->last_run_frame[node->id] = cache->current_frame;
+    }
     
     node->last_execution_cycles = ReadCPUTimer() - start;
     g_exec.node_cycles[node->id] = node->last_execution_cycles;
@@ -233,11 +492,8 @@ void executor_execute_graph(node_graph_t *graph, node_execution_context_t *conte
         node_graph_compile(graph);
     }
     
-    // Build dependencies for parallel execution
-    build_dependencies(graph);
-    
     // Increment cache frame
-    g_exec.cache.current_frame++;
+    prepare_cache(graph);
     
     // Reset stack
     g_exec.stack.top = -1;
@@ -260,32 +516,8 @@ void executor_execute_graph(node_graph_t *graph, node_execution_context_t *conte
             }
         }
         
-        // Transfer values from connected outputs to inputs
-        // PERFORMANCE: Do this just before execution for cache locality
-        for (i32 j = 0; j < node->input_count; ++j) {
-            node_pin_t *input = &node->inputs[j];
-            
-            // Find connection to this input
-            for (i32 k = 0; k < graph->connection_count; ++k) {
-                node_connection_t *conn = &graph->connections[k];
-                
-                if (conn->target_node == node_id && conn->target_pin == j) {
-                    node_t *source_node = &graph->nodes[conn->source_node];
-                    if (source_node->type && conn->source_pin < source_node->output_count) {
-                        // PERFORMANCE: Direct memory copy for value transfer
-                        input->value = source_node->outputs[conn->source_pin].value;
-                    }
-                    break;  // Only one connection per input
-                }
-            }
-        }
-        
         // Execute node
-        node->state = NODE_STATE_EXECUTING;
-        execute_node_optimized(node, context);
-        node->state = NODE_STATE_COMPLETED;
-        
-        node->execution_count++;
+        execute_node_optimized(graph, node, context, true);
         context->nodes_executed++;
     }
     
@@ -295,41 +527,297 @@ void executor_execute_graph(node_graph_t *graph, node_execution_context_t *conte
     graph->last_execution_ms = (f32)(g_exec.total_cycles / 3000000.0);  // Assuming 3GHz
 }
 
-// Parallel execution using thread pool (future enhancement)
-void executor_execute_parallel(node_graph_t *graph, node_execution_context_t *context) {
-    // TODO: Implement parallel execution using thread pool
-    // For now, fall back to sequential
-    executor_execute_graph(graph, context);
+// THREADING: Queue locks are held for a few instructions, so spin
+static void lock_queue(work_queue_t *queue) {
+    while (__atomic_exchange_n(&queue->lock, 1, __ATOMIC_ACQUIRE)) {
+        _mm_pause();
+    }
 }
 
-// SIMD-optimized value operations
-void executor_simd_add_float4(pin_value_t *a, pin_value_t *b, pin_value_t *result) {
-    // PERFORMANCE: Use SSE for 4-float operations
-    __m128 va = _mm_set_ps(a->v4.w, a->v4.z, a->v4.y, a->v4.x);
-    __m128 vb = _mm_set_ps(b->v4.w, b->v4.z, b->v4.y, b->v4.x);
-    __m128 vr = _mm_add_ps(va, vb);
+static void unlock_queue(work_queue_t *queue) {
+    __atomic_store_n(&queue->lock, 0, __ATOMIC_RELEASE);
+}
+
+static void push_ready_node(i32 participant, i32 node_id) {
+    work_queue_t *queue = &g_exec.thread_pool.queues[participant];
+    lock_queue(queue);
+    queue->nodes[queue->tail] = node_id;
+    __atomic_store_n(&queue->tail, queue->tail + 1, __ATOMIC_RELAXED);
+    unlock_queue(queue);
+}
+
+// Newest node from our own queue, else steal the oldest from another
+static i32 pop_ready_node(i32 participant) {
+    thread_pool_t *pool = &g_exec.thread_pool;
+    work_queue_t *own = &pool->queues[participant];
+    i32 node_id = -1;
     
-    _mm_store_ps((float*)&result->v4, vr);
+    lock_queue(own);
+    if (own->tail > own->head) {
+        node_id = own->nodes[own->tail - 1];
+        __atomic_store_n(&own->tail, own->tail - 1, __ATOMIC_RELAXED);
+    }
+    unlock_queue(own);
+    if (node_id >= 0) return node_id;
+    
+    for (i32 k = 1; k < pool->thread_count; ++k) {
+        work_queue_t *victim = &pool->queues[(participant + k) % pool->thread_count];
+        
+        // Skip empty queues without taking their lock, head and tail are
+        // only written atomically so the peek is safe
+        if (__atomic_load_n(&victim->tail, __ATOMIC_RELAXED) <=
+            __atomic_load_n(&victim->head, __ATOMIC_RELAXED)) continue;
+        
+        lock_queue(victim);
+        if (victim->tail > victim->head) {
+            node_id = victim->nodes[victim->head];
+            __atomic_store_n(&victim->head, victim->head + 1, __ATOMIC_RELAXED);
+        }
+        unlock_queue(victim);
+        
+        if (node_id >= 0) {
+            __atomic_add_fetch(&pool->steals, 1, __ATOMIC_RELAXED);
+            return node_id;
+        }
+    }
+    
+    return -1;
 }
 
-void executor_simd_mul_float4(pin_value_t *a, pin_value_t *b, pin_value_t *result) {
-    __m128 va = _mm_set_ps(a->v4.w, a->v4.z, a->v4.y, a->v4.x);
-    __m128 vb = _mm_set_ps(b->v4.w, b->v4.z, b->v4.y, b->v4.x);
-    __m128 vr = _mm_mul_ps(va, vb);
+// Runs ready nodes until the whole graph is done. Runs on the calling
+// thread (participant 0) and on every worker.
+static void run_parallel_nodes(i32 participant) {
+    thread_pool_t *pool = &g_exec.thread_pool;
+    node_graph_t *graph = pool->graph;
     
-    _mm_store_ps((float*)&result->v4, vr);
+    i32 idle_spins = 0;
+    
+    while (__atomic_load_n(&pool->nodes_remaining, __ATOMIC_ACQUIRE) > 0) {
+        i32 node_id = pop_ready_node(participant);
+        if (node_id < 0) {
+            // Give the core back when a long node holds up the rest
+            if (++idle_spins < 64) {
+                _mm_pause();
+            } else {
+                sched_yield();
+            }
+            continue;
+        }
+        idle_spins = 0;
+        
+        execute_node_optimized(graph, &graph->nodes[node_id], pool->context, false);
+        
+        // THREADING: Release ordering publishes our outputs to whoever
+        // takes the last dependency of a dependent
+        i32 first = g_exec.dependent_start[node_id];
+        for (i32 d = 0; d < g_exec.dependent_count[node_id]; ++d) {
+            i32 dependent = g_exec.dependents[first + d];
+            if (__atomic_sub_fetch(&pool->pending_inputs[dependent], 1, __ATOMIC_ACQ_REL) == 0) {
+                push_ready_node(participant, dependent);
+            }
+        }
+        
+        __atomic_sub_fetch(&pool->nodes_remaining, 1, __ATOMIC_RELEASE);
+    }
 }
 
-void executor_simd_lerp_float4(pin_value_t *a, pin_value_t *b, f32 t, pin_value_t *result) {
-    __m128 va = _mm_set_ps(a->v4.w, a->v4.z, a->v4.y, a->v4.x);
-    __m128 vb = _mm_set_ps(b->v4.w, b->v4.z, b->v4.y, b->v4.x);
-    __m128 vt = _mm_set1_ps(t);
-    __m128 one_minus_t = _mm_set1_ps(1.0f - t);
+static void* executor_worker_main(void *arg) {
+    thread_pool_t *pool = &g_exec.thread_pool;
+    i32 participant = *(i32*)arg;
+    u32 seen_generation = 0;
     
-    // result = a * (1-t) + b * t
-    __m128 vr = _mm_add_ps(_mm_mul_ps(va, one_minus_t), _mm_mul_ps(vb, vt));
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen_generation) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (pool->shutdown) break;
+        seen_generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+        
+        run_parallel_nodes(participant);
+        
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    
+    return NULL;
+}
+
+bool executor_start_workers(i32 worker_count) {
+    thread_pool_t *pool = &g_exec.thread_pool;
+    if (pool->thread_count > 1) return true;
+    if (worker_count <= 0) return false;
+    if (worker_count > EXECUTOR_MAX_WORKERS) worker_count = EXECUTOR_MAX_WORKERS;
+    
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    pool->shutdown = false;
+    pool->generation = 0;  // Workers start out waiting for generation 1
+    pool->pending = 0;
+    pool->thread_count = 1;
+    
+    for (i32 i = 0; i < worker_count; ++i) {
+        pool->worker_index[i] = i + 1;  // Queue 0 belongs to the calling thread
+        if (pthread_create(&pool->threads[i], NULL, executor_worker_main, &pool->worker_index[i]) != 0) {
+            break;
+        }
+        pool->thread_count++;
+    }
+    
+    if (pool->thread_count == 1) {
+        pthread_cond_destroy(&pool->done_cond);
+        pthread_cond_destroy(&pool->work_cond);
+        pthread_mutex_destroy(&pool->mutex);
+        return false;
+    }
+    
+    return true;
+}
+
+void executor_stop_workers(void) {
+    thread_pool_t *pool = &g_exec.thread_pool;
+    if (pool->thread_count <= 1) return;
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (i32 i = 0; i < pool->thread_count - 1; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pool->thread_count = 1;
+    
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->mutex);
+}
+
+// Parallel execution using thread pool
+// PERFORMANCE: Dependency counters instead of level barriers, so a wide
+// fan-out keeps every core busy until the graph is done. Results match
+// sequential execution: data only flows along dependencies and impure
+// nodes keep their order.
+void executor_execute_parallel(node_graph_t *graph, node_execution_context_t *context) {
+    if (!graph || !context) return;
+    
+    thread_pool_t *pool = &g_exec.thread_pool;
+    
+    // Compile if needed
+    if (graph->needs_recompile) {
+        node_graph_compile(graph);
+    }
+    
+    // Stepping and small graphs stay on the calling thread
+    if (pool->thread_count <= 1 || context->step_mode ||
+        graph->execution_order_count < EXECUTOR_PARALLEL_MIN_NODES) {
+        executor_execute_graph(graph, context);
+        return;
+    }
+    
+    u64 start = ReadCPUTimer();
+    
+    build_dependencies(graph);
+    prepare_cache(graph);
+    
+    pool->graph = graph;
+    pool->context = context;
+    for (i32 p = 0; p < pool->thread_count; ++p) {
+        pool->queues[p].head = 0;
+        pool->queues[p].tail = 0;
+    }
     
-    _mm_store_ps((float*)&result->v4, vr);
+    // Seed counters, deal roots round-robin in execution order
+    i32 scheduled = 0;
+    i32 next_queue = 0;
+    for (i32 n = 0; n < graph->execution_order_count; ++n) {
+        i32 node_id = graph->execution_order[n];
+        if (g_exec.order_index[node_id] < 0) continue;
+        
+        pool->pending_inputs[node_id] = g_exec.dependency_count[node_id];
+        scheduled++;
+        
+        if (g_exec.dependency_count[node_id] == 0) {
+            work_queue_t *queue = &pool->queues[next_queue];
+            queue->nodes[queue->tail++] = node_id;
+            next_queue = (next_queue + 1) % pool->thread_count;
+        }
+    }
+    pool->nodes_remaining = scheduled;
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->pending = pool->thread_count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    run_parallel_nodes(0);
+    
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    
+    context->nodes_executed += scheduled;
+    
+    // Update performance stats
+    g_exec.total_cycles = ReadCPUTimer() - start;
+    graph->last_execution_cycles = g_exec.total_cycles;
+    graph->last_execution_ms = (f32)(g_exec.total_cycles / 3000000.0);  // Assuming 3GHz
+}
+
+// SIMD-optimized value operations
+// PERFORMANCE: 8 items per AVX op. Unaligned loads - an input lane can
+// be any source's output lane.
+void executor_simd_add_f32(const f32 *a, const f32 *b, f32 *result, i32 count) {
+    i32 i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 va = _mm256_loadu_ps(&a[i]);
+        __m256 vb = _mm256_loadu_ps(&b[i]);
+        _mm256_storeu_ps(&result[i], _mm256_add_ps(va, vb));
+    }
+    for (; i < count; ++i) {
+        result[i] = a[i] + b[i];
+    }
+}
+
+void executor_simd_mul_f32(const f32 *a, const f32 *b, f32 *result, i32 count) {
+    i32 i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 va = _mm256_loadu_ps(&a[i]);
+        __m256 vb = _mm256_loadu_ps(&b[i]);
+        _mm256_storeu_ps(&result[i], _mm256_mul_ps(va, vb));
+    }
+    for (; i < count; ++i) {
+        result[i] = a[i] * b[i];
+    }
+}
+
+// result = a + (b - a) * t, t clamped to [0, 1] per item
+void executor_simd_lerp_f32(const f32 *a, const f32 *b, const f32 *t, f32 *result, i32 count) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    
+    i32 i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 va = _mm256_loadu_ps(&a[i]);
+        __m256 vb = _mm256_loadu_ps(&b[i]);
+        __m256 vt = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&t[i]), zero), one);
+        __m256 vr = _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(vb, va), vt));
+        _mm256_storeu_ps(&result[i], vr);
+    }
+    for (; i < count; ++i) {
+        f32 alpha = t[i];
+        if (alpha < 0.0f) alpha = 0.0f;
+        if (alpha > 1.0f) alpha = 1.0f;
+        result[i] = a[i] + (b[i] - a[i]) * alpha;
+    }
 }
 
 // Matrix operations with SIMD
@@ -352,10 +840,154 @@ void executor_simd_mat4_mul(pin_value_t *a, pin_value_t *b, pin_value_t *result)
     }
 }
 
+#define BATCH_LANE_ALIGN 32  // One AVX register
+
+// Carve the next lane out of batch storage
+static u8* batch_take_lane(u8 **cursor, u32 stride, i32 batch_size) {
+    u8 *lane = (u8*)(((uintptr_t)*cursor + BATCH_LANE_ALIGN - 1) & ~(uintptr_t)(BATCH_LANE_ALIGN - 1));
+    *cursor = lane + (memory_index)stride * batch_size;
+    return lane;
+}
+
+static void batch_fill_lane(u8 *lane, const pin_value_t *value, u32 stride, i32 batch_size) {
+    for (i32 b = 0; b < batch_size; ++b) {
+        memcpy(lane + (memory_index)b * stride, value, stride);
+    }
+}
+
+// Lay out lanes for one batch, each packed at its pin type's size.
+// Connected inputs read their source's output lane directly when both
+// sides are packed alike, unconnected inputs get a lane of their constant.
+// PERFORMANCE: Bindings resolved once per batch instead of per item and input
+static bool bind_batch_lanes(node_graph_t *graph, void **contexts, i32 batch_size) {
+    batch_state_t *batch = &g_exec.batch;
+    batch->generation++;
+    batch->batch_size = batch_size;
+    batch->conversion_count = 0;
+    
+    // Upper bound - one aligned lane per pin of every node in the order
+    memory_index needed = BATCH_LANE_ALIGN;
+    for (i32 n = 0; n < graph->execution_order_count; ++n) {
+        node_t *node = &graph->nodes[graph->execution_order[n]];
+        if (!node->type) continue;
+        
+        batch->bound[node->id] = batch->generation;
+        for (i32 j = 0; j < node->input_count; ++j) {
+            needed += executor_pin_value_size(node->inputs[j].type) * (memory_index)batch_size + BATCH_LANE_ALIGN;
+        }
+        for (i32 j = 0; j < node->output_count; ++j) {
+            needed += executor_pin_value_size(node->outputs[j].type) * (memory_index)batch_size + BATCH_LANE_ALIGN;
+        }
+    }
+    
+    if (needed > batch->capacity) {
+        u8 *storage = (u8*)realloc(batch->storage, needed);
+        if (!storage) return false;
+        
+        batch->storage = storage;
+        batch->capacity = needed;
+    }
+    
+    u8 *cursor = batch->storage;
+    
+    // Outputs first so any input can bind to its source. Lanes start from
+    // the current value, like a node that leaves an output untouched.
+    for (i32 n = 0; n < graph->execution_order_count; ++n) {
+        node_t *node = &graph->nodes[graph->execution_order[n]];
+        if (!node->type) continue;
+        
+        node_batch_lanes_t *lanes = &batch->lanes[node->id];
+        lanes->contexts = contexts;
+        
+        for (i32 j = 0; j < MAX_PINS_PER_NODE/2; ++j) {
+            if (j >= node->output_count) {
+                lanes->outputs[j] = NULL;
+                lanes->output_strides[j] = 0;
+                continue;
+            }
+            
+            u32 stride = executor_pin_value_size(node->outputs[j].type);
+            u8 *lane = batch_take_lane(&cursor, stride, batch_size);
+            batch_fill_lane(lane, &node->outputs[j].value, stride, batch_size);
+            lanes->outputs[j] = lane;
+            lanes->output_strides[j] = (u8)stride;
+        }
+    }
+    
+    for (i32 n = 0; n < graph->execution_order_count; ++n) {
+        node_t *node = &graph->nodes[graph->execution_order[n]];
+        if (!node->type) continue;
+        
+        node_batch_lanes_t *lanes = &batch->lanes[node->id];
+        
+        for (i32 j = 0; j < MAX_PINS_PER_NODE/2; ++j) {
+            if (j >= node->input_count) {
+                lanes->inputs[j] = NULL;
+                lanes->input_strides[j] = 0;
+                continue;
+            }
+            
+            // Only one connection per input
+            node_pin_t *input = &node->inputs[j];
+            u32 stride = executor_pin_value_size(input->type);
+            u8 *source_lane = NULL;
+            u32 source_stride = 0;
+            
+            if (input->connection_count > 0) {
+                node_connection_t *conn = &graph->connections[input->connections[0]];
+                i32 source_id = conn->source_node;
+                
+                if (source_id >= 0 && source_id < MAX_NODES_PER_GRAPH &&
+                    batch->bound[source_id] == batch->generation &&
+                    conn->source_pin < graph->nodes[source_id].output_count) {
+                    source_lane = (u8*)batch->lanes[source_id].outputs[conn->source_pin];
+                    source_stride = batch->lanes[source_id].output_strides[conn->source_pin];
+                }
+            }
+            
+            lanes->input_strides[j] = (u8)stride;
+            
+            if (source_lane && source_stride == stride) {
+                lanes->inputs[j] = source_lane;
+                continue;
+            }
+            
+            u8 *lane = batch_take_lane(&cursor, stride, batch_size);
+            batch_fill_lane(lane, &input->value, stride, batch_size);
+            lanes->inputs[j] = lane;
+            
+            if (source_lane) {
+                batch_conversion_t *conversion = &batch->conversions[batch->conversion_count++];
+                conversion->node_id = node->id;
+                conversion->pin = j;
+                conversion->source = source_lane;
+                conversion->source_stride = source_stride;
+            }
+        }
+    }
+    
+    return true;
+}
+
+// Bring an input lane fed by a differently packed source up to date.
+// Bytes the source does not have keep the input's constant, like a
+// pin_value_t copy that only the source's bytes are meaningful in.
+static void batch_convert_input(batch_conversion_t *conversion, i32 batch_size) {
+    node_batch_lanes_t *lanes = &g_exec.batch.lanes[conversion->node_id];
+    u8 *lane = (u8*)lanes->inputs[conversion->pin];
+    u32 stride = lanes->input_strides[conversion->pin];
+    u32 size = (conversion->source_stride < stride) ? conversion->source_stride : stride;
+    
+    for (i32 b = 0; b < batch_size; ++b) {
+        memcpy(lane + (memory_index)b * stride,
+               conversion->source + (memory_index)b * conversion->source_stride, size);
+    }
+}
+
 // Batch execution for data flow graphs
 void executor_batch_execute(node_graph_t *graph, void **contexts, i32 batch_size) {
     // PERFORMANCE: Process multiple data items through the graph at once
-    // This improves cache usage and allows SIMD across items
+    // Every pin has one lane per item, so items never overwrite each other
     
     if (!graph || !contexts || batch_size <= 0) return;
     
@@ -364,42 +996,73 @@ void executor_batch_execute(node_graph_t *graph, void **contexts, i32 batch_size
         node_graph_compile(graph);
     }
     
+    if (!bind_batch_lanes(graph, contexts, batch_size)) return;
+    
+    for (i32 b = 0; b < batch_size; ++b) {
+        ((node_execution_context_t*)contexts[b])->graph = graph;
+    }
+    
+    batch_state_t *batch = &g_exec.batch;
+    i32 conversion = 0;
+    
     // Process each node for all items in batch
     for (i32 n = 0; n < graph->execution_order_count; ++n) {
         i32 node_id = graph->execution_order[n];
         node_t *node = &graph->nodes[node_id];
         
-        if (!node->type || !node->type->execute) continue;
+        if (!node->type) continue;
+        
+        while (conversion < batch->conversion_count &&
+               batch->conversions[conversion].node_id == node_id) {
+            batch_convert_input(&batch->conversions[conversion++], batch_size);
+        }
+        
+        node_batch_lanes_t *lanes = &batch->lanes[node_id];
         
-        // Execute node for each item in batch
+        // PERFORMANCE: Whole batch in one call, SIMD across items
+        if (node->type->execute_batch &&
+            node->type->execute_batch(node, lanes, batch_size)) {
+            node->execution_count += batch_size;
+            continue;
+        }
+        
+        if (!node->type->execute) continue;
+        
+        // Scalar fallback - the node's own pins hold one item at a time
         // CACHE: Process all items for one node before moving to next node
         for (i32 b = 0; b < batch_size; ++b) {
-            node_execution_context_t *ctx = (node_execution_context_t*)contexts[b];
-            ctx->graph = graph;
-            
-            // Transfer inputs
             for (i32 j = 0; j < node->input_count; ++j) {
-                node_pin_t *input = &node->inputs[j];
-                
-                for (i32 k = 0; k < graph->connection_count; ++k) {
-                    node_connection_t *conn = &graph->connections[k];
-                    
-                    if (conn->target_node == node_id && conn->target_pin == j) {
-                        node_t *source = &graph->nodes[conn->source_node];
-                        if (source->type && conn->source_pin < source->output_count) {
-                            input->value = source->outputs[conn->source_pin].value;
-                        }
-                        break;
-                    }
-                }
+                u32 stride = lanes->input_strides[j];
+                memcpy(&node->inputs[j].value, (u8*)lanes->inputs[j] + (memory_index)b * stride, stride);
             }
+            for (i32 j = 0; j < node->output_count; ++j) {
+                u32 stride = lanes->output_strides[j];
+                memcpy(&node->outputs[j].value, (u8*)lanes->outputs[j] + (memory_index)b * stride, stride);
+            }
+            
+            node->type->execute(node, contexts[b]);
             
-            // Execute
-            node->type->execute(node, ctx);
+            for (i32 j = 0; j < node->output_count; ++j) {
+                u32 stride = lanes->output_strides[j];
+                memcpy((u8*)lanes->outputs[j] + (memory_index)b * stride, &node->outputs[j].value, stride);
+            }
         }
+        
+        node->execution_count += batch_size;
     }
 }
 
+// Output lane from the last batch, one value per item, packed at
+// executor_pin_value_size of the pin's type (f32 array for float pins).
+// NULL if the node or pin was not part of it.
+void* executor_batch_get_output(i32 node_id, i32 pin_index) {
+    if (node_id < 0 || node_id >= MAX_NODES_PER_GRAPH) return NULL;
+    if (pin_index < 0 || pin_index >= MAX_PINS_PER_NODE/2) return NULL;
+    if (g_exec.batch.bound[node_id] != g_exec.batch.generation) return NULL;
+    
+    return g_exec.batch.lanes[node_id].outputs[pin_index];
+}
+
 // Debug stepping control
 void executor_step_into(node_execution_context_t *context) {
     context->step_mode = true;
@@ -426,15 +1089,20 @@ void executor_start_profiling(void) {
 void executor_stop_profiling(void) {
     // Generate profiling report
     printf("Node Execution Profile:\n");
-    printf("Total cycles: %llu\n", g_exec.total_cycles);
+    printf("Total cycles: %llu\n", (unsigned long long)g_exec.total_cycles);
     printf("Cache hits: %llu, misses: %llu (%.1f%% hit rate)\n",
-           g_exec.cache.cache_hits, g_exec.cache.cache_misses,
+           (unsigned long long)g_exec.cache.cache_hits,
+           (unsigned long long)g_exec.cache.cache_misses,
            100.0f * g_exec.cache.cache_hits / 
            (g_exec.cache.cache_hits + g_exec.cache.cache_misses));
+    printf("Threads: %d, work steals: %llu\n",
+           g_exec.thread_pool.thread_count, (unsigned long long)g_exec.thread_pool.steals);
 }
 
 // Clear execution cache
 void executor_clear_cache(void) {
+    memset(g_exec.cache.keys, 0, sizeof(g_exec.cache.keys));
+    g_exec.cache.graph = NULL;
     g_exec.cache.entry_count = 0;
     g_exec.cache.cache_hits = 0;
     g_exec.cache.cache_misses = 0;
@@ -170,6 +170,141 @@ static void execute_lerp(node_t *node, void *context) {
     }
 }
 
+// Batch versions - every item of a batch in one call. Lanes are packed at
+// the pin type's size, so float and vector lanes are flat f32 arrays and a
+// component-wise op runs across items. Lanes packed any other way (mixed
+// pin types) are left to the per-item execute.
+
+// f32 components of a float or vector pin, 0 for anything else
+static i32 batch_float_components(pin_type_e type) {
+    switch (type) {
+        case PIN_TYPE_FLOAT:   return 1;
+        case PIN_TYPE_VECTOR2: return 2;
+        case PIN_TYPE_VECTOR3: return 3;
+        case PIN_TYPE_VECTOR4: return 4;
+        default:               return 0;
+    }
+}
+
+// Every listed lane holds one value of the type per item
+static bool batch_lanes_match(node_batch_lanes_t *lanes, i32 input_count, pin_type_e type) {
+    u32 stride = executor_pin_value_size(type);
+    for (i32 j = 0; j < input_count; ++j) {
+        if (lanes->input_strides[j] != stride) return false;
+    }
+    return lanes->output_strides[0] == stride;
+}
+
+static bool execute_add_batch(node_t *node, node_batch_lanes_t *lanes, i32 count) {
+    pin_type_e type = node->inputs[0].type;
+    if (node->inputs[1].type != type || node->outputs[0].type != type ||
+        !batch_lanes_match(lanes, 2, type)) {
+        return false;
+    }
+    
+    // Scalar execute only handles float, int, vector2 and vector3
+    i32 components = batch_float_components(type);
+    if (components && components < 4) {
+        executor_simd_add_f32((f32*)lanes->inputs[0], (f32*)lanes->inputs[1],
+                              (f32*)lanes->outputs[0], count * components);
+        return true;
+    }
+    
+    if (type == PIN_TYPE_INT) {
+        i32 *a = (i32*)lanes->inputs[0];
+        i32 *b = (i32*)lanes->inputs[1];
+        i32 *result = (i32*)lanes->outputs[0];
+        for (i32 i = 0; i < count; ++i) {
+            result[i] = a[i] + b[i];
+        }
+        return true;
+    }
+    
+    return false;
+}
+
+static bool execute_multiply_batch(node_t *node, node_batch_lanes_t *lanes, i32 count) {
+    pin_type_e type = node->inputs[0].type;
+    if (node->outputs[0].type != type) return false;
+    
+    // Vector by scalar
+    if (type == PIN_TYPE_VECTOR2 && node->inputs[1].type == PIN_TYPE_FLOAT) {
+        if (lanes->input_strides[0] != 2 * sizeof(f32) ||
+            lanes->input_strides[1] != sizeof(f32) ||
+            lanes->output_strides[0] != 2 * sizeof(f32)) {
+            return false;
+        }
+        
+        f32 *a = (f32*)lanes->inputs[0];
+        f32 *b = (f32*)lanes->inputs[1];
+        f32 *result = (f32*)lanes->outputs[0];
+        for (i32 i = 0; i < count; ++i) {
+            result[i * 2 + 0] = a[i * 2 + 0] * b[i];
+            result[i * 2 + 1] = a[i * 2 + 1] * b[i];
+        }
+        return true;
+    }
+    
+    if (node->inputs[1].type != type || !batch_lanes_match(lanes, 2, type)) {
+        return false;
+    }
+    
+    // Scalar execute only handles float, int and vector2
+    if (type == PIN_TYPE_FLOAT || type == PIN_TYPE_VECTOR2) {
+        executor_simd_mul_f32((f32*)lanes->inputs[0], (f32*)lanes->inputs[1],
+                              (f32*)lanes->outputs[0], count * batch_float_components(type));
+        return true;
+    }
+    
+    if (type == PIN_TYPE_INT) {
+        i32 *a = (i32*)lanes->inputs[0];
+        i32 *b = (i32*)lanes->inputs[1];
+        i32 *result = (i32*)lanes->outputs[0];
+        for (i32 i = 0; i < count; ++i) {
+            result[i] = a[i] * b[i];
+        }
+        return true;
+    }
+    
+    return false;
+}
+
+static bool execute_lerp_batch(node_t *node, node_batch_lanes_t *lanes, i32 count) {
+    pin_type_e type = node->inputs[0].type;
+    i32 components = batch_float_components(type);
+    
+    // Scalar execute only handles float, vector2 and vector3
+    if (components == 0 || components == 4) return false;
+    if (node->inputs[1].type != type || node->outputs[0].type != type ||
+        node->inputs[2].type != PIN_TYPE_FLOAT ||
+        !batch_lanes_match(lanes, 2, type) ||
+        lanes->input_strides[2] != sizeof(f32)) {
+        return false;
+    }
+    
+    f32 *a = (f32*)lanes->inputs[0];
+    f32 *b = (f32*)lanes->inputs[1];
+    f32 *t = (f32*)lanes->inputs[2];
+    f32 *result = (f32*)lanes->outputs[0];
+    
+    if (components == 1) {
+        executor_simd_lerp_f32(a, b, t, result, count);
+        return true;
+    }
+    
+    for (i32 i = 0; i < count; ++i) {
+        f32 alpha = t[i];
+        if (alpha < 0.0f) alpha = 0.0f;
+        if (alpha > 1.0f) alpha = 1.0f;
+        
+        for (i32 c = 0; c < components; ++c) {
+            i32 k = i * components + c;
+            result[k] = a[k] + (b[k] - a[k]) * alpha;
+        }
+    }
+    return true;
+}
+
 static void execute_clamp(node_t *node, void *context) {
     pin_value_t *value = node_get_input_value(node, 0);
     pin_value_t *min = node_get_input_value(node, 1);
@@ -595,6 +730,7 @@ void register_math_nodes(void) {
         type.width = 100;
         type.min_height = 60;
         type.execute = execute_add;
+        type.execute_batch = execute_add_batch;
         type.flags = NODE_TYPE_FLAG_PURE | NODE_TYPE_FLAG_COMPACT;
         
         type.input_count = 2;
@@ -620,6 +756,7 @@ void register_math_nodes(void) {
         type.width = 100;
         type.min_height = 60;
         type.execute = execute_multiply;
+        type.execute_batch = execute_multiply_batch;
         type.flags = NODE_TYPE_FLAG_PURE | NODE_TYPE_FLAG_COMPACT;
         
         type.input_count = 2;
@@ -645,6 +782,7 @@ void register_math_nodes(void) {
         type.width = 120;
         type.min_height = 80;
         type.execute = execute_lerp;
+        type.execute_batch = execute_lerp_batch;
         type.flags = NODE_TYPE_FLAG_PURE;
         
         type.input_count = 3;
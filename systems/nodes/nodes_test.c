@@ -0,0 +1,282 @@
+/*
+    Node Executor Tests
+
+    Batch lanes against scalar runs, parallel against sequential execution
+    and dirty propagation after a constant edit. Workers are started
+    explicitly so the parallel path runs on single core machines too.
+*/
+
+#include "handmade_nodes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+void nodes_library_init(void);
+void executor_init(void);
+void executor_execute_graph(node_graph_t *graph, node_execution_context_t *context);
+void executor_clear_cache(void);
+
+#define TEST_WORKERS 4
+
+static int g_failures;
+
+static void check(bool passed, const char *name) {
+    printf("[%s] %s\n", passed ? "PASS" : "FAIL", name);
+    if (!passed) g_failures++;
+}
+
+// Test node types
+static i32 g_run_count[MAX_NODES_PER_GRAPH];
+
+// Reads the lane's value from the execution context
+static void execute_item(node_t *node, void *context) {
+    node_execution_context_t *ctx = (node_execution_context_t*)context;
+    node->outputs[0].value.f = *(f32*)ctx->user_data;
+}
+
+// Scalar only, batches fall back to one call per lane
+static void execute_square(node_t *node, void *context) {
+    (void)context;
+    f32 v = node->inputs[0].value.f;
+    node->outputs[0].value.f = v * v;
+}
+
+// Enough transcendental work per node that rounding differences would show
+static void execute_heavy(node_t *node, void *context) {
+    (void)context;
+    f32 v = node->inputs[0].value.f;
+    for (i32 i = 0; i < 200; ++i) v = sinf(v) * 1.5f + 0.25f;
+    node->outputs[0].value.f = v + node->inputs[1].value.f;
+}
+
+// Counts runs per node, only used on the calling thread
+static void execute_counted(node_t *node, void *context) {
+    (void)context;
+    g_run_count[node->id]++;
+    node->outputs[0].value.f = node->inputs[0].value.f + node->inputs[1].value.f + 1.0f;
+}
+
+static void register_test_type(const char *name, void (*execute)(node_t *node, void *context),
+                               i32 input_count, u32 flags) {
+    node_type_t type = {0};
+    strcpy(type.name, name);
+    type.execute = execute;
+    type.flags = flags;
+    type.input_count = input_count;
+    for (i32 i = 0; i < input_count; ++i) {
+        type.input_templates[i].type = PIN_TYPE_FLOAT;
+    }
+    type.output_count = 1;
+    type.output_templates[0].type = PIN_TYPE_FLOAT;
+    node_register_type(&type);
+}
+
+static node_t* create(node_graph_t *graph, const char *type) {
+    return node_create(graph, node_get_type_id(type), 0, 0);
+}
+
+// Item -> Add -> Multiply -> Lerp(Item, Multiply) -> Square, one lane per context
+static void test_batch_matches_scalar(void) {
+    node_graph_t *graph = node_graph_create("Batch Test");
+    node_t *item = create(graph, "Item");
+    node_t *add = create(graph, "Add");
+    node_t *mul = create(graph, "Multiply");
+    node_t *lerp = create(graph, "Lerp");
+    node_t *square = create(graph, "Square");
+    
+    add->inputs[1].value.f = 10.0f;
+    mul->inputs[1].value.f = 2.0f;
+    lerp->inputs[2].value.f = 0.25f;
+    node_connect(graph, item->id, 0, add->id, 0);
+    node_connect(graph, add->id, 0, mul->id, 0);
+    node_connect(graph, item->id, 0, lerp->id, 0);
+    node_connect(graph, mul->id, 0, lerp->id, 1);
+    node_connect(graph, lerp->id, 0, square->id, 0);
+    
+    enum { LANES = 1000 };
+    static node_execution_context_t contexts[LANES];
+    static void *lanes[LANES];
+    static f32 values[LANES];
+    for (i32 i = 0; i < LANES; ++i) {
+        values[i] = (f32)i * 0.5f - 100.0f;
+        contexts[i].user_data = &values[i];
+        lanes[i] = &contexts[i];
+    }
+    
+    executor_batch_execute(graph, lanes, LANES);
+    f32 *batch_mul = (f32*)executor_batch_get_output(mul->id, 0);
+    f32 *batch_square = (f32*)executor_batch_get_output(square->id, 0);
+    
+    bool passed = batch_mul && batch_square;
+    for (i32 i = 0; i < LANES && passed; ++i) {
+        node_execution_context_t context = {0};
+        context.user_data = &values[i];
+        executor_execute_graph(graph, &context);
+        
+        passed = memcmp(&batch_mul[i], &mul->outputs[0].value.f, sizeof(f32)) == 0 &&
+                 memcmp(&batch_square[i], &square->outputs[0].value.f, sizeof(f32)) == 0;
+    }
+    
+    check(passed, "Batch lanes match scalar execution");
+    node_graph_destroy(graph);
+}
+
+// 8-way fan-out into heavy nodes, reduced pairwise back to one sink
+static void test_parallel_matches_sequential(void) {
+    node_graph_t *graph = node_graph_create("Parallel Test");
+    
+    enum { WIDTH = 512 };  // Power of 8
+    static i32 layer[WIDTH];
+    node_t *root = create(graph, "Add");
+    root->inputs[0].value.f = 0.5f;
+    layer[0] = root->id;
+    
+    // Outputs keep at most 8 connections
+    for (i32 width = 1; width < WIDTH; width *= 8) {
+        for (i32 i = width * 8 - 1; i >= 0; --i) {
+            node_t *add = create(graph, "Add");
+            add->inputs[1].value.f = (f32)i * 0.001f;
+            node_connect(graph, layer[i / 8], 0, add->id, 0);
+            layer[i] = add->id;
+        }
+    }
+    for (i32 i = 0; i < WIDTH; ++i) {
+        node_t *heavy = create(graph, "Heavy");
+        heavy->inputs[1].value.f = (f32)i;
+        node_connect(graph, layer[i], 0, heavy->id, 0);
+        layer[i] = heavy->id;
+    }
+    for (i32 count = WIDTH; count > 1; count /= 2) {
+        for (i32 i = 0; i < count / 2; ++i) {
+            node_t *add = create(graph, "Add");
+            node_connect(graph, layer[2 * i], 0, add->id, 0);
+            node_connect(graph, layer[2 * i + 1], 0, add->id, 1);
+            layer[i] = add->id;
+        }
+    }
+    
+    executor_clear_cache();
+    node_execution_context_t context = {0};
+    executor_execute_graph(graph, &context);
+    
+    static f32 expected[MAX_NODES_PER_GRAPH];
+    for (i32 i = 0; i < graph->node_count; ++i) {
+        expected[i] = graph->nodes[i].outputs[0].value.f;
+    }
+    
+    bool passed = executor_start_workers(TEST_WORKERS);
+    for (i32 run = 0; run < 20 && passed; ++run) {
+        executor_clear_cache();
+        for (i32 i = 0; i < graph->node_count; ++i) {
+            graph->nodes[i].outputs[0].value.f = 0.0f;
+        }
+        
+        node_execution_context_t parallel = {0};
+        executor_execute_parallel(graph, &parallel);
+        
+        passed = parallel.nodes_executed == graph->execution_order_count;
+        for (i32 i = 0; i < graph->node_count && passed; ++i) {
+            passed = memcmp(&expected[i], &graph->nodes[i].outputs[0].value.f, sizeof(f32)) == 0;
+        }
+    }
+    executor_stop_workers();
+    
+    check(passed, "Parallel execution matches sequential bit for bit");
+    node_graph_destroy(graph);
+}
+
+// Runs one frame and checks that exactly the expected nodes executed
+static bool run_counted_frame(node_graph_t *graph, bool parallel, const bool *expected) {
+    memset(g_run_count, 0, sizeof(g_run_count));
+    node_execution_context_t context = {0};
+    if (parallel) {
+        executor_execute_parallel(graph, &context);
+    } else {
+        executor_execute_graph(graph, &context);
+    }
+    
+    bool passed = true;
+    for (i32 i = 0; i < graph->node_count; ++i) {
+        passed = passed && g_run_count[i] == (expected[i] ? 1 : 0);
+    }
+    return passed;
+}
+
+// Two chains from two roots, joined by shared nodes: editing a constant of
+// the first root must rerun exactly the nodes downstream of it. Parallel
+// frames skip the memo table, so they see dirty propagation alone.
+static void test_constant_edit_dirties_cone(void) {
+    node_graph_t *graph = node_graph_create("Dirty Test");
+    
+    enum { CHAIN = 32, SHARED = 8 };
+    static bool in_cone[MAX_NODES_PER_GRAPH];
+    static bool none[MAX_NODES_PER_GRAPH];
+    memset(in_cone, 0, sizeof(in_cone));
+    
+    node_t *root_a = create(graph, "Counted");
+    node_t *root_b = create(graph, "Counted");
+    root_a->inputs[0].value.f = 1.0f;
+    root_b->inputs[0].value.f = 2.0f;
+    in_cone[root_a->id] = true;
+    
+    i32 chain_a[CHAIN], chain_b[CHAIN];
+    for (i32 i = 0; i < CHAIN; ++i) {
+        node_t *a = create(graph, "Counted");
+        node_t *b = create(graph, "Counted");
+        node_connect(graph, i ? chain_a[i - 1] : root_a->id, 0, a->id, 0);
+        node_connect(graph, i ? chain_b[i - 1] : root_b->id, 0, b->id, 0);
+        chain_a[i] = a->id;
+        chain_b[i] = b->id;
+        in_cone[a->id] = true;
+    }
+    for (i32 i = 0; i < SHARED; ++i) {
+        node_t *shared = create(graph, "Counted");
+        node_connect(graph, chain_a[i * (CHAIN / SHARED)], 0, shared->id, 0);
+        node_connect(graph, chain_b[i * (CHAIN / SHARED)], 0, shared->id, 1);
+        in_cone[shared->id] = true;
+    }
+    
+    executor_clear_cache();
+    bool passed = executor_start_workers(TEST_WORKERS);
+    
+    for (i32 pass = 0; pass < 2 && passed; ++pass) {
+        bool parallel = (pass == 0);
+        node_execution_context_t context = {0};
+        executor_execute_graph(graph, &context);
+        
+        // A clean frame runs nothing, an edit to a value the memo table has
+        // never seen reruns the cone
+        passed = run_counted_frame(graph, parallel, none);
+        root_a->inputs[1].value.f += 1.0f;
+        passed = passed && run_counted_frame(graph, parallel, in_cone);
+        passed = passed && run_counted_frame(graph, parallel, none);
+    }
+    executor_stop_workers();
+    
+    check(passed, "Constant edit dirties exactly the downstream cone");
+    node_graph_destroy(graph);
+}
+
+int main(void) {
+    memory_index size = MEGABYTES(512);
+    void *memory = malloc(size);
+    if (!memory) return 1;
+    
+    nodes_init(memory, size);
+    executor_init();
+    nodes_library_init();
+    register_test_type("Item", execute_item, 0, 0);
+    register_test_type("Square", execute_square, 1, NODE_TYPE_FLAG_PURE);
+    register_test_type("Heavy", execute_heavy, 2, NODE_TYPE_FLAG_PURE);
+    register_test_type("Counted", execute_counted, 2, NODE_TYPE_FLAG_PURE);
+    
+    printf("=== Node Executor Tests ===\n");
+    test_batch_matches_scalar();
+    test_parallel_matches_sequential();
+    test_constant_edit_dirties_cone();
+    printf("%s\n", g_failures ? "Some tests FAILED" : "All tests passed");
+    
+    free(memory);
+    return g_failures != 0;
+}
@@ -8,6 +8,7 @@
 #include <math.h>
 #include <immintrin.h>  // For SIMD
 #include <stdio.h>
+#include <pthread.h>
 
 // ============================================================================
 // MEMORY MANAGEMENT
@@ -28,6 +29,117 @@ static void* arena_alloc(particle_system* system, u64 size) {
     return ptr;
 }
 
+// ============================================================================
+// UPDATE JOB
+// ============================================================================
+
+// Force field snapshotted once per update
+typedef struct particle_field_params {
+    f32 x, y, z;
+    f32 radius_sq;
+    f32 strength;
+    u32 type;
+} particle_field_params;
+
+// One frame of block work, shared by the owning thread and the workers
+typedef struct particle_update_job {
+    particle_system* system;
+    b32 simd;
+    u32 count;
+    u32 block_count;
+    u32 next_block;
+    
+    u32 field_count;
+    particle_field_params fields[PARTICLE_FORCE_FIELDS];
+    
+    // Step per emitter slot, 0 for emitters waiting on their LOD tick.
+    // Entry PARTICLE_MAX_EMITTERS + 1 covers untracked owner tags.
+    f32 emitter_dt[PARTICLE_MAX_EMITTERS + 2];
+    
+    // Survivors per block after compaction, and kills per emitter slot
+    // for each participant (row 0 is the owning thread)
+    u32 block_alive[PARTICLE_MAX_TOTAL / PARTICLE_UPDATE_BLOCK];
+    u32 kills[PARTICLE_MAX_WORKERS + 1][PARTICLE_MAX_EMITTERS + 1];
+} particle_update_job;
+
+// Work run on the owning thread (participant 0) and on every worker
+typedef void particle_task(void* data, u32 participant);
+
+typedef struct particle_worker {
+    struct particle_worker_pool* pool;
+    u32 index;
+} particle_worker;
+
+typedef struct particle_worker_pool {
+    pthread_t threads[PARTICLE_MAX_WORKERS];
+    particle_worker workers[PARTICLE_MAX_WORKERS];
+    u32 worker_count;
+    
+    // THREADING: mutex guards generation, pending, task and shutdown
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    u32 generation;
+    u32 pending;
+    b32 shutdown;
+    particle_task* task;
+    void* task_data;
+} particle_worker_pool;
+
+#define PARTICLE_SORT_DIGITS   256
+#define PARTICLE_SORT_NONE     0xFFFFFFFFu  // Key of a particle that is not sorted
+#define PARTICLE_SORT_INDEX_BITS 24           // Covers PARTICLE_MAX_TOTAL
+
+// Radix sort state for particles_sort_for_rendering
+typedef struct particle_sort_job {
+    particle_system* system;
+    v3 camera;
+    u32 count;
+    u32 participants;
+    u32 pass;
+    u32 sorted_count;
+    
+    f32 depth_min;
+    f32 depth_scale;
+    
+    // -1 for emitter slots whose particles are sorted
+    i32 sorted_emitter[PARTICLE_MAX_EMITTERS + 2];
+    
+    f32 depth_low[PARTICLE_MAX_WORKERS + 1];
+    f32 depth_high[PARTICLE_MAX_WORKERS + 1];
+    u32 histogram[PARTICLE_MAX_WORKERS + 1][PARTICLE_SORT_DIGITS];
+} particle_sort_job;
+
+#define PARTICLE_CELL_NONE     0xFFFFFFFFu  // Particle left out of the spatial hash
+
+typedef struct particle_collision_event {
+    particle_id particle;
+    v3 position;
+    v3 normal;
+} particle_collision_event;
+
+// Collision pass state, events are replayed to the callback afterwards
+typedef struct particle_collision_job {
+    particle_system* system;
+    f32 dt;
+    u32 count;
+    u32 block_count;
+    u32 next_block;
+    u32 participants;
+    u32 grid_count;
+    
+    // -1 for emitter slots with enable_collision
+    i32 colliding_emitter[PARTICLE_MAX_EMITTERS + 2];
+    
+    u32 hits[PARTICLE_MAX_WORKERS + 1];
+    u32 event_count;
+    particle_collision_event events[PARTICLE_MAX_COLLISION_EVENTS];
+} particle_collision_job;
+
+static void build_pack_lut(void);
+static u32 compact_particles(particle_system* system);
+static void collide_particles(particle_system* system, f32 delta_time);
+
 // ============================================================================
 // SYSTEM LIFECYCLE
 // ============================================================================
@@ -78,16 +190,30 @@ particle_system* particles_init(void* memory, u64 memory_size) {
     
     // Allocate emitters
     system->emitter_capacity = PARTICLE_MAX_EMITTERS;
+    system->next_emitter_id = 1;
     system->emitters = (particle_emitter*)arena_alloc(system, 
         system->emitter_capacity * sizeof(particle_emitter));
     
+    // Block update scratch
+    system->update_job = (particle_update_job*)arena_alloc(system, sizeof(particle_update_job));
+    build_pack_lut();
+    
+    // Render order and radix sort scratch
+    system->render_order.indices = (u32*)arena_alloc(system, PARTICLE_MAX_TOTAL * sizeof(u32));
+    system->render_order.keys = (u32*)arena_alloc(system, PARTICLE_MAX_TOTAL * sizeof(u32));
+    system->render_order.entries = (u32*)arena_alloc(system, PARTICLE_MAX_TOTAL * sizeof(u32));
+    system->render_order.job = (particle_sort_job*)arena_alloc(system, sizeof(particle_sort_job));
+    
     // Initialize spatial hash
     system->spatial_hash.grid_size = 256;
     system->spatial_hash.cell_size = 1.0f;
     u32 hash_size = system->spatial_hash.grid_size * system->spatial_hash.grid_size;
-    system->spatial_hash.cell_starts = (u32*)arena_alloc(system, hash_size * sizeof(u32));
+    system->spatial_hash.cell_starts = (u32*)arena_alloc(system, (hash_size + 1) * sizeof(u32));
     system->spatial_hash.cell_ends = (u32*)arena_alloc(system, hash_size * sizeof(u32));
     system->spatial_hash.particle_indices = (u32*)arena_alloc(system, PARTICLE_MAX_TOTAL * sizeof(u32));
+    system->spatial_hash.particle_cells = (u32*)arena_alloc(system, PARTICLE_MAX_TOTAL * sizeof(u32));
+    system->spatial_hash.cell_positions = (f32*)arena_alloc(system, PARTICLE_MAX_TOTAL * 3 * sizeof(f32));
+    system->collision_job = (particle_collision_job*)arena_alloc(system, sizeof(particle_collision_job));
     
     // Default configuration
     system->use_simd = true;
@@ -101,6 +227,8 @@ particle_system* particles_init(void* memory, u64 memory_size) {
 
 void particles_shutdown(particle_system* system) {
     if (system) {
+        particles_stop_workers(system);
+        
         // Nothing to free - arena allocated
         system->memory_used = 0;
     }
@@ -123,11 +251,25 @@ emitter_id particles_create_emitter(particle_system* system, const emitter_confi
         return 0;
     }
     
-    emitter_id id = system->emitter_count + 1;  // IDs start at 1
+    // IDs start at 1 and are never handed out twice
+    emitter_id id = system->next_emitter_id++;
+    if (system->next_emitter_id == 0) system->next_emitter_id = 1;
+    
+    // Lowest table slot no live emitter holds. Destroying an emitter kills
+    // its particles, so a reused slot starts without tagged particles.
+    u64 slot_used[PARTICLE_MAX_EMITTERS / 64 + 1] = {0};
+    for (u32 i = 0; i < system->emitter_count; i++) {
+        u32 used = system->emitters[i].slot;
+        slot_used[used / 64] |= 1ull << (used % 64);
+    }
+    u32 slot = 1;
+    while (slot_used[slot / 64] & (1ull << (slot % 64))) slot++;
+    
     particle_emitter* emitter = &system->emitters[system->emitter_count++];
     
     memset(emitter, 0, sizeof(particle_emitter));
     emitter->id = id;
+    emitter->slot = slot;
     emitter->config = *config;
     emitter->world_position = config->position;
     emitter->is_active = true;
@@ -142,20 +284,15 @@ emitter_id particles_create_emitter(particle_system* system, const emitter_confi
 void particles_destroy_emitter(particle_system* system, emitter_id id) {
     for (u32 i = 0; i < system->emitter_count; i++) {
         if (system->emitters[i].id == id) {
-            // Kill all particles from this emitter
-            u32 start = system->emitters[i].particle_start;
-            u32 count = system->emitters[i].particle_count;
-            
-            // Shift particles down
-            if (start + count < system->particles.count) {
-                u32 move_count = system->particles.count - (start + count);
-                memmove(&system->particles.position_x[start], 
-                       &system->particles.position_x[start + count],
-                       move_count * sizeof(f32));
-                // ... repeat for all arrays
+            // Kill all particles from this emitter. The owner tag is
+            // cleared so a later emitter reusing the slot is not charged.
+            u32 owner = system->emitters[i].slot << PARTICLE_EMITTER_SHIFT;
+            for (u32 p = 0; p < system->particles.count; p++) {
+                if ((system->particles.flags[p] & ~((1u << PARTICLE_EMITTER_SHIFT) - 1)) == owner) {
+                    system->particles.flags[p] = PARTICLE_FLAG_DEAD;
+                }
             }
-            
-            system->particles.count -= count;
+            system->stats.particles_killed += compact_particles(system);
             
             // Remove emitter
             if (i < system->emitter_count - 1) {
@@ -287,7 +424,7 @@ void particles_burst_emitter(particle_system* system, emitter_id id, u32 count)
         
         // Metadata
         system->particles.texture_id[idx] = cfg->texture_id;
-        system->particles.flags[idx] = 0;
+        system->particles.flags[idx] = emitter->slot << PARTICLE_EMITTER_SHIFT;
         
         emitter->particle_count++;
         system->stats.particles_spawned++;
@@ -302,10 +439,9 @@ static void update_particle_scalar(particle_system* system, u32 idx, f32 dt) {
     // Age particle
     system->particles.age[idx] += dt;
     
-    // Kill if too old
+    // Kill if too old (removed by the compaction pass)
     if (system->particles.age[idx] >= system->particles.max_age[idx]) {
-        system->particles.flags[idx] |= 0x1;  // Mark as dead
-        system->stats.particles_killed++;
+        system->particles.flags[idx] |= PARTICLE_FLAG_DEAD;
         return;
     }
     
@@ -343,89 +479,637 @@ static void update_particle_scalar(particle_system* system, u32 idx, f32 dt) {
     system->particles.rotation[idx] += 90.0f * dt;  // degrees per second
 }
 
+static void apply_force_fields_scalar(particle_system* system, u32 i, f32 delta_time) {
+    for (u32 f = 0; f < system->force_field_count; f++) {
+        force_field* field = &system->force_fields[f];
+        if (!field->is_active) continue;
+        
+        f32 dx = system->particles.position_x[i] - field->position.x;
+        f32 dy = system->particles.position_y[i] - field->position.y;
+        f32 dz = system->particles.position_z[i] - field->position.z;
+        
+        f32 dist_sq = dx*dx + dy*dy + dz*dz;
+        if (dist_sq < field->radius * field->radius && dist_sq > 0.001f) {
+            f32 dist = sqrtf(dist_sq);
+            f32 force = field->strength / dist_sq;
+            
+            switch (field->type) {
+                case FORCE_ATTRACT:
+                    system->particles.velocity_x[i] -= (dx / dist) * force * delta_time;
+                    system->particles.velocity_y[i] -= (dy / dist) * force * delta_time;
+                    system->particles.velocity_z[i] -= (dz / dist) * force * delta_time;
+                    break;
+                
+                case FORCE_REPEL:
+                    system->particles.velocity_x[i] += (dx / dist) * force * delta_time;
+                    system->particles.velocity_y[i] += (dy / dist) * force * delta_time;
+                    system->particles.velocity_z[i] += (dz / dist) * force * delta_time;
+                    break;
+                
+                case FORCE_VORTEX:
+                    // Rotate around field center
+                    system->particles.velocity_x[i] += (-dy / dist) * force * delta_time;
+                    system->particles.velocity_y[i] += (dx / dist) * force * delta_time;
+                    break;
+                
+                default:
+                    break;
+            }
+        }
+    }
+}
+
 // ============================================================================
-// PARTICLE UPDATE - SIMD VERSION
+// PARTICLE UPDATE - STREAM COMPACTION
 // ============================================================================
 
-void particles_update_simd(particle_system* system, f32 delta_time) {
+#define PARTICLE_STREAM_COUNT 16
+
+// Left-pack permutations for _mm256_permutevar8x32, indexed by alive mask
+static u32 particle_pack_lut[256][8];
+
+static void build_pack_lut(void) {
+    for (u32 mask = 0; mask < 256; mask++) {
+        u32 n = 0;
+        for (u32 lane = 0; lane < 8; lane++) {
+            if (mask & (1u << lane)) particle_pack_lut[mask][n++] = lane;
+        }
+        while (n < 8) particle_pack_lut[mask][n++] = 0;
+    }
+}
+
+// Every per-particle array, viewed as 32-bit lanes so one loop moves them all
+static void get_particle_streams(particle_state* p, u32** streams) {
+    streams[0] = (u32*)p->position_x;
+    streams[1] = (u32*)p->position_y;
+    streams[2] = (u32*)p->position_z;
+    streams[3] = (u32*)p->velocity_x;
+    streams[4] = (u32*)p->velocity_y;
+    streams[5] = (u32*)p->velocity_z;
+    streams[6] = (u32*)p->size;
+    streams[7] = (u32*)p->rotation;
+    streams[8] = (u32*)p->opacity;
+    streams[9] = p->color;
+    streams[10] = (u32*)p->age;
+    streams[11] = (u32*)p->max_age;
+    streams[12] = (u32*)p->mass;
+    streams[13] = (u32*)p->drag;
+    streams[14] = p->texture_id;
+    streams[15] = p->flags;
+}
+
+// Packs the live particles of [begin, end) to the front of the range and
+// returns how many survived. Kills are tallied per emitter slot when kills
+// is non-null.
+// PERFORMANCE: Runs right after the block is simulated so it stays in L2;
+// groups with no deaths and nothing to shift are skipped outright
+static u32 compact_particle_block(particle_system* system, u32 begin, u32 end, u32* kills) {
+    particle_state* p = &system->particles;
+    u32* streams[PARTICLE_STREAM_COUNT];
+    get_particle_streams(p, streams);
+    
+    u32 write = begin;
+    for (u32 i = begin; i < end; i += 8) {
+        u32 valid = (end - i >= 8) ? 0xFF : ((1u << (end - i)) - 1);
+        __m256i flags = _mm256_loadu_si256((__m256i*)&p->flags[i]);
+        u32 dead = (u32)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(flags, 31))) & valid;
+        u32 alive = ~dead & valid;
+        
+        if (dead && kills) {
+            for (u32 bits = dead; bits; bits &= bits - 1) {
+                u32 id = p->flags[i + __builtin_ctz(bits)] >> PARTICLE_EMITTER_SHIFT;
+                if (id <= PARTICLE_MAX_EMITTERS) kills[id]++;
+            }
+        }
+        
+        if (alive == 0xFF && write == i) {
+            write += 8;
+            continue;
+        }
+        if (!alive) continue;
+        
+        // Full 8-lane stores never pass i + 8, which is inside this block
+        __m256i pack = _mm256_loadu_si256((__m256i*)particle_pack_lut[alive]);
+        for (u32 s = 0; s < PARTICLE_STREAM_COUNT; s++) {
+            __m256i v = _mm256_loadu_si256((__m256i*)&streams[s][i]);
+            _mm256_storeu_si256((__m256i*)&streams[s][write], _mm256_permutevar8x32_epi32(v, pack));
+        }
+        write += (u32)__builtin_popcount(alive);
+    }
+    
+    return write - begin;
+}
+
+// After block compaction every block holds its survivors at its front. The
+// holes below the new count are filled from survivors above it, so only as
+// many particles move as died. Order across blocks is not preserved.
+static u32 fill_block_holes(particle_system* system, const u32* block_alive, u32 block_count, u32 count) {
+    u32 new_count = 0;
+    for (u32 b = 0; b < block_count; b++) new_count += block_alive[b];
+    if (new_count == count) return count;
+    
+    u32* streams[PARTICLE_STREAM_COUNT];
+    get_particle_streams(&system->particles, streams);
+    
+    u32 hole_block = 0, hole_pos = 0, hole_end = 0;
+    u32 src_block = block_count, src_begin = 0, src_end = 0;
+    
+    for (;;) {
+        while (hole_pos >= hole_end) {
+            if (hole_block >= block_count) return new_count;
+            u32 start = hole_block * PARTICLE_UPDATE_BLOCK;
+            if (start >= new_count) return new_count;
+            u32 block_end = start + PARTICLE_UPDATE_BLOCK;
+            if (block_end > count) block_end = count;
+            hole_pos = start + block_alive[hole_block];
+            hole_end = block_end < new_count ? block_end : new_count;
+            hole_block++;
+        }
+        
+        while (src_end <= src_begin) {
+            if (src_block == 0) return new_count;
+            src_block--;
+            u32 start = src_block * PARTICLE_UPDATE_BLOCK;
+            src_begin = start > new_count ? start : new_count;
+            src_end = start + block_alive[src_block];
+        }
+        
+        u32 n = hole_end - hole_pos;
+        if (src_end - src_begin < n) n = src_end - src_begin;
+        src_end -= n;
+        for (u32 s = 0; s < PARTICLE_STREAM_COUNT; s++) {
+            memcpy(&streams[s][hole_pos], &streams[s][src_end], n * sizeof(u32));
+        }
+        hole_pos += n;
+    }
+}
+
+// Serial compaction for callers outside the update (emitter destruction)
+static u32 compact_particles(particle_system* system) {
+    particle_update_job* job = system->update_job;
     u32 count = system->particles.count;
-    if (count == 0) return;
+    u32 block_count = (count + PARTICLE_UPDATE_BLOCK - 1) / PARTICLE_UPDATE_BLOCK;
     
-    // Process 8 particles at a time using AVX2
-    u32 simd_count = (count / 8) * 8;
+    for (u32 b = 0; b < block_count; b++) {
+        u32 begin = b * PARTICLE_UPDATE_BLOCK;
+        u32 end = begin + PARTICLE_UPDATE_BLOCK;
+        if (end > count) end = count;
+        job->block_alive[b] = compact_particle_block(system, begin, end, NULL);
+    }
     
-    __m256 dt = _mm256_set1_ps(delta_time);
-    __m256 gravity = _mm256_set1_ps(-9.8f * delta_time);
-    __m256 one = _mm256_set1_ps(1.0f);
+    system->particles.count = fill_block_holes(system, job->block_alive, block_count, count);
+    return count - system->particles.count;
+}
+
+// ============================================================================
+// PARTICLE UPDATE - FUSED SIMD BLOCKS
+// ============================================================================
+
+// Integrate, apply every force field, drag and age one block in a single
+// AVX2 pass. Dead particles are flagged for the compaction that follows.
+// PERFORMANCE: One trip through memory instead of 1 + N passes (N fields)
+static void simulate_particle_block(particle_update_job* job, u32 begin, u32 end) {
+    particle_state* p = &job->system->particles;
     
-    for (u32 i = 0; i < simd_count; i += 8) {
-        // Load particle data (use unaligned loads for safety)
-        __m256 px = _mm256_loadu_ps(&system->particles.position_x[i]);
-        __m256 py = _mm256_loadu_ps(&system->particles.position_y[i]);
-        __m256 pz = _mm256_loadu_ps(&system->particles.position_z[i]);
+    __m256 gravity = _mm256_set1_ps(-9.8f);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256 three_halves = _mm256_set1_ps(1.5f);
+    __m256 min_dist_sq = _mm256_set1_ps(0.001f);
+    __m256i dead_flag = _mm256_set1_epi32(PARTICLE_FLAG_DEAD);
+    __m256i max_id = _mm256_set1_epi32(PARTICLE_MAX_EMITTERS + 1);
+    
+    // The last block may end mid-group; lanes past the count are scratch
+    // (capacity is a multiple of 8) and never survive compaction
+    for (u32 i = begin; i < end; i += 8) {
+        // Step of the owning emitter; a zero step leaves the particle as is
+        __m256i flags = _mm256_loadu_si256((__m256i*)&p->flags[i]);
+        __m256i id = _mm256_min_epu32(_mm256_srli_epi32(flags, PARTICLE_EMITTER_SHIFT), max_id);
+        __m256 dt = _mm256_i32gather_ps(job->emitter_dt, id, 4);
         
-        __m256 vx = _mm256_loadu_ps(&system->particles.velocity_x[i]);
-        __m256 vy = _mm256_loadu_ps(&system->particles.velocity_y[i]);
-        __m256 vz = _mm256_loadu_ps(&system->particles.velocity_z[i]);
+        // PERFORMANCE: Groups of LOD-skipped emitters cost one load
+        if (_mm256_testz_si256(_mm256_castps_si256(dt), _mm256_castps_si256(dt))) continue;
         
-        __m256 age = _mm256_loadu_ps(&system->particles.age[i]);
-        __m256 max_age = _mm256_loadu_ps(&system->particles.max_age[i]);
-        __m256 drag = _mm256_loadu_ps(&system->particles.drag[i]);
+        __m256 px = _mm256_loadu_ps(&p->position_x[i]);
+        __m256 py = _mm256_loadu_ps(&p->position_y[i]);
+        __m256 pz = _mm256_loadu_ps(&p->position_z[i]);
+        
+        __m256 vx = _mm256_loadu_ps(&p->velocity_x[i]);
+        __m256 vy = _mm256_loadu_ps(&p->velocity_y[i]);
+        __m256 vz = _mm256_loadu_ps(&p->velocity_z[i]);
+        
+        __m256 age = _mm256_loadu_ps(&p->age[i]);
+        __m256 max_age = _mm256_loadu_ps(&p->max_age[i]);
+        __m256 drag = _mm256_loadu_ps(&p->drag[i]);
         
         // Update age
         age = _mm256_add_ps(age, dt);
         
         // Apply gravity
-        vy = _mm256_add_ps(vy, gravity);
+        vy = _mm256_fmadd_ps(gravity, dt, vy);
         
         // Apply drag
-        __m256 drag_factor = _mm256_sub_ps(one, _mm256_mul_ps(drag, dt));
+        __m256 drag_factor = _mm256_fnmadd_ps(drag, dt, one);
         vx = _mm256_mul_ps(vx, drag_factor);
         vy = _mm256_mul_ps(vy, drag_factor);
         vz = _mm256_mul_ps(vz, drag_factor);
         
         // Update position
-        px = _mm256_add_ps(px, _mm256_mul_ps(vx, dt));
-        py = _mm256_add_ps(py, _mm256_mul_ps(vy, dt));
-        pz = _mm256_add_ps(pz, _mm256_mul_ps(vz, dt));
+        px = _mm256_fmadd_ps(vx, dt, px);
+        py = _mm256_fmadd_ps(vy, dt, py);
+        pz = _mm256_fmadd_ps(vz, dt, pz);
         
-        // Store back (use unaligned store)
-        _mm256_storeu_ps(&system->particles.position_x[i], px);
-        _mm256_storeu_ps(&system->particles.position_y[i], py);
-        _mm256_storeu_ps(&system->particles.position_z[i], pz);
+        // Force fields act on the new position and feed next frame's velocity
+        for (u32 f = 0; f < job->field_count; f++) {
+            particle_field_params* field = &job->fields[f];
+            
+            __m256 dx = _mm256_sub_ps(px, _mm256_set1_ps(field->x));
+            __m256 dy = _mm256_sub_ps(py, _mm256_set1_ps(field->y));
+            __m256 dz = _mm256_sub_ps(pz, _mm256_set1_ps(field->z));
+            __m256 dist_sq = _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz)));
+            
+            __m256 inside = _mm256_and_ps(
+                _mm256_cmp_ps(dist_sq, _mm256_set1_ps(field->radius_sq), _CMP_LT_OQ),
+                _mm256_cmp_ps(dist_sq, min_dist_sq, _CMP_GT_OQ));
+            
+            // PERFORMANCE: Fields are local, most groups skip the math
+            if (!_mm256_movemask_ps(inside)) continue;
+            
+            // strength / dist^2 along d / dist, one Newton step on rsqrt
+            __m256 inv = _mm256_rsqrt_ps(dist_sq);
+            inv = _mm256_mul_ps(inv, _mm256_fnmadd_ps(_mm256_mul_ps(half, dist_sq),
+                                                      _mm256_mul_ps(inv, inv), three_halves));
+            __m256 k = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(field->strength), dt),
+                                     _mm256_mul_ps(inv, _mm256_mul_ps(inv, inv)));
+            k = _mm256_and_ps(k, inside);
+            
+            switch (field->type) {
+                case FORCE_ATTRACT:
+                    vx = _mm256_fnmadd_ps(dx, k, vx);
+                    vy = _mm256_fnmadd_ps(dy, k, vy);
+                    vz = _mm256_fnmadd_ps(dz, k, vz);
+                    break;
+                
+                case FORCE_REPEL:
+                    vx = _mm256_fmadd_ps(dx, k, vx);
+                    vy = _mm256_fmadd_ps(dy, k, vy);
+                    vz = _mm256_fmadd_ps(dz, k, vz);
+                    break;
+                
+                case FORCE_VORTEX:
+                    vx = _mm256_fnmadd_ps(dy, k, vx);
+                    vy = _mm256_fmadd_ps(dx, k, vy);
+                    break;
+                
+                default:
+                    break;
+            }
+        }
         
-        _mm256_storeu_ps(&system->particles.velocity_x[i], vx);
-        _mm256_storeu_ps(&system->particles.velocity_y[i], vy);
-        _mm256_storeu_ps(&system->particles.velocity_z[i], vz);
+        // Lifetime kill
+        __m256 expired = _mm256_cmp_ps(age, max_age, _CMP_GE_OQ);
+        flags = _mm256_or_si256(flags, _mm256_and_si256(_mm256_castps_si256(expired), dead_flag));
         
-        _mm256_storeu_ps(&system->particles.age[i], age);
+        _mm256_storeu_ps(&p->position_x[i], px);
+        _mm256_storeu_ps(&p->position_y[i], py);
+        _mm256_storeu_ps(&p->position_z[i], pz);
+        
+        _mm256_storeu_ps(&p->velocity_x[i], vx);
+        _mm256_storeu_ps(&p->velocity_y[i], vy);
+        _mm256_storeu_ps(&p->velocity_z[i], vz);
+        
+        _mm256_storeu_ps(&p->age[i], age);
+        _mm256_storeu_si256((__m256i*)&p->flags[i], flags);
         
         // Update opacity based on age
         __m256 life_ratio = _mm256_div_ps(age, max_age);
         __m256 opacity = _mm256_sub_ps(one, life_ratio);
-        _mm256_storeu_ps(&system->particles.opacity[i], opacity);
+        _mm256_storeu_ps(&p->opacity[i], opacity);
+    }
+}
+
+// Claims blocks until none are left. Runs on the owning thread and on
+// every worker; participant selects the kill-tally row.
+static void run_particle_blocks(void* data, u32 participant) {
+    particle_update_job* job = (particle_update_job*)data;
+    u32* kills = job->kills[participant];
+    memset(kills, 0, sizeof(job->kills[0]));
+    
+    for (;;) {
+        // THREADING: Blocks are claimed lock-free, each is owned by one thread
+        u32 b = __atomic_fetch_add(&job->next_block, 1, __ATOMIC_RELAXED);
+        if (b >= job->block_count) break;
+        
+        u32 begin = b * PARTICLE_UPDATE_BLOCK;
+        u32 end = begin + PARTICLE_UPDATE_BLOCK;
+        if (end > job->count) end = job->count;
+        
+        if (job->simd) {
+            simulate_particle_block(job, begin, end);
+        } else {
+            for (u32 i = begin; i < end; i++) {
+                u32 id = job->system->particles.flags[i] >> PARTICLE_EMITTER_SHIFT;
+                f32 dt = job->emitter_dt[id <= PARTICLE_MAX_EMITTERS ? id : PARTICLE_MAX_EMITTERS + 1];
+                if (dt == 0.0f) continue;
+                
+                update_particle_scalar(job->system, i, dt);
+                apply_force_fields_scalar(job->system, i, dt);
+            }
+        }
+        job->block_alive[b] = compact_particle_block(job->system, begin, end, kills);
+    }
+}
+
+// ============================================================================
+// WORKER THREADS
+// ============================================================================
+
+static void* particle_worker_main(void* arg) {
+    particle_worker* worker = (particle_worker*)arg;
+    particle_worker_pool* pool = worker->pool;
+    u32 seen_generation = 0;
+    
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen_generation) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (pool->shutdown) break;
+        seen_generation = pool->generation;
+        particle_task* task = pool->task;
+        void* data = pool->task_data;
+        pthread_mutex_unlock(&pool->mutex);
+        
+        task(data, worker->index);
+        
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    
+    return NULL;
+}
+
+b32 particles_start_workers(particle_system* system, u32 worker_count) {
+    if (system->workers && system->workers->worker_count > 0) return true;
+    if (worker_count == 0) worker_count = 1;
+    if (worker_count > PARTICLE_MAX_WORKERS) worker_count = PARTICLE_MAX_WORKERS;
+    
+    // Arena memory is never returned, so a stopped pool is reused
+    if (!system->workers) {
+        system->workers = (particle_worker_pool*)arena_alloc(system, sizeof(particle_worker_pool));
+        if (!system->workers) return false;
     }
     
-    // Handle remaining particles
-    for (u32 i = simd_count; i < count; i++) {
-        update_particle_scalar(system, i, delta_time);
+    particle_worker_pool* pool = system->workers;
+    memset(pool, 0, sizeof(particle_worker_pool));
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    
+    for (u32 i = 0; i < worker_count; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i + 1;  // Row 0 belongs to the owning thread
+        if (pthread_create(&pool->threads[i], NULL, particle_worker_main, &pool->workers[i]) != 0) {
+            break;
+        }
+        pool->worker_count++;
     }
     
-    // Remove dead particles
-    u32 write_idx = 0;
-    for (u32 read_idx = 0; read_idx < count; read_idx++) {
-        if (!(system->particles.flags[read_idx] & 0x1)) {  // Not dead
-            if (write_idx != read_idx) {
-                // Copy particle data
-                system->particles.position_x[write_idx] = system->particles.position_x[read_idx];
-                system->particles.position_y[write_idx] = system->particles.position_y[read_idx];
-                system->particles.position_z[write_idx] = system->particles.position_z[read_idx];
-                // ... copy all other properties
+    if (pool->worker_count == 0) {
+        printf("Particle system: Failed to start worker threads\n");
+        pthread_cond_destroy(&pool->done_cond);
+        pthread_cond_destroy(&pool->work_cond);
+        pthread_mutex_destroy(&pool->mutex);
+        return false;
+    }
+    
+    printf("Particle system: %u update workers started\n", pool->worker_count);
+    return true;
+}
+
+void particles_stop_workers(particle_system* system) {
+    particle_worker_pool* pool = system->workers;
+    if (!pool || pool->worker_count == 0) return;
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (u32 i = 0; i < pool->worker_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pool->worker_count = 0;
+    
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->mutex);
+}
+
+// The owning thread plus every worker, or just the owning thread when
+// there is not enough work to share
+static u32 particle_participants(particle_system* system, u32 work_items) {
+    particle_worker_pool* pool = system->workers;
+    if (!pool || pool->worker_count == 0 || work_items < 2) return 1;
+    return 1 + pool->worker_count;
+}
+
+// Runs task once per participant and returns when all of them are done
+static void run_particle_task(particle_system* system, u32 participants,
+                              particle_task* task, void* data) {
+    particle_worker_pool* pool = system->workers;
+    
+    if (participants > 1) {
+        pthread_mutex_lock(&pool->mutex);
+        pool->task = task;
+        pool->task_data = data;
+        pool->pending = pool->worker_count;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->work_cond);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    
+    task(data, 0);
+    
+    if (participants > 1) {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->pending > 0) {
+            pthread_cond_wait(&pool->done_cond, &pool->mutex);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+}
+
+// ============================================================================
+// PARTICLE UPDATE - BLOCK DISPATCH
+// ============================================================================
+
+// Steps each particle by job->emitter_dt of its emitter
+static void update_particle_blocks(particle_system* system, b32 simd) {
+    u32 count = system->particles.count;
+    if (count == 0) return;
+    
+    particle_update_job* job = system->update_job;
+    job->system = system;
+    job->simd = simd;
+    job->count = count;
+    job->block_count = (count + PARTICLE_UPDATE_BLOCK - 1) / PARTICLE_UPDATE_BLOCK;
+    job->next_block = 0;
+    
+    // Snapshot active fields once per frame
+    job->field_count = 0;
+    for (u32 f = 0; f < system->force_field_count; f++) {
+        force_field* field = &system->force_fields[f];
+        if (!field->is_active) continue;
+        
+        particle_field_params* params = &job->fields[job->field_count++];
+        params->x = field->position.x;
+        params->y = field->position.y;
+        params->z = field->position.z;
+        params->radius_sq = field->radius * field->radius;
+        params->strength = field->strength;
+        params->type = field->type;
+    }
+    
+    // THREADING: Workers only pay off with more than one block to share
+    u32 participants = particle_participants(system, job->block_count);
+    run_particle_task(system, participants, run_particle_blocks, job);
+    
+    system->particles.count = fill_block_holes(system, job->block_alive, job->block_count, count);
+    system->stats.particles_killed += count - system->particles.count;
+    
+    // Per-emitter live counts from the kill tallies
+    for (u32 e = 0; e < system->emitter_count; e++) {
+        particle_emitter* emitter = &system->emitters[e];
+        
+        u32 killed = 0;
+        for (u32 t = 0; t < participants; t++) killed += job->kills[t][emitter->slot];
+        emitter->particle_count = killed < emitter->particle_count ? emitter->particle_count - killed : 0;
+    }
+}
+
+void particles_update_simd(particle_system* system, f32 delta_time) {
+    // Direct calls step every emitter, LOD scheduling is particles_update's
+    particle_update_job* job = system->update_job;
+    for (u32 e = 0; e < PARTICLE_MAX_EMITTERS + 2; e++) job->emitter_dt[e] = delta_time;
+    
+    update_particle_blocks(system, true);
+}
+
+// ============================================================================
+// LEVEL OF DETAIL
+// ============================================================================
+
+// Box around everything an emitter's particles can reach within one
+// lifetime under gravity. Force fields are not accounted for.
+static void emitter_bounds(const emitter_config* cfg, v3* min, v3* max) {
+    *min = cfg->position;
+    *max = cfg->position;
+    
+    switch (cfg->shape) {
+        case EMISSION_BOX:
+            *min = cfg->box_min;
+            *max = cfg->box_max;
+            break;
+        
+        case EMISSION_SPHERE:
+        case EMISSION_RING:
+            min->x -= cfg->radius; min->y -= cfg->radius; min->z -= cfg->radius;
+            max->x += cfg->radius; max->y += cfg->radius; max->z += cfg->radius;
+            break;
+        
+        default:
+            break;
+    }
+    
+    f32 t = cfg->particle_lifetime + 0.5f * fabsf(cfg->lifetime_variance);
+    f32 speed = fabsf(cfg->start_speed) + 0.5f * fabsf(cfg->start_speed_variance);
+    f32 reach = speed * t + 4.9f * t * t + cfg->start_size + cfg->start_size_variance;
+    
+    min->x -= reach; min->y -= reach; min->z -= reach;
+    max->x += reach; max->y += reach; max->z += reach;
+}
+
+// Picks the LOD level and culls emitters whose bounds leave the frustum
+static void classify_emitter(particle_system* system, particle_emitter* emitter) {
+    emitter->lod_level = 0;
+    emitter->is_culled = false;
+    if (!system->lod.enabled || !system->lod.has_camera) return;
+    
+    v3 min, max;
+    emitter_bounds(&emitter->config, &min, &max);
+    
+    if (system->lod.has_frustum) {
+        v3 center = {(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f};
+        v3 half = {(max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f};
+        
+        for (u32 i = 0; i < 6; i++) {
+            particle_frustum_plane* plane = &system->lod.planes[i];
+            f32 dist = plane->normal.x * center.x + plane->normal.y * center.y +
+                       plane->normal.z * center.z + plane->d;
+            f32 radius = fabsf(plane->normal.x * half.x) + fabsf(plane->normal.y * half.y) +
+                         fabsf(plane->normal.z * half.z);
+            if (dist < -radius) {
+                emitter->is_culled = true;
+                return;
             }
-            write_idx++;
         }
     }
-    system->particles.count = write_idx;
+    
+    if (system->lod.distance <= 0.0f) return;
+    
+    // Distance from the camera to the nearest point of the bounds
+    v3 cam = system->lod.camera_position;
+    f32 dx = cam.x < min.x ? min.x - cam.x : (cam.x > max.x ? cam.x - max.x : 0.0f);
+    f32 dy = cam.y < min.y ? min.y - cam.y : (cam.y > max.y ? cam.y - max.y : 0.0f);
+    f32 dz = cam.z < min.z ? min.z - cam.z : (cam.z > max.z ? cam.z - max.z : 0.0f);
+    f32 dist_sq = dx*dx + dy*dy + dz*dz;
+    
+    f32 threshold = system->lod.distance;
+    while (emitter->lod_level < PARTICLE_LOD_LEVELS - 1 && dist_sq >= threshold * threshold) {
+        emitter->lod_level++;
+        threshold *= 2.0f;
+    }
+}
+
+// Advances the system tick. Returns the time since the previous tick, or
+// 0 while the update frequency holds the simulation back.
+static f32 advance_particle_tick(particle_system* system, f32 delta_time) {
+    system->lod.tick_accumulator += delta_time;
+    
+    // Half a frame of slack keeps 30 Hz ticking every other 60 Hz frame
+    f32 interval = system->lod.update_interval;
+    if (interval > 0.0f && system->lod.tick_accumulator + 0.5f * delta_time < interval) {
+        return 0.0f;
+    }
+    
+    f32 step = system->lod.tick_accumulator;
+    system->lod.tick_accumulator = 0.0f;
+    system->lod.tick++;
+    return step;
+}
+
+void particles_set_update_frequency(particle_system* system, f32 hz) {
+    system->lod.update_interval = (hz > 0.0f) ? 1.0f / hz : 0.0f;
+    system->lod.tick_accumulator = 0.0f;
+}
+
+void particles_enable_lod(particle_system* system, b32 enable, f32 distance) {
+    system->lod.enabled = enable;
+    system->lod.distance = (distance > 0.0f) ? distance : 0.0f;
+}
+
+void particles_set_view(particle_system* system, v3 camera_position,
+                        const particle_frustum_plane* planes) {
+    system->lod.camera_position = camera_position;
+    system->lod.has_camera = true;
+    system->lod.has_frustum = planes != NULL;
+    if (planes) {
+        memcpy(system->lod.planes, planes, sizeof(system->lod.planes));
+    }
 }
 
 // ============================================================================
@@ -433,77 +1117,89 @@ void particles_update_simd(particle_system* system, f32 delta_time) {
 // ============================================================================
 
 void particles_update(particle_system* system, f32 delta_time) {
+    particle_update_job* job = system->update_job;
+    f32 step = advance_particle_tick(system, delta_time);
+    
+    system->stats.particles_simulated = 0;
+    system->stats.particles_skipped = 0;
+    system->stats.emitters_culled = 0;
+    
+    // Twice the longest regular LOD step, slack for frame time jitter
+    f32 tick_time = (system->lod.update_interval > delta_time) ? system->lod.update_interval : delta_time;
+    f32 max_step = (f32)(1u << PARTICLE_LOD_LEVELS) * tick_time;
+    
+    // Particles of untracked owner tags step with the system tick
+    for (u32 e = 0; e < PARTICLE_MAX_EMITTERS + 2; e++) job->emitter_dt[e] = step;
+    
     // Update emitters
     for (u32 i = 0; i < system->emitter_count; i++) {
         particle_emitter* emitter = &system->emitters[i];
         
-        if (!emitter->is_active || emitter->is_paused) continue;
+        classify_emitter(system, emitter);
+        emitter->update_accumulator += delta_time;
         
-        // Update emitter lifetime
-        emitter->time_alive += delta_time;
-        if (emitter->config.emitter_lifetime > 0 && 
-            emitter->time_alive >= emitter->config.emitter_lifetime) {
-            emitter->is_active = false;
-            continue;
+        // Culled emitters keep accumulating until they are visible again.
+        // Cap the catch-up so one Euler step cannot overshoot (drag * dt
+        // past 1 flips the velocity).
+        if (emitter->update_accumulator > max_step) {
+            emitter->update_accumulator = max_step;
         }
+        system->stats.emitters_culled += emitter->is_culled;
         
-        // Spawn new particles
-        if (emitter->config.continuous) {
-            emitter->emission_accumulator += emitter->config.emission_rate * delta_time;
+        // Level n emitters tick on every 2^n-th system tick, staggered by id
+        u32 period_mask = (1u << emitter->lod_level) - 1;
+        emitter->is_due = step > 0.0f && !emitter->is_culled &&
+            ((system->lod.tick + emitter->id) & period_mask) == 0;
+        
+        b32 spawning = emitter->is_active && !emitter->is_paused;
+        if (spawning) {
+            // Update emitter lifetime
+            emitter->time_alive += delta_time;
+            if (emitter->config.emitter_lifetime > 0 &&
+                emitter->time_alive >= emitter->config.emitter_lifetime) {
+                emitter->is_active = false;
+                spawning = false;
+            }
+        }
+        
+        // Culled emitters stop emitting, far ones emit at a reduced rate
+        // and spawn on their own tick
+        if (spawning && emitter->config.continuous && !emitter->is_culled) {
+            emitter->emission_accumulator += emitter->config.emission_rate * delta_time /
+                                             (f32)(1u << emitter->lod_level);
             
-            while (emitter->emission_accumulator >= 1.0f) {
+            while (emitter->is_due && emitter->emission_accumulator >= 1.0f) {
                 particles_burst_emitter(system, emitter->id, 1);
                 emitter->emission_accumulator -= 1.0f;
             }
         }
-    }
-    
-    // Update particles
-    if (system->use_simd) {
-        particles_update_simd(system, delta_time);
-    } else {
-        for (u32 i = 0; i < system->particles.count; i++) {
-            update_particle_scalar(system, i, delta_time);
+        
+        if (emitter->is_due) {
+            job->emitter_dt[emitter->slot] = emitter->update_accumulator;
+            emitter->update_accumulator = 0.0f;
+            system->stats.particles_simulated += emitter->particle_count;
+        } else {
+            job->emitter_dt[emitter->slot] = 0.0f;
+            system->stats.particles_skipped += emitter->particle_count;
         }
     }
     
-    // Apply force fields
-    for (u32 f = 0; f < system->force_field_count; f++) {
-        force_field* field = &system->force_fields[f];
-        if (!field->is_active) continue;
-        
-        for (u32 i = 0; i < system->particles.count; i++) {
-            f32 dx = system->particles.position_x[i] - field->position.x;
-            f32 dy = system->particles.position_y[i] - field->position.y;
-            f32 dz = system->particles.position_z[i] - field->position.z;
-            
-            f32 dist_sq = dx*dx + dy*dy + dz*dz;
-            if (dist_sq < field->radius * field->radius && dist_sq > 0.001f) {
-                f32 dist = sqrtf(dist_sq);
-                f32 force = field->strength / dist_sq;
-                
-                switch (field->type) {
-                    case FORCE_ATTRACT:
-                        system->particles.velocity_x[i] -= (dx / dist) * force * delta_time;
-                        system->particles.velocity_y[i] -= (dy / dist) * force * delta_time;
-                        system->particles.velocity_z[i] -= (dz / dist) * force * delta_time;
-                        break;
-                        
-                    case FORCE_REPEL:
-                        system->particles.velocity_x[i] += (dx / dist) * force * delta_time;
-                        system->particles.velocity_y[i] += (dy / dist) * force * delta_time;
-                        system->particles.velocity_z[i] += (dz / dist) * force * delta_time;
-                        break;
-                        
-                    case FORCE_VORTEX:
-                        // Rotate around field center
-                        system->particles.velocity_x[i] += (-dy / dist) * force * delta_time;
-                        system->particles.velocity_y[i] += (dx / dist) * force * delta_time;
-                        break;
-                }
-            }
-        }
+    u32 tracked = system->stats.particles_simulated + system->stats.particles_skipped;
+    if (system->particles.count > tracked) {
+        u32 untracked = system->particles.count - tracked;
+        if (step > 0.0f) system->stats.particles_simulated += untracked;
+        else system->stats.particles_skipped += untracked;
     }
+    
+    // PERFORMANCE: Nothing moves between ticks of a reduced update frequency
+    if (step == 0.0f) return;
+    
+    // Update particles - integration, force fields, drag and lifetime are
+    // fused per block, then dead particles are compacted away
+    update_particle_blocks(system, system->use_simd);
+    
+    // World contacts and particle-particle repulsion on the survivors
+    collide_particles(system, step);
 }
 
 // ============================================================================
@@ -525,9 +1221,738 @@ particle_render_data particles_get_render_data(particle_system* system) {
     data.rotations = system->particles.rotation;
     data.texture_ids = system->particles.texture_id;
     
+    // Valid until the next update moves particles
+    data.sorted_indices = system->render_order.indices;
+    data.sorted_count = system->render_order.count;
+    
     return data;
 }
 
+// ============================================================================
+// RENDER SORTING
+// ============================================================================
+
+// LSD radix sort on 16-bit quantized view depth, two 8-bit digit passes.
+// Every pass splits its input into one contiguous chunk per participant;
+// per-chunk histograms prefixed digit-major keep the scatter stable.
+
+// Participant's share of [0, count), split on 8-particle groups
+static void sort_chunk(u32 count, u32 participants, u32 participant, u32* begin, u32* end) {
+    *begin = (u32)(((u64)count * participant / participants) & ~7ull);
+    *end = (participant + 1 == participants) ? count :
+        (u32)(((u64)count * (participant + 1) / participants) & ~7ull);
+}
+
+// Pass 1: distance to camera for sorted particles, -1 for the rest
+static void sort_depth_task(void* data, u32 participant) {
+    particle_sort_job* job = (particle_sort_job*)data;
+    particle_state* p = &job->system->particles;
+    f32* depth = (f32*)job->system->render_order.keys;
+    
+    u32 begin, end;
+    sort_chunk(job->count, job->participants, participant, &begin, &end);
+    
+    __m256 cx = _mm256_set1_ps(job->camera.x);
+    __m256 cy = _mm256_set1_ps(job->camera.y);
+    __m256 cz = _mm256_set1_ps(job->camera.z);
+    __m256 none = _mm256_set1_ps(-1.0f);
+    __m256 low = _mm256_set1_ps(1e30f);
+    __m256 high = _mm256_set1_ps(-1e30f);
+    __m256i max_id = _mm256_set1_epi32(PARTICLE_MAX_EMITTERS + 1);
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    
+    // Lanes past the count read scratch and are masked out
+    for (u32 i = begin; i < end; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&p->position_x[i]), cx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&p->position_y[i]), cy);
+        __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&p->position_z[i]), cz);
+        __m256 d = _mm256_sqrt_ps(_mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz))));
+        
+        __m256i flags = _mm256_loadu_si256((__m256i*)&p->flags[i]);
+        __m256i id = _mm256_min_epu32(_mm256_srli_epi32(flags, PARTICLE_EMITTER_SHIFT), max_id);
+        __m256i sorted = _mm256_i32gather_epi32((const int*)job->sorted_emitter, id, 4);
+        __m256i in_range = _mm256_cmpgt_epi32(_mm256_set1_epi32((i32)(end - i)), lanes);
+        __m256 mask = _mm256_castsi256_ps(_mm256_and_si256(sorted, in_range));
+        
+        low = _mm256_min_ps(low, _mm256_blendv_ps(low, d, mask));
+        high = _mm256_max_ps(high, _mm256_blendv_ps(high, d, mask));
+        _mm256_storeu_ps(&depth[i], _mm256_blendv_ps(none, d, mask));
+    }
+    
+    f32 lows[8], highs[8];
+    _mm256_storeu_ps(lows, low);
+    _mm256_storeu_ps(highs, high);
+    job->depth_low[participant] = lows[0];
+    job->depth_high[participant] = highs[0];
+    for (u32 l = 1; l < 8; l++) {
+        if (lows[l] < job->depth_low[participant]) job->depth_low[participant] = lows[l];
+        if (highs[l] > job->depth_high[participant]) job->depth_high[participant] = highs[l];
+    }
+}
+
+// Pass 2: quantize to 16 bits, farthest first, and count the low digit
+static void sort_quantize_task(void* data, u32 participant) {
+    particle_sort_job* job = (particle_sort_job*)data;
+    u32* keys = job->system->render_order.keys;
+    u32* histogram = job->histogram[participant];
+    memset(histogram, 0, sizeof(job->histogram[0]));
+    
+    u32 begin, end;
+    sort_chunk(job->count, job->participants, participant, &begin, &end);
+    
+    __m256 depth_min = _mm256_set1_ps(job->depth_min);
+    __m256 depth_scale = _mm256_set1_ps(job->depth_scale);
+    __m256 zero = _mm256_setzero_ps();
+    __m256i far_key = _mm256_set1_epi32(65535);
+    __m256i none = _mm256_set1_epi32((i32)PARTICLE_SORT_NONE);
+    
+    for (u32 i = begin; i < end; i += 8) {
+        __m256 d = _mm256_loadu_ps((f32*)&keys[i]);
+        __m256i q = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(d, depth_min), depth_scale));
+        __m256i key = _mm256_sub_epi32(far_key, _mm256_min_epi32(q, far_key));
+        key = _mm256_blendv_epi8(none, key, _mm256_castps_si256(_mm256_cmp_ps(d, zero, _CMP_GE_OQ)));
+        _mm256_storeu_si256((__m256i*)&keys[i], key);
+        
+        u32 group_end = end - i < 8 ? end - i : 8;
+        for (u32 l = 0; l < group_end; l++) {
+            u32 k = keys[i + l];
+            if (k != PARTICLE_SORT_NONE) histogram[k & 0xFF]++;
+        }
+    }
+}
+
+// Pass 4: count the high digit of the partially sorted entries
+static void sort_histogram_task(void* data, u32 participant) {
+    particle_sort_job* job = (particle_sort_job*)data;
+    u32* entries = job->system->render_order.entries;
+    u32* histogram = job->histogram[participant];
+    memset(histogram, 0, sizeof(job->histogram[0]));
+    
+    u32 begin, end;
+    sort_chunk(job->sorted_count, job->participants, participant, &begin, &end);
+    
+    for (u32 i = begin; i < end; i++) {
+        histogram[entries[i] >> PARTICLE_SORT_INDEX_BITS]++;
+    }
+}
+
+// Scatter writes staged per digit and flushed a cache line at a time
+#define PARTICLE_SORT_LINE 16
+
+typedef struct sort_scatter_buffer {
+    u32 values[PARTICLE_SORT_DIGITS][PARTICLE_SORT_LINE];
+    u32 fill[PARTICLE_SORT_DIGITS];
+} sort_scatter_buffer;
+
+static inline void sort_scatter_push(sort_scatter_buffer* buffer, u32* out, u32* offsets,
+                                     u32 digit, u32 value) {
+    u32 n = buffer->fill[digit];
+    buffer->values[digit][n++] = value;
+    if (n == PARTICLE_SORT_LINE) {
+        memcpy(&out[offsets[digit]], buffer->values[digit], sizeof(buffer->values[0]));
+        offsets[digit] += PARTICLE_SORT_LINE;
+        n = 0;
+    }
+    buffer->fill[digit] = n;
+}
+
+static void sort_scatter_flush(sort_scatter_buffer* buffer, u32* out, u32* offsets) {
+    for (u32 d = 0; d < PARTICLE_SORT_DIGITS; d++) {
+        memcpy(&out[offsets[d]], buffer->values[d], buffer->fill[d] * sizeof(u32));
+    }
+}
+
+// Passes 3 and 5: stable scatter by the current digit
+// PERFORMANCE: 256 scattered write streams thrash the TLB and store
+// buffers; staging them turns each into whole cache-line writes
+static void sort_scatter_task(void* data, u32 participant) {
+    particle_sort_job* job = (particle_sort_job*)data;
+    particle_system* system = job->system;
+    u32* offsets = job->histogram[participant];
+    u32 begin, end;
+    
+    sort_scatter_buffer buffer;
+    memset(buffer.fill, 0, sizeof(buffer.fill));
+    
+    // The first pass only carries the high digit forward, packed above
+    // the particle index so each pass writes one stream
+    if (job->pass == 0) {
+        u32* keys = system->render_order.keys;
+        u32* entries_out = system->render_order.entries;
+        
+        sort_chunk(job->count, job->participants, participant, &begin, &end);
+        for (u32 i = begin; i < end; i++) {
+            u32 k = keys[i];
+            if (k == PARTICLE_SORT_NONE) continue;
+            sort_scatter_push(&buffer, entries_out, offsets, k & 0xFF,
+                              ((k >> 8) << PARTICLE_SORT_INDEX_BITS) | i);
+        }
+        sort_scatter_flush(&buffer, entries_out, offsets);
+    } else {
+        u32* entries = system->render_order.entries;
+        u32* indices_out = system->render_order.indices;
+        
+        sort_chunk(job->sorted_count, job->participants, participant, &begin, &end);
+        for (u32 i = begin; i < end; i++) {
+            u32 e = entries[i];
+            sort_scatter_push(&buffer, indices_out, offsets, e >> PARTICLE_SORT_INDEX_BITS,
+                              e & ((1u << PARTICLE_SORT_INDEX_BITS) - 1));
+        }
+        sort_scatter_flush(&buffer, indices_out, offsets);
+    }
+}
+
+// Turns per-participant counts into scatter offsets, returns the total
+static u32 prefix_sort_histograms(particle_sort_job* job) {
+    u32 sum = 0;
+    for (u32 d = 0; d < PARTICLE_SORT_DIGITS; d++) {
+        for (u32 t = 0; t < job->participants; t++) {
+            u32 c = job->histogram[t][d];
+            job->histogram[t][d] = sum;
+            sum += c;
+        }
+    }
+    return sum;
+}
+
+// PERFORMANCE: O(n) in five streaming passes; a comparison sort of 1M
+// particles does not fit in a frame
+void particles_sort_for_rendering(particle_system* system, v3 camera_position) {
+    particle_sort_job* job = system->render_order.job;
+    system->render_order.count = 0;
+    system->stats.particles_sorted = 0;
+    
+    u32 count = system->particles.count;
+    if (count == 0) return;
+    
+    // Only alpha blending depends on draw order
+    b32 any_sorted = false;
+    memset(job->sorted_emitter, 0, sizeof(job->sorted_emitter));
+    for (u32 e = 0; e < system->emitter_count; e++) {
+        particle_emitter* emitter = &system->emitters[e];
+        if (emitter->config.blend_mode == BLEND_ALPHA) {
+            job->sorted_emitter[emitter->slot] = -1;
+            any_sorted = true;
+        }
+    }
+    if (!any_sorted) return;
+    
+    job->system = system;
+    job->camera = camera_position;
+    job->count = count;
+    job->participants = particle_participants(system, count / PARTICLE_UPDATE_BLOCK);
+    
+    run_particle_task(system, job->participants, sort_depth_task, job);
+    
+    f32 low = job->depth_low[0];
+    f32 high = job->depth_high[0];
+    for (u32 t = 1; t < job->participants; t++) {
+        if (job->depth_low[t] < low) low = job->depth_low[t];
+        if (job->depth_high[t] > high) high = job->depth_high[t];
+    }
+    if (high < low) return;  // No sorted particles alive
+    
+    job->depth_min = low;
+    job->depth_scale = (high > low) ? 65535.0f / (high - low) : 0.0f;
+    
+    run_particle_task(system, job->participants, sort_quantize_task, job);
+    job->sorted_count = prefix_sort_histograms(job);
+    
+    job->pass = 0;
+    run_particle_task(system, job->participants, sort_scatter_task, job);
+    
+    // The second pass splits the sorted subset, which may be much smaller
+    job->participants = particle_participants(system, job->sorted_count / PARTICLE_UPDATE_BLOCK);
+    run_particle_task(system, job->participants, sort_histogram_task, job);
+    prefix_sort_histograms(job);
+    
+    job->pass = 1;
+    run_particle_task(system, job->participants, sort_scatter_task, job);
+    
+    system->render_order.count = job->sorted_count;
+    system->stats.particles_sorted = job->sorted_count;
+}
+
+// ============================================================================
+// COLLISION
+// ============================================================================
+
+// Pushes hit lanes out along the contact normal and bounces their velocity
+static inline void resolve_particle_contact(__m256 hit, __m256 nx, __m256 ny, __m256 nz,
+                                            __m256 penetration, f32 restitution, f32 friction,
+                                            __m256* px, __m256* py, __m256* pz,
+                                            __m256* vx, __m256* vy, __m256* vz) {
+    penetration = _mm256_and_ps(penetration, hit);
+    *px = _mm256_fmadd_ps(nx, penetration, *px);
+    *py = _mm256_fmadd_ps(ny, penetration, *py);
+    *pz = _mm256_fmadd_ps(nz, penetration, *pz);
+    
+    // Separating lanes keep their normal speed, approaching ones reflect
+    __m256 vn = _mm256_fmadd_ps(*vx, nx, _mm256_fmadd_ps(*vy, ny, _mm256_mul_ps(*vz, nz)));
+    __m256 tx = _mm256_fnmadd_ps(vn, nx, *vx);
+    __m256 ty = _mm256_fnmadd_ps(vn, ny, *vy);
+    __m256 tz = _mm256_fnmadd_ps(vn, nz, *vz);
+    __m256 approaching = _mm256_cmp_ps(vn, _mm256_setzero_ps(), _CMP_LT_OQ);
+    __m256 vn_out = _mm256_blendv_ps(vn, _mm256_mul_ps(vn, _mm256_set1_ps(-restitution)), approaching);
+    __m256 keep = _mm256_set1_ps(1.0f - friction);
+    
+    *vx = _mm256_blendv_ps(*vx, _mm256_fmadd_ps(tx, keep, _mm256_mul_ps(nx, vn_out)), hit);
+    *vy = _mm256_blendv_ps(*vy, _mm256_fmadd_ps(ty, keep, _mm256_mul_ps(ny, vn_out)), hit);
+    *vz = _mm256_blendv_ps(*vz, _mm256_fmadd_ps(tz, keep, _mm256_mul_ps(nz, vn_out)), hit);
+}
+
+static void record_collision_events(particle_collision_job* job, u32 base, u32 hits,
+                                    __m256 px, __m256 py, __m256 pz,
+                                    __m256 nx, __m256 ny, __m256 nz) {
+    f32 x[8], y[8], z[8], n_x[8], n_y[8], n_z[8];
+    _mm256_storeu_ps(x, px);
+    _mm256_storeu_ps(y, py);
+    _mm256_storeu_ps(z, pz);
+    _mm256_storeu_ps(n_x, nx);
+    _mm256_storeu_ps(n_y, ny);
+    _mm256_storeu_ps(n_z, nz);
+    
+    for (; hits; hits &= hits - 1) {
+        u32 lane = __builtin_ctz(hits);
+        // THREADING: Slots are reserved lock-free; the count may pass the buffer
+        u32 slot = __atomic_fetch_add(&job->event_count, 1, __ATOMIC_RELAXED);
+        if (slot >= PARTICLE_MAX_COLLISION_EVENTS) return;
+        
+        particle_collision_event* event = &job->events[slot];
+        event->particle = base + lane;
+        event->position = (v3){x[lane], y[lane], z[lane]};
+        event->normal = (v3){n_x[lane], n_y[lane], n_z[lane]};
+    }
+}
+
+// Heightfield, planes and spheres for one block, eight particles per step
+static void collide_particle_block(particle_collision_job* job, u32 begin, u32 end, u32 participant) {
+    particle_system* system = job->system;
+    particle_state* p = &system->particles;
+    particle_heightfield* field = &system->heightfield;
+    b32 record = system->collision_callback != NULL;
+    
+    __m256i max_id = _mm256_set1_epi32(PARTICLE_MAX_EMITTERS + 1);
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    
+    for (u32 i = begin; i < end; i += 8) {
+        __m256i flags = _mm256_loadu_si256((__m256i*)&p->flags[i]);
+        __m256i id = _mm256_min_epu32(_mm256_srli_epi32(flags, PARTICLE_EMITTER_SHIFT), max_id);
+        __m256i colliding = _mm256_i32gather_epi32((const int*)job->colliding_emitter, id, 4);
+        __m256i in_range = _mm256_cmpgt_epi32(_mm256_set1_epi32((i32)(end - i)), lanes);
+        __m256 active = _mm256_castsi256_ps(_mm256_and_si256(colliding, in_range));
+        if (!_mm256_movemask_ps(active)) continue;
+        
+        __m256 px = _mm256_loadu_ps(&p->position_x[i]);
+        __m256 py = _mm256_loadu_ps(&p->position_y[i]);
+        __m256 pz = _mm256_loadu_ps(&p->position_z[i]);
+        __m256 vx = _mm256_loadu_ps(&p->velocity_x[i]);
+        __m256 vy = _mm256_loadu_ps(&p->velocity_y[i]);
+        __m256 vz = _mm256_loadu_ps(&p->velocity_z[i]);
+        __m256 radius = _mm256_mul_ps(_mm256_loadu_ps(&p->size[i]), half);
+        u32 group_hits = 0;
+        
+        if (field->heights) {
+            // Bilinear ground height under each particle; lanes off the
+            // grid are clamped for the gathers and masked out
+            __m256 inv_cell = _mm256_set1_ps(1.0f / field->cell_size);
+            __m256 u = _mm256_mul_ps(_mm256_sub_ps(px, _mm256_set1_ps(field->origin.x)), inv_cell);
+            __m256 v = _mm256_mul_ps(_mm256_sub_ps(pz, _mm256_set1_ps(field->origin.z)), inv_cell);
+            __m256 u_max = _mm256_set1_ps((f32)(field->width - 1));
+            __m256 v_max = _mm256_set1_ps((f32)(field->depth - 1));
+            __m256 on_grid = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, u_max, _CMP_LT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ), _mm256_cmp_ps(v, v_max, _CMP_LT_OQ)));
+            on_grid = _mm256_and_ps(on_grid, active);
+            
+            if (_mm256_movemask_ps(on_grid)) {
+                u = _mm256_and_ps(u, on_grid);
+                v = _mm256_and_ps(v, on_grid);
+                __m256 u0 = _mm256_floor_ps(u);
+                __m256 v0 = _mm256_floor_ps(v);
+                __m256 fu = _mm256_sub_ps(u, u0);
+                __m256 fv = _mm256_sub_ps(v, v0);
+                
+                __m256i width = _mm256_set1_epi32((i32)field->width);
+                __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_cvttps_epi32(v0), width),
+                                                 _mm256_cvttps_epi32(u0));
+                __m256 h00 = _mm256_i32gather_ps(field->heights, index, 4);
+                __m256 h10 = _mm256_i32gather_ps(field->heights + 1, index, 4);
+                __m256 h01 = _mm256_i32gather_ps(field->heights + field->width, index, 4);
+                __m256 h11 = _mm256_i32gather_ps(field->heights + field->width + 1, index, 4);
+                
+                __m256 h0 = _mm256_fmadd_ps(_mm256_sub_ps(h10, h00), fu, h00);
+                __m256 h1 = _mm256_fmadd_ps(_mm256_sub_ps(h11, h01), fu, h01);
+                __m256 ground = _mm256_add_ps(_mm256_fmadd_ps(_mm256_sub_ps(h1, h0), fv, h0),
+                                              _mm256_set1_ps(field->origin.y));
+                
+                __m256 penetration = _mm256_sub_ps(_mm256_add_ps(ground, radius), py);
+                __m256 hit = _mm256_and_ps(_mm256_cmp_ps(penetration, zero, _CMP_GT_OQ), on_grid);
+                u32 hits = (u32)_mm256_movemask_ps(hit);
+                
+                if (hits) {
+                    // Normal from the surface gradient (-dh/dx, 1, -dh/dz)
+                    __m256 dhdx = _mm256_mul_ps(_mm256_fmadd_ps(_mm256_sub_ps(_mm256_sub_ps(h11, h01),
+                                                                              _mm256_sub_ps(h10, h00)), fv,
+                                                                _mm256_sub_ps(h10, h00)), inv_cell);
+                    __m256 dhdz = _mm256_mul_ps(_mm256_sub_ps(h1, h0), inv_cell);
+                    __m256 nx = _mm256_sub_ps(zero, dhdx);
+                    __m256 nz = _mm256_sub_ps(zero, dhdz);
+                    __m256 inv_len = _mm256_rsqrt_ps(_mm256_fmadd_ps(nx, nx, _mm256_fmadd_ps(nz, nz, one)));
+                    nx = _mm256_mul_ps(nx, inv_len);
+                    nz = _mm256_mul_ps(nz, inv_len);
+                    __m256 ny = inv_len;
+                    
+                    // Heights are vertical, so lift straight up to the surface
+                    __m256 lift = _mm256_and_ps(penetration, hit);
+                    py = _mm256_add_ps(py, lift);
+                    resolve_particle_contact(hit, nx, ny, nz, zero, field->restitution, field->friction,
+                                             &px, &py, &pz, &vx, &vy, &vz);
+                    if (record) record_collision_events(job, i, hits, px, py, pz, nx, ny, nz);
+                    group_hits |= hits;
+                }
+            }
+        }
+        
+        for (u32 c = 0; c < system->collider_count; c++) {
+            particle_collider* collider = &system->colliders[c];
+            if (!collider->is_active) continue;
+            
+            __m256 dx = _mm256_sub_ps(px, _mm256_set1_ps(collider->position.x));
+            __m256 dy = _mm256_sub_ps(py, _mm256_set1_ps(collider->position.y));
+            __m256 dz = _mm256_sub_ps(pz, _mm256_set1_ps(collider->position.z));
+            __m256 nx, ny, nz, penetration;
+            
+            if (collider->type == COLLIDER_PLANE) {
+                nx = _mm256_set1_ps(collider->normal.x);
+                ny = _mm256_set1_ps(collider->normal.y);
+                nz = _mm256_set1_ps(collider->normal.z);
+                __m256 distance = _mm256_fmadd_ps(dx, nx, _mm256_fmadd_ps(dy, ny, _mm256_mul_ps(dz, nz)));
+                penetration = _mm256_sub_ps(radius, distance);
+            } else {
+                __m256 dist_sq = _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz)));
+                // Centered particles get a zero normal and are left alone
+                __m256 inv = _mm256_and_ps(_mm256_rsqrt_ps(dist_sq),
+                                           _mm256_cmp_ps(dist_sq, _mm256_set1_ps(1e-12f), _CMP_GT_OQ));
+                nx = _mm256_mul_ps(dx, inv);
+                ny = _mm256_mul_ps(dy, inv);
+                nz = _mm256_mul_ps(dz, inv);
+                __m256 distance = _mm256_mul_ps(dist_sq, inv);
+                penetration = _mm256_sub_ps(_mm256_add_ps(_mm256_set1_ps(collider->radius), radius), distance);
+            }
+            
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(penetration, zero, _CMP_GT_OQ), active);
+            u32 hits = (u32)_mm256_movemask_ps(hit);
+            if (!hits) continue;
+            
+            resolve_particle_contact(hit, nx, ny, nz, penetration, collider->restitution, collider->friction,
+                                     &px, &py, &pz, &vx, &vy, &vz);
+            if (record) record_collision_events(job, i, hits, px, py, pz, nx, ny, nz);
+            group_hits |= hits;
+        }
+        
+        if (!group_hits) continue;
+        job->hits[participant] += (u32)__builtin_popcount(group_hits);
+        
+        _mm256_storeu_ps(&p->position_x[i], px);
+        _mm256_storeu_ps(&p->position_y[i], py);
+        _mm256_storeu_ps(&p->position_z[i], pz);
+        _mm256_storeu_ps(&p->velocity_x[i], vx);
+        _mm256_storeu_ps(&p->velocity_y[i], vy);
+        _mm256_storeu_ps(&p->velocity_z[i], vz);
+    }
+}
+
+static void collide_particles_task(void* data, u32 participant) {
+    particle_collision_job* job = (particle_collision_job*)data;
+    job->hits[participant] = 0;
+    
+    for (;;) {
+        u32 b = __atomic_fetch_add(&job->next_block, 1, __ATOMIC_RELAXED);
+        if (b >= job->block_count) break;
+        
+        u32 begin = b * PARTICLE_UPDATE_BLOCK;
+        u32 end = begin + PARTICLE_UPDATE_BLOCK;
+        if (end > job->count) end = job->count;
+        collide_particle_block(job, begin, end, participant);
+    }
+}
+
+// Cell of a point in the 3D hash, folded into the 2D table. Linear in x
+// so a row of neighbor cells is one run of buckets.
+static inline u32 spatial_hash_cell(particle_system* system, i32 x, i32 y, i32 z) {
+    u32 h = (u32)x + (u32)y * 19349663u + (u32)z * 83492791u;
+    return h & (system->spatial_hash.grid_size * system->spatial_hash.grid_size - 1);
+}
+
+// Counting sort, step 1: hash every colliding particle and count per cell.
+// THREADING: Shared counters only need atomics when workers take part
+static void grid_count_task(void* data, u32 participant) {
+    particle_collision_job* job = (particle_collision_job*)data;
+    particle_system* system = job->system;
+    particle_state* p = &system->particles;
+    u32* cells = system->spatial_hash.particle_cells;
+    u32* counts = system->spatial_hash.cell_ends;
+    f32 inv_cell = 1.0f / system->spatial_hash.cell_size;
+    b32 shared = job->participants > 1;
+    
+    u32 begin, end;
+    sort_chunk(job->count, job->participants, participant, &begin, &end);
+    
+    for (u32 i = begin; i < end; i++) {
+        u32 id = p->flags[i] >> PARTICLE_EMITTER_SHIFT;
+        if (id > PARTICLE_MAX_EMITTERS || !job->colliding_emitter[id]) {
+            cells[i] = PARTICLE_CELL_NONE;
+            continue;
+        }
+        
+        u32 cell = spatial_hash_cell(system,
+                                     (i32)floorf(p->position_x[i] * inv_cell),
+                                     (i32)floorf(p->position_y[i] * inv_cell),
+                                     (i32)floorf(p->position_z[i] * inv_cell));
+        cells[i] = cell;
+        if (shared) __atomic_fetch_add(&counts[cell], 1, __ATOMIC_RELAXED);
+        else counts[cell]++;
+    }
+}
+
+// Counting sort, step 3: drop each particle into its cell's range.
+// CACHE: Positions are copied along so neighbor scans read contiguously
+static void grid_scatter_task(void* data, u32 participant) {
+    particle_collision_job* job = (particle_collision_job*)data;
+    particle_system* system = job->system;
+    particle_state* p = &system->particles;
+    u32* cells = system->spatial_hash.particle_cells;
+    u32* cursors = system->spatial_hash.cell_ends;
+    u32* indices = system->spatial_hash.particle_indices;
+    f32* positions = system->spatial_hash.cell_positions;
+    b32 shared = job->participants > 1;
+    
+    u32 begin, end;
+    sort_chunk(job->count, job->participants, participant, &begin, &end);
+    
+    for (u32 i = begin; i < end; i++) {
+        u32 cell = cells[i];
+        if (cell == PARTICLE_CELL_NONE) continue;
+        u32 slot = shared ? __atomic_fetch_add(&cursors[cell], 1, __ATOMIC_RELAXED) : cursors[cell]++;
+        indices[slot] = i;
+        positions[slot * 3 + 0] = p->position_x[i];
+        positions[slot * 3 + 1] = p->position_y[i];
+        positions[slot * 3 + 2] = p->position_z[i];
+    }
+}
+
+// Accumulates the push on slot k from the slots in [begin, end)
+static inline void repel_from_slots(const f32* positions, u32 k, u32 begin, u32 end,
+                                    f32 radius, f32 inv_radius, f32 push_dt, f32* dv) {
+    f32 x = positions[k * 3 + 0];
+    f32 y = positions[k * 3 + 1];
+    f32 z = positions[k * 3 + 2];
+    
+    for (u32 m = begin; m < end; m++) {
+        f32 dx = x - positions[m * 3 + 0];
+        f32 dy = y - positions[m * 3 + 1];
+        f32 dz = z - positions[m * 3 + 2];
+        f32 dist_sq = dx*dx + dy*dy + dz*dz;
+        if (m == k || dist_sq >= radius * radius || dist_sq < 1e-12f) continue;
+        
+        f32 dist = sqrtf(dist_sq);
+        f32 push = push_dt * (1.0f - dist * inv_radius) / dist;
+        dv[0] += dx * push;
+        dv[1] += dy * push;
+        dv[2] += dz * push;
+    }
+}
+
+// Soft particle-particle push within one cell size. Walks the grid in cell
+// order so consecutive particles share neighbor cells. Only velocities are
+// written, one per slot, so blocks of slots run in parallel.
+// PERFORMANCE: Each of the nine neighbor rows is a single bucket range
+// unless it wraps the table, so lookups drop from 27 to 9
+static void repel_particles_task(void* data, u32 participant) {
+    particle_collision_job* job = (particle_collision_job*)data;
+    particle_system* system = job->system;
+    particle_state* p = &system->particles;
+    u32* starts = system->spatial_hash.cell_starts;
+    u32* indices = system->spatial_hash.particle_indices;
+    f32* positions = system->spatial_hash.cell_positions;
+    u32 cell_count = system->spatial_hash.grid_size * system->spatial_hash.grid_size;
+    f32 radius = system->spatial_hash.cell_size;
+    f32 inv_cell = 1.0f / radius;
+    f32 push_dt = system->spatial_hash.repulsion_strength * job->dt;
+    (void)participant;  // Blocks are claimed, not partitioned
+    
+    u32 block_count = (job->grid_count + PARTICLE_UPDATE_BLOCK - 1) / PARTICLE_UPDATE_BLOCK;
+    for (;;) {
+        u32 b = __atomic_fetch_add(&job->next_block, 1, __ATOMIC_RELAXED);
+        if (b >= block_count) break;
+        
+        u32 begin = b * PARTICLE_UPDATE_BLOCK;
+        u32 end = begin + PARTICLE_UPDATE_BLOCK;
+        if (end > job->grid_count) end = job->grid_count;
+        
+        for (u32 k = begin; k < end; k++) {
+            i32 cx = (i32)floorf(positions[k * 3 + 0] * inv_cell);
+            i32 cy = (i32)floorf(positions[k * 3 + 1] * inv_cell);
+            i32 cz = (i32)floorf(positions[k * 3 + 2] * inv_cell);
+            f32 dv[3] = {0.0f, 0.0f, 0.0f};
+            
+            // Hash collisions can list a bucket twice; rare enough to ignore
+            for (i32 oz = -1; oz <= 1; oz++)
+            for (i32 oy = -1; oy <= 1; oy++) {
+                u32 first = spatial_hash_cell(system, cx - 1, cy + oy, cz + oz);
+                if (first + 3 <= cell_count) {
+                    repel_from_slots(positions, k, starts[first], starts[first + 3],
+                                     radius, inv_cell, push_dt, dv);
+                } else {
+                    for (i32 ox = -1; ox <= 1; ox++) {
+                        u32 cell = spatial_hash_cell(system, cx + ox, cy + oy, cz + oz);
+                        repel_from_slots(positions, k, starts[cell], starts[cell + 1],
+                                         radius, inv_cell, push_dt, dv);
+                    }
+                }
+            }
+            
+            u32 i = indices[k];
+            p->velocity_x[i] += dv[0];
+            p->velocity_y[i] += dv[1];
+            p->velocity_z[i] += dv[2];
+        }
+    }
+}
+
+static void build_spatial_hash(particle_system* system, particle_collision_job* job) {
+    u32 cell_count = system->spatial_hash.grid_size * system->spatial_hash.grid_size;
+    u32* starts = system->spatial_hash.cell_starts;
+    u32* ends = system->spatial_hash.cell_ends;
+    
+    memset(ends, 0, cell_count * sizeof(u32));
+    run_particle_task(system, job->participants, grid_count_task, job);
+    
+    // Counts become ranges; ends doubles as the scatter cursor. starts has
+    // one extra entry so a cell's range is [starts[c], starts[c + 1]).
+    u32 sum = 0;
+    for (u32 c = 0; c < cell_count; c++) {
+        u32 n = ends[c];
+        starts[c] = sum;
+        ends[c] = sum;
+        sum += n;
+    }
+    starts[cell_count] = sum;
+    job->grid_count = sum;
+    
+    run_particle_task(system, job->participants, grid_scatter_task, job);
+}
+
+// Runs after compaction, so callback particle ids index the live arrays
+// until the next update
+static void collide_particles(particle_system* system, f32 delta_time) {
+    u32 count = system->particles.count;
+    system->stats.particle_collisions = 0;
+    if (!system->enable_collisions || count == 0) return;
+    
+    b32 world = system->heightfield.heights != NULL;
+    for (u32 c = 0; c < system->collider_count; c++) {
+        if (system->colliders[c].is_active) world = true;
+    }
+    b32 repel = system->spatial_hash.repulsion_strength > 0.0f;
+    if (!world && !repel) return;
+    
+    particle_collision_job* job = system->collision_job;
+    b32 any_colliding = false;
+    memset(job->colliding_emitter, 0, sizeof(job->colliding_emitter));
+    for (u32 e = 0; e < system->emitter_count; e++) {
+        particle_emitter* emitter = &system->emitters[e];
+        if (emitter->config.enable_collision && emitter->is_due) {
+            job->colliding_emitter[emitter->slot] = -1;
+            any_colliding = true;
+        }
+    }
+    if (!any_colliding) return;
+    
+    job->system = system;
+    job->dt = delta_time;
+    job->count = count;
+    job->block_count = (count + PARTICLE_UPDATE_BLOCK - 1) / PARTICLE_UPDATE_BLOCK;
+    job->participants = particle_participants(system, job->block_count);
+    job->event_count = 0;
+    
+    if (world) {
+        job->next_block = 0;
+        run_particle_task(system, job->participants, collide_particles_task, job);
+        for (u32 t = 0; t < job->participants; t++) {
+            system->stats.particle_collisions += job->hits[t];
+        }
+    }
+    
+    if (repel) {
+        build_spatial_hash(system, job);
+        job->next_block = 0;
+        run_particle_task(system, particle_participants(system, job->grid_count / PARTICLE_UPDATE_BLOCK),
+                          repel_particles_task, job);
+    }
+    
+    // Callbacks run on the calling thread, never on workers
+    if (system->collision_callback) {
+        u32 events = job->event_count < PARTICLE_MAX_COLLISION_EVENTS ?
+            job->event_count : PARTICLE_MAX_COLLISION_EVENTS;
+        for (u32 e = 0; e < events; e++) {
+            particle_collision_event* event = &job->events[e];
+            system->collision_callback(event->particle, event->position, event->normal);
+        }
+    }
+}
+
+void particles_enable_collisions(particle_system* system, b32 enable) {
+    system->enable_collisions = enable;
+}
+
+void particles_set_collision_callback(particle_system* system,
+    void (*callback)(particle_id, v3 position, v3 normal)) {
+    system->collision_callback = callback;
+}
+
+u32 particles_add_collider(particle_system* system, const particle_collider* collider) {
+    if (system->collider_count >= PARTICLE_MAX_COLLIDERS) {
+        printf("Particle system: Max colliders reached!\n");
+        return (u32)-1;
+    }
+    
+    u32 index = system->collider_count++;
+    system->colliders[index] = *collider;
+    return index;
+}
+
+void particles_remove_collider(particle_system* system, u32 index) {
+    if (index >= system->collider_count) return;
+    
+    system->collider_count--;
+    if (index < system->collider_count) {
+        memmove(&system->colliders[index], &system->colliders[index + 1],
+               (system->collider_count - index) * sizeof(particle_collider));
+    }
+}
+
+void particles_set_heightfield(particle_system* system, const particle_heightfield* heightfield) {
+    if (!heightfield || !heightfield->heights || heightfield->width < 2 || heightfield->depth < 2) {
+        memset(&system->heightfield, 0, sizeof(system->heightfield));
+        return;
+    }
+    system->heightfield = *heightfield;
+}
+
+// radius becomes the hash cell size, so one ring of neighbor cells covers it
+void particles_set_repulsion(particle_system* system, f32 radius, f32 strength) {
+    if (radius <= 0.0f || strength <= 0.0f) {
+        system->spatial_hash.repulsion_strength = 0.0f;
+        return;
+    }
+    system->spatial_hash.cell_size = radius;
+    system->spatial_hash.repulsion_strength = strength;
+}
 // ============================================================================
 // PRESET EFFECTS
 // ============================================================================
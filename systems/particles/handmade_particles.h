@@ -29,6 +29,15 @@
 #define PARTICLE_MAX_TOTAL         (1024 * 1024)  // 1M particles
 #define PARTICLE_TEXTURE_SLOTS     64
 #define PARTICLE_FORCE_FIELDS      32
+#define PARTICLE_MAX_COLLIDERS     16
+#define PARTICLE_MAX_COLLISION_EVENTS 4096  // Callbacks per update, extra hits are counted only
+#define PARTICLE_UPDATE_BLOCK      1024  // Particles per update block (~64KB of SoA data)
+#define PARTICLE_MAX_WORKERS       8
+#define PARTICLE_LOD_LEVELS        4     // Level n ticks every 2^n and spawns at 1/2^n rate
+
+// Particle flags - the owning emitter id lives in the high 16 bits
+#define PARTICLE_FLAG_DEAD         0x1
+#define PARTICLE_EMITTER_SHIFT     16
 
 // ============================================================================
 // TYPES
@@ -151,7 +160,8 @@ typedef struct emitter_config {
 
 // Particle emitter
 typedef struct particle_emitter {
-    emitter_id id;
+    emitter_id id;           // Never reused, see next_emitter_id
+    u32 slot;                // Per-emitter table key and particle owner tag
     emitter_config config;
     
     // Runtime state
@@ -161,6 +171,12 @@ typedef struct particle_emitter {
     b32 is_active;
     b32 is_paused;
     
+    // LOD scheduling
+    f32 update_accumulator;  // Time since the particles last moved
+    u32 lod_level;
+    b32 is_culled;           // Bounds outside the view frustum
+    b32 is_due;              // Particles simulated by this update
+    
     // Particle pool indices
     u32 particle_start;
     u32 particle_count;
@@ -183,6 +199,39 @@ typedef struct force_field {
     b32 is_active;
 } force_field;
 
+// View frustum plane, inside where dot(normal, p) + d >= 0
+typedef struct particle_frustum_plane {
+    v3 normal;
+    f32 d;
+} particle_frustum_plane;
+
+// World collider for particles of emitters with enable_collision
+typedef struct particle_collider {
+    enum {
+        COLLIDER_PLANE,     // Solid half-space behind the plane
+        COLLIDER_SPHERE     // Solid sphere
+    } type;
+    
+    v3 position;          // Point on the plane or sphere center
+    v3 normal;            // Plane normal (unit length)
+    f32 radius;           // Sphere radius
+    f32 restitution;      // Normal velocity kept after a bounce
+    f32 friction;         // Tangential velocity removed on contact
+    
+    b32 is_active;
+} particle_collider;
+
+// Ground heights sampled on a regular grid, row-major in z
+typedef struct particle_heightfield {
+    const f32* heights;   // width * depth samples, owned by the caller
+    u32 width;
+    u32 depth;
+    v3 origin;            // World position of sample (0, 0)
+    f32 cell_size;
+    f32 restitution;
+    f32 friction;
+} particle_heightfield;
+
 // Particle system context
 typedef struct particle_system {
     // Memory arena
@@ -197,20 +246,57 @@ typedef struct particle_system {
     particle_emitter* emitters;
     u32 emitter_count;
     u32 emitter_capacity;
+    emitter_id next_emitter_id;  // Monotonic, a destroyed emitter's id stays dead
     
     // Force fields
     force_field force_fields[PARTICLE_FORCE_FIELDS];
     u32 force_field_count;
     
+    // World colliders
+    particle_collider colliders[PARTICLE_MAX_COLLIDERS];
+    u32 collider_count;
+    particle_heightfield heightfield;
+    void (*collision_callback)(particle_id, v3 position, v3 normal);
+    struct particle_collision_job* collision_job;
+    
     // Spatial hash for collisions
     struct {
         u32* cell_starts;
         u32* cell_ends;
         u32* particle_indices;
+        u32* particle_cells;    // Hashed cell per particle, rebuilt each update
+        f32* cell_positions;    // xyz per particle_indices slot, in cell order
         f32 cell_size;
         u32 grid_size;
+        f32 repulsion_strength; // Particle-particle push, 0 disables the grid
     } spatial_hash;
     
+    // Back-to-front draw order for alpha-blended particles
+    struct {
+        u32* indices;        // Particle indices, farthest first
+        u32 count;
+        u32* keys;           // Radix sort scratch
+        u32* entries;
+        struct particle_sort_job* job;
+    } render_order;
+    
+    // Distance LOD and view culling of emitters
+    struct {
+        v3 camera_position;
+        particle_frustum_plane planes[6];  // left, right, top, bottom, near, far
+        b32 has_camera;
+        b32 has_frustum;
+        b32 enabled;
+        f32 distance;          // LOD level 1 starts here, each doubling adds a level
+        f32 update_interval;   // Seconds between ticks, 0 ticks every update
+        f32 tick_accumulator;
+        u32 tick;
+    } lod;
+    
+    // Block-parallel update (workers are optional)
+    struct particle_update_job* update_job;
+    struct particle_worker_pool* workers;
+    
     // GPU resources (optional)
     struct {
         void* compute_shader;
@@ -223,6 +309,11 @@ typedef struct particle_system {
     struct {
         u32 particles_spawned;
         u32 particles_killed;
+        u32 particles_sorted;
+        u32 particle_collisions;
+        u32 particles_simulated;
+        u32 particles_skipped;   // Waiting for their emitter's LOD tick
+        u32 emitters_culled;
         f32 update_time_ms;
         f32 render_time_ms;
     } stats;
@@ -265,6 +356,10 @@ void particles_update(particle_system* system, f32 delta_time);
 void particles_update_simd(particle_system* system, f32 delta_time);
 void particles_update_gpu(particle_system* system, f32 delta_time);
 
+// Worker threads share update blocks with the calling thread
+b32 particles_start_workers(particle_system* system, u32 worker_count);
+void particles_stop_workers(particle_system* system);
+
 // Rendering
 typedef struct particle_render_data {
     f32* positions;      // x,y,z interleaved
@@ -273,6 +368,11 @@ typedef struct particle_render_data {
     f32* rotations;
     u32* texture_ids;
     u32 count;
+    
+    // Alpha-blended particles back to front, from particles_sort_for_rendering.
+    // Additive, multiply and screen particles are order independent.
+    u32* sorted_indices;
+    u32 sorted_count;
 } particle_render_data;
 
 particle_render_data particles_get_render_data(particle_system* system);
@@ -282,6 +382,10 @@ void particles_sort_for_rendering(particle_system* system, v3 camera_position);
 void particles_enable_collisions(particle_system* system, b32 enable);
 void particles_set_collision_callback(particle_system* system, 
     void (*callback)(particle_id, v3 position, v3 normal));
+u32 particles_add_collider(particle_system* system, const particle_collider* collider);
+void particles_remove_collider(particle_system* system, u32 index);
+void particles_set_heightfield(particle_system* system, const particle_heightfield* heightfield);
+void particles_set_repulsion(particle_system* system, f32 radius, f32 strength);
 
 // ============================================================================
 // PRESET EFFECTS
@@ -307,6 +411,8 @@ emitter_config particles_preset_water_splash(v3 position);
 void particles_set_max_particles(particle_system* system, u32 max);
 void particles_set_update_frequency(particle_system* system, f32 hz);
 void particles_enable_lod(particle_system* system, b32 enable, f32 distance);
+void particles_set_view(particle_system* system, v3 camera_position,
+                        const particle_frustum_plane* planes);  // planes: 6 or NULL
 
 // Debug visualization
 void particles_debug_draw_emitters(particle_system* system);
@@ -3,6 +3,13 @@
 #include <stdlib.h>
 #include <time.h>
 
+// Wall clock - clock() counts CPU time of every worker thread
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
 int main() {
     printf("=== Particle System Performance Test ===\n\n");
     
@@ -11,6 +18,7 @@ int main() {
     void* memory = malloc(memory_size);
     
     particle_system* system = particles_init(memory, memory_size);
+    particles_start_workers(system, 3);
     
     // Create multiple emitters
     v3 positions[] = {
@@ -34,15 +42,16 @@ int main() {
     printf("Particles active: %u\n", system->particles.count);
     
     // Benchmark different particle counts
-    u32 test_counts[] = {1000, 10000, 50000, 100000};
+    u32 test_counts[] = {1000, 10000, 50000, 100000, PARTICLE_MAX_TOTAL};
     
-    for (int t = 0; t < 4; t++) {
+    for (int t = 0; t < 5; t++) {
         // Reset and spawn exact number
         particles_reset(system);
         
         u32 target = test_counts[t];
         emitter_config burst_cfg = particles_preset_explosion((v3){0,0,0}, 1.0f);
-        burst_cfg.particle_lifetime = 10.0f;  // Long lifetime
+        burst_cfg.particle_lifetime = 1000.0f;  // Outlives the benchmark
+        burst_cfg.blend_mode = BLEND_ALPHA;     // Sorted for rendering
         emitter_id burst = particles_create_emitter(system, &burst_cfg);
         
         while (system->particles.count < target) {
@@ -52,23 +61,32 @@ int main() {
         }
         
         // Benchmark update
-        clock_t start = clock();
-        int iterations = 1000;
+        // Same particle-update budget per count, at most 1000 frames
+        int iterations = (int)(100000000u / target);
+        if (iterations > 1000) iterations = 1000;
+        double start = now_ms();
         
         for (int i = 0; i < iterations; i++) {
             particles_update(system, 0.016f);
         }
         
-        clock_t end = clock();
-        double time_ms = ((double)(end - start) / CLOCKS_PER_SEC) * 1000.0;
+        double time_ms = now_ms() - start;
         double per_frame = time_ms / iterations;
         double particles_per_ms = target / per_frame;
         
-        printf("\n%u particles:\n", target);
+        printf("\n%u particles (%d frames):\n", target, iterations);
         printf("  Total time: %.2f ms\n", time_ms);
         printf("  Per frame: %.3f ms\n", per_frame);
         printf("  Throughput: %.0f particles/ms\n", particles_per_ms);
         printf("  Can sustain: %.0f FPS\n", 1000.0 / per_frame);
+        
+        // Benchmark back-to-front render sort
+        start = now_ms();
+        for (int i = 0; i < 100; i++) {
+            particles_sort_for_rendering(system, (v3){0, 5, -20});
+        }
+        printf("  Depth sort: %.3f ms (%u sorted)\n",
+               (now_ms() - start) / 100, system->stats.particles_sorted);
     }
     
     // Test memory usage
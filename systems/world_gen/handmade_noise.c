@@ -196,6 +196,97 @@ f32 noise_perlin_3d(noise_state* state, f32 x, f32 y, f32 z) {
     return res;
 }
 
+// =============================================================================
+// BATCH KERNELS
+// =============================================================================
+
+#if defined(__AVX2__) && defined(__FMA__)
+#define NOISE_BATCH_SIMD 1
+#endif
+
+#ifndef NOISE_BATCH_SIMD
+
+// Scalar mirror of perlin_2d_lanes for builds without AVX2/FMA. Same
+// operation order and fused multiply-adds, so it matches the SIMD path bit for
+// bit under IEEE semantics (-ffast-math reassociation voids that guarantee).
+internal f32 perlin_2d_exact(noise_state* state, f32 x, f32 y) {
+    f32 fx = floorf(x);
+    f32 fy = floorf(y);
+    s32 X = (s32)fx & 255;
+    s32 Y = (s32)fy & 255;
+    x -= fx;
+    y -= fy;
+    
+    f32 u = x * x * x * fmaf(x, fmaf(x, 6.0f, -15.0f), 10.0f);
+    f32 v = y * y * y * fmaf(y, fmaf(y, 6.0f, -15.0f), 10.0f);
+    
+    u32 A = state->perm[X] + Y;
+    u32 B = state->perm[X + 1] + Y;
+    
+    f32 g00 = grad2(state->perm[state->perm[A]], x, y);
+    f32 g10 = grad2(state->perm[state->perm[B]], x - 1.0f, y);
+    f32 g01 = grad2(state->perm[state->perm[A + 1]], x, y - 1.0f);
+    f32 g11 = grad2(state->perm[state->perm[B + 1]], x - 1.0f, y - 1.0f);
+    
+    f32 nx0 = fmaf(u, g10 - g00, g00);
+    f32 nx1 = fmaf(u, g11 - g01, g01);
+    return fmaf(v, nx1 - nx0, nx0);
+}
+
+#else
+
+// PERFORMANCE: Gathered byte lookups. Reads 4 bytes per index; the table is
+// followed by grad3 inside noise_state so the over-read stays in bounds.
+internal __m256i perm_gather(noise_state* state, __m256i index) {
+    __m256i bytes = _mm256_i32gather_epi32((const int*)state->perm, index, 1);
+    return _mm256_and_si256(bytes, _mm256_set1_epi32(255));
+}
+
+internal __m256 grad2_simd(__m256i hash, __m256 x, __m256 y) {
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(3));
+    __m256 lt2 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(2), h));
+    __m256 u = _mm256_blendv_ps(y, x, lt2);
+    __m256 v = _mm256_blendv_ps(x, y, lt2);
+    
+    // Bit 0 negates u, bit 1 negates v (sign flip is exact, like scalar negation)
+    __m256 sign_u = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+    __m256 sign_v = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+    return _mm256_add_ps(_mm256_xor_ps(u, sign_u), _mm256_xor_ps(v, sign_v));
+}
+
+// 8-lane Perlin 2D, fully vectorized including hashing
+internal __m256 perlin_2d_lanes(noise_state* state, __m256 x, __m256 y) {
+    __m256 fx = _mm256_floor_ps(x);
+    __m256 fy = _mm256_floor_ps(y);
+    __m256i mask = _mm256_set1_epi32(255);
+    __m256i X = _mm256_and_si256(_mm256_cvttps_epi32(fx), mask);
+    __m256i Y = _mm256_and_si256(_mm256_cvttps_epi32(fy), mask);
+    x = _mm256_sub_ps(x, fx);
+    y = _mm256_sub_ps(y, fy);
+    
+    __m256 u = fade_simd(x);
+    __m256 v = fade_simd(y);
+    
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i A = _mm256_add_epi32(perm_gather(state, X), Y);
+    __m256i B = _mm256_add_epi32(perm_gather(state, _mm256_add_epi32(X, one)), Y);
+    
+    __m256 f_one = _mm256_set1_ps(1.0f);
+    __m256 xm1 = _mm256_sub_ps(x, f_one);
+    __m256 ym1 = _mm256_sub_ps(y, f_one);
+    
+    __m256 g00 = grad2_simd(perm_gather(state, perm_gather(state, A)), x, y);
+    __m256 g10 = grad2_simd(perm_gather(state, perm_gather(state, B)), xm1, y);
+    __m256 g01 = grad2_simd(perm_gather(state, perm_gather(state, _mm256_add_epi32(A, one))), x, ym1);
+    __m256 g11 = grad2_simd(perm_gather(state, perm_gather(state, _mm256_add_epi32(B, one))), xm1, ym1);
+    
+    __m256 nx0 = _mm256_fmadd_ps(u, _mm256_sub_ps(g10, g00), g00);
+    __m256 nx1 = _mm256_fmadd_ps(u, _mm256_sub_ps(g11, g01), g01);
+    return _mm256_fmadd_ps(v, _mm256_sub_ps(nx1, nx0), nx0);
+}
+
+#endif
+
 // =============================================================================
 // SIMD BATCH PROCESSING (8 points at once)
 // =============================================================================
@@ -203,73 +294,33 @@ f32 noise_perlin_3d(noise_state* state, f32 x, f32 y, f32 z) {
 void noise_perlin_2d_simd(noise_state* state, 
                           const f32* x, const f32* y, 
                           f32* output, u32 count) {
+    u32 i = 0;
     
+#ifdef NOISE_BATCH_SIMD
     // Process 8 points at a time
-    u32 simd_count = count & ~7;
-    
-    for (u32 i = 0; i < simd_count; i += 8) {
-        // Load 8 x,y coordinates
+    for (; i + 8 <= count; i += 8) {
         __m256 vx = _mm256_loadu_ps(&x[i]);
         __m256 vy = _mm256_loadu_ps(&y[i]);
-        
-        // Floor to get grid coordinates
-        __m256 fx = _mm256_floor_ps(vx);
-        __m256 fy = _mm256_floor_ps(vy);
-        
-        // Get fractional parts
-        __m256 fracx = _mm256_sub_ps(vx, fx);
-        __m256 fracy = _mm256_sub_ps(vy, fy);
-        
-        // Compute fade curves
-        __m256 u = fade_simd(fracx);
-        __m256 v = fade_simd(fracy);
-        
-        // Convert to integer grid coords (& 255)
-        __m256i ix = _mm256_cvtps_epi32(fx);
-        __m256i iy = _mm256_cvtps_epi32(fy);
-        __m256i mask = _mm256_set1_epi32(255);
-        ix = _mm256_and_si256(ix, mask);
-        iy = _mm256_and_si256(iy, mask);
-        
-        // This part would need gather instructions for full SIMD
-        // For now, we'll do scalar fallback for permutation lookup
-        f32 results[8];
-        s32 ix_arr[8], iy_arr[8];
-        f32 u_arr[8], v_arr[8];
-        f32 fracx_arr[8], fracy_arr[8];
-        
-        _mm256_storeu_si256((__m256i*)ix_arr, ix);
-        _mm256_storeu_si256((__m256i*)iy_arr, iy);
-        _mm256_storeu_ps(u_arr, u);
-        _mm256_storeu_ps(v_arr, v);
-        _mm256_storeu_ps(fracx_arr, fracx);
-        _mm256_storeu_ps(fracy_arr, fracy);
-        
-        for (u32 j = 0; j < 8; j++) {
-            s32 X = ix_arr[j];
-            s32 Y = iy_arr[j];
-            
-            u32 A = state->perm[X] + Y;
-            u32 AA = state->perm[A];
-            u32 AB = state->perm[A + 1];
-            u32 B = state->perm[X + 1] + Y;
-            u32 BA = state->perm[B];
-            u32 BB = state->perm[B + 1];
-            
-            results[j] = lerp(v_arr[j], 
-                lerp(u_arr[j], grad2(state->perm[AA], fracx_arr[j], fracy_arr[j]),
-                              grad2(state->perm[BA], fracx_arr[j] - 1, fracy_arr[j])),
-                lerp(u_arr[j], grad2(state->perm[AB], fracx_arr[j], fracy_arr[j] - 1),
-                              grad2(state->perm[BB], fracx_arr[j] - 1, fracy_arr[j] - 1)));
-        }
-        
-        _mm256_storeu_ps(&output[i], _mm256_loadu_ps(results));
+        _mm256_storeu_ps(&output[i], perlin_2d_lanes(state, vx, vy));
     }
     
-    // Handle remaining points
-    for (u32 i = simd_count; i < count; i++) {
-        output[i] = noise_perlin_2d(state, x[i], y[i]);
+    // Remaining points run through padded lanes so every point sees the same code
+    if (i < count) {
+        f32 px[8] = {0}, py[8] = {0}, result[8];
+        for (u32 j = 0; j < count - i; j++) {
+            px[j] = x[i + j];
+            py[j] = y[i + j];
+        }
+        _mm256_storeu_ps(result, perlin_2d_lanes(state, _mm256_loadu_ps(px), _mm256_loadu_ps(py)));
+        for (u32 j = 0; j < count - i; j++) {
+            output[i + j] = result[j];
+        }
+    }
+#else
+    for (; i < count; i++) {
+        output[i] = perlin_2d_exact(state, x[i], y[i]);
     }
+#endif
 }
 
 // =============================================================================
@@ -304,6 +355,119 @@ f32 noise_fractal_3d(noise_state* state, noise_config* config, f32 x, f32 y, f32
     return value;
 }
 
+// Octave combiners shared by the batch paths. Each octave adds
+// shape(perlin(x * f, y * f)) * a with a single fused multiply-add.
+typedef enum noise_batch_shape {
+    NOISE_SHAPE_FBM,         // n
+    NOISE_SHAPE_RIDGE,       // (offset - |n|)^2 * gain
+    NOISE_SHAPE_TURBULENCE   // |n|
+} noise_batch_shape;
+
+#ifndef NOISE_BATCH_SIMD
+internal f32 shape_octave(noise_batch_shape shape, f32 n, f32 offset, f32 gain) {
+    switch (shape) {
+        case NOISE_SHAPE_RIDGE: {
+            f32 signal = offset - fabsf(n);
+            return signal * signal * gain;
+        }
+        case NOISE_SHAPE_TURBULENCE: return fabsf(n);
+        default: return n;
+    }
+}
+#else
+internal __m256 shape_octave_simd(noise_batch_shape shape, __m256 n, __m256 offset, __m256 gain) {
+    __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    switch (shape) {
+        case NOISE_SHAPE_RIDGE: {
+            __m256 signal = _mm256_sub_ps(offset, _mm256_and_ps(n, abs_mask));
+            return _mm256_mul_ps(_mm256_mul_ps(signal, signal), gain);
+        }
+        case NOISE_SHAPE_TURBULENCE: return _mm256_and_ps(n, abs_mask);
+        default: return n;
+    }
+}
+
+internal __m256 octaves_lanes(noise_state* state, noise_config* config, noise_batch_shape shape,
+                              __m256 x, __m256 y, __m256 offset, __m256 gain) {
+    __m256 value = _mm256_setzero_ps();
+    f32 amplitude = config->amplitude;
+    f32 frequency = config->frequency;
+    
+    for (u32 octave = 0; octave < config->octaves; octave++) {
+        __m256 f = _mm256_set1_ps(frequency);
+        __m256 n = perlin_2d_lanes(state, _mm256_mul_ps(x, f), _mm256_mul_ps(y, f));
+        n = shape_octave_simd(shape, n, offset, gain);
+        value = _mm256_fmadd_ps(n, _mm256_set1_ps(amplitude), value);
+        amplitude *= config->persistence;
+        frequency *= config->lacunarity;
+    }
+    
+    return value;
+}
+#endif
+
+internal void noise_octaves_batch(noise_state* state, noise_config* config,
+                                  noise_batch_shape shape, f32 offset, f32 gain,
+                                  const f32* x, const f32* y, f32* output, u32 count) {
+    u32 i = 0;
+    
+#ifdef NOISE_BATCH_SIMD
+    __m256 voffset = _mm256_set1_ps(offset);
+    __m256 vgain = _mm256_set1_ps(gain);
+    
+    for (; i + 8 <= count; i += 8) {
+        __m256 value = octaves_lanes(state, config, shape,
+                                     _mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&y[i]),
+                                     voffset, vgain);
+        _mm256_storeu_ps(&output[i], value);
+    }
+    
+    if (i < count) {
+        f32 px[8] = {0}, py[8] = {0}, result[8];
+        for (u32 j = 0; j < count - i; j++) {
+            px[j] = x[i + j];
+            py[j] = y[i + j];
+        }
+        __m256 value = octaves_lanes(state, config, shape,
+                                     _mm256_loadu_ps(px), _mm256_loadu_ps(py), voffset, vgain);
+        _mm256_storeu_ps(result, value);
+        for (u32 j = 0; j < count - i; j++) {
+            output[i + j] = result[j];
+        }
+    }
+#else
+    for (; i < count; i++) {
+        f32 value = 0.0f;
+        f32 amplitude = config->amplitude;
+        f32 frequency = config->frequency;
+        
+        for (u32 octave = 0; octave < config->octaves; octave++) {
+            f32 n = perlin_2d_exact(state, x[i] * frequency, y[i] * frequency);
+            value = fmaf(shape_octave(shape, n, offset, gain), amplitude, value);
+            amplitude *= config->persistence;
+            frequency *= config->lacunarity;
+        }
+        
+        output[i] = value;
+    }
+#endif
+}
+
+void noise_fbm_2d_batch(noise_state* state, noise_config* config,
+                        const f32* x, const f32* y, f32* output, u32 count) {
+    noise_octaves_batch(state, config, NOISE_SHAPE_FBM, 0.0f, 1.0f, x, y, output, count);
+}
+
+void noise_ridge_2d_batch(noise_state* state, noise_config* config, f32 offset, f32 gain,
+                          const f32* x, const f32* y, f32* output, u32 count) {
+    noise_octaves_batch(state, config, NOISE_SHAPE_RIDGE, offset, gain, x, y, output, count);
+}
+
+void noise_turbulence_2d_batch(noise_state* state, noise_config* config,
+                               const f32* x, const f32* y, f32* output, u32 count) {
+    noise_octaves_batch(state, config, NOISE_SHAPE_TURBULENCE, 0.0f, 1.0f, x, y, output, count);
+}
+
 // =============================================================================
 // TERRAIN-SPECIFIC NOISE
 // =============================================================================
@@ -344,52 +508,43 @@ f32 noise_billowy(noise_state* state, f32 x, f32 y, f32 z) {
 void terrain_generate_heightmap(noise_state* state, terrain_params* params,
                                 f32* heightmap, u32 width, u32 height) {
     
-    // Generate heightmap using SIMD batch processing
+    noise_config config = {
+        .frequency = params->base_frequency,
+        .amplitude = params->amplitude,
+        .octaves = params->octaves,
+        .persistence = params->persistence,
+        .lacunarity = params->lacunarity,
+        .seed = 0
+    };
+    
     // Use stack allocation for coordinates (avoid arena dependency)
-    f32 x_coords[1024];  // Limit to 1024 width for stack safety
+    f32 x_coords[1024];
     f32 y_coords[1024];
     
-    if (width > 1024) {
-        // For larger widths, process in chunks
-        width = 1024;
-    }
-    
     for (u32 row = 0; row < height; row++) {
-        // Prepare coordinates for this row
-        for (u32 col = 0; col < width; col++) {
-            x_coords[col] = (f32)col * params->base_frequency;
-            y_coords[col] = (f32)row * params->base_frequency;
-        }
-        
-        // Process row with SIMD
-        noise_perlin_2d_simd(state, x_coords, y_coords, 
-                            &heightmap[row * width], width);
-        
-        // Apply terrain shaping
-        for (u32 col = 0; col < width; col++) {
-            u32 idx = row * width + col;
-            f32 h = heightmap[idx];
-            
-            // Add octaves for detail
-            f32 frequency = params->base_frequency * params->lacunarity;
-            f32 amplitude = params->amplitude * params->persistence;
+        // Rows wider than the scratch arrays are processed in spans
+        for (u32 span = 0; span < width; span += 1024) {
+            u32 span_width = width - span < 1024 ? width - span : 1024;
+            f32* out = &heightmap[row * width + span];
             
-            for (u32 octave = 1; octave < params->octaves; octave++) {
-                h += noise_perlin_2d(state, 
-                                    (f32)col * frequency, 
-                                    (f32)row * frequency) * amplitude;
-                frequency *= params->lacunarity;
-                amplitude *= params->persistence;
+            for (u32 col = 0; col < span_width; col++) {
+                x_coords[col] = (f32)(span + col);
+                y_coords[col] = (f32)row;
             }
             
-            // Apply elevation scaling
-            h = h * params->elevation_scale + params->elevation_offset;
+            // All octaves in one SIMD pass
+            noise_fbm_2d_batch(state, &config, x_coords, y_coords, out, span_width);
             
-            // Clamp to valid range
-            if (h < -1.0f) h = -1.0f;
-            if (h > 1.0f) h = 1.0f;
-            
-            heightmap[idx] = h;
+            // Apply terrain shaping
+            for (u32 col = 0; col < span_width; col++) {
+                f32 h = out[col] * params->elevation_scale + params->elevation_offset;
+                
+                // Clamp to valid range
+                if (h < -1.0f) h = -1.0f;
+                if (h > 1.0f) h = 1.0f;
+                
+                out[col] = h;
+            }
         }
     }
 }
@@ -61,6 +61,15 @@ void noise_perlin_3d_simd(noise_state* state,
 f32 noise_fractal_2d(noise_state* state, noise_config* config, f32 x, f32 y);
 f32 noise_fractal_3d(noise_state* state, noise_config* config, f32 x, f32 y, f32 z);
 
+// Batch fractal noise over arrays of points, all octaves per pass (8 lanes, AVX2 + FMA).
+// The scalar path (tails, non-AVX2 builds) is bit-identical to the SIMD path.
+void noise_fbm_2d_batch(noise_state* state, noise_config* config,
+                        const f32* x, const f32* y, f32* output, u32 count);
+void noise_ridge_2d_batch(noise_state* state, noise_config* config, f32 offset, f32 gain,
+                          const f32* x, const f32* y, f32* output, u32 count);
+void noise_turbulence_2d_batch(noise_state* state, noise_config* config,
+                               const f32* x, const f32* y, f32* output, u32 count);
+
 // Terrain-specific noise functions
 f32 noise_ridge(noise_state* state, f32 x, f32 y, f32 z, f32 offset, f32 gain);
 f32 noise_turbulence(noise_state* state, f32 x, f32 y, f32 z, u32 octaves);
@@ -171,6 +171,24 @@ terrain_system* terrain_init(arena* arena, renderer_state* renderer,
         terrain->chunks[i].indices = arena_push_array(arena, u32, max_indices);
     }
     
+    // Allocate heightfield cache
+    terrain->height_tiles = arena_push_array(arena, terrain_height_tile, TERRAIN_HEIGHT_TILE_CACHE_SIZE);
+    terrain->height_tile_samples = arena_push_array(arena, f32, 
+                                                    TERRAIN_HEIGHT_TILE_CACHE_SIZE * TERRAIN_HEIGHT_TILE_SAMPLES);
+    for (u32 i = 0; i < TERRAIN_HEIGHT_TILE_CACHE_SIZE; i++) {
+        terrain->height_tiles[i].mip_mask = 0;
+    }
+    terrain->height_tile_clock = 0;
+    
+    // Allocate raycast pyramid cache
+    terrain->pyramids = arena_push_array(arena, terrain_height_pyramid, TERRAIN_PYRAMID_CACHE_SIZE);
+    for (u32 i = 0; i < TERRAIN_PYRAMID_CACHE_SIZE; i++) {
+        terrain->pyramids[i].is_valid = 0;
+    }
+    terrain->pyramid_clock = 0;
+    memset(terrain->pyramid_misses, 0, sizeof(terrain->pyramid_misses));
+    terrain->pyramid_miss_window = 0;
+    
     // Initialize streaming
     terrain->streaming.load_queue_capacity = 64;
     terrain->streaming.load_queue = arena_push_array(arena, terrain_chunk*, 
@@ -184,7 +202,8 @@ terrain_system* terrain_init(arena* arena, renderer_state* renderer,
 // HEIGHT SAMPLING
 // =============================================================================
 
-f32 terrain_sample_height(terrain_system* terrain, f32 x, f32 z) {
+// Full procedural height, only reached for areas no chunk has generated
+internal f32 terrain_evaluate_height(terrain_system* terrain, f32 x, f32 z) {
     terrain_gen_params* p = &terrain->params;
     
     // Base terrain height
@@ -217,8 +236,272 @@ f32 terrain_sample_height(terrain_system* terrain, f32 x, f32 z) {
     return height * p->vertical_scale;
 }
 
+// =============================================================================
+// HEIGHTFIELD CACHE
+// =============================================================================
+
+#define TERRAIN_HEIGHT_TILE_SETS (TERRAIN_HEIGHT_TILE_CACHE_SIZE / TERRAIN_HEIGHT_TILE_WAYS)
+#define TERRAIN_HEIGHT_MIP_EDGE(level) ((TERRAIN_CHUNK_SIZE >> (level)) + 1)
+
+// Offset of each level in terrain_height_tile.heights
+static const u32 terrain_height_mip_offset[TERRAIN_HEIGHT_MIPS] = {
+    0, 4225, 5314, 5603, 5684
+};
+
+internal s32 terrain_floor_div(s32 value, s32 divisor) {
+    return (value >= 0 ? value : value - (divisor - 1)) / divisor;
+}
+
+internal terrain_height_tile* terrain_height_tile_slot(terrain_system* terrain,
+                                                      s32 chunk_x, s32 chunk_z, b32* found) {
+    u32 hash = (u32)chunk_x * 73856093u ^ (u32)chunk_z * 19349663u;
+    terrain_height_tile* set = &terrain->height_tiles[(hash % TERRAIN_HEIGHT_TILE_SETS) * TERRAIN_HEIGHT_TILE_WAYS];
+    terrain_height_tile* victim = set;
+    
+    for (u32 way = 0; way < TERRAIN_HEIGHT_TILE_WAYS; way++) {
+        terrain_height_tile* tile = &set[way];
+        if (tile->mip_mask && tile->chunk_x == chunk_x && tile->chunk_z == chunk_z) {
+            *found = 1;
+            return tile;
+        }
+        // Prefer empty slots, then the coarsest tile (cheapest to regenerate),
+        // then least recently used. Masks are contiguous up to the top level, so
+        // a smaller mask means a coarser finest level.
+        if (!tile->mip_mask) {
+            if (victim->mip_mask) victim = tile;
+        } else if (victim->mip_mask &&
+                   (tile->mip_mask < victim->mip_mask ||
+                    (tile->mip_mask == victim->mip_mask && tile->last_used < victim->last_used))) {
+            victim = tile;
+        }
+    }
+    
+    *found = 0;
+    return victim;
+}
+
+internal f32* terrain_height_tile_level(terrain_system* terrain, terrain_height_tile* tile, u32 level) {
+    u32 index = (u32)(tile - terrain->height_tiles);
+    return terrain->height_tile_samples + index * TERRAIN_HEIGHT_TILE_SAMPLES + terrain_height_mip_offset[level];
+}
+
+// THREADING: Queries only read the tags and samples, so any number of threads
+// may run them while no chunk is being generated
+internal terrain_height_tile* terrain_lookup_height_tile(terrain_system* terrain, s32 chunk_x, s32 chunk_z) {
+    u32 hash = (u32)chunk_x * 73856093u ^ (u32)chunk_z * 19349663u;
+    terrain_height_tile* set = &terrain->height_tiles[(hash % TERRAIN_HEIGHT_TILE_SETS) * TERRAIN_HEIGHT_TILE_WAYS];
+    
+    for (u32 way = 0; way < TERRAIN_HEIGHT_TILE_WAYS; way++) {
+        terrain_height_tile* tile = &set[way];
+        if (tile->mip_mask && tile->chunk_x == chunk_x && tile->chunk_z == chunk_z) {
+            return tile;
+        }
+    }
+    return 0;
+}
+
+// Lookup for the generation paths, which own the LRU clock
+internal terrain_height_tile* terrain_find_height_tile(terrain_system* terrain, s32 chunk_x, s32 chunk_z) {
+    terrain_height_tile* tile = terrain_lookup_height_tile(terrain, chunk_x, chunk_z);
+    if (tile) tile->last_used = ++terrain->height_tile_clock;
+    return tile;
+}
+
+// Cached height of a lattice point, read only
+internal b32 terrain_cached_lattice_height(terrain_system* terrain, s32 lattice_x, s32 lattice_z,
+                                           f32* height) {
+    s32 chunk_x = terrain_floor_div(lattice_x, TERRAIN_PYRAMID_CHUNK_CELLS);
+    s32 chunk_z = terrain_floor_div(lattice_z, TERRAIN_PYRAMID_CHUNK_CELLS);
+    terrain_height_tile* tile = terrain_lookup_height_tile(terrain, chunk_x, chunk_z);
+    if (!tile) return 0;
+    
+    u32 local_x = (u32)(lattice_x - chunk_x * TERRAIN_PYRAMID_CHUNK_CELLS);
+    u32 local_z = (u32)(lattice_z - chunk_z * TERRAIN_PYRAMID_CHUNK_CELLS);
+    
+    // Every resident level holds exact samples, use any that has this point
+    for (u32 level = 0; level < TERRAIN_HEIGHT_MIPS; level++) {
+        u32 align = (1u << level) - 1;
+        if ((tile->mip_mask & (1u << level)) && !((local_x | local_z) & align)) {
+            *height = terrain_height_tile_level(terrain, tile, level)[
+                (local_z >> level) * TERRAIN_HEIGHT_MIP_EDGE(level) + (local_x >> level)];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void terrain_store_height_tile(terrain_system* terrain, terrain_chunk* chunk) {
+    u32 level = chunk->lod_level;
+    if (!chunk->is_generated || level >= TERRAIN_HEIGHT_MIPS) return;
+    
+    b32 found;
+    terrain_height_tile* tile = terrain_height_tile_slot(terrain, chunk->chunk_x, chunk->chunk_z, &found);
+    if (!found) {
+        tile->chunk_x = chunk->chunk_x;
+        tile->chunk_z = chunk->chunk_z;
+        tile->mip_mask = 0;
+    }
+    tile->last_used = ++terrain->height_tile_clock;
+    
+    // Vertices at this LOD are exactly this level's lattice samples
+    f32* dst = terrain_height_tile_level(terrain, tile, level);
+    u32 edge = TERRAIN_HEIGHT_MIP_EDGE(level);
+    for (u32 i = 0; i < edge * edge; i++) {
+        dst[i] = chunk->vertices[i].position.y;
+    }
+    
+    // Coarser levels keep every other sample of the level below
+    for (u32 mip = level + 1; mip < TERRAIN_HEIGHT_MIPS; mip++) {
+        f32* src = terrain_height_tile_level(terrain, tile, mip - 1);
+        u32 src_edge = TERRAIN_HEIGHT_MIP_EDGE(mip - 1);
+        dst = terrain_height_tile_level(terrain, tile, mip);
+        edge = TERRAIN_HEIGHT_MIP_EDGE(mip);
+        for (u32 z = 0; z < edge; z++) {
+            for (u32 x = 0; x < edge; x++) {
+                dst[z * edge + x] = src[(z * 2) * src_edge + x * 2];
+            }
+        }
+    }
+    
+    tile->mip_mask |= ((1u << TERRAIN_HEIGHT_MIPS) - 1) & ~((1u << level) - 1);
+}
+
+b32 terrain_get_lattice_cell(terrain_system* terrain, s32 cell_x, s32 cell_z, f32 corners[4]) {
+    s32 chunk_x = terrain_floor_div(cell_x, TERRAIN_PYRAMID_CHUNK_CELLS);
+    s32 chunk_z = terrain_floor_div(cell_z, TERRAIN_PYRAMID_CHUNK_CELLS);
+    terrain_height_tile* tile = terrain_lookup_height_tile(terrain, chunk_x, chunk_z);
+    
+    if (tile && (tile->mip_mask & 1)) {
+        u32 local_x = (u32)(cell_x - chunk_x * TERRAIN_PYRAMID_CHUNK_CELLS);
+        u32 local_z = (u32)(cell_z - chunk_z * TERRAIN_PYRAMID_CHUNK_CELLS);
+        f32* row0 = terrain_height_tile_level(terrain, tile, 0) + local_z * TERRAIN_PYRAMID_STRIDE + local_x;
+        f32* row1 = row0 + TERRAIN_PYRAMID_STRIDE;
+        corners[0] = row0[0];
+        corners[1] = row0[1];
+        corners[2] = row1[0];
+        corners[3] = row1[1];
+        return 1;
+    }
+    
+    // Same lattice points the chunk generator stores, so loading a chunk never moves the surface
+    f32 sample_size = terrain->params.horizontal_scale;
+    f32 x0 = (f32)cell_x * sample_size;
+    f32 x1 = (f32)(cell_x + 1) * sample_size;
+    f32 z0 = (f32)cell_z * sample_size;
+    f32 z1 = (f32)(cell_z + 1) * sample_size;
+    corners[0] = terrain_evaluate_height(terrain, x0, z0);
+    corners[1] = terrain_evaluate_height(terrain, x1, z0);
+    corners[2] = terrain_evaluate_height(terrain, x0, z1);
+    corners[3] = terrain_evaluate_height(terrain, x1, z1);
+    return 0;
+}
+
+f32 terrain_sample_height(terrain_system* terrain, f32 x, f32 z) {
+    f32 sample_size = terrain->params.horizontal_scale;
+    f32 grid_x = roundf(x / sample_size);
+    f32 grid_z = roundf(z / sample_size);
+    
+    // CACHE: Lattice points inside generated chunks never touch the noise
+    f32 height;
+    if (fabsf(grid_x) < 1e9f && fabsf(grid_z) < 1e9f &&
+        grid_x * sample_size == x && grid_z * sample_size == z &&
+        terrain_cached_lattice_height(terrain, (s32)grid_x, (s32)grid_z, &height)) {
+        return height;
+    }
+    return terrain_evaluate_height(terrain, x, z);
+}
+
+// Catmull-Rom weights for a sample offset t in [0, 1)
+internal void terrain_cubic_weights(f32 t, f32 weights[4]) {
+    f32 t2 = t * t;
+    f32 t3 = t2 * t;
+    weights[0] = 0.5f * (-t3 + 2.0f * t2 - t);
+    weights[1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+    weights[2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+    weights[3] = 0.5f * (t3 - t2);
+}
+
+// Sample (col, row) of a chunk's level lattice, from the tile when resident.
+// Levels are anchored at the chunk origin, so the analytic fallback has to
+// use the same points for cached and uncached queries to agree.
+internal f32 terrain_level_sample(terrain_system* terrain, f32* heights, s32 chunk_x, s32 chunk_z,
+                                  u32 level, s32 col, s32 row) {
+    if (heights) {
+        return heights[row * TERRAIN_HEIGHT_MIP_EDGE(level) + col];
+    }
+    f32 sample_size = terrain->params.horizontal_scale;
+    return terrain_evaluate_height(terrain,
+        (f32)(chunk_x * TERRAIN_PYRAMID_CHUNK_CELLS + (col << level)) * sample_size,
+        (f32)(chunk_z * TERRAIN_PYRAMID_CHUNK_CELLS + (row << level)) * sample_size);
+}
+
+f32 terrain_get_height_filtered(terrain_system* terrain, f32 world_x, f32 world_z,
+                               f32 footprint, terrain_height_filter filter) {
+    f32 sample_size = terrain->params.horizontal_scale;
+    s32 lattice_x = (s32)floorf(world_x / sample_size);
+    s32 lattice_z = (s32)floorf(world_z / sample_size);
+    s32 chunk_x = terrain_floor_div(lattice_x, TERRAIN_PYRAMID_CHUNK_CELLS);
+    s32 chunk_z = terrain_floor_div(lattice_z, TERRAIN_PYRAMID_CHUNK_CELLS);
+    
+    // Level whose spacing matches the footprint
+    u32 level = 0;
+    while (level + 1 < TERRAIN_HEIGHT_MIPS && (f32)(2u << level) * sample_size <= footprint) {
+        level++;
+    }
+    
+    // Tiles hold every level from their finest down, so a resident level is
+    // exact; anything else evaluates the same lattice points analytically
+    terrain_height_tile* tile = terrain_lookup_height_tile(terrain, chunk_x, chunk_z);
+    f32* heights = 0;
+    if (tile && (tile->mip_mask & (1u << level))) {
+        heights = terrain_height_tile_level(terrain, tile, level);
+    }
+    
+    s32 edge = TERRAIN_HEIGHT_MIP_EDGE(level);
+    f32 spacing = (f32)(1u << level) * sample_size;
+    f32 u = (world_x - (f32)(chunk_x * TERRAIN_PYRAMID_CHUNK_CELLS) * sample_size) / spacing;
+    f32 v = (world_z - (f32)(chunk_z * TERRAIN_PYRAMID_CHUNK_CELLS) * sample_size) / spacing;
+    s32 cell_x = (s32)floorf(u);
+    s32 cell_z = (s32)floorf(v);
+    if (cell_x < 0) cell_x = 0;
+    if (cell_z < 0) cell_z = 0;
+    if (cell_x > edge - 2) cell_x = edge - 2;
+    if (cell_z > edge - 2) cell_z = edge - 2;
+    f32 fx = u - (f32)cell_x;
+    f32 fz = v - (f32)cell_z;
+    
+    if (filter == TERRAIN_FILTER_BICUBIC) {
+        f32 wx[4], wz[4];
+        terrain_cubic_weights(fx, wx);
+        terrain_cubic_weights(fz, wz);
+        
+        // Neighbours past the tile edge clamp, decimated levels do not line up across tiles
+        f32 result = 0.0f;
+        for (s32 j = 0; j < 4; j++) {
+            s32 row = cell_z - 1 + j;
+            row = row < 0 ? 0 : (row >= edge ? edge - 1 : row);
+            f32 row_sum = 0.0f;
+            for (s32 i = 0; i < 4; i++) {
+                s32 col = cell_x - 1 + i;
+                col = col < 0 ? 0 : (col >= edge ? edge - 1 : col);
+                row_sum += terrain_level_sample(terrain, heights, chunk_x, chunk_z, level, col, row) * wx[i];
+            }
+            result += row_sum * wz[j];
+        }
+        return result;
+    }
+    
+    f32 h00 = terrain_level_sample(terrain, heights, chunk_x, chunk_z, level, cell_x, cell_z);
+    f32 h10 = terrain_level_sample(terrain, heights, chunk_x, chunk_z, level, cell_x + 1, cell_z);
+    f32 h01 = terrain_level_sample(terrain, heights, chunk_x, chunk_z, level, cell_x, cell_z + 1);
+    f32 h11 = terrain_level_sample(terrain, heights, chunk_x, chunk_z, level, cell_x + 1, cell_z + 1);
+    f32 h0 = h00 * (1.0f - fx) + h10 * fx;
+    f32 h1 = h01 * (1.0f - fx) + h11 * fx;
+    return h0 * (1.0f - fz) + h1 * fz;
+}
+
 f32 terrain_get_height(terrain_system* terrain, f32 world_x, f32 world_z) {
-    return terrain_sample_height(terrain, world_x, world_z);
+    return terrain_get_height_filtered(terrain, world_x, world_z, 0.0f, TERRAIN_FILTER_BILINEAR);
 }
 
 // =============================================================================
@@ -259,17 +542,29 @@ void terrain_generate_chunk(terrain_system* terrain, terrain_chunk* chunk,
     
     // Generate vertices
     u32 vertex_idx = 0;
-    f32 chunk_world_x = chunk_x * (TERRAIN_CHUNK_SIZE - 1) * terrain->params.horizontal_scale;
-    f32 chunk_world_z = chunk_z * (TERRAIN_CHUNK_SIZE - 1) * terrain->params.horizontal_scale;
     
     chunk->min_bounds = (v3){1e9f, 1e9f, 1e9f};
     chunk->max_bounds = (v3){-1e9f, -1e9f, -1e9f};
     
+    // Integer lattice coordinates keep vertices exactly on the collision lattice
+    s32 lattice_x = chunk_x * (TERRAIN_CHUNK_SIZE - 1);
+    s32 lattice_z = chunk_z * (TERRAIN_CHUNK_SIZE - 1);
+    
     for (u32 z = 0; z < vertices_per_edge; z++) {
         for (u32 x = 0; x < vertices_per_edge; x++) {
-            f32 world_x = chunk_world_x + x * step * terrain->params.horizontal_scale;
-            f32 world_z = chunk_world_z + z * step * terrain->params.horizontal_scale;
-            f32 height = terrain_sample_height(terrain, world_x, world_z);
+            s32 sample_x = lattice_x + (s32)(x * step);
+            s32 sample_z = lattice_z + (s32)(z * step);
+            f32 world_x = (f32)sample_x * terrain->params.horizontal_scale;
+            f32 world_z = (f32)sample_z * terrain->params.horizontal_scale;
+            
+            // Regenerating at another LOD reuses the samples already cached
+            f32 height;
+            if (terrain_cached_lattice_height(terrain, sample_x, sample_z, &height)) {
+                terrain->stats.height_cache_hits++;
+            } else {
+                height = terrain_evaluate_height(terrain, world_x, world_z);
+                terrain->stats.height_cache_misses++;
+            }
             
             terrain_vertex* v = &chunk->vertices[vertex_idx++];
             v->position = (v3){world_x, height, world_z};
@@ -322,6 +617,171 @@ void terrain_generate_chunk(terrain_system* terrain, terrain_chunk* chunk,
     chunk->is_generated = 1;
     chunk->needs_update = 1;
     terrain->stats.chunks_generated++;
+    
+    // Keep the heights for queries, full resolution ones also feed raycasts
+    terrain_store_height_tile(terrain, chunk);
+    if (lod_level == 0) {
+        terrain_build_height_pyramid(terrain, chunk);
+    }
+}
+
+// =============================================================================
+// HEIGHT PYRAMID
+// =============================================================================
+
+#define TERRAIN_PYRAMID_SETS (TERRAIN_PYRAMID_CACHE_SIZE / TERRAIN_PYRAMID_WAYS)
+
+internal void terrain_pyramid_build_levels(terrain_height_pyramid* pyramid) {
+    // Level 0: bounds of the four corners of each lattice cell
+    for (u32 z = 0; z < TERRAIN_CHUNK_SIZE; z++) {
+        f32* row0 = &pyramid->heights[z * TERRAIN_PYRAMID_STRIDE];
+        f32* row1 = row0 + TERRAIN_PYRAMID_STRIDE;
+        f32* min_out = &pyramid->min_height[z * TERRAIN_CHUNK_SIZE];
+        f32* max_out = &pyramid->max_height[z * TERRAIN_CHUNK_SIZE];
+        
+        for (u32 x = 0; x < TERRAIN_CHUNK_SIZE; x++) {
+            f32 lo = fminf(fminf(row0[x], row0[x + 1]), fminf(row1[x], row1[x + 1]));
+            f32 hi = fmaxf(fmaxf(row0[x], row0[x + 1]), fmaxf(row1[x], row1[x + 1]));
+            min_out[x] = lo;
+            max_out[x] = hi;
+        }
+    }
+    
+    // Coarser levels reduce 2x2 children
+    for (u32 level = 1; level < TERRAIN_PYRAMID_LEVELS; level++) {
+        u32 size = TERRAIN_CHUNK_SIZE >> level;
+        u32 child_size = size * 2;
+        f32* child_min = &pyramid->min_height[TERRAIN_PYRAMID_LEVEL_OFFSET(level - 1)];
+        f32* child_max = &pyramid->max_height[TERRAIN_PYRAMID_LEVEL_OFFSET(level - 1)];
+        f32* min_out = &pyramid->min_height[TERRAIN_PYRAMID_LEVEL_OFFSET(level)];
+        f32* max_out = &pyramid->max_height[TERRAIN_PYRAMID_LEVEL_OFFSET(level)];
+        
+        for (u32 z = 0; z < size; z++) {
+            for (u32 x = 0; x < size; x++) {
+                u32 c = (z * 2) * child_size + x * 2;
+                min_out[z * size + x] = fminf(fminf(child_min[c], child_min[c + 1]),
+                                              fminf(child_min[c + child_size], child_min[c + child_size + 1]));
+                max_out[z * size + x] = fmaxf(fmaxf(child_max[c], child_max[c + 1]),
+                                              fmaxf(child_max[c + child_size], child_max[c + child_size + 1]));
+            }
+        }
+    }
+}
+
+internal terrain_height_pyramid* terrain_pyramid_set(terrain_system* terrain, s32 chunk_x, s32 chunk_z) {
+    u32 hash = (u32)chunk_x * 73856093u ^ (u32)chunk_z * 19349663u;
+    return &terrain->pyramids[(hash % TERRAIN_PYRAMID_SETS) * TERRAIN_PYRAMID_WAYS];
+}
+
+// Find the cache slot for a chunk; on a miss returns the slot to overwrite
+internal terrain_height_pyramid* terrain_pyramid_slot(terrain_system* terrain,
+                                                      s32 chunk_x, s32 chunk_z, b32* found) {
+    terrain_height_pyramid* set = terrain_pyramid_set(terrain, chunk_x, chunk_z);
+    terrain_height_pyramid* victim = set;
+    
+    for (u32 way = 0; way < TERRAIN_PYRAMID_WAYS; way++) {
+        terrain_height_pyramid* pyramid = &set[way];
+        if (pyramid->is_valid && pyramid->chunk_x == chunk_x && pyramid->chunk_z == chunk_z) {
+            *found = 1;
+            return pyramid;
+        }
+        // Prefer empty slots, then least recently used
+        if (!pyramid->is_valid) {
+            if (victim->is_valid) victim = pyramid;
+        } else if (victim->is_valid && pyramid->last_used < victim->last_used) {
+            victim = pyramid;
+        }
+    }
+    
+    *found = 0;
+    return victim;
+}
+
+void terrain_build_height_pyramid(terrain_system* terrain, terrain_chunk* chunk) {
+    if (!chunk->is_generated || chunk->lod_level != 0) return;
+    
+    b32 found;
+    terrain_height_pyramid* pyramid = terrain_pyramid_slot(terrain, chunk->chunk_x, chunk->chunk_z, &found);
+    
+    for (u32 i = 0; i < TERRAIN_PYRAMID_STRIDE * TERRAIN_PYRAMID_STRIDE; i++) {
+        pyramid->heights[i] = chunk->vertices[i].position.y;
+    }
+    
+    pyramid->chunk_x = chunk->chunk_x;
+    pyramid->chunk_z = chunk->chunk_z;
+    pyramid->last_used = ++terrain->pyramid_clock;
+    pyramid->is_valid = 1;
+    terrain_pyramid_build_levels(pyramid);
+    terrain->stats.pyramids_built++;
+}
+
+// THREADING: Same contract as the height tiles - any number of threads may
+// look up while no chunk is being generated. Nothing is written, so lookups
+// leave the LRU order to the builds.
+terrain_height_pyramid* terrain_lookup_height_pyramid(terrain_system* terrain,
+                                                      s32 chunk_x, s32 chunk_z) {
+    terrain_height_pyramid* set = terrain_pyramid_set(terrain, chunk_x, chunk_z);
+    
+    for (u32 way = 0; way < TERRAIN_PYRAMID_WAYS; way++) {
+        terrain_height_pyramid* pyramid = &set[way];
+        if (pyramid->is_valid && pyramid->chunk_x == chunk_x && pyramid->chunk_z == chunk_z) {
+            return pyramid;
+        }
+    }
+    return 0;
+}
+
+// Get a chunk's pyramid. Sampling 65x65 heights costs as much as dozens of
+// marched rays, so a chunk is only admitted after repeated misses; until then
+// returns 0. Touches the LRU clock and the miss counters and may build, so
+// only the thread that generates chunks calls it - raycasts use the lookup.
+terrain_height_pyramid* terrain_get_height_pyramid(terrain_system* terrain,
+                                                   s32 chunk_x, s32 chunk_z) {
+    b32 found;
+    terrain_height_pyramid* pyramid = terrain_pyramid_slot(terrain, chunk_x, chunk_z, &found);
+    if (found) {
+        pyramid->last_used = ++terrain->pyramid_clock;
+        return pyramid;
+    }
+    
+    // Age the counters so scattered one-off rays never accumulate into builds
+    if (++terrain->pyramid_miss_window >= TERRAIN_PYRAMID_MISS_WINDOW) {
+        terrain->pyramid_miss_window = 0;
+        for (u32 i = 0; i < TERRAIN_PYRAMID_MISS_SLOTS; i++) {
+            terrain->pyramid_misses[i] >>= 1;
+        }
+    }
+    
+    // A cached full resolution tile makes the build a copy, so admit at once
+    terrain_height_tile* tile = terrain_find_height_tile(terrain, chunk_x, chunk_z);
+    if (tile && (tile->mip_mask & 1)) {
+        memcpy(pyramid->heights, terrain_height_tile_level(terrain, tile, 0), sizeof(pyramid->heights));
+    } else {
+        u32 slot = ((u32)chunk_x * 83492791u ^ (u32)chunk_z * 2654435761u) % TERRAIN_PYRAMID_MISS_SLOTS;
+        if (++terrain->pyramid_misses[slot] < TERRAIN_PYRAMID_ADMIT_MISSES) return 0;
+        terrain->pyramid_misses[slot] = 0;
+        
+        // Same lattice coordinates terrain_get_height_interpolated samples
+        f32 sample_size = terrain->params.horizontal_scale;
+        s32 lattice_x = chunk_x * TERRAIN_PYRAMID_CHUNK_CELLS;
+        s32 lattice_z = chunk_z * TERRAIN_PYRAMID_CHUNK_CELLS;
+        
+        for (u32 z = 0; z < TERRAIN_PYRAMID_STRIDE; z++) {
+            f32 world_z = (f32)(lattice_z + (s32)z) * sample_size;
+            for (u32 x = 0; x < TERRAIN_PYRAMID_STRIDE; x++) {
+                f32 world_x = (f32)(lattice_x + (s32)x) * sample_size;
+                pyramid->heights[z * TERRAIN_PYRAMID_STRIDE + x] = terrain_sample_height(terrain, world_x, world_z);
+            }
+        }
+    }
+    
+    pyramid->chunk_x = chunk_x;
+    pyramid->chunk_z = chunk_z;
+    pyramid->last_used = ++terrain->pyramid_clock;
+    pyramid->is_valid = 1;
+    terrain_pyramid_build_levels(pyramid);
+    terrain->stats.pyramids_built++;
+    return pyramid;
 }
 
 // =============================================================================
@@ -561,6 +1021,13 @@ void terrain_print_stats(terrain_system* terrain) {
     printf("Chunks cached: %u\n", terrain->stats.chunks_cached);
     printf("Vertices rendered: %u\n", terrain->stats.vertices_rendered);
     printf("Generation time: %.2f ms\n", terrain->stats.generation_time_ms);
+    u64 height_queries = terrain->stats.height_cache_hits + terrain->stats.height_cache_misses;
+    printf("Height cache: %llu hits, %llu misses (%.1f%% hit rate)\n",
+           (unsigned long long)terrain->stats.height_cache_hits,
+           (unsigned long long)terrain->stats.height_cache_misses,
+           height_queries ? 100.0 * (f64)terrain->stats.height_cache_hits / (f64)height_queries : 0.0);
+    printf("Height pyramids built: %u\n", terrain->stats.pyramids_built);
+    printf("Raycast nodes visited: %llu\n", (unsigned long long)terrain->stats.raycast_nodes_visited);
     
     // Count active chunks
     u32 active_count = 0;
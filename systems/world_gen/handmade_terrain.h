@@ -77,6 +77,78 @@ typedef struct terrain_chunk {
     struct terrain_chunk* prev;
 } terrain_chunk;
 
+// Min/max height pyramid over one chunk's height lattice. Level 0 holds the
+// bounds of each lattice cell, every level above halves the resolution, so a
+// raycast can skip whole quadrants the ray passes over without sampling.
+#define TERRAIN_PYRAMID_LEVELS 7       // 64x64 cells down to 1x1
+#define TERRAIN_PYRAMID_NODES 5461     // 4096 + 1024 + 256 + 64 + 16 + 4 + 1
+#define TERRAIN_PYRAMID_CACHE_SIZE 64  // Resident pyramids
+#define TERRAIN_PYRAMID_WAYS 4         // Cache set associativity
+#define TERRAIN_PYRAMID_MISS_SLOTS 1024 // Miss counters for build admission
+#define TERRAIN_PYRAMID_ADMIT_MISSES 32 // Rays through a chunk before it gets a pyramid
+#define TERRAIN_PYRAMID_MISS_WINDOW 4096 // Misses between counter halvings
+
+// Pyramids follow the render chunk grid: chunk N starts at lattice index
+// N * (TERRAIN_CHUNK_SIZE - 1), so the last cell column overlaps the neighbour
+#define TERRAIN_PYRAMID_STRIDE (TERRAIN_CHUNK_SIZE + 1)
+#define TERRAIN_PYRAMID_CHUNK_CELLS (TERRAIN_CHUNK_SIZE - 1)
+
+// Offset of a level in min_height/max_height (sum of the finer levels)
+#define TERRAIN_PYRAMID_LEVEL_OFFSET(level) \
+    (((TERRAIN_CHUNK_SIZE * TERRAIN_CHUNK_SIZE) - \
+      ((TERRAIN_CHUNK_SIZE * TERRAIN_CHUNK_SIZE) >> (2 * (level)))) / 3 * 4)
+
+typedef struct terrain_height_pyramid {
+    s32 chunk_x;
+    s32 chunk_z;
+    u32 last_used;
+    b32 is_valid;
+    
+    // Lattice heights, exactly what terrain_get_height_interpolated blends
+    f32 heights[(TERRAIN_CHUNK_SIZE + 1) * (TERRAIN_CHUNK_SIZE + 1)];
+    
+    // Per-node bounds, finest level first
+    f32 min_height[TERRAIN_PYRAMID_NODES];
+    f32 max_height[TERRAIN_PYRAMID_NODES];
+} terrain_height_pyramid;
+
+// Heightfield tile cache. A tile mirrors one render chunk's height lattice at
+// every LOD the chunk generator has produced: level L keeps every 2^L-th
+// lattice sample, so any resident level answers exact lattice queries and the
+// coarse levels serve far, wide-footprint lookups without touching the noise.
+#define TERRAIN_HEIGHT_MIPS (TERRAIN_MAX_LOD + 1)  // 65x65 down to 5x5
+#define TERRAIN_HEIGHT_TILE_SAMPLES 5709           // 65^2 + 33^2 + 17^2 + 9^2 + 5^2
+#define TERRAIN_HEIGHT_TILE_CACHE_SIZE 256         // Resident tiles
+#define TERRAIN_HEIGHT_TILE_WAYS 4                 // Cache set associativity
+
+typedef enum terrain_height_filter {
+    TERRAIN_FILTER_BILINEAR = 0,
+    TERRAIN_FILTER_BICUBIC
+} terrain_height_filter;
+
+// CACHE: Tags are 16 bytes so a 4-way set is one cache line; the samples
+// live in a parallel array and are only touched on a hit
+typedef struct terrain_height_tile {
+    s32 chunk_x;
+    s32 chunk_z;
+    u32 last_used;
+    u32 mip_mask;  // Bit L set when level L is resident
+} terrain_height_tile;
+
+// Batched raycast input/output
+typedef struct terrain_ray {
+    v3 origin;
+    v3 direction;
+    f32 max_distance;
+} terrain_ray;
+
+typedef struct terrain_ray_hit {
+    v3 point;
+    v3 normal;
+    f32 distance;
+    b32 hit;
+} terrain_ray_hit;
+
 // Biome types
 typedef enum terrain_biome {
     BIOME_OCEAN = 0,
@@ -155,6 +227,17 @@ typedef struct terrain_system {
     terrain_chunk* active_chunks;   // LRU list of active chunks
     u32 chunk_count;
     
+    // Heightfield cache
+    terrain_height_tile* height_tiles;  // TERRAIN_HEIGHT_TILE_CACHE_SIZE tags
+    f32* height_tile_samples;           // TERRAIN_HEIGHT_TILE_SAMPLES per tag
+    u32 height_tile_clock;
+    
+    // Raycast acceleration
+    terrain_height_pyramid* pyramids;  // TERRAIN_PYRAMID_CACHE_SIZE entries
+    u32 pyramid_clock;
+    u8 pyramid_misses[TERRAIN_PYRAMID_MISS_SLOTS];
+    u32 pyramid_miss_window;
+    
     // Streaming
     struct {
         terrain_chunk** load_queue;
@@ -172,6 +255,10 @@ typedef struct terrain_system {
         u32 chunks_generated;
         u32 chunks_cached;
         u32 vertices_rendered;
+        u64 height_cache_hits;
+        u64 height_cache_misses;
+        u32 pyramids_built;
+        u64 raycast_nodes_visited;
         f64 generation_time_ms;
     } stats;
 } terrain_system;
@@ -197,9 +284,19 @@ void terrain_generate_chunk(terrain_system* terrain, terrain_chunk* chunk,
 // Upload chunk to GPU
 void terrain_upload_chunk(terrain_system* terrain, terrain_chunk* chunk);
 
-// Get height at world position
+// Get height at world position (cached, analytical only where nothing is loaded)
 f32 terrain_get_height(terrain_system* terrain, f32 world_x, f32 world_z);
 
+// Get height filtered from the cache level matching a query footprint in world units
+f32 terrain_get_height_filtered(terrain_system* terrain, f32 world_x, f32 world_z,
+                               f32 footprint, terrain_height_filter filter);
+
+// Bilinear height between lattice samples
+f32 terrain_get_height_interpolated(terrain_system* terrain, f32 world_x, f32 world_z);
+
+// Four corners of lattice cell (cell_x, cell_z), returns whether they came from the cache
+b32 terrain_get_lattice_cell(terrain_system* terrain, s32 cell_x, s32 cell_z, f32 corners[4]);
+
 // Get biome at world position
 terrain_biome terrain_get_biome(terrain_system* terrain, f32 world_x, f32 world_z);
 
@@ -207,13 +304,39 @@ terrain_biome terrain_get_biome(terrain_system* terrain, f32 world_x, f32 world_
 b32 terrain_raycast(terrain_system* terrain, v3 origin, v3 direction,
                    f32 max_distance, v3* hit_point, v3* hit_normal);
 
+// Raycast many rays, returns number of hits
+u32 terrain_raycast_batch(terrain_system* terrain, terrain_ray* rays,
+                         terrain_ray_hit* hits, u32 count);
+
+// Check terrain visibility between two points
+b32 terrain_line_of_sight(terrain_system* terrain, v3 from, v3 to);
+
+// Check visibility for many point pairs
+void terrain_line_of_sight_batch(terrain_system* terrain, v3* from, v3* to,
+                                b32* visible, u32 count);
+
+// Build the min/max height pyramid for a generated LOD 0 chunk
+void terrain_build_height_pyramid(terrain_system* terrain, terrain_chunk* chunk);
+
+// Resident pyramid for a chunk, or 0 while the chunk is not yet admitted.
+// Admits and builds on repeated misses, generation thread only
+terrain_height_pyramid* terrain_get_height_pyramid(terrain_system* terrain,
+                                                   s32 chunk_x, s32 chunk_z);
+
+// Resident pyramid for a chunk or 0, read only so queries may run on any thread
+terrain_height_pyramid* terrain_lookup_height_pyramid(terrain_system* terrain,
+                                                      s32 chunk_x, s32 chunk_z);
+
 // =============================================================================
 // TERRAIN GENERATION HELPERS
 // =============================================================================
 
-// Generate height for a point
+// Height for a point, from the heightfield cache on lattice points
 f32 terrain_sample_height(terrain_system* terrain, f32 x, f32 z);
 
+// Copy a generated chunk's heights into the heightfield cache
+void terrain_store_height_tile(terrain_system* terrain, terrain_chunk* chunk);
+
 // Generate vertex normals from height data
 void terrain_calculate_normals(terrain_vertex* vertices, u32* indices,
                               u32 vertex_count, u32 index_count);
@@ -16,15 +16,13 @@ f32 terrain_get_height_interpolated(terrain_system* terrain, f32 world_x, f32 wo
     f32 sample_size = terrain->params.horizontal_scale;
     
     f32 x0 = floorf(world_x / sample_size) * sample_size;
-    f32 x1 = x0 + sample_size;
     f32 z0 = floorf(world_z / sample_size) * sample_size;
-    f32 z1 = z0 + sample_size;
     
-    // Sample heights at corners
-    f32 h00 = terrain_sample_height(terrain, x0, z0);
-    f32 h10 = terrain_sample_height(terrain, x1, z0);
-    f32 h01 = terrain_sample_height(terrain, x0, z1);
-    f32 h11 = terrain_sample_height(terrain, x1, z1);
+    // Sample heights at corners, one cache lookup for the whole cell
+    f32 corners[4];
+    terrain_get_lattice_cell(terrain, (s32)floorf(world_x / sample_size),
+                             (s32)floorf(world_z / sample_size), corners);
+    f32 h00 = corners[0], h10 = corners[1], h01 = corners[2], h11 = corners[3];
     
     // Bilinear interpolation
     f32 fx = (world_x - x0) / sample_size;
@@ -159,91 +157,340 @@ b32 terrain_capsule_collision(terrain_system* terrain, v3 bottom, v3 top, f32 ra
 // RAY-TERRAIN INTERSECTION
 // =============================================================================
 
-b32 terrain_raycast(terrain_system* terrain, v3 origin, v3 direction,
-                   f32 max_distance, v3* hit_point, v3* hit_normal) {
-    // Normalize direction
-    f32 dir_len = sqrtf(direction.x * direction.x + 
-                       direction.y * direction.y + 
-                       direction.z * direction.z);
-    if (dir_len < 0.0001f) return 0;
+#define TERRAIN_RAY_FAR 1e30f
+
+typedef struct terrain_ray_state {
+    v3 origin;
+    v3 dir;
+    f32 inv_dx;
+    f32 inv_dz;
+    b32 flat_x;   // Direction has no x component
+    b32 flat_z;   // Direction has no z component
     
-    v3 dir = {
-        direction.x / dir_len,
-        direction.y / dir_len,
-        direction.z / dir_len
-    };
+    // Last pyramid touched, rays in a batch tend to share chunks
+    terrain_height_pyramid* pyramid;
     
-    // Ray marching parameters
-    f32 step_size = terrain->params.horizontal_scale * 0.5f;
-    f32 distance = 0;
-    v3 current_pos = origin;
-    
-    // Early out if ray is going up and starts above terrain
-    if (dir.y > 0) {
-        f32 terrain_height = terrain_get_height_interpolated(terrain, origin.x, origin.z);
-        if (origin.y > terrain_height + 100.0f) {
-            return 0;  // Ray going up from high above terrain
+    // Added to the stats once per query, which may run on any thread
+    u64 nodes_visited;
+} terrain_ray_state;
+
+// Clip [t0, t1] against the ray's crossing of the XZ box, returns 0 if empty
+internal b32 terrain_ray_clip_box(terrain_ray_state* ray, f32 x0, f32 x1, f32 z0, f32 z1,
+                                  f32* t0, f32* t1) {
+    if (ray->flat_x) {
+        if (ray->origin.x < x0 || ray->origin.x > x1) return 0;
+    } else {
+        f32 ta = (x0 - ray->origin.x) * ray->inv_dx;
+        f32 tb = (x1 - ray->origin.x) * ray->inv_dx;
+        *t0 = fmaxf(*t0, fminf(ta, tb));
+        *t1 = fminf(*t1, fmaxf(ta, tb));
+    }
+    
+    if (ray->flat_z) {
+        if (ray->origin.z < z0 || ray->origin.z > z1) return 0;
+    } else {
+        f32 ta = (z0 - ray->origin.z) * ray->inv_dz;
+        f32 tb = (z1 - ray->origin.z) * ray->inv_dz;
+        *t0 = fmaxf(*t0, fminf(ta, tb));
+        *t1 = fminf(*t1, fmaxf(ta, tb));
+    }
+    
+    return *t0 <= *t1;
+}
+
+// Exact ray vs bilinear cell: along a line the cell surface is quadratic in t
+internal b32 terrain_ray_cell(terrain_ray_state* ray, terrain_height_pyramid* pyramid,
+                              u32 cell_x, u32 cell_z, f32 cell_x0, f32 cell_z0, f32 sample_size,
+                              f32 t0, f32 t1, f32* t_hit) {
+    f32* row0 = &pyramid->heights[cell_z * TERRAIN_PYRAMID_STRIDE + cell_x];
+    f32* row1 = row0 + TERRAIN_PYRAMID_STRIDE;
+    f32 h00 = row0[0], h10 = row0[1], h01 = row1[0], h11 = row1[1];
+    
+    f32 a = h10 - h00;
+    f32 b = h01 - h00;
+    f32 c = h00 - h10 - h01 + h11;
+    
+    // Cell-local coordinates at entry and their rate along the ray
+    f32 inv_size = 1.0f / sample_size;
+    f32 fx = (ray->origin.x + ray->dir.x * t0 - cell_x0) * inv_size;
+    f32 fz = (ray->origin.z + ray->dir.z * t0 - cell_z0) * inv_size;
+    f32 ex = ray->dir.x * inv_size;
+    f32 ez = ray->dir.z * inv_size;
+    
+    // g(u) = ray height - terrain height, u = t - t0
+    f32 g0 = ray->origin.y + ray->dir.y * t0 - (h00 + a * fx + b * fz + c * fx * fz);
+    f32 g1 = ray->dir.y - (a * ex + b * ez + c * (fx * ez + fz * ex));
+    f32 g2 = -c * ex * ez;
+    f32 length = t1 - t0;
+    
+    if (g0 <= 0.0f) {
+        *t_hit = t0;
+        return 1;
+    }
+    
+    // Smallest root in (0, length]
+    f32 u = length + 1.0f;
+    if (fabsf(g2) < 1e-12f) {
+        if (g1 < 0.0f) u = -g0 / g1;
+    } else {
+        f32 disc = g1 * g1 - 4.0f * g2 * g0;
+        if (disc >= 0.0f) {
+            f32 q = -0.5f * (g1 + (g1 >= 0.0f ? sqrtf(disc) : -sqrtf(disc)));
+            f32 r0 = q / g2;
+            f32 r1 = (q != 0.0f) ? g0 / q : r0;
+            if (r0 > r1) { f32 tmp = r0; r0 = r1; r1 = tmp; }
+            u = (r0 >= 0.0f) ? r0 : r1;
+        }
+    }
+    
+    if (u >= 0.0f && u <= length) {
+        *t_hit = t0 + u;
+        return 1;
+    }
+    return 0;
+}
+
+// Front-to-back quadtree walk of one chunk's pyramid over [t0, t1]
+internal b32 terrain_ray_trace_chunk(terrain_system* terrain, terrain_ray_state* ray,
+                                     terrain_height_pyramid* pyramid, f32 t0, f32 t1, f32* t_hit) {
+    f32 sample_size = terrain->params.horizontal_scale;
+    f32 base_x = (f32)(pyramid->chunk_x * TERRAIN_PYRAMID_CHUNK_CELLS) * sample_size;
+    f32 base_z = (f32)(pyramid->chunk_z * TERRAIN_PYRAMID_CHUNK_CELLS) * sample_size;
+    
+    // Child visiting order: the quadrant the ray enters first, then the sides, then the far one
+    u32 near_x = ray->dir.x < 0.0f ? 1 : 0;
+    u32 near_z = ray->dir.z < 0.0f ? 1 : 0;
+    
+    // Stack entries pack level and node coordinates
+    u32 stack[4 * TERRAIN_PYRAMID_LEVELS];
+    u32 top = 0;
+    stack[top++] = (TERRAIN_PYRAMID_LEVELS - 1) << 16;
+    
+    while (top) {
+        u32 entry = stack[--top];
+        u32 level = entry >> 16;
+        u32 node_x = (entry >> 8) & 0xFF;
+        u32 node_z = entry & 0xFF;
+        ray->nodes_visited++;
+        
+        f32 node_size = (f32)(1u << level) * sample_size;
+        f32 x0 = base_x + (f32)(node_x << level) * sample_size;
+        f32 z0 = base_z + (f32)(node_z << level) * sample_size;
+        
+        f32 ta = t0, tb = t1;
+        if (!terrain_ray_clip_box(ray, x0, x0 + node_size, z0, z0 + node_size, &ta, &tb)) continue;
+        
+        // PERFORMANCE: Skip the node if the ray stays above its highest sample
+        u32 size = TERRAIN_CHUNK_SIZE >> level;
+        u32 node = TERRAIN_PYRAMID_LEVEL_OFFSET(level) + node_z * size + node_x;
+        f32 ya = ray->origin.y + ray->dir.y * ta;
+        f32 yb = ray->origin.y + ray->dir.y * tb;
+        if (fminf(ya, yb) > pyramid->max_height[node]) continue;
+        
+        if (level == 0) {
+            if (terrain_ray_cell(ray, pyramid, node_x, node_z, x0, z0, sample_size, ta, tb, t_hit)) {
+                return 1;
+            }
+            continue;
         }
+        
+        // Push far child first so the near child is popped next
+        u32 child_level = (level - 1) << 16;
+        u32 cx = node_x * 2, cz = node_z * 2;
+        stack[top++] = child_level | ((cx + (1 - near_x)) << 8) | (cz + (1 - near_z));
+        stack[top++] = child_level | ((cx + near_x) << 8) | (cz + (1 - near_z));
+        stack[top++] = child_level | ((cx + (1 - near_x)) << 8) | (cz + near_z);
+        stack[top++] = child_level | ((cx + near_x) << 8) | (cz + near_z);
     }
     
-    // March along ray
-    while (distance < max_distance) {
-        f32 terrain_height = terrain_get_height_interpolated(terrain, 
-                                                            current_pos.x, 
-                                                            current_pos.z);
+    return 0;
+}
+
+// Fixed-step march over [t0, t1] with binary refine, for chunks without a pyramid
+internal b32 terrain_ray_march(terrain_system* terrain, terrain_ray_state* ray,
+                               f32 t0, f32 t1, f32* t_hit) {
+    f32 step_size = terrain->params.horizontal_scale * 0.5f;
+    f32 t = t0;
+    
+    for (;;) {
+        f32 x = ray->origin.x + ray->dir.x * t;
+        f32 y = ray->origin.y + ray->dir.y * t;
+        f32 z = ray->origin.z + ray->dir.z * t;
+        f32 terrain_height = terrain_get_height_interpolated(terrain, x, z);
         
-        // Check for intersection
-        if (current_pos.y <= terrain_height) {
-            // Binary search for exact intersection point
-            v3 hit_pos = current_pos;
-            v3 prev_pos = {
-                current_pos.x - dir.x * step_size,
-                current_pos.y - dir.y * step_size,
-                current_pos.z - dir.z * step_size
-            };
-            
-            // Refine hit position
+        if (y <= terrain_height) {
+            // Binary search between the previous step and this one
+            f32 hit = t;
+            f32 prev = fmaxf(0.0f, t - step_size);
             for (u32 i = 0; i < 8; i++) {
-                v3 mid_pos = {
-                    (hit_pos.x + prev_pos.x) * 0.5f,
-                    (hit_pos.y + prev_pos.y) * 0.5f,
-                    (hit_pos.z + prev_pos.z) * 0.5f
-                };
-                
-                f32 mid_height = terrain_get_height_interpolated(terrain, mid_pos.x, mid_pos.z);
-                
-                if (mid_pos.y <= mid_height) {
-                    hit_pos = mid_pos;
+                f32 mid = (hit + prev) * 0.5f;
+                f32 mid_height = terrain_get_height_interpolated(terrain,
+                                                                 ray->origin.x + ray->dir.x * mid,
+                                                                 ray->origin.z + ray->dir.z * mid);
+                if (ray->origin.y + ray->dir.y * mid <= mid_height) {
+                    hit = mid;
                 } else {
-                    prev_pos = mid_pos;
+                    prev = mid;
                 }
             }
-            
-            if (hit_point) {
-                *hit_point = hit_pos;
-            }
-            
-            if (hit_normal) {
-                *hit_normal = terrain_get_normal(terrain, hit_pos.x, hit_pos.z);
-            }
-            
+            *t_hit = hit;
             return 1;
         }
         
+        if (t >= t1) return 0;
+        
         // Adaptive step size based on distance to terrain
-        f32 height_diff = current_pos.y - terrain_height;
-        f32 adaptive_step = fminf(step_size * (1.0f + height_diff * 0.1f), step_size * 10.0f);
+        f32 height_diff = y - terrain_height;
+        t = fminf(t + fminf(step_size * (1.0f + height_diff * 0.1f), step_size * 10.0f), t1);
+    }
+}
+
+internal s32 terrain_ray_chunk_index(f32 position, f32 chunk_width) {
+    s32 index = (s32)floorf(position / chunk_width);
+    // Guard against the division rounding across a chunk edge
+    if ((f32)index * chunk_width > position) index--;
+    else if ((f32)(index + 1) * chunk_width <= position) index++;
+    return index;
+}
+
+// March chunk to chunk (grid DDA) and trace each pyramid, returns hit distance
+internal b32 terrain_ray_trace(terrain_system* terrain, terrain_ray_state* ray,
+                               f32 max_distance, f32* t_hit) {
+    f32 chunk_width = (f32)TERRAIN_PYRAMID_CHUNK_CELLS * terrain->params.horizontal_scale;
+    s32 chunk_x = terrain_ray_chunk_index(ray->origin.x, chunk_width);
+    s32 chunk_z = terrain_ray_chunk_index(ray->origin.z, chunk_width);
+    
+    s32 step_x = ray->dir.x < 0.0f ? -1 : 1;
+    s32 step_z = ray->dir.z < 0.0f ? -1 : 1;
+    f32 next_x = TERRAIN_RAY_FAR, next_z = TERRAIN_RAY_FAR;
+    f32 delta_x = 0.0f, delta_z = 0.0f;
+    
+    if (!ray->flat_x) {
+        f32 edge = (f32)(chunk_x + (step_x > 0 ? 1 : 0)) * chunk_width;
+        next_x = (edge - ray->origin.x) * ray->inv_dx;
+        delta_x = chunk_width * fabsf(ray->inv_dx);
+    }
+    if (!ray->flat_z) {
+        f32 edge = (f32)(chunk_z + (step_z > 0 ? 1 : 0)) * chunk_width;
+        next_z = (edge - ray->origin.z) * ray->inv_dz;
+        delta_z = chunk_width * fabsf(ray->inv_dz);
+    }
+    
+    f32 t = 0.0f;
+    while (t < max_distance) {
+        f32 t_end = fminf(fminf(next_x, next_z), max_distance);
+        
+        terrain_height_pyramid* pyramid = ray->pyramid;
+        if (!pyramid || !pyramid->is_valid || pyramid->chunk_x != chunk_x || pyramid->chunk_z != chunk_z) {
+            // Read only: chunk generation builds pyramids, rays never do
+            pyramid = terrain_lookup_height_pyramid(terrain, chunk_x, chunk_z);
+            if (pyramid) ray->pyramid = pyramid;
+        }
         
-        // March forward
-        current_pos.x += dir.x * adaptive_step;
-        current_pos.y += dir.y * adaptive_step;
-        current_pos.z += dir.z * adaptive_step;
-        distance += adaptive_step;
+        if (pyramid) {
+            if (terrain_ray_trace_chunk(terrain, ray, pyramid, t, t_end, t_hit)) return 1;
+        } else {
+            if (terrain_ray_march(terrain, ray, t, t_end, t_hit)) return 1;
+        }
+        
+        t = t_end;
+        if (next_x < next_z) {
+            chunk_x += step_x;
+            next_x += delta_x;
+        } else {
+            chunk_z += step_z;
+            next_z += delta_z;
+        }
     }
     
     return 0;
 }
 
+internal b32 terrain_ray_setup(terrain_ray_state* ray, v3 origin, v3 direction) {
+    f32 dir_len = sqrtf(direction.x * direction.x + 
+                       direction.y * direction.y + 
+                       direction.z * direction.z);
+    if (dir_len < 0.0001f) return 0;
+    
+    ray->origin = origin;
+    ray->dir = (v3){
+        direction.x / dir_len,
+        direction.y / dir_len,
+        direction.z / dir_len
+    };
+    
+    // Axis-parallel rays never cross chunk edges on that axis
+    ray->flat_x = fabsf(ray->dir.x) < 1e-7f;
+    ray->flat_z = fabsf(ray->dir.z) < 1e-7f;
+    ray->inv_dx = ray->flat_x ? 0.0f : 1.0f / ray->dir.x;
+    ray->inv_dz = ray->flat_z ? 0.0f : 1.0f / ray->dir.z;
+    return 1;
+}
+
+internal void terrain_ray_flush_stats(terrain_system* terrain, terrain_ray_state* ray) {
+    __atomic_fetch_add(&terrain->stats.raycast_nodes_visited, ray->nodes_visited, __ATOMIC_RELAXED);
+}
+
+b32 terrain_raycast(terrain_system* terrain, v3 origin, v3 direction,
+                   f32 max_distance, v3* hit_point, v3* hit_normal) {
+    terrain_ray_state ray = {0};
+    if (!terrain_ray_setup(&ray, origin, direction)) return 0;
+    
+    f32 t;
+    b32 hit = terrain_ray_trace(terrain, &ray, max_distance, &t);
+    terrain_ray_flush_stats(terrain, &ray);
+    if (!hit) return 0;
+    
+    v3 hit_pos = {
+        origin.x + ray.dir.x * t,
+        origin.y + ray.dir.y * t,
+        origin.z + ray.dir.z * t
+    };
+    
+    if (hit_point) {
+        *hit_point = hit_pos;
+    }
+    
+    if (hit_normal) {
+        *hit_normal = terrain_get_normal(terrain, hit_pos.x, hit_pos.z);
+    }
+    
+    return 1;
+}
+
+u32 terrain_raycast_batch(terrain_system* terrain, terrain_ray* rays,
+                         terrain_ray_hit* hits, u32 count) {
+    terrain_ray_state ray = {0};
+    u32 hit_count = 0;
+    
+    for (u32 i = 0; i < count; i++) {
+        terrain_ray_hit* hit = &hits[i];
+        hit->hit = 0;
+        hit->distance = rays[i].max_distance;
+        
+        // Keep the pyramid from the previous ray, neighbours usually share it
+        terrain_height_pyramid* last = ray.pyramid;
+        if (!terrain_ray_setup(&ray, rays[i].origin, rays[i].direction)) continue;
+        ray.pyramid = last;
+        
+        f32 t;
+        if (!terrain_ray_trace(terrain, &ray, rays[i].max_distance, &t)) continue;
+        
+        hit->hit = 1;
+        hit->distance = t;
+        hit->point = (v3){
+            ray.origin.x + ray.dir.x * t,
+            ray.origin.y + ray.dir.y * t,
+            ray.origin.z + ray.dir.z * t
+        };
+        hit->normal = terrain_get_normal(terrain, hit->point.x, hit->point.z);
+        hit_count++;
+    }
+    
+    terrain_ray_flush_stats(terrain, &ray);
+    return hit_count;
+}
+
 // =============================================================================
 // BOX COLLISION
 // =============================================================================
@@ -300,7 +547,8 @@ b32 terrain_box_collision(terrain_system* terrain, v3 box_min, v3 box_max,
 // TERRAIN LINE OF SIGHT
 // =============================================================================
 
-b32 terrain_line_of_sight(terrain_system* terrain, v3 from, v3 to) {
+// Visibility test for one segment, reusing the caller's ray state
+internal b32 terrain_segment_clear(terrain_system* terrain, terrain_ray_state* ray, v3 from, v3 to) {
     v3 direction = {
         to.x - from.x,
         to.y - from.y,
@@ -311,23 +559,36 @@ b32 terrain_line_of_sight(terrain_system* terrain, v3 from, v3 to) {
                         direction.y * direction.y + 
                         direction.z * direction.z);
     
+    terrain_height_pyramid* last = ray->pyramid;
+    if (!terrain_ray_setup(ray, from, direction)) return 1;
+    ray->pyramid = last;
+    
     // Use raycast to check for terrain obstruction
-    v3 hit_point, hit_normal;
-    if (terrain_raycast(terrain, from, direction, distance, &hit_point, &hit_normal)) {
-        // Check if hit is before the target
-        f32 hit_dist_sq = (hit_point.x - from.x) * (hit_point.x - from.x) +
-                         (hit_point.y - from.y) * (hit_point.y - from.y) +
-                         (hit_point.z - from.z) * (hit_point.z - from.z);
-        
-        f32 target_dist_sq = distance * distance;
-        
+    f32 t;
+    if (terrain_ray_trace(terrain, ray, distance, &t)) {
         // Allow small tolerance for floating point errors
-        return (hit_dist_sq >= target_dist_sq - 0.01f);
+        return (t * t >= distance * distance - 0.01f);
     }
     
     return 1;  // No terrain obstruction
 }
 
+b32 terrain_line_of_sight(terrain_system* terrain, v3 from, v3 to) {
+    terrain_ray_state ray = {0};
+    b32 visible = terrain_segment_clear(terrain, &ray, from, to);
+    terrain_ray_flush_stats(terrain, &ray);
+    return visible;
+}
+
+void terrain_line_of_sight_batch(terrain_system* terrain, v3* from, v3* to,
+                                b32* visible, u32 count) {
+    terrain_ray_state ray = {0};
+    for (u32 i = 0; i < count; i++) {
+        visible[i] = terrain_segment_clear(terrain, &ray, from[i], to[i]);
+    }
+    terrain_ray_flush_stats(terrain, &ray);
+}
+
 // =============================================================================
 // TERRAIN SLOPE QUERY
 // =============================================================================
@@ -9,12 +9,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <immintrin.h>
 
 #define internal static
 #define PI 3.14159265359f
 
+#if defined(__AVX2__) && defined(__FMA__)
+#define WORLD_GEN_NOISE_SIMD 1
+#endif
+
 // Permutation table for Perlin noise
-internal u8 permutation[512] = {
+// PERFORMANCE: 4 bytes of padding so AVX2 gathers can read 32 bits at index 511
+internal u8 permutation[512 + 4] = {
     151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
     190, 6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,
     88,237,149,56,87,174,20,125,136,171,168, 68,175,74,165,71,134,139,48,27,166,
@@ -42,16 +48,15 @@ internal u8 permutation[512] = {
     138,236,205,93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180
 };
 
-// Fast random number generator state
-internal u32 rng_state = 1;
-
+// Fast random number generator
+// THREADING: Stateless so generation workers can call it concurrently
 internal u32
 fast_rand(u32 seed) {
-    rng_state = seed;
-    rng_state ^= rng_state << 13;
-    rng_state ^= rng_state >> 17;
-    rng_state ^= rng_state << 5;
-    return rng_state;
+    u32 state = seed;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
 }
 
 f32
@@ -84,6 +89,7 @@ world_gen_interpolate_cubic(f32 a, f32 b, f32 c, f32 d, f32 t) {
     return p*t*t*t + q*t*t + r*t + s;
 }
 
+#ifndef WORLD_GEN_NOISE_SIMD
 // Gradient function for Perlin noise
 internal f32
 gradient_2d(i32 hash, f32 x, f32 y) {
@@ -92,6 +98,7 @@ gradient_2d(i32 hash, f32 x, f32 y) {
     f32 v = h < 4 ? y : h == 12 || h == 14 ? x : 0;
     return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 }
+#endif
 
 internal f32
 gradient_3d(i32 hash, f32 x, f32 y, f32 z) {
@@ -101,44 +108,244 @@ gradient_3d(i32 hash, f32 x, f32 y, f32 z) {
     return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 }
 
-// Core Perlin noise implementation
-f32
-world_gen_noise_2d(noise_params *params, f32 x, f32 y) {
-    // Apply frequency and offset
-    x = (x + params->offset_x) * params->frequency;
-    y = (y + params->offset_y) * params->frequency;
+// =============================================================================
+// BATCH NOISE
+// =============================================================================
+
+// All 2D noise goes through one batch kernel so single-point queries and
+// whole-chunk generation produce identical values. AVX2 builds evaluate 8
+// points per pass (tails padded into a full vector); other builds use the
+// scalar mirror, which is bit-identical under IEEE semantics.
+
+typedef enum world_noise_shape {
+    WORLD_NOISE_SINGLE,      // One octave, n * amplitude
+    WORLD_NOISE_FBM,         // Sum of octaves normalized by total amplitude
+    WORLD_NOISE_RIDGE,       // 1 - |n * amplitude|
+    WORLD_NOISE_TURBULENCE   // Sum of |octave|
+} world_noise_shape;
+
+#ifdef WORLD_GEN_NOISE_SIMD
+
+internal __m256i
+permutation_gather(__m256i index) {
+    __m256i bytes = _mm256_i32gather_epi32((const int *)permutation, index, 1);
+    return _mm256_and_si256(bytes, _mm256_set1_epi32(255));
+}
+
+internal __m256
+gradient_2d_lanes(__m256i hash, __m256 x, __m256 y) {
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+    __m256 lt8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+    __m256 lt4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+    __m256 use_x = _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)),
+                                                       _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+    
+    __m256 u = _mm256_blendv_ps(y, x, lt8);
+    __m256 v = _mm256_blendv_ps(_mm256_and_ps(use_x, x), y, lt4);
+    
+    __m256 sign_u = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+    __m256 sign_v = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+    return _mm256_add_ps(_mm256_xor_ps(u, sign_u), _mm256_xor_ps(v, sign_v));
+}
+
+internal __m256
+smoother_step_lanes(__m256 t) {
+    __m256 inner = _mm256_fmadd_ps(t, _mm256_set1_ps(6.0f), _mm256_set1_ps(-15.0f));
+    inner = _mm256_fmadd_ps(t, inner, _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+}
+
+// Unscaled Perlin noise for 8 points at one frequency
+internal __m256
+noise_2d_lanes(noise_params *params, f32 frequency, __m256 x, __m256 y) {
+    __m256 f = _mm256_set1_ps(frequency);
+    x = _mm256_mul_ps(_mm256_add_ps(x, _mm256_set1_ps(params->offset_x)), f);
+    y = _mm256_mul_ps(_mm256_add_ps(y, _mm256_set1_ps(params->offset_y)), f);
+    
+    __m256 fx = _mm256_floor_ps(x);
+    __m256 fy = _mm256_floor_ps(y);
+    __m256 dx = _mm256_sub_ps(x, fx);
+    __m256 dy = _mm256_sub_ps(y, fy);
+    
+    __m256i mask = _mm256_set1_epi32(255);
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i x0 = _mm256_cvttps_epi32(fx);
+    __m256i y0 = _mm256_cvttps_epi32(fy);
+    __m256i px0 = permutation_gather(_mm256_and_si256(x0, mask));
+    __m256i px1 = permutation_gather(_mm256_and_si256(_mm256_add_epi32(x0, one), mask));
+    __m256i y0m = _mm256_and_si256(y0, mask);
+    __m256i y1m = _mm256_and_si256(_mm256_add_epi32(y0, one), mask);
+    
+    __m256 f_one = _mm256_set1_ps(1.0f);
+    __m256 dxm1 = _mm256_sub_ps(dx, f_one);
+    __m256 dym1 = _mm256_sub_ps(dy, f_one);
+    
+    __m256 g00 = gradient_2d_lanes(permutation_gather(_mm256_add_epi32(px0, y0m)), dx, dy);
+    __m256 g10 = gradient_2d_lanes(permutation_gather(_mm256_add_epi32(px1, y0m)), dxm1, dy);
+    __m256 g01 = gradient_2d_lanes(permutation_gather(_mm256_add_epi32(px0, y1m)), dx, dym1);
+    __m256 g11 = gradient_2d_lanes(permutation_gather(_mm256_add_epi32(px1, y1m)), dxm1, dym1);
+    
+    __m256 u = smoother_step_lanes(dx);
+    __m256 v = smoother_step_lanes(dy);
+    
+    __m256 nx0 = _mm256_fmadd_ps(u, _mm256_sub_ps(g10, g00), g00);
+    __m256 nx1 = _mm256_fmadd_ps(u, _mm256_sub_ps(g11, g01), g01);
+    return _mm256_fmadd_ps(v, _mm256_sub_ps(nx1, nx0), nx0);
+}
+
+internal __m256
+noise_octaves_lanes(noise_params *params, world_noise_shape shape, i32 octaves, __m256 x, __m256 y) {
+    __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 result = _mm256_setzero_ps();
+    f32 amplitude = params->amplitude;
+    f32 frequency = params->frequency;
+    f32 max_value = 0.0f;
     
-    // Get integer coordinates
-    i32 x0 = (i32)floorf(x);
-    i32 y0 = (i32)floorf(y);
-    i32 x1 = x0 + 1;
-    i32 y1 = y0 + 1;
+    for (i32 i = 0; i < octaves; i++) {
+        __m256 n = _mm256_mul_ps(noise_2d_lanes(params, frequency, x, y), _mm256_set1_ps(amplitude));
+        if (shape == WORLD_NOISE_TURBULENCE) {
+            n = _mm256_and_ps(n, abs_mask);
+        }
+        result = _mm256_add_ps(result, n);
+        max_value += amplitude;
+        
+        amplitude *= params->persistence;
+        frequency *= params->lacunarity;
+    }
     
-    // Get fractional part
-    f32 dx = x - x0;
-    f32 dy = y - y0;
+    if (shape == WORLD_NOISE_FBM) {
+        result = _mm256_div_ps(result, _mm256_set1_ps(max_value)); // Normalize
+    } else if (shape == WORLD_NOISE_RIDGE) {
+        result = _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_and_ps(result, abs_mask));
+    }
     
-    // Hash coordinates
-    i32 h00 = permutation[permutation[x0 & 255] + (y0 & 255)];
-    i32 h10 = permutation[permutation[x1 & 255] + (y0 & 255)];
-    i32 h01 = permutation[permutation[x0 & 255] + (y1 & 255)];
-    i32 h11 = permutation[permutation[x1 & 255] + (y1 & 255)];
+    return result;
+}
+
+#else
+
+internal f32
+smoother_step_fused(f32 t) {
+    return t * t * t * fmaf(t, fmaf(t, 6.0f, -15.0f), 10.0f);
+}
+
+// Scalar mirror of noise_2d_lanes
+internal f32
+noise_2d_exact(noise_params *params, f32 frequency, f32 x, f32 y) {
+    x = (x + params->offset_x) * frequency;
+    y = (y + params->offset_y) * frequency;
+    
+    f32 fx = floorf(x);
+    f32 fy = floorf(y);
+    f32 dx = x - fx;
+    f32 dy = y - fy;
+    
+    i32 x0 = (i32)fx;
+    i32 y0 = (i32)fy;
+    i32 px0 = permutation[x0 & 255];
+    i32 px1 = permutation[(x0 + 1) & 255];
+    
+    f32 g00 = gradient_2d(permutation[px0 + (y0 & 255)], dx, dy);
+    f32 g10 = gradient_2d(permutation[px1 + (y0 & 255)], dx - 1.0f, dy);
+    f32 g01 = gradient_2d(permutation[px0 + ((y0 + 1) & 255)], dx, dy - 1.0f);
+    f32 g11 = gradient_2d(permutation[px1 + ((y0 + 1) & 255)], dx - 1.0f, dy - 1.0f);
+    
+    f32 u = smoother_step_fused(dx);
+    f32 v = smoother_step_fused(dy);
+    
+    f32 nx0 = fmaf(u, g10 - g00, g00);
+    f32 nx1 = fmaf(u, g11 - g01, g01);
+    return fmaf(v, nx1 - nx0, nx0);
+}
+
+internal f32
+noise_octaves_exact(noise_params *params, world_noise_shape shape, i32 octaves, f32 x, f32 y) {
+    f32 result = 0.0f;
+    f32 amplitude = params->amplitude;
+    f32 frequency = params->frequency;
+    f32 max_value = 0.0f;
     
-    // Calculate gradients
-    f32 g00 = gradient_2d(h00, dx, dy);
-    f32 g10 = gradient_2d(h10, dx - 1, dy);
-    f32 g01 = gradient_2d(h01, dx, dy - 1);
-    f32 g11 = gradient_2d(h11, dx - 1, dy - 1);
+    for (i32 i = 0; i < octaves; i++) {
+        f32 n = noise_2d_exact(params, frequency, x, y) * amplitude;
+        if (shape == WORLD_NOISE_TURBULENCE) {
+            n = fabsf(n);
+        }
+        result += n;
+        max_value += amplitude;
+        
+        amplitude *= params->persistence;
+        frequency *= params->lacunarity;
+    }
     
-    // Interpolate
-    f32 u = smoother_step(dx);
-    f32 v = smoother_step(dy);
+    if (shape == WORLD_NOISE_FBM) {
+        result = result / max_value; // Normalize
+    } else if (shape == WORLD_NOISE_RIDGE) {
+        result = 1.0f - fabsf(result);
+    }
     
-    f32 nx0 = g00 + u * (g10 - g00);
-    f32 nx1 = g01 + u * (g11 - g01);
-    f32 result = nx0 + v * (nx1 - nx0);
+    return result;
+}
+
+#endif
+
+internal void
+world_noise_batch(noise_params *params, world_noise_shape shape, i32 octaves,
+                  const f32 *x, const f32 *y, f32 *out, u32 count) {
+    u32 i = 0;
+    
+#ifdef WORLD_GEN_NOISE_SIMD
+    for (; i + 8 <= count; i += 8) {
+        __m256 result = noise_octaves_lanes(params, shape, octaves,
+                                            _mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&y[i]));
+        _mm256_storeu_ps(&out[i], result);
+    }
     
-    return result * params->amplitude;
+    // Tail goes through padded lanes so every point runs the same code
+    if (i < count) {
+        f32 px[8] = {0}, py[8] = {0}, result[8];
+        for (u32 j = 0; j < count - i; j++) {
+            px[j] = x[i + j];
+            py[j] = y[i + j];
+        }
+        _mm256_storeu_ps(result, noise_octaves_lanes(params, shape, octaves,
+                                                     _mm256_loadu_ps(px), _mm256_loadu_ps(py)));
+        for (u32 j = 0; j < count - i; j++) {
+            out[i + j] = result[j];
+        }
+    }
+#else
+    for (; i < count; i++) {
+        out[i] = noise_octaves_exact(params, shape, octaves, x[i], y[i]);
+    }
+#endif
+}
+
+void
+world_gen_noise_2d_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count) {
+    world_noise_batch(params, WORLD_NOISE_SINGLE, 1, x, y, out, count);
+}
+
+void
+world_gen_fbm_noise_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count, i32 octaves) {
+    world_noise_batch(params, WORLD_NOISE_FBM, octaves, x, y, out, count);
+}
+
+void
+world_gen_ridge_noise_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count) {
+    world_noise_batch(params, WORLD_NOISE_RIDGE, 1, x, y, out, count);
+}
+
+void
+world_gen_turbulence_noise_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count) {
+    world_noise_batch(params, WORLD_NOISE_TURBULENCE, (i32)params->octaves, x, y, out, count);
+}
+
+// Core Perlin noise implementation
+f32
+world_gen_noise_2d(noise_params *params, f32 x, f32 y) {
+    f32 result;
+    world_gen_noise_2d_batch(params, &x, &y, &result, 1);
+    return result;
 }
 
 f32
@@ -197,53 +404,24 @@ world_gen_noise_3d(noise_params *params, f32 x, f32 y, f32 z) {
 // Fractal Brownian Motion (FBM) noise
 f32
 world_gen_fbm_noise(noise_params *params, f32 x, f32 y, i32 octaves) {
-    f32 result = 0.0f;
-    f32 amplitude = params->amplitude;
-    f32 frequency = params->frequency;
-    f32 max_value = 0.0f;
-    
-    noise_params octave_params = *params;
-    
-    for (i32 i = 0; i < octaves; i++) {
-        octave_params.frequency = frequency;
-        octave_params.amplitude = amplitude;
-        
-        result += world_gen_noise_2d(&octave_params, x, y);
-        max_value += amplitude;
-        
-        amplitude *= params->persistence;
-        frequency *= params->lacunarity;
-    }
-    
-    return result / max_value; // Normalize
+    f32 result;
+    world_gen_fbm_noise_batch(params, &x, &y, &result, 1, octaves);
+    return result;
 }
 
 // Ridge noise for mountain ridges
 f32
 world_gen_ridge_noise(noise_params *params, f32 x, f32 y) {
-    f32 noise = world_gen_noise_2d(params, x, y);
-    return 1.0f - fabsf(noise);
+    f32 result;
+    world_gen_ridge_noise_batch(params, &x, &y, &result, 1);
+    return result;
 }
 
 // Turbulence noise for chaotic patterns
 f32
 world_gen_turbulence_noise(noise_params *params, f32 x, f32 y) {
-    f32 result = 0.0f;
-    f32 amplitude = params->amplitude;
-    f32 frequency = params->frequency;
-    
-    noise_params turbulence_params = *params;
-    
-    for (i32 i = 0; i < params->octaves; i++) {
-        turbulence_params.frequency = frequency;
-        turbulence_params.amplitude = amplitude;
-        
-        result += fabsf(world_gen_noise_2d(&turbulence_params, x, y));
-        
-        amplitude *= params->persistence;
-        frequency *= params->lacunarity;
-    }
-    
+    f32 result;
+    world_gen_turbulence_noise_batch(params, &x, &y, &result, 1);
     return result;
 }
 
@@ -380,11 +558,14 @@ init_default_biomes(world_gen_system *system) {
 }
 
 // Hash function for chunk lookup
+// Full 32-bit mix; callers mask to their table size
 u32
 world_gen_hash_chunk_id(i32 chunk_x, i32 chunk_y) {
-    u32 h1 = (u32)(chunk_x * 73856093);
-    u32 h2 = (u32)(chunk_y * 19349663);
-    return (h1 ^ h2) & 255; // Mod 256 for hash table
+    u32 h = (u32)chunk_x * 0x9E3779B1u ^ (u32)chunk_y * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
 }
 
 u64
@@ -443,10 +624,15 @@ world_gen_init(void *memory, u32 memory_size, u64 seed) {
     // Initialize biome definitions
     init_default_biomes(system);
     
-    // Initialize chunk hash table
-    for (u32 i = 0; i < 256; i++) {
-        system->chunk_hash[i] = 0;
+    // Initialize chunk map and slot free list
+    for (u32 i = 0; i < WORLD_CHUNK_MAP_SIZE; i++) {
+        system->chunk_map[i] = 0;
     }
+    system->free_chunk_count = WORLD_MAX_ACTIVE_CHUNKS;
+    for (u32 i = 0; i < WORLD_MAX_ACTIVE_CHUNKS; i++) {
+        system->free_chunk_slots[i] = (u16)(WORLD_MAX_ACTIVE_CHUNKS - 1 - i);
+    }
+    world_gen_set_chunk_budget(system, (u64)WORLD_MAX_ACTIVE_CHUNKS * sizeof(world_chunk));
     
     printf("[WORLD_GEN] World generation system initialized\n");
     printf("[WORLD_GEN] Seed: %llu\n", (unsigned long long)seed);
@@ -460,6 +646,8 @@ void
 world_gen_shutdown(world_gen_system *system) {
     if (!system) return;
     
+    world_gen_stop_pipeline(system);
+    
     printf("[WORLD_GEN] Shutting down world generation system\n");
     printf("[WORLD_GEN] Total chunks generated: %llu\n", (unsigned long long)system->total_chunks_generated);
     printf("[WORLD_GEN] Average generation time: %.3f ms\n", 
@@ -482,6 +670,9 @@ world_gen_update(world_gen_system *system, f32 dt) {
         stats_timer = 0.0f;
     }
     
+    // Publish chunks finished by the generation pipeline
+    world_gen_publish_chunks(system, WORLD_GEN_PUBLISH_PER_UPDATE);
+    
     // Optimize chunk cache periodically
     static f32 cache_timer = 0.0f;
     cache_timer += dt;
@@ -492,13 +683,13 @@ world_gen_update(world_gen_system *system, f32 dt) {
     }
 }
 
-// Climate calculation
-climate_data
-world_gen_calculate_climate(world_gen_system *system, f32 world_x, f32 world_y, f32 elevation) {
+// Climate from pre-sampled noise (shared by the single-point and batch paths)
+internal climate_data
+climate_from_noise(world_gen_system *system, f32 world_y, f32 elevation,
+                   f32 temp_noise, f32 humidity_noise, f32 wind_noise, f32 direction_noise) {
     climate_data climate = {0};
     
     // Base temperature from noise + global settings
-    f32 temp_noise = world_gen_noise_2d(&system->temperature_noise, world_x, world_y);
     climate.temperature = system->global_temperature_offset + temp_noise;
     
     // Altitude effect on temperature
@@ -509,7 +700,7 @@ world_gen_calculate_climate(world_gen_system *system, f32 world_x, f32 world_y,
     climate.temperature -= latitude * system->latitude_effect * 20.0f;
     
     // Humidity from noise
-    climate.humidity = (world_gen_noise_2d(&system->humidity_noise, world_x, world_y) + 1.0f) * 0.5f;
+    climate.humidity = (humidity_noise + 1.0f) * 0.5f;
     climate.humidity = fmaxf(0.0f, fminf(1.0f, climate.humidity));
     
     // Ocean distance effect on humidity
@@ -519,30 +710,101 @@ world_gen_calculate_climate(world_gen_system *system, f32 world_x, f32 world_y,
     climate.precipitation = climate.humidity * fmaxf(0.0f, (climate.temperature + 10.0f)) * 10.0f;
     
     // Wind simulation
-    climate.wind_speed = (world_gen_noise_2d(&system->biome_noise, world_x * 0.1f, world_y * 0.1f) + 1.0f) * 25.0f;
-    climate.wind_direction = world_gen_noise_2d(&system->biome_noise, world_x * 0.05f, world_y * 0.05f) * 360.0f;
+    climate.wind_speed = (wind_noise + 1.0f) * 25.0f;
+    climate.wind_direction = direction_noise * 360.0f;
     
     climate.elevation_factor = elevation / 1000.0f;
     
     return climate;
 }
 
+// Climate calculation
+climate_data
+world_gen_calculate_climate(world_gen_system *system, f32 world_x, f32 world_y, f32 elevation) {
+    climate_data climate;
+    world_gen_calculate_climate_batch(system, &world_x, &world_y, &elevation, &climate, 1);
+    return climate;
+}
+
+// PERFORMANCE: Four noise passes over the whole batch, then a scalar combine
+void
+world_gen_calculate_climate_batch(world_gen_system *system, const f32 *world_x, const f32 *world_y,
+                                  const f32 *elevation, climate_data *out, u32 count) {
+    f32 temp_noise[WORLD_GEN_NOISE_BATCH];
+    f32 humidity_noise[WORLD_GEN_NOISE_BATCH];
+    f32 wind_noise[WORLD_GEN_NOISE_BATCH];
+    f32 direction_noise[WORLD_GEN_NOISE_BATCH];
+    f32 wind_x[WORLD_GEN_NOISE_BATCH], wind_y[WORLD_GEN_NOISE_BATCH];
+    f32 direction_x[WORLD_GEN_NOISE_BATCH], direction_y[WORLD_GEN_NOISE_BATCH];
+    
+    for (u32 start = 0; start < count; start += WORLD_GEN_NOISE_BATCH) {
+        u32 n = count - start < WORLD_GEN_NOISE_BATCH ? count - start : WORLD_GEN_NOISE_BATCH;
+        const f32 *x = world_x + start;
+        const f32 *y = world_y + start;
+        
+        for (u32 i = 0; i < n; i++) {
+            wind_x[i] = x[i] * 0.1f;
+            wind_y[i] = y[i] * 0.1f;
+            direction_x[i] = x[i] * 0.05f;
+            direction_y[i] = y[i] * 0.05f;
+        }
+        
+        world_gen_noise_2d_batch(&system->temperature_noise, x, y, temp_noise, n);
+        world_gen_noise_2d_batch(&system->humidity_noise, x, y, humidity_noise, n);
+        world_gen_noise_2d_batch(&system->biome_noise, wind_x, wind_y, wind_noise, n);
+        world_gen_noise_2d_batch(&system->biome_noise, direction_x, direction_y, direction_noise, n);
+        
+        for (u32 i = 0; i < n; i++) {
+            out[start + i] = climate_from_noise(system, y[i], elevation[start + i],
+                                                temp_noise[i], humidity_noise[i],
+                                                wind_noise[i], direction_noise[i]);
+        }
+    }
+}
+
 f32
 world_gen_sample_elevation(world_gen_system *system, f32 world_x, f32 world_y) {
-    // Base terrain elevation
-    f32 base_elevation = world_gen_fbm_noise(&system->elevation_noise, world_x, world_y, 6) * 200.0f;
-    
-    // Mountain ridges
-    f32 mountain_noise = world_gen_ridge_noise(&system->elevation_noise, world_x * 0.002f, world_y * 0.002f);
-    f32 mountain_mask = fmaxf(0.0f, mountain_noise - 0.3f) * 3.33f; // 0-1 range
-    base_elevation += mountain_mask * 800.0f;
-    
-    // Fine detail
-    for (u32 i = 0; i < system->detail_noise_count; i++) {
-        base_elevation += world_gen_noise_2d(&system->detail_noise[i], world_x, world_y);
+    f32 elevation;
+    world_gen_sample_elevation_batch(system, &world_x, &world_y, &elevation, 1);
+    return elevation;
+}
+
+void
+world_gen_sample_elevation_batch(world_gen_system *system, const f32 *world_x, const f32 *world_y,
+                                 f32 *out, u32 count) {
+    f32 base[WORLD_GEN_NOISE_BATCH];
+    f32 ridge[WORLD_GEN_NOISE_BATCH];
+    f32 detail[WORLD_GEN_NOISE_BATCH];
+    f32 ridge_x[WORLD_GEN_NOISE_BATCH], ridge_y[WORLD_GEN_NOISE_BATCH];
+    
+    for (u32 start = 0; start < count; start += WORLD_GEN_NOISE_BATCH) {
+        u32 n = count - start < WORLD_GEN_NOISE_BATCH ? count - start : WORLD_GEN_NOISE_BATCH;
+        const f32 *x = world_x + start;
+        const f32 *y = world_y + start;
+        f32 *elevation = out + start;
+        
+        for (u32 i = 0; i < n; i++) {
+            ridge_x[i] = x[i] * 0.002f;
+            ridge_y[i] = y[i] * 0.002f;
+        }
+        
+        // Base terrain elevation and mountain ridges
+        world_gen_fbm_noise_batch(&system->elevation_noise, x, y, base, n, 6);
+        world_gen_ridge_noise_batch(&system->elevation_noise, ridge_x, ridge_y, ridge, n);
+        
+        for (u32 i = 0; i < n; i++) {
+            f32 mountain_mask = fmaxf(0.0f, ridge[i] - 0.3f) * 3.33f; // 0-1 range
+            elevation[i] = base[i] * 200.0f + mountain_mask * 800.0f;
+        }
+        
+        // Fine detail
+        for (u32 layer = 0; layer < system->detail_noise_count; layer++) {
+            world_gen_noise_2d_batch(&system->detail_noise[layer], x, y, detail, n);
+            for (u32 i = 0; i < n; i++) {
+                elevation[i] += detail[i];
+            }
+        }
     }
-    
-    return base_elevation;
 }
 
 biome_type
@@ -579,22 +841,39 @@ world_gen_sample_biome(world_gen_system *system, f32 world_x, f32 world_y) {
     return world_gen_determine_biome(system, climate.temperature, climate.humidity, elevation);
 }
 
-world_tile *
-world_gen_get_tile(world_gen_system *system, i32 world_x, i32 world_y) {
-    i32 chunk_x = world_x / WORLD_CHUNK_SIZE;
-    i32 chunk_y = world_y / WORLD_CHUNK_SIZE;
+// Resolve a world tile coordinate to its chunk and in-chunk position
+internal world_chunk *
+world_gen_tile_chunk(world_gen_system *system, i32 world_x, i32 world_y, i32 *tile_x, i32 *tile_y) {
+    // Floor division so negative coordinates land in the correct chunk
+    i32 chunk_x = (world_x >= 0 ? world_x : world_x - (WORLD_CHUNK_SIZE - 1)) / WORLD_CHUNK_SIZE;
+    i32 chunk_y = (world_y >= 0 ? world_y : world_y - (WORLD_CHUNK_SIZE - 1)) / WORLD_CHUNK_SIZE;
     
     world_chunk *chunk = world_gen_get_chunk(system, chunk_x, chunk_y);
     if (!chunk) return 0;
     
-    i32 tile_x = world_x - (chunk_x * WORLD_CHUNK_SIZE);
-    i32 tile_y = world_y - (chunk_y * WORLD_CHUNK_SIZE);
+    *tile_x = world_x - (chunk_x * WORLD_CHUNK_SIZE);
+    *tile_y = world_y - (chunk_y * WORLD_CHUNK_SIZE);
+    return chunk;
+}
+
+b32
+world_gen_get_tile(world_gen_system *system, i32 world_x, i32 world_y, world_tile *tile) {
+    i32 tile_x, tile_y;
+    world_chunk *chunk = world_gen_tile_chunk(system, world_x, world_y, &tile_x, &tile_y);
+    if (!chunk || !tile) return 0;
     
-    if (tile_x < 0 || tile_x >= WORLD_CHUNK_SIZE || tile_y < 0 || tile_y >= WORLD_CHUNK_SIZE) {
-        return 0;
-    }
+    *tile = world_chunk_get_tile(chunk, tile_x, tile_y);
+    return 1;
+}
+
+b32
+world_gen_set_tile(world_gen_system *system, i32 world_x, i32 world_y, world_tile *tile) {
+    i32 tile_x, tile_y;
+    world_chunk *chunk = world_gen_tile_chunk(system, world_x, world_y, &tile_x, &tile_y);
+    if (!chunk || !tile) return 0;
     
-    return &chunk->tiles[tile_x][tile_y];
+    world_chunk_set_tile(chunk, tile_x, tile_y, tile);
+    return 1;
 }
 
 void
@@ -604,7 +883,8 @@ world_gen_print_stats(world_gen_system *system) {
     printf("\n=== World Generation System Stats ===\n");
     printf("Initialized: %s\n", system->initialized ? "Yes" : "No");
     printf("World seed: %llu\n", (unsigned long long)system->world_seed);
-    printf("Active chunks: %u/%u\n", system->active_chunk_count, WORLD_MAX_ACTIVE_CHUNKS);
+    printf("Active chunks: %u/%u (budget %llu KB)\n", system->active_chunk_count, 
+           system->max_resident_chunks, (unsigned long long)(system->chunk_memory_budget / 1024));
     printf("Total chunks generated: %llu\n", (unsigned long long)system->total_chunks_generated);
     printf("Generation rate: %u chunks/second\n", system->chunks_per_second);
     printf("Cache hits: %u\n", system->cache_hits);
@@ -612,6 +892,10 @@ world_gen_print_stats(world_gen_system *system) {
     printf("Cache hit rate: %.1f%%\n", 
            system->cache_hits + system->cache_misses > 0 ? 
            (f32)system->cache_hits / (f32)(system->cache_hits + system->cache_misses) * 100.0f : 0.0f);
+    printf("Chunks evicted: %u (spilled %u, reloaded %u)\n",
+           system->chunks_evicted, system->chunks_spilled, system->chunks_reloaded);
+    printf("Pipeline: %u pending, %u published, %u cancelled\n",
+           world_gen_pending_chunks(system), system->chunks_published, system->chunks_cancelled);
     printf("Average generation time: %.3f ms\n",
            system->total_chunks_generated > 0 ?
            (f32)system->total_generation_time_us / (f32)system->total_chunks_generated / 1000.0f : 0.0f);
@@ -620,12 +904,6 @@ world_gen_print_stats(world_gen_system *system) {
     printf("========================================\n\n");
 }
 
-void
-world_gen_optimize_chunk_cache(world_gen_system *system) {
-    // Implementation would optimize chunk cache
-    // For now, just a placeholder
-    (void)system;
-}
 
 b32
 world_gen_should_unload_chunk(world_gen_system *system, world_chunk *chunk, i32 player_x, i32 player_y) {
@@ -27,12 +27,22 @@
 #define WORLD_GEN_VERSION 1
 #define WORLD_CHUNK_SIZE 64
 #define WORLD_CHUNK_HEIGHT 256
-#define WORLD_MAX_ACTIVE_CHUNKS 64
+#define WORLD_CHUNK_TILES (WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE)
+#define WORLD_CHUNK_BITSET_WORDS (WORLD_CHUNK_TILES / 64)
+#define WORLD_TILE_INDEX(x, y) ((y) * WORLD_CHUNK_SIZE + (x)) // Row-major plane index
+#define WORLD_MAX_ACTIVE_CHUNKS 128
+#define WORLD_CHUNK_MAP_SIZE (WORLD_MAX_ACTIVE_CHUNKS * 4) // Power of two, load <= 25%
+#define WORLD_CHUNK_SLOT_NONE 0xFFFFFFFF
 #define WORLD_BIOME_COUNT 16
 #define WORLD_NOISE_LAYERS 8
 #define WORLD_STRUCTURE_COUNT 32
 #define WORLD_RESOURCE_TYPES 16
 #define WORLD_SEED_DEFAULT 12345
+#define WORLD_GEN_MAX_WORKERS 8
+#define WORLD_GEN_MAX_JOBS 256
+#define WORLD_GEN_STAGING_CHUNKS 16       // Chunks generated concurrently off-thread
+#define WORLD_GEN_PUBLISH_PER_UPDATE 4    // Chunks published per world_gen_update
+#define WORLD_GEN_NOISE_BATCH 64          // Points per batch noise pass (one chunk row)
 
 // Forward declarations
 typedef struct achievement_system achievement_system;
@@ -183,7 +193,15 @@ typedef struct world_structure {
     f32 durability;
 } world_structure;
 
-// Chunk tile data
+// Chunk generation stages, run in order for each chunk
+typedef enum chunk_gen_stage {
+    CHUNK_STAGE_TERRAIN = 0,     // Elevation, climate, biome
+    CHUNK_STAGE_BIOME_BLEND,     // Transitions, needs terrain of surrounding tiles
+    CHUNK_STAGE_FEATURES,        // Features and resource richness
+    CHUNK_STAGE_COMPLETE
+} chunk_gen_stage;
+
+// Unpacked tile view (chunks store tiles as planes, see world_tile_planes)
 typedef struct world_tile {
     f32 elevation;           // Height above sea level
     biome_type biome;        // Primary biome
@@ -209,13 +227,47 @@ typedef struct world_tile {
     u64 last_update_time;
 } world_tile;
 
+// Quantized encodings for 0-1 plane values
+#define WORLD_UNIT_TO_U8(v) ((u8)(fmaxf(0.0f, fminf(1.0f, (v))) * 255.0f + 0.5f))
+#define WORLD_U8_TO_UNIT(q) ((f32)(q) * (1.0f / 255.0f))
+
+// Tile storage as per-field planes, indexed with WORLD_TILE_INDEX.
+// world_tile is the unpacked view (world_chunk_get_tile / world_chunk_set_tile).
+// CACHE: Hot planes are scanned by gameplay, collision and generation; cold
+// planes are only touched when a full tile is unpacked.
+typedef struct world_tile_planes {
+    // Hot
+    f32 elevation[WORLD_CHUNK_TILES];
+    u8 biome[WORLD_CHUNK_TILES];
+    u8 feature[WORLD_CHUNK_TILES];
+    u8 resource[WORLD_CHUNK_TILES];
+    u8 danger[WORLD_CHUNK_TILES];             // danger_level, 0-1 in 1/255 steps
+    u64 explored[WORLD_CHUNK_BITSET_WORDS];   // Bit per tile
+    u64 visible[WORLD_CHUNK_BITSET_WORDS];
+    
+    // Cold
+    u8 secondary_biome[WORLD_CHUNK_TILES];
+    u8 biome_blend[WORLD_CHUNK_TILES];        // 1/255 steps
+    u8 resource_density[WORLD_CHUNK_TILES];   // 1/255 steps
+    u8 resource_quality[WORLD_CHUNK_TILES];   // 1/255 steps
+    u8 humidity[WORLD_CHUNK_TILES];           // 1/255 steps
+    u8 wind_speed[WORLD_CHUNK_TILES];         // 0.2 m/s
+    s16 temperature[WORLD_CHUNK_TILES];       // 0.01 C
+    s16 wind_direction[WORLD_CHUNK_TILES];    // 0.02 degrees
+    u16 precipitation[WORLD_CHUNK_TILES];     // 0.1 mm/month
+    u16 ocean_distance[WORLD_CHUNK_TILES];    // Meters
+    u16 structure_id[WORLD_CHUNK_TILES];
+    u16 structure_health[WORLD_CHUNK_TILES];  // 0.1 units
+    u32 last_update_time[WORLD_CHUNK_TILES];
+} world_tile_planes;
+
 // World chunk - 64x64 tiles
 typedef struct world_chunk {
     i32 chunk_x;
     i32 chunk_y;
     u64 chunk_id;            // Unique identifier
     
-    world_tile tiles[WORLD_CHUNK_SIZE][WORLD_CHUNK_SIZE];
+    world_tile_planes planes;
     
     // Chunk metadata
     biome_type dominant_biome;
@@ -234,6 +286,10 @@ typedef struct world_chunk {
     u64 last_access_time;
     u32 access_count;
     
+    // Cache state
+    b32 resident;            // Slot holds a live chunk
+    b32 referenced;          // Clock bit, set on access, cleared by eviction sweep
+    
     // Neighbors (for seamless generation)
     struct world_chunk *neighbors[8]; // N, NE, E, SE, S, SW, W, NW
 } world_chunk;
@@ -246,9 +302,21 @@ typedef struct world_gen_system {
     f32 world_scale;         // Affects feature sizes
     
     // Chunk management
+    // Slots are stable while resident; chunk_map resolves coordinates to slots
     world_chunk active_chunks[WORLD_MAX_ACTIVE_CHUNKS];
     u32 active_chunk_count;
-    world_chunk *chunk_hash[256]; // Hash table for quick lookup
+    u16 chunk_map[WORLD_CHUNK_MAP_SIZE]; // Open addressing, slot + 1 (0 = empty)
+    u16 free_chunk_slots[WORLD_MAX_ACTIVE_CHUNKS];
+    u32 free_chunk_count;
+    
+    // Eviction (clock policy bounded by memory budget)
+    u64 chunk_memory_budget;     // Bytes of resident chunk data allowed
+    u32 max_resident_chunks;     // Derived from budget
+    u32 clock_hand;
+    char spill_path[256];        // Directory for evicted chunks, empty = disabled
+    
+    // Asynchronous generation (see world_gen_start_pipeline)
+    struct world_gen_pipeline *pipeline;
     
     // Biome definitions
     biome_definition biomes[WORLD_BIOME_COUNT];
@@ -287,6 +355,11 @@ typedef struct world_gen_system {
     u32 chunks_per_second;
     u32 cache_hits;
     u32 cache_misses;
+    u32 chunks_evicted;
+    u32 chunks_spilled;
+    u32 chunks_reloaded;
+    u32 chunks_published;
+    u32 chunks_cancelled;
     
     // Memory management
     u8 *memory;
@@ -317,12 +390,38 @@ world_chunk *world_gen_get_chunk(world_gen_system *system, i32 chunk_x, i32 chun
 world_chunk *world_gen_generate_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y);
 void world_gen_unload_chunk(world_gen_system *system, world_chunk *chunk);
 void world_gen_preload_area(world_gen_system *system, i32 center_x, i32 center_y, i32 radius);
+world_chunk *world_gen_find_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y);
+
+// Chunk cache
+void world_gen_set_chunk_budget(world_gen_system *system, u64 budget_bytes);
+void world_gen_set_chunk_spill_path(world_gen_system *system, char *directory);
+b32 world_gen_spill_chunk(world_gen_system *system, world_chunk *chunk);
+b32 world_gen_reload_chunk(world_gen_system *system, world_chunk *chunk, i32 chunk_x, i32 chunk_y);
+
+// Asynchronous generation pipeline
+// Workers run chunk stages in priority order (nearest to focus first).
+// Finished chunks only enter the cache in world_gen_publish_chunks, which
+// must be called from the thread that owns the system (world_gen_update does).
+b32 world_gen_start_pipeline(world_gen_system *system, u32 worker_count);
+void world_gen_stop_pipeline(world_gen_system *system);
+b32 world_gen_request_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y);
+void world_gen_cancel_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y);
+void world_gen_set_generation_focus(world_gen_system *system, f32 chunk_x, f32 chunk_y, f32 keep_radius);
+u32 world_gen_publish_chunks(world_gen_system *system, u32 max_chunks);
+u32 world_gen_pending_chunks(world_gen_system *system);
 
 // Terrain queries
 f32 world_gen_sample_elevation(world_gen_system *system, f32 world_x, f32 world_y);
 biome_type world_gen_sample_biome(world_gen_system *system, f32 world_x, f32 world_y);
 climate_data world_gen_sample_climate(world_gen_system *system, f32 world_x, f32 world_y);
-world_tile *world_gen_get_tile(world_gen_system *system, i32 world_x, i32 world_y);
+b32 world_gen_get_tile(world_gen_system *system, i32 world_x, i32 world_y, world_tile *tile);
+b32 world_gen_set_tile(world_gen_system *system, i32 world_x, i32 world_y, world_tile *tile);
+
+// Tile planes
+world_tile world_chunk_get_tile(world_chunk *chunk, i32 x, i32 y);
+void world_chunk_set_tile(world_chunk *chunk, i32 x, i32 y, world_tile *tile);
+b32 world_chunk_tile_flag(u64 *bitset, i32 x, i32 y);
+void world_chunk_set_tile_flag(u64 *bitset, i32 x, i32 y, b32 value);
 
 // Noise generation (Perlin/Simplex noise implementation)
 f32 world_gen_noise_2d(noise_params *params, f32 x, f32 y);
@@ -331,6 +430,14 @@ f32 world_gen_fbm_noise(noise_params *params, f32 x, f32 y, i32 octaves);
 f32 world_gen_ridge_noise(noise_params *params, f32 x, f32 y);
 f32 world_gen_turbulence_noise(noise_params *params, f32 x, f32 y);
 
+// Batch noise: same results as the single-point functions, AVX2/FMA 8 points per pass
+void world_gen_noise_2d_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count);
+void world_gen_fbm_noise_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count, i32 octaves);
+void world_gen_ridge_noise_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count);
+void world_gen_turbulence_noise_batch(noise_params *params, const f32 *x, const f32 *y, f32 *out, u32 count);
+void world_gen_sample_elevation_batch(world_gen_system *system, const f32 *world_x, const f32 *world_y,
+                                      f32 *out, u32 count);
+
 // Biome system
 void world_gen_register_biome(world_gen_system *system, biome_definition *biome);
 biome_type world_gen_determine_biome(world_gen_system *system, f32 temperature, f32 humidity, f32 elevation);
@@ -353,6 +460,8 @@ void world_gen_create_cave_network(generation_context *ctx, i32 start_x, i32 sta
 
 // Climate simulation
 climate_data world_gen_calculate_climate(world_gen_system *system, f32 world_x, f32 world_y, f32 elevation);
+void world_gen_calculate_climate_batch(world_gen_system *system, const f32 *world_x, const f32 *world_y,
+                                       const f32 *elevation, climate_data *out, u32 count);
 f32 world_gen_temperature_at_point(world_gen_system *system, f32 world_x, f32 world_y, f32 elevation);
 f32 world_gen_humidity_at_point(world_gen_system *system, f32 world_x, f32 world_y);
 f32 world_gen_precipitation_at_point(world_gen_system *system, f32 world_x, f32 world_y);
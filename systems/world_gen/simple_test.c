@@ -63,11 +63,9 @@ int main() {
         
         // Count resources in chunk
         i32 resource_tiles = 0;
-        for (i32 y = 0; y < WORLD_CHUNK_SIZE; y++) {
-            for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
-                if (chunk->tiles[x][y].resource != RESOURCE_NONE) {
-                    resource_tiles++;
-                }
+        for (u32 i = 0; i < WORLD_CHUNK_TILES; i++) {
+            if (chunk->planes.resource[i] != RESOURCE_NONE) {
+                resource_tiles++;
             }
         }
         printf("Resource tiles: %d/%d\n", resource_tiles, WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE);
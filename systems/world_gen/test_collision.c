@@ -73,6 +73,53 @@ void test_height_queries(terrain_system* terrain) {
     printf("Is walkable (max 45°): %s\n", walkable ? "Yes" : "No");
 }
 
+// Heights must not move when a chunk's tile enters the cache
+void test_height_cache_agreement(terrain_system* terrain) {
+    printf("\n=== Height Cache Agreement Tests ===\n");
+    
+    const u32 SAMPLES = 64;
+    f32 sample_size = terrain->params.horizontal_scale;
+    f32 chunk_extent = (f32)TERRAIN_PYRAMID_CHUNK_CELLS * sample_size;
+    f32 footprints[3] = {0.0f, 2.0f * sample_size, 4.0f * sample_size};
+    
+    // Chunk (3,1) loads at full resolution, chunk (4,1) only at LOD 2
+    for (u32 c = 0; c < 2; c++) {
+        s32 chunk_x = 3 + (s32)c;
+        u32 lod = c ? 2 : 0;
+        f32 before[64][4];
+        
+        for (u32 i = 0; i < SAMPLES; i++) {
+            f32 x = ((f32)chunk_x + ((f32)(i % 8) + 0.37f) / 8.0f) * chunk_extent;
+            f32 z = (1.0f + ((f32)(i / 8) + 0.61f) / 8.0f) * chunk_extent;
+            before[i][0] = terrain_get_height_interpolated(terrain, x, z);
+            for (u32 f = 0; f < 3; f++) {
+                before[i][1 + f] = terrain_get_height_filtered(terrain, x, z, footprints[f],
+                    f == 2 ? TERRAIN_FILTER_BICUBIC : TERRAIN_FILTER_BILINEAR);
+            }
+        }
+        
+        terrain_generate_chunk(terrain, &terrain->chunks[1 + c], chunk_x, 1, lod);
+        
+        f32 max_error = 0.0f;
+        for (u32 i = 0; i < SAMPLES; i++) {
+            f32 x = ((f32)chunk_x + ((f32)(i % 8) + 0.37f) / 8.0f) * chunk_extent;
+            f32 z = (1.0f + ((f32)(i / 8) + 0.61f) / 8.0f) * chunk_extent;
+            f32 after[4];
+            after[0] = terrain_get_height_interpolated(terrain, x, z);
+            for (u32 f = 0; f < 3; f++) {
+                after[1 + f] = terrain_get_height_filtered(terrain, x, z, footprints[f],
+                    f == 2 ? TERRAIN_FILTER_BICUBIC : TERRAIN_FILTER_BILINEAR);
+            }
+            for (u32 k = 0; k < 4; k++) {
+                max_error = fmaxf(max_error, fabsf(after[k] - before[i][k]));
+            }
+        }
+        
+        printf("Chunk (%d,1) at LOD %u: max height change on load %.5f\n", chunk_x, lod, max_error);
+        assert(max_error < 1e-3f);
+    }
+}
+
 void test_sphere_collision(terrain_system* terrain) {
     printf("\n=== Sphere Collision Tests ===\n");
     
@@ -222,6 +269,118 @@ void test_line_of_sight(terrain_system* terrain) {
     printf("Low altitude LOS: %s\n", clear ? "Clear" : "Blocked");
 }
 
+// Reference: dense march of the bilinear surface with a bisection refine,
+// returns the first t where the segment goes below the terrain
+static b32 reference_march(terrain_system* terrain, v3 origin, v3 dir, f32 max_distance, f32* t_hit) {
+    f32 step = terrain->params.horizontal_scale * 0.01f;
+    f32 prev = 0.0f;
+    for (f32 t = 0.0f; t <= max_distance; t += step) {
+        f32 y = origin.y + dir.y * t;
+        if (y <= terrain_get_height_interpolated(terrain, origin.x + dir.x * t, origin.z + dir.z * t)) {
+            f32 lo = prev, hi = t;
+            for (u32 i = 0; i < 24; i++) {
+                f32 mid = (lo + hi) * 0.5f;
+                f32 h = terrain_get_height_interpolated(terrain, origin.x + dir.x * mid, origin.z + dir.z * mid);
+                if (origin.y + dir.y * mid <= h) hi = mid; else lo = mid;
+            }
+            *t_hit = hi;
+            return 1;
+        }
+        prev = t;
+    }
+    return 0;
+}
+
+// Rays and sight lines over a resident chunk must walk its pyramid and agree with the march
+void test_pyramid_raycast(terrain_system* terrain) {
+    printf("\n=== Height Pyramid Tests ===\n");
+    
+    terrain_chunk* chunk = &terrain->chunks[0];  // Chunk (0,0) at LOD 0
+    assert(terrain_lookup_height_pyramid(terrain, 0, 0) != 0);
+    
+    // Queries may run on worker threads, so none of them may touch the caches
+    u32 pyramid_clock = terrain->pyramid_clock;
+    u32 pyramids_built = terrain->stats.pyramids_built;
+    u32 tile_clock = terrain->height_tile_clock;
+    u8 pyramid_misses[TERRAIN_PYRAMID_MISS_SLOTS];
+    memcpy(pyramid_misses, terrain->pyramid_misses, sizeof(pyramid_misses));
+    
+    f32 extent = (f32)TERRAIN_PYRAMID_CHUNK_CELLS * terrain->params.horizontal_scale;
+    u64 nodes_before = terrain->stats.raycast_nodes_visited;
+    u32 hits = 0;
+    f32 max_error = 0.0f;
+    
+    for (u32 i = 0; i < 64; i++) {
+        v3 origin = {
+            extent * (0.25f + 0.5f * (f32)(i % 8) / 7.0f),
+            chunk->max_bounds.y + 5.0f,
+            extent * (0.25f + 0.5f * (f32)(i / 8) / 7.0f)
+        };
+        v3 dir = {0.3f * cosf((f32)i), -1.0f, 0.3f * sinf((f32)i)};
+        f32 len = sqrtf(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+        dir = (v3){dir.x / len, dir.y / len, dir.z / len};
+        
+        v3 hit_point;
+        f32 t_ref;
+        b32 hit = terrain_raycast(terrain, origin, dir, 500.0f, &hit_point, 0);
+        b32 ref = reference_march(terrain, origin, dir, 500.0f, &t_ref);
+        assert(hit == ref);
+        if (!hit) continue;
+        
+        f32 dx = hit_point.x - origin.x, dy = hit_point.y - origin.y, dz = hit_point.z - origin.z;
+        max_error = fmaxf(max_error, fabsf(sqrtf(dx * dx + dy * dy + dz * dz) - t_ref));
+        hits++;
+    }
+    
+    u64 ray_nodes = terrain->stats.raycast_nodes_visited - nodes_before;
+    printf("Pyramid rays: %u/64 hits, max distance error vs march %.5f, %llu nodes visited\n",
+           hits, max_error, (unsigned long long)ray_nodes);
+    assert(hits == 64);
+    assert(ray_nodes > 0);
+    assert(max_error < 0.01f);
+    
+    // Sight lines between points just above the surface
+    nodes_before = terrain->stats.raycast_nodes_visited;
+    u32 blocked = 0, mismatches = 0;
+    for (u32 i = 0; i < 64; i++) {
+        f32 ax = extent * (0.1f + 0.8f * (f32)(i % 8) / 7.0f);
+        f32 az = extent * 0.1f;
+        f32 bx = extent * (0.9f - 0.8f * (f32)(i / 8) / 7.0f);
+        f32 bz = extent * 0.9f;
+        v3 from = {ax, terrain_get_height_interpolated(terrain, ax, az) + 2.0f, az};
+        v3 to = {bx, terrain_get_height_interpolated(terrain, bx, bz) + 2.0f, bz};
+        
+        v3 d = {to.x - from.x, to.y - from.y, to.z - from.z};
+        f32 distance = sqrtf(d.x * d.x + d.y * d.y + d.z * d.z);
+        d = (v3){d.x / distance, d.y / distance, d.z / distance};
+        
+        f32 t_ref;
+        b32 ref_visible = !reference_march(terrain, from, d, distance, &t_ref);
+        b32 visible = terrain_line_of_sight(terrain, from, to);
+        blocked += !visible;
+        mismatches += (visible != ref_visible);
+    }
+    
+    u64 los_nodes = terrain->stats.raycast_nodes_visited - nodes_before;
+    printf("Pyramid sight lines: %u/64 blocked, %u mismatches vs march, %llu nodes visited\n",
+           blocked, mismatches, (unsigned long long)los_nodes);
+    assert(los_nodes > 0);
+    assert(mismatches == 0);
+    
+    // Long rays through chunks that have no pyramid march them instead
+    for (u32 i = 0; i < 4 * TERRAIN_PYRAMID_ADMIT_MISSES; i++) {
+        v3 origin = {extent * 0.5f, chunk->max_bounds.y + 50.0f, extent * 0.5f};
+        v3 dir = {cosf((f32)i * 0.1f), -0.05f, sinf((f32)i * 0.1f)};
+        terrain_raycast(terrain, origin, dir, 4.0f * extent, 0, 0);
+    }
+    
+    assert(terrain->pyramid_clock == pyramid_clock);
+    assert(terrain->stats.pyramids_built == pyramids_built);
+    assert(terrain->height_tile_clock == tile_clock);
+    assert(memcmp(pyramid_misses, terrain->pyramid_misses, sizeof(pyramid_misses)) == 0);
+    printf("Queries left the pyramid and height tile caches untouched\n");
+}
+
 void benchmark_collision(terrain_system* terrain) {
     printf("\n=== Collision Performance ===\n");
     
@@ -302,11 +461,13 @@ int main() {
     
     // Run tests
     test_height_queries(terrain);
+    test_height_cache_agreement(terrain);
     test_sphere_collision(terrain);
     test_raycast(terrain);
     test_capsule_collision(terrain);
     test_box_collision(terrain);
     test_line_of_sight(terrain);
+    test_pyramid_raycast(terrain);
     
     // Benchmark
     benchmark_collision(terrain);
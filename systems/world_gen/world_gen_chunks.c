@@ -3,11 +3,14 @@
     Handles chunk loading, generation, and caching
 */
 
+#define _POSIX_C_SOURCE 200112L
+
 #include "handmade_world_gen.h"
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <pthread.h>
 
 #define internal static
 
@@ -25,6 +28,107 @@ init_generation_context(generation_context *ctx, world_gen_system *world_gen,
     ctx->random_seed = (u32)world_gen_get_chunk_seed(world_gen, chunk_x, chunk_y);
 }
 
+// =============================================================================
+// TILE PLANES
+// =============================================================================
+
+internal i32
+quantize_clamped(f32 value, f32 scale, i32 min_value, i32 max_value) {
+    f32 q = roundf(value * scale);
+    if (q < (f32)min_value) return min_value;
+    if (q > (f32)max_value) return max_value;
+    return (i32)q;
+}
+
+internal void
+store_tile_climate(world_tile_planes *planes, u32 index, climate_data *climate) {
+    planes->temperature[index] = (s16)quantize_clamped(climate->temperature, 100.0f, -32768, 32767);
+    planes->humidity[index] = WORLD_UNIT_TO_U8(climate->humidity);
+    planes->precipitation[index] = (u16)quantize_clamped(climate->precipitation, 10.0f, 0, 65535);
+    planes->wind_speed[index] = (u8)quantize_clamped(climate->wind_speed, 5.0f, 0, 255);
+    planes->wind_direction[index] = (s16)quantize_clamped(climate->wind_direction, 50.0f, -32768, 32767);
+    planes->ocean_distance[index] = (u16)quantize_clamped(climate->ocean_distance, 1.0f, 0, 65535);
+}
+
+internal climate_data
+load_tile_climate(world_tile_planes *planes, u32 index) {
+    climate_data climate;
+    climate.temperature = (f32)planes->temperature[index] * 0.01f;
+    climate.humidity = WORLD_U8_TO_UNIT(planes->humidity[index]);
+    climate.precipitation = (f32)planes->precipitation[index] * 0.1f;
+    climate.wind_speed = (f32)planes->wind_speed[index] * 0.2f;
+    climate.wind_direction = (f32)planes->wind_direction[index] * 0.02f;
+    climate.ocean_distance = (f32)planes->ocean_distance[index];
+    climate.elevation_factor = planes->elevation[index] / 1000.0f;
+    return climate;
+}
+
+b32
+world_chunk_tile_flag(u64 *bitset, i32 x, i32 y) {
+    u32 index = WORLD_TILE_INDEX(x, y);
+    return (bitset[index >> 6] >> (index & 63)) & 1;
+}
+
+void
+world_chunk_set_tile_flag(u64 *bitset, i32 x, i32 y, b32 value) {
+    u32 index = WORLD_TILE_INDEX(x, y);
+    u64 bit = 1ull << (index & 63);
+    if (value) {
+        bitset[index >> 6] |= bit;
+    } else {
+        bitset[index >> 6] &= ~bit;
+    }
+}
+
+// Unpack one tile from the planes
+world_tile
+world_chunk_get_tile(world_chunk *chunk, i32 x, i32 y) {
+    world_tile_planes *planes = &chunk->planes;
+    u32 index = WORLD_TILE_INDEX(x, y);
+    world_tile tile;
+    
+    tile.elevation = planes->elevation[index];
+    tile.biome = (biome_type)planes->biome[index];
+    tile.secondary_biome = (biome_type)planes->secondary_biome[index];
+    tile.biome_blend = WORLD_U8_TO_UNIT(planes->biome_blend[index]);
+    tile.climate = load_tile_climate(planes, index);
+    tile.feature = (terrain_feature)planes->feature[index];
+    tile.resource = (resource_type)planes->resource[index];
+    tile.resource_density = WORLD_U8_TO_UNIT(planes->resource_density[index]);
+    tile.resource_quality = WORLD_U8_TO_UNIT(planes->resource_quality[index]);
+    tile.structure_id = planes->structure_id[index];
+    tile.structure_health = (f32)planes->structure_health[index] * 0.1f;
+    tile.explored = world_chunk_tile_flag(planes->explored, x, y);
+    tile.visible = world_chunk_tile_flag(planes->visible, x, y);
+    tile.danger_level = WORLD_U8_TO_UNIT(planes->danger[index]);
+    tile.last_update_time = planes->last_update_time[index];
+    
+    return tile;
+}
+
+// Pack one tile into the planes (values are quantized to plane precision)
+void
+world_chunk_set_tile(world_chunk *chunk, i32 x, i32 y, world_tile *tile) {
+    world_tile_planes *planes = &chunk->planes;
+    u32 index = WORLD_TILE_INDEX(x, y);
+    
+    planes->elevation[index] = tile->elevation;
+    planes->biome[index] = (u8)tile->biome;
+    planes->secondary_biome[index] = (u8)tile->secondary_biome;
+    planes->biome_blend[index] = WORLD_UNIT_TO_U8(tile->biome_blend);
+    store_tile_climate(planes, index, &tile->climate);
+    planes->feature[index] = (u8)tile->feature;
+    planes->resource[index] = (u8)tile->resource;
+    planes->resource_density[index] = WORLD_UNIT_TO_U8(tile->resource_density);
+    planes->resource_quality[index] = WORLD_UNIT_TO_U8(tile->resource_quality);
+    planes->structure_id[index] = (u16)tile->structure_id;
+    planes->structure_health[index] = (u16)quantize_clamped(tile->structure_health, 10.0f, 0, 65535);
+    world_chunk_set_tile_flag(planes->explored, x, y, tile->explored);
+    world_chunk_set_tile_flag(planes->visible, x, y, tile->visible);
+    planes->danger[index] = WORLD_UNIT_TO_U8(tile->danger_level);
+    planes->last_update_time[index] = (u32)tile->last_update_time;
+}
+
 // Generate basic terrain for a chunk
 internal void
 generate_chunk_terrain(generation_context *ctx) {
@@ -36,45 +140,48 @@ generate_chunk_terrain(generation_context *ctx) {
     f32 total_elevation = 0.0f;
     f32 total_temperature = 0.0f;
     
+    f32 row_x[WORLD_CHUNK_SIZE];
+    f32 row_y[WORLD_CHUNK_SIZE];
+    f32 row_elevation[WORLD_CHUNK_SIZE];
+    climate_data row_climate[WORLD_CHUNK_SIZE];
+    
+    for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
+        row_x[x] = (f32)(ctx->global_x + x);
+    }
+    
     // Generate each tile
     for (i32 y = 0; y < WORLD_CHUNK_SIZE; y++) {
+        // PERFORMANCE: Elevation and climate noise for the whole row in batch passes
         for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
-            world_tile *tile = &chunk->tiles[x][y];
-            
-            i32 world_x = ctx->global_x + x;
-            i32 world_y = ctx->global_y + y;
-            
-            // Generate elevation
-            tile->elevation = world_gen_sample_elevation(system, (f32)world_x, (f32)world_y);
+            row_y[x] = (f32)(ctx->global_y + y);
+        }
+        world_gen_sample_elevation_batch(system, row_x, row_y, row_elevation, WORLD_CHUNK_SIZE);
+        world_gen_calculate_climate_batch(system, row_x, row_y, row_elevation, row_climate, WORLD_CHUNK_SIZE);
+        
+        world_tile_planes *planes = &chunk->planes;
+        for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
+            u32 index = WORLD_TILE_INDEX(x, y);
+            f32 elevation = row_elevation[x];
+            climate_data *climate = &row_climate[x];
             
-            // Calculate climate
-            tile->climate = world_gen_calculate_climate(system, (f32)world_x, (f32)world_y, tile->elevation);
+            // Determine biome (from unquantized climate)
+            biome_type biome = world_gen_determine_biome(system, 
+                                                        climate->temperature,
+                                                        climate->humidity, 
+                                                        elevation);
             
-            // Determine biome
-            tile->biome = world_gen_determine_biome(system, 
-                                                   tile->climate.temperature,
-                                                   tile->climate.humidity, 
-                                                   tile->elevation);
+            planes->elevation[index] = elevation;
+            planes->biome[index] = (u8)biome;
+            planes->secondary_biome[index] = (u8)biome;
+            store_tile_climate(planes, index, climate);
             
-            // Initialize other properties
-            tile->secondary_biome = tile->biome;
-            tile->biome_blend = 0.0f;
-            tile->feature = FEATURE_NONE;
-            tile->resource = RESOURCE_NONE;
-            tile->resource_density = 0.0f;
-            tile->resource_quality = 0.0f;
-            tile->structure_id = 0;
-            tile->structure_health = 0.0f;
-            tile->explored = 0;
-            tile->visible = 0;
-            tile->danger_level = 0.0f;
-            tile->last_update_time = 0;
+            // Remaining planes start zeroed: no feature, resource, structure or flags
             
             // Track statistics
-            if (tile->elevation < min_elevation) min_elevation = tile->elevation;
-            if (tile->elevation > max_elevation) max_elevation = tile->elevation;
-            total_elevation += tile->elevation;
-            total_temperature += tile->climate.temperature;
+            if (elevation < min_elevation) min_elevation = elevation;
+            if (elevation > max_elevation) max_elevation = elevation;
+            total_elevation += elevation;
+            total_temperature += climate->temperature;
         }
     }
     
@@ -84,12 +191,10 @@ generate_chunk_terrain(generation_context *ctx) {
     
     // Determine dominant biome
     i32 biome_counts[WORLD_BIOME_COUNT] = {0};
-    for (i32 y = 0; y < WORLD_CHUNK_SIZE; y++) {
-        for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
-            biome_type biome = chunk->tiles[x][y].biome;
-            if (biome < WORLD_BIOME_COUNT) {
-                biome_counts[biome]++;
-            }
+    for (u32 i = 0; i < WORLD_CHUNK_TILES; i++) {
+        u8 biome = chunk->planes.biome[i];
+        if (biome < WORLD_BIOME_COUNT) {
+            biome_counts[biome]++;
         }
     }
     
@@ -100,9 +205,6 @@ generate_chunk_terrain(generation_context *ctx) {
             chunk->dominant_biome = (biome_type)i;
         }
     }
-    
-    printf("[WORLD_GEN] Generated terrain for chunk (%d,%d), dominant biome: %d, avg elevation: %.1fm\n",
-           chunk->chunk_x, chunk->chunk_y, chunk->dominant_biome, chunk->average_elevation);
 }
 
 // Add biome transitions and blending
@@ -111,24 +213,38 @@ generate_chunk_biome_blending(generation_context *ctx) {
     world_chunk *chunk = ctx->chunk;
     world_gen_system *system = ctx->world_gen;
     
+    f32 blend_x[WORLD_CHUNK_SIZE], blend_y[WORLD_CHUNK_SIZE], blend_row[WORLD_CHUNK_SIZE];
+    
     // Add biome transitions for more natural looking boundaries
     for (i32 y = 1; y < WORLD_CHUNK_SIZE - 1; y++) {
+        for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
+            blend_x[x] = (f32)(ctx->global_x + x) * 0.1f;
+            blend_y[x] = (f32)(ctx->global_y + y) * 0.1f;
+        }
+        world_gen_noise_2d_batch(&system->biome_noise, blend_x, blend_y, blend_row, WORLD_CHUNK_SIZE);
+        
+        // CACHE: Three consecutive biome rows, read left to right
+        u8 *above = &chunk->planes.biome[WORLD_TILE_INDEX(0, y - 1)];
+        u8 *row = &chunk->planes.biome[WORLD_TILE_INDEX(0, y)];
+        u8 *below = &chunk->planes.biome[WORLD_TILE_INDEX(0, y + 1)];
+        
         for (i32 x = 1; x < WORLD_CHUNK_SIZE - 1; x++) {
-            world_tile *tile = &chunk->tiles[x][y];
+            u32 index = WORLD_TILE_INDEX(x, y);
+            u8 biome = row[x];
             
             // Check neighboring tiles for different biomes
-            biome_type neighbors[8] = {
-                chunk->tiles[x-1][y-1].biome, chunk->tiles[x][y-1].biome, chunk->tiles[x+1][y-1].biome,
-                chunk->tiles[x-1][y].biome,                               chunk->tiles[x+1][y].biome,
-                chunk->tiles[x-1][y+1].biome, chunk->tiles[x][y+1].biome, chunk->tiles[x+1][y+1].biome
+            u8 neighbors[8] = {
+                above[x-1], above[x], above[x+1],
+                row[x-1],             row[x+1],
+                below[x-1], below[x], below[x+1]
             };
             
             // Count different biomes in neighborhood
             i32 biome_variety = 0;
-            biome_type different_biome = tile->biome;
+            u8 different_biome = biome;
             
             for (i32 i = 0; i < 8; i++) {
-                if (neighbors[i] != tile->biome) {
+                if (neighbors[i] != biome) {
                     biome_variety++;
                     different_biome = neighbors[i];
                 }
@@ -136,15 +252,11 @@ generate_chunk_biome_blending(generation_context *ctx) {
             
             // If we have biome variety, create a transition
             if (biome_variety > 2) {
-                tile->secondary_biome = different_biome;
+                chunk->planes.secondary_biome[index] = different_biome;
                 
                 // Blend factor based on noise for natural transitions
-                i32 world_x = ctx->global_x + x;
-                i32 world_y = ctx->global_y + y;
-                f32 blend_noise = world_gen_noise_2d(&system->biome_noise, 
-                                                    (f32)world_x * 0.1f, (f32)world_y * 0.1f);
-                tile->biome_blend = (blend_noise + 1.0f) * 0.5f; // 0-1 range
-                tile->biome_blend = fmaxf(0.0f, fminf(1.0f, tile->biome_blend));
+                f32 blend_noise = blend_row[x];
+                chunk->planes.biome_blend[index] = WORLD_UNIT_TO_U8((blend_noise + 1.0f) * 0.5f); // 0-1 range
             }
         }
     }
@@ -156,168 +268,476 @@ generate_chunk_features(generation_context *ctx) {
     world_chunk *chunk = ctx->chunk;
     world_gen_system *system = ctx->world_gen;
     
+    f32 feature_x[WORLD_CHUNK_SIZE], feature_y[WORLD_CHUNK_SIZE], feature_row[WORLD_CHUNK_SIZE];
+    f32 river_x[WORLD_CHUNK_SIZE], river_y[WORLD_CHUNK_SIZE], river_row[WORLD_CHUNK_SIZE];
+    f32 cave_x[WORLD_CHUNK_SIZE], cave_y[WORLD_CHUNK_SIZE], cave_row[WORLD_CHUNK_SIZE];
+    
     for (i32 y = 0; y < WORLD_CHUNK_SIZE; y++) {
         for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
-            world_tile *tile = &chunk->tiles[x][y];
+            f32 world_x = (f32)(ctx->global_x + x);
+            f32 world_y = (f32)(ctx->global_y + y);
+            feature_x[x] = world_x * 0.02f;
+            feature_y[x] = world_y * 0.02f;
+            river_x[x] = world_x * 0.01f;
+            river_y[x] = world_y * 0.01f;
+            cave_x[x] = world_x;
+            cave_y[x] = world_y;
+        }
+        world_gen_noise_2d_batch(&system->detail_noise[0], feature_x, feature_y, feature_row, WORLD_CHUNK_SIZE);
+        world_gen_noise_2d_batch(&system->detail_noise[1], river_x, river_y, river_row, WORLD_CHUNK_SIZE);
+        world_gen_noise_2d_batch(&system->cave_noise, cave_x, cave_y, cave_row, WORLD_CHUNK_SIZE);
+        
+        for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
+            u32 index = WORLD_TILE_INDEX(x, y);
+            f32 elevation = chunk->planes.elevation[index];
+            biome_type biome = (biome_type)chunk->planes.biome[index];
+            terrain_feature feature = (terrain_feature)chunk->planes.feature[index];
             i32 world_x = ctx->global_x + x;
             i32 world_y = ctx->global_y + y;
             
             // Feature placement based on biome and terrain
-            f32 feature_noise = world_gen_noise_2d(&system->detail_noise[0], 
-                                                  (f32)world_x * 0.02f, (f32)world_y * 0.02f);
+            f32 feature_noise = feature_row[x];
             
             // Hills and valleys
-            if (feature_noise > 0.6f && tile->elevation > system->sea_level + 50.0f) {
-                tile->feature = FEATURE_HILL;
-            } else if (feature_noise < -0.6f && tile->elevation > system->sea_level) {
-                tile->feature = FEATURE_VALLEY;
+            if (feature_noise > 0.6f && elevation > system->sea_level + 50.0f) {
+                feature = FEATURE_HILL;
+            } else if (feature_noise < -0.6f && elevation > system->sea_level) {
+                feature = FEATURE_VALLEY;
             }
             
             // Cliffs near elevation changes
             if (x > 0 && y > 0) {
-                f32 elevation_diff = fabsf(tile->elevation - chunk->tiles[x-1][y-1].elevation);
+                f32 elevation_diff = fabsf(elevation - chunk->planes.elevation[WORLD_TILE_INDEX(x - 1, y - 1)]);
                 if (elevation_diff > 100.0f) {
-                    tile->feature = FEATURE_CLIFF;
+                    feature = FEATURE_CLIFF;
                 }
             }
             
             // Rivers in valleys near water
-            f32 river_noise = world_gen_noise_2d(&system->detail_noise[1], 
-                                                (f32)world_x * 0.01f, (f32)world_y * 0.01f);
-            if (river_noise > system->river_threshold && tile->feature == FEATURE_VALLEY) {
-                tile->feature = FEATURE_RIVER;
+            f32 river_noise = river_row[x];
+            if (river_noise > system->river_threshold && feature == FEATURE_VALLEY) {
+                feature = FEATURE_RIVER;
             }
             
             // Lakes in low areas
-            if (tile->elevation < chunk->average_elevation - 20.0f && 
-                tile->elevation > system->sea_level && 
+            if (elevation < chunk->average_elevation - 20.0f && 
+                elevation > system->sea_level && 
                 fast_randf(ctx->random_seed + x + y * WORLD_CHUNK_SIZE) > 0.99f) {
-                tile->feature = FEATURE_LAKE;
+                feature = FEATURE_LAKE;
             }
             
             // Cave entrances in mountains
-            if (tile->biome == BIOME_MOUNTAINS || tile->biome == BIOME_SNOW_MOUNTAINS) {
-                f32 cave_noise = world_gen_noise_2d(&system->cave_noise, (f32)world_x, (f32)world_y);
+            if (biome == BIOME_MOUNTAINS || biome == BIOME_SNOW_MOUNTAINS) {
+                f32 cave_noise = cave_row[x];
                 if (cave_noise > system->cave_threshold) {
-                    tile->feature = FEATURE_CAVE_ENTRANCE;
+                    feature = FEATURE_CAVE_ENTRANCE;
                 }
             }
             
             // Biome-specific features
-            switch (tile->biome) {
+            switch (biome) {
                 case BIOME_DESERT:
                     if (fast_randf(ctx->random_seed + world_x + world_y) > 0.999f) {
-                        tile->feature = FEATURE_OASIS;
+                        feature = FEATURE_OASIS;
                     }
                     break;
                     
                 case BIOME_VOLCANIC:
                     if (fast_randf(ctx->random_seed + world_x + world_y) > 0.995f) {
-                        tile->feature = FEATURE_GEYSER;
+                        feature = FEATURE_GEYSER;
                     }
                     break;
                     
                 case BIOME_TUNDRA:
                     if (fast_randf(ctx->random_seed + world_x + world_y) > 0.998f) {
-                        tile->feature = FEATURE_GLACIER;
+                        feature = FEATURE_GLACIER;
                     }
                     break;
                     
                 default:
                     break;
             }
+            
+            chunk->planes.feature[index] = (u8)feature;
+        }
+    }
+}
+
+// Run one generation stage; stages only touch ctx->chunk and read-only system state
+internal void
+run_generation_stage(generation_context *ctx, chunk_gen_stage stage) {
+    world_chunk *chunk = ctx->chunk;
+    
+    switch (stage) {
+        case CHUNK_STAGE_TERRAIN: {
+            generate_chunk_terrain(ctx);
+            chunk->generated = 1;
+            chunk->climate_calculated = 1; // Done in terrain generation
+        } break;
+        
+        case CHUNK_STAGE_BIOME_BLEND: {
+            generate_chunk_biome_blending(ctx);
+        } break;
+        
+        case CHUNK_STAGE_FEATURES: {
+            generate_chunk_features(ctx);
+            
+            // Resources will be generated separately
+            chunk->resources_calculated = 0;
+            chunk->structures_placed = 0;
+            
+            f32 resource_noise = world_gen_fbm_noise(&ctx->world_gen->resource_noise,
+                                                   (f32)(ctx->global_x), (f32)(ctx->global_y), 4);
+            chunk->resource_richness = (resource_noise + 1.0f) * 0.5f; // 0-1 range
+        } break;
+        
+        default: break;
+    }
+}
+
+internal u64
+world_gen_time_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 1000000ull + (u64)now.tv_nsec / 1000ull;
+}
+
+// =============================================================================
+// CHUNK CACHE
+// =============================================================================
+
+#define WORLD_CHUNK_FILE_VERSION 2
+
+// Find map position holding a chunk, or the empty position ending its probe
+internal u32
+chunk_map_probe(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
+    u32 mask = WORLD_CHUNK_MAP_SIZE - 1;
+    u32 index = world_gen_hash_chunk_id(chunk_x, chunk_y) & mask;
+    
+    while (system->chunk_map[index]) {
+        world_chunk *chunk = &system->active_chunks[system->chunk_map[index] - 1];
+        if (chunk->chunk_x == chunk_x && chunk->chunk_y == chunk_y) {
+            break;
+        }
+        index = (index + 1) & mask;
+    }
+    
+    return index;
+}
+
+internal void
+chunk_map_insert(world_gen_system *system, u32 slot) {
+    world_chunk *chunk = &system->active_chunks[slot];
+    u32 index = chunk_map_probe(system, chunk->chunk_x, chunk->chunk_y);
+    system->chunk_map[index] = (u16)(slot + 1);
+}
+
+// Remove with backward-shift deletion so probes never need tombstones
+internal void
+chunk_map_remove(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
+    u32 mask = WORLD_CHUNK_MAP_SIZE - 1;
+    u32 hole = chunk_map_probe(system, chunk_x, chunk_y);
+    if (!system->chunk_map[hole]) return;
+    
+    system->chunk_map[hole] = 0;
+    
+    for (u32 next = (hole + 1) & mask; system->chunk_map[next]; next = (next + 1) & mask) {
+        world_chunk *chunk = &system->active_chunks[system->chunk_map[next] - 1];
+        u32 home = world_gen_hash_chunk_id(chunk->chunk_x, chunk->chunk_y) & mask;
+        
+        // Entry may move into the hole unless its home lies in (hole, next]
+        b32 home_between = (hole <= next) ? (home > hole && home <= next)
+                                          : (home > hole || home <= next);
+        if (!home_between) {
+            system->chunk_map[hole] = system->chunk_map[next];
+            system->chunk_map[next] = 0;
+            hole = next;
         }
     }
 }
 
+// Drop chunk from the cache and return its slot to the free list
+internal void
+release_chunk_slot(world_gen_system *system, world_chunk *chunk) {
+    u32 slot = (u32)(chunk - system->active_chunks);
+    
+    chunk_map_remove(system, chunk->chunk_x, chunk->chunk_y);
+    chunk->resident = 0;
+    system->free_chunk_slots[system->free_chunk_count++] = (u16)slot;
+    system->active_chunk_count--;
+}
+
+// Clock sweep: clear reference bits until an unreferenced chunk is found
+internal world_chunk *
+select_eviction_victim(world_gen_system *system) {
+    for (u32 step = 0; step < 2 * WORLD_MAX_ACTIVE_CHUNKS; step++) {
+        world_chunk *chunk = &system->active_chunks[system->clock_hand];
+        system->clock_hand = (system->clock_hand + 1) % WORLD_MAX_ACTIVE_CHUNKS;
+        
+        if (!chunk->resident) continue;
+        if (chunk->referenced) {
+            chunk->referenced = 0;
+            continue;
+        }
+        return chunk;
+    }
+    
+    return 0;
+}
+
+internal void
+evict_chunk(world_gen_system *system, world_chunk *chunk) {
+    if (system->spill_path[0] && world_gen_spill_chunk(system, chunk)) {
+        system->chunks_spilled++;
+    }
+    
+    release_chunk_slot(system, chunk);
+    system->chunks_evicted++;
+}
+
+// Take a free slot, evicting under the memory budget if needed
+internal world_chunk *
+acquire_chunk_slot(world_gen_system *system) {
+    while (system->active_chunk_count >= system->max_resident_chunks ||
+           system->free_chunk_count == 0) {
+        world_chunk *victim = select_eviction_victim(system);
+        if (!victim) return 0;
+        evict_chunk(system, victim);
+    }
+    
+    u32 slot = system->free_chunk_slots[--system->free_chunk_count];
+    system->active_chunk_count++;
+    return &system->active_chunks[slot];
+}
+
+void
+world_gen_set_chunk_budget(world_gen_system *system, u64 budget_bytes) {
+    if (!system) return;
+    
+    u64 max_chunks = budget_bytes / sizeof(world_chunk);
+    if (max_chunks < 1) max_chunks = 1;
+    if (max_chunks > WORLD_MAX_ACTIVE_CHUNKS) max_chunks = WORLD_MAX_ACTIVE_CHUNKS;
+    
+    system->chunk_memory_budget = budget_bytes;
+    system->max_resident_chunks = (u32)max_chunks;
+}
+
+void
+world_gen_set_chunk_spill_path(world_gen_system *system, char *directory) {
+    if (!system) return;
+    
+    if (!directory) {
+        system->spill_path[0] = 0;
+        return;
+    }
+    
+    snprintf(system->spill_path, sizeof(system->spill_path), "%s", directory);
+}
+
+// Evict down to the current budget
+void
+world_gen_optimize_chunk_cache(world_gen_system *system) {
+    if (!system) return;
+    
+    while (system->active_chunk_count > system->max_resident_chunks) {
+        world_chunk *victim = select_eviction_victim(system);
+        if (!victim) break;
+        evict_chunk(system, victim);
+    }
+}
+
+internal void
+chunk_spill_filename(world_gen_system *system, i32 chunk_x, i32 chunk_y,
+                     char *buffer, u32 buffer_size) {
+    snprintf(buffer, buffer_size, "%s/chunk_%d_%d.hwc", system->spill_path, chunk_x, chunk_y);
+}
+
+// Spill file layout: header, chunk metadata, then one packed record per tile.
+// Records narrow enums and flags to bytes but keep every float bit-exact, so
+// a reloaded chunk is identical to a regenerated one (plus gameplay state).
+typedef struct world_chunk_file_header {
+    u32 magic;
+    u32 version;
+    u64 world_seed;
+    i32 chunk_x;
+    i32 chunk_y;
+    u32 tile_count;
+    u32 planes_size;  // sizeof(world_tile_planes), rejects stale layouts
+} world_chunk_file_header;
+
+typedef struct world_chunk_file_meta {
+    f32 average_elevation;
+    f32 average_temperature;
+    f32 resource_richness;
+    u32 dominant_biome;
+    u32 flags;  // structures_placed | resources_calculated << 1
+} world_chunk_file_meta;
+
+b32
+world_gen_spill_chunk(world_gen_system *system, world_chunk *chunk) {
+    if (!system || !chunk || !system->spill_path[0]) return 0;
+    
+    char filename[320];
+    chunk_spill_filename(system, chunk->chunk_x, chunk->chunk_y, filename, sizeof(filename));
+    
+    FILE *file = fopen(filename, "wb");
+    if (!file) return 0;
+    
+    world_chunk_file_header header = {
+        WORLD_GEN_MAGIC_NUMBER, WORLD_CHUNK_FILE_VERSION, system->world_seed,
+        chunk->chunk_x, chunk->chunk_y,
+        WORLD_CHUNK_TILES, (u32)sizeof(world_tile_planes)
+    };
+    world_chunk_file_meta meta = {
+        chunk->average_elevation, chunk->average_temperature, chunk->resource_richness,
+        (u32)chunk->dominant_biome,
+        (chunk->structures_placed ? 1u : 0u) | (chunk->resources_calculated ? 2u : 0u)
+    };
+    
+    // PERFORMANCE: Planes are flat arrays - spill is a single write
+    b32 ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(&meta, sizeof(meta), 1, file) == 1 &&
+             fwrite(&chunk->planes, sizeof(chunk->planes), 1, file) == 1;
+    
+    fclose(file);
+    return ok;
+}
+
+b32
+world_gen_reload_chunk(world_gen_system *system, world_chunk *chunk, i32 chunk_x, i32 chunk_y) {
+    if (!system || !chunk || !system->spill_path[0]) return 0;
+    
+    char filename[320];
+    chunk_spill_filename(system, chunk_x, chunk_y, filename, sizeof(filename));
+    
+    FILE *file = fopen(filename, "rb");
+    if (!file) return 0;
+    
+    world_chunk_file_header header;
+    world_chunk_file_meta meta;
+    b32 ok = fread(&header, sizeof(header), 1, file) == 1 &&
+             header.magic == WORLD_GEN_MAGIC_NUMBER &&
+             header.version == WORLD_CHUNK_FILE_VERSION &&
+             header.world_seed == system->world_seed &&
+             header.chunk_x == chunk_x && header.chunk_y == chunk_y &&
+             header.tile_count == WORLD_CHUNK_TILES &&
+             header.planes_size == sizeof(world_tile_planes) &&
+             fread(&meta, sizeof(meta), 1, file) == 1 &&
+             fread(&chunk->planes, sizeof(chunk->planes), 1, file) == 1;
+    
+    fclose(file);
+    if (!ok) return 0;
+    
+    chunk->average_elevation = meta.average_elevation;
+    chunk->average_temperature = meta.average_temperature;
+    chunk->resource_richness = meta.resource_richness;
+    chunk->dominant_biome = (biome_type)meta.dominant_biome;
+    chunk->structures_placed = (meta.flags & 1) != 0;
+    chunk->resources_calculated = (meta.flags & 2) != 0;
+    chunk->generated = 1;
+    chunk->climate_calculated = 1;
+    return 1;
+}
+
+// Look up a resident chunk without generating it
+world_chunk *
+world_gen_find_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
+    if (!system || !system->initialized) return 0;
+    
+    u32 index = chunk_map_probe(system, chunk_x, chunk_y);
+    if (!system->chunk_map[index]) return 0;
+    
+    return &system->active_chunks[system->chunk_map[index] - 1];
+}
+
 // Get or load a chunk
 world_chunk *
 world_gen_get_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
     if (!system || !system->initialized) return 0;
     
-    // Check hash table first
-    u32 hash = world_gen_hash_chunk_id(chunk_x, chunk_y);
-    (void)hash; // Silence unused variable warning for now
-    
-    // Linear probe for collisions
-    for (u32 i = 0; i < system->active_chunk_count; i++) {
-        world_chunk *test_chunk = &system->active_chunks[i];
-        if (test_chunk->chunk_x == chunk_x && test_chunk->chunk_y == chunk_y) {
-            system->cache_hits++;
-            test_chunk->last_access_time = system->total_chunks_generated;
-            test_chunk->access_count++;
-            return test_chunk;
-        }
+    // PERFORMANCE: O(1) expected lookup through the open-addressing map
+    world_chunk *chunk = world_gen_find_chunk(system, chunk_x, chunk_y);
+    if (chunk) {
+        system->cache_hits++;
+        chunk->last_access_time = system->total_chunks_generated;
+        chunk->access_count++;
+        chunk->referenced = 1;
+        return chunk;
     }
     
     system->cache_misses++;
     
-    // Generate new chunk if not found
+    // Generate new chunk if not found (reloads from spill cache when present)
     return world_gen_generate_chunk(system, chunk_x, chunk_y);
 }
 
+// Initialize a chunk slot and register it with the map
+internal void
+begin_chunk(world_gen_system *system, world_chunk *chunk, i32 chunk_x, i32 chunk_y) {
+    memset(chunk, 0, sizeof(world_chunk));
+    
+    chunk->chunk_x = chunk_x;
+    chunk->chunk_y = chunk_y;
+    chunk->chunk_id = ((u64)chunk_x << 32) | (u64)(u32)chunk_y;
+    chunk->last_access_time = system->total_chunks_generated;
+    chunk->access_count = 1;
+    chunk->resident = 1;
+    chunk->referenced = 1;
+    
+    chunk_map_insert(system, (u32)(chunk - system->active_chunks));
+}
+
 // Generate a new chunk
+// Regenerates in place if the chunk is already resident
 world_chunk *
 world_gen_generate_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
     if (!system || !system->initialized) return 0;
     
-    // Check if we have space for more chunks
-    if (system->active_chunk_count >= WORLD_MAX_ACTIVE_CHUNKS) {
-        // TODO: Implement chunk eviction policy
-        printf("[WORLD_GEN] Warning: Maximum active chunks reached\n");
-        return 0;
+    // Generated here, so any queued job for this chunk is redundant
+    world_gen_cancel_chunk(system, chunk_x, chunk_y);
+    
+    world_chunk *chunk = world_gen_find_chunk(system, chunk_x, chunk_y);
+    if (chunk) {
+        release_chunk_slot(system, chunk);
+    } else if (system->spill_path[0]) {
+        // Fast path: reload an evicted chunk from the spill cache
+        chunk = acquire_chunk_slot(system);
+        if (!chunk) return 0;
+        
+        begin_chunk(system, chunk, chunk_x, chunk_y);
+        if (world_gen_reload_chunk(system, chunk, chunk_x, chunk_y)) {
+            system->chunks_reloaded++;
+            return chunk;
+        }
+        release_chunk_slot(system, chunk);
     }
     
-    clock_t start_time = clock();
+    u64 start_time = world_gen_time_us();
     
-    // Allocate new chunk
-    world_chunk *chunk = &system->active_chunks[system->active_chunk_count++];
-    memset(chunk, 0, sizeof(world_chunk));
+    // Allocate new chunk (evicts least recently referenced under budget)
+    chunk = acquire_chunk_slot(system);
+    if (!chunk) {
+        printf("[WORLD_GEN] Warning: No chunk slot available\n");
+        return 0;
+    }
     
-    chunk->chunk_x = chunk_x;
-    chunk->chunk_y = chunk_y;
-    chunk->chunk_id = ((u64)chunk_x << 32) | (u64)chunk_y;
-    chunk->last_access_time = system->total_chunks_generated;
-    chunk->access_count = 1;
+    begin_chunk(system, chunk, chunk_x, chunk_y);
     
     // Set up generation context
     generation_context ctx;
     init_generation_context(&ctx, system, chunk, chunk_x, chunk_y);
     
-    // Generate terrain
-    generate_chunk_terrain(&ctx);
-    chunk->generated = 1;
-    
-    // Generate biome blending
-    generate_chunk_biome_blending(&ctx);
-    
-    // Generate terrain features
-    generate_chunk_features(&ctx);
-    
-    // Resources will be generated separately
-    chunk->resources_calculated = 0;
-    chunk->structures_placed = 0;
-    chunk->climate_calculated = 1; // Already done in terrain generation
+    // Terrain, biome blending, features
+    for (u32 stage = CHUNK_STAGE_TERRAIN; stage < CHUNK_STAGE_COMPLETE; stage++) {
+        run_generation_stage(&ctx, (chunk_gen_stage)stage);
+    }
     
-    // Calculate generation time
-    clock_t end_time = clock();
-    chunk->generation_time_us = (u64)(((f64)(end_time - start_time) / CLOCKS_PER_SEC) * 1000000.0);
+    chunk->generation_time_us = world_gen_time_us() - start_time;
     
     // Update system statistics
     system->total_chunks_generated++;
     system->total_generation_time_us += chunk->generation_time_us;
     
-    // Add to hash table
-    u32 hash = world_gen_hash_chunk_id(chunk_x, chunk_y);
-    system->chunk_hash[hash] = chunk;
-    
-    // Calculate resource richness
-    chunk->resource_richness = 0.0f;
-    f32 resource_noise = world_gen_fbm_noise(&system->resource_noise, 
-                                           (f32)(chunk_x * WORLD_CHUNK_SIZE), 
-                                           (f32)(chunk_y * WORLD_CHUNK_SIZE), 4);
-    chunk->resource_richness = (resource_noise + 1.0f) * 0.5f; // 0-1 range
-    
     printf("[WORLD_GEN] Generated chunk (%d,%d) in %.3f ms, resource richness: %.2f\n",
            chunk_x, chunk_y, (f32)chunk->generation_time_us / 1000.0f, chunk->resource_richness);
     
@@ -325,35 +745,430 @@ world_gen_generate_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
 }
 
 // Unload a chunk from memory
+// Spills to disk first when a spill path is configured
 void
 world_gen_unload_chunk(world_gen_system *system, world_chunk *chunk) {
-    if (!system || !chunk) return;
+    if (!system || !chunk || !chunk->resident) return;
     
-    // Remove from hash table
-    u32 hash = world_gen_hash_chunk_id(chunk->chunk_x, chunk->chunk_y);
-    if (system->chunk_hash[hash] == chunk) {
-        system->chunk_hash[hash] = 0;
+    if (system->spill_path[0] && world_gen_spill_chunk(system, chunk)) {
+        system->chunks_spilled++;
     }
     
-    // Find chunk in active array and remove it
-    for (u32 i = 0; i < system->active_chunk_count; i++) {
-        if (&system->active_chunks[i] == chunk) {
-            // Move last chunk to this position
-            if (i < system->active_chunk_count - 1) {
-                system->active_chunks[i] = system->active_chunks[system->active_chunk_count - 1];
-                
-                // Update hash table for moved chunk
-                world_chunk *moved_chunk = &system->active_chunks[i];
-                u32 moved_hash = world_gen_hash_chunk_id(moved_chunk->chunk_x, moved_chunk->chunk_y);
-                system->chunk_hash[moved_hash] = moved_chunk;
-            }
+    release_chunk_slot(system, chunk);
+    
+    printf("[WORLD_GEN] Unloaded chunk (%d,%d)\n", chunk->chunk_x, chunk->chunk_y);
+}
+
+// =============================================================================
+// GENERATION PIPELINE
+// =============================================================================
+
+// Job lifecycle: FREE -> QUEUED <-> RUNNING (one stage at a time) -> DONE -> FREE.
+// A job owns a staging chunk from its first stage until it is published or
+// cancelled, so workers never write to chunks visible through the cache.
+typedef enum chunk_job_state {
+    CHUNK_JOB_FREE = 0,
+    CHUNK_JOB_QUEUED,
+    CHUNK_JOB_RUNNING,
+    CHUNK_JOB_DONE,
+    CHUNK_JOB_PUBLISHING
+} chunk_job_state;
+
+typedef struct chunk_job {
+    i32 chunk_x;
+    i32 chunk_y;
+    f32 priority;            // Squared distance to focus, lower runs first
+    chunk_gen_stage stage;   // Next stage to run
+    chunk_job_state state;
+    b32 cancelled;           // Set while running, honoured between stages
+    i32 staging;             // Staging chunk index, -1 = none
+    u64 generation_time_us;
+} chunk_job;
+
+struct world_gen_pipeline {
+    world_gen_system *system;
+    
+    pthread_t threads[WORLD_GEN_MAX_WORKERS];
+    u32 worker_count;
+    b32 running;
+    
+    // THREADING: mutex guards jobs, staging free list and counters below
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    
+    chunk_job jobs[WORLD_GEN_MAX_JOBS];
+    u32 live_jobs;
+    
+    world_chunk *staging;    // Allocated from the system arena
+    u32 staging_count;
+    u32 free_staging[WORLD_GEN_STAGING_CHUNKS];
+    u32 free_staging_count;
+    
+    f32 focus_x;
+    f32 focus_y;
+    f32 keep_radius;         // <= 0 disables distance cancellation
+};
+
+internal f32
+job_priority(struct world_gen_pipeline *pipeline, i32 chunk_x, i32 chunk_y) {
+    f32 dx = (f32)chunk_x - pipeline->focus_x;
+    f32 dy = (f32)chunk_y - pipeline->focus_y;
+    return dx * dx + dy * dy;
+}
+
+internal chunk_job *
+find_job(struct world_gen_pipeline *pipeline, i32 chunk_x, i32 chunk_y) {
+    for (u32 i = 0; i < WORLD_GEN_MAX_JOBS; i++) {
+        chunk_job *job = &pipeline->jobs[i];
+        if (job->state != CHUNK_JOB_FREE && !job->cancelled &&
+            job->chunk_x == chunk_x && job->chunk_y == chunk_y) {
+            return job;
+        }
+    }
+    return 0;
+}
+
+// Caller holds the mutex
+internal void
+free_job(struct world_gen_pipeline *pipeline, chunk_job *job) {
+    if (job->staging >= 0) {
+        pipeline->free_staging[pipeline->free_staging_count++] = (u32)job->staging;
+        job->staging = -1;
+        // A staging chunk became available for queued jobs
+        pthread_cond_broadcast(&pipeline->work_cond);
+    }
+    job->state = CHUNK_JOB_FREE;
+    job->cancelled = 0;
+    pipeline->live_jobs--;
+}
+
+// Caller holds the mutex. Running jobs are dropped by their worker.
+internal void
+cancel_job(struct world_gen_pipeline *pipeline, chunk_job *job) {
+    pipeline->system->chunks_cancelled++;
+    if (job->state == CHUNK_JOB_RUNNING || job->state == CHUNK_JOB_PUBLISHING) {
+        job->cancelled = 1;
+    } else {
+        free_job(pipeline, job);
+    }
+}
+
+// Highest priority runnable job. Jobs without a staging chunk can only start
+// when one is free, so partially generated chunks are never starved.
+internal chunk_job *
+pick_job(struct world_gen_pipeline *pipeline) {
+    chunk_job *best = 0;
+    
+    for (u32 i = 0; i < WORLD_GEN_MAX_JOBS; i++) {
+        chunk_job *job = &pipeline->jobs[i];
+        if (job->state != CHUNK_JOB_QUEUED) continue;
+        if (job->staging < 0 && pipeline->free_staging_count == 0) continue;
+        if (!best || job->priority < best->priority) {
+            best = job;
+        }
+    }
+    
+    return best;
+}
+
+internal void *
+pipeline_worker(void *arg) {
+    struct world_gen_pipeline *pipeline = (struct world_gen_pipeline *)arg;
+    
+    pthread_mutex_lock(&pipeline->mutex);
+    
+    while (pipeline->running) {
+        chunk_job *job = pick_job(pipeline);
+        if (!job) {
+            pthread_cond_wait(&pipeline->work_cond, &pipeline->mutex);
+            continue;
+        }
+        
+        if (job->staging < 0) {
+            job->staging = (i32)pipeline->free_staging[--pipeline->free_staging_count];
+            world_chunk *chunk = &pipeline->staging[job->staging];
+            memset(chunk, 0, sizeof(world_chunk));
+            chunk->chunk_x = job->chunk_x;
+            chunk->chunk_y = job->chunk_y;
+            job->generation_time_us = 0;
+        }
+        job->state = CHUNK_JOB_RUNNING;
+        
+        chunk_gen_stage stage = job->stage;
+        world_chunk *chunk = &pipeline->staging[job->staging];
+        pthread_mutex_unlock(&pipeline->mutex);
+        
+        // PERFORMANCE: Stage runs without the lock
+        u64 start_time = world_gen_time_us();
+        generation_context ctx;
+        init_generation_context(&ctx, pipeline->system, chunk, chunk->chunk_x, chunk->chunk_y);
+        run_generation_stage(&ctx, stage);
+        u64 elapsed = world_gen_time_us() - start_time;
+        
+        pthread_mutex_lock(&pipeline->mutex);
+        job->generation_time_us += elapsed;
+        job->stage = (chunk_gen_stage)(stage + 1);
+        
+        if (job->cancelled) {
+            free_job(pipeline, job);
+        } else if (job->stage == CHUNK_STAGE_COMPLETE) {
+            job->state = CHUNK_JOB_DONE;
+        } else {
+            // Requeue so a nearer chunk can run its next stage first
+            job->state = CHUNK_JOB_QUEUED;
+        }
+    }
+    
+    pthread_mutex_unlock(&pipeline->mutex);
+    return 0;
+}
+
+b32
+world_gen_start_pipeline(world_gen_system *system, u32 worker_count) {
+    if (!system || !system->initialized) return 0;
+    if (system->pipeline && system->pipeline->running) return 1;
+    
+    if (worker_count == 0) worker_count = 1;
+    if (worker_count > WORLD_GEN_MAX_WORKERS) worker_count = WORLD_GEN_MAX_WORKERS;
+    
+    struct world_gen_pipeline *pipeline = system->pipeline;
+    
+    // Pipeline and staging chunks come from the system arena on first start
+    if (!pipeline) {
+        u32 offset = (system->memory_used + 63) & ~63u;
+        u32 available = system->memory_size > offset ? system->memory_size - offset : 0;
+        if (available < sizeof(struct world_gen_pipeline) + sizeof(world_chunk)) {
+            printf("[WORLD_GEN] Warning: Not enough memory for generation pipeline\n");
+            return 0;
+        }
+        
+        pipeline = (struct world_gen_pipeline *)(system->memory + offset);
+        memset(pipeline, 0, sizeof(*pipeline));
+        
+        u32 staging_offset = (offset + (u32)sizeof(*pipeline) + 63) & ~63u;
+        u32 staging_count = (system->memory_size - staging_offset) / (u32)sizeof(world_chunk);
+        if (staging_count > WORLD_GEN_STAGING_CHUNKS) staging_count = WORLD_GEN_STAGING_CHUNKS;
+        
+        pipeline->staging = (world_chunk *)(system->memory + staging_offset);
+        pipeline->staging_count = staging_count;
+        system->memory_used = staging_offset + staging_count * (u32)sizeof(world_chunk);
+        
+        pipeline->system = system;
+        system->pipeline = pipeline;
+    }
+    
+    pthread_mutex_init(&pipeline->mutex, 0);
+    pthread_cond_init(&pipeline->work_cond, 0);
+    
+    for (u32 i = 0; i < WORLD_GEN_MAX_JOBS; i++) {
+        pipeline->jobs[i].state = CHUNK_JOB_FREE;
+        pipeline->jobs[i].staging = -1;
+    }
+    pipeline->live_jobs = 0;
+    pipeline->free_staging_count = pipeline->staging_count;
+    for (u32 i = 0; i < pipeline->staging_count; i++) {
+        pipeline->free_staging[i] = pipeline->staging_count - 1 - i;
+    }
+    
+    pipeline->running = 1;
+    pipeline->worker_count = 0;
+    for (u32 i = 0; i < worker_count; i++) {
+        if (pthread_create(&pipeline->threads[i], 0, pipeline_worker, pipeline) != 0) {
+            break;
+        }
+        pipeline->worker_count++;
+    }
+    
+    if (pipeline->worker_count == 0) {
+        pipeline->running = 0;
+        pthread_cond_destroy(&pipeline->work_cond);
+        pthread_mutex_destroy(&pipeline->mutex);
+        return 0;
+    }
+    
+    printf("[WORLD_GEN] Generation pipeline started: %u workers, %u staging chunks\n",
+           pipeline->worker_count, pipeline->staging_count);
+    return 1;
+}
+
+// Joins workers and drops unpublished chunks
+void
+world_gen_stop_pipeline(world_gen_system *system) {
+    if (!system || !system->pipeline || !system->pipeline->running) return;
+    
+    struct world_gen_pipeline *pipeline = system->pipeline;
+    
+    pthread_mutex_lock(&pipeline->mutex);
+    pipeline->running = 0;
+    pthread_cond_broadcast(&pipeline->work_cond);
+    pthread_mutex_unlock(&pipeline->mutex);
+    
+    for (u32 i = 0; i < pipeline->worker_count; i++) {
+        pthread_join(pipeline->threads[i], 0);
+    }
+    pipeline->worker_count = 0;
+    
+    for (u32 i = 0; i < WORLD_GEN_MAX_JOBS; i++) {
+        pipeline->jobs[i].state = CHUNK_JOB_FREE;
+        pipeline->jobs[i].staging = -1;
+    }
+    pipeline->live_jobs = 0;
+    
+    pthread_cond_destroy(&pipeline->work_cond);
+    pthread_mutex_destroy(&pipeline->mutex);
+}
+
+// Queue a chunk for background generation. Returns 0 if it cannot be queued;
+// resident or already queued chunks count as success.
+b32
+world_gen_request_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
+    if (!system || !system->pipeline || !system->pipeline->running) return 0;
+    if (world_gen_find_chunk(system, chunk_x, chunk_y)) return 1;
+    
+    struct world_gen_pipeline *pipeline = system->pipeline;
+    b32 queued = 0;
+    
+    pthread_mutex_lock(&pipeline->mutex);
+    
+    chunk_job *job = find_job(pipeline, chunk_x, chunk_y);
+    if (job) {
+        queued = 1;
+    } else if (pipeline->live_jobs < WORLD_GEN_MAX_JOBS) {
+        for (u32 i = 0; i < WORLD_GEN_MAX_JOBS; i++) {
+            job = &pipeline->jobs[i];
+            if (job->state != CHUNK_JOB_FREE) continue;
+            
+            job->chunk_x = chunk_x;
+            job->chunk_y = chunk_y;
+            job->priority = job_priority(pipeline, chunk_x, chunk_y);
+            job->stage = CHUNK_STAGE_TERRAIN;
+            job->cancelled = 0;
+            job->staging = -1;
+            job->state = CHUNK_JOB_QUEUED;
+            pipeline->live_jobs++;
             
-            system->active_chunk_count--;
+            pthread_cond_signal(&pipeline->work_cond);
+            queued = 1;
             break;
         }
     }
     
-    printf("[WORLD_GEN] Unloaded chunk (%d,%d)\n", chunk->chunk_x, chunk->chunk_y);
+    pthread_mutex_unlock(&pipeline->mutex);
+    return queued;
+}
+
+void
+world_gen_cancel_chunk(world_gen_system *system, i32 chunk_x, i32 chunk_y) {
+    if (!system || !system->pipeline || !system->pipeline->running) return;
+    
+    struct world_gen_pipeline *pipeline = system->pipeline;
+    
+    pthread_mutex_lock(&pipeline->mutex);
+    chunk_job *job = find_job(pipeline, chunk_x, chunk_y);
+    if (job) {
+        cancel_job(pipeline, job);
+    }
+    pthread_mutex_unlock(&pipeline->mutex);
+}
+
+// Reprioritize queued work around the camera and cancel chunks that moved
+// out of keep_radius (in chunks)
+void
+world_gen_set_generation_focus(world_gen_system *system, f32 chunk_x, f32 chunk_y, f32 keep_radius) {
+    if (!system || !system->pipeline || !system->pipeline->running) return;
+    
+    struct world_gen_pipeline *pipeline = system->pipeline;
+    f32 keep_sq = keep_radius * keep_radius;
+    
+    pthread_mutex_lock(&pipeline->mutex);
+    
+    pipeline->focus_x = chunk_x;
+    pipeline->focus_y = chunk_y;
+    pipeline->keep_radius = keep_radius;
+    
+    for (u32 i = 0; i < WORLD_GEN_MAX_JOBS; i++) {
+        chunk_job *job = &pipeline->jobs[i];
+        if (job->state == CHUNK_JOB_FREE || job->cancelled) continue;
+        
+        job->priority = job_priority(pipeline, job->chunk_x, job->chunk_y);
+        if (keep_radius > 0.0f && job->priority > keep_sq) {
+            cancel_job(pipeline, job);
+        }
+    }
+    
+    pthread_mutex_unlock(&pipeline->mutex);
+}
+
+// Move finished chunks into the cache, nearest first.
+// Must run on the thread that owns the system; returns chunks published.
+u32
+world_gen_publish_chunks(world_gen_system *system, u32 max_chunks) {
+    if (!system || !system->pipeline || !system->pipeline->running) return 0;
+    
+    struct world_gen_pipeline *pipeline = system->pipeline;
+    u32 published = 0;
+    
+    while (published < max_chunks) {
+        pthread_mutex_lock(&pipeline->mutex);
+        
+        chunk_job *best = 0;
+        for (u32 i = 0; i < WORLD_GEN_MAX_JOBS; i++) {
+            chunk_job *job = &pipeline->jobs[i];
+            if (job->state != CHUNK_JOB_DONE) continue;
+            if (!best || job->priority < best->priority) {
+                best = job;
+            }
+        }
+        
+        if (!best) {
+            pthread_mutex_unlock(&pipeline->mutex);
+            break;
+        }
+        
+        best->state = CHUNK_JOB_PUBLISHING;
+        world_chunk *staged = &pipeline->staging[best->staging];
+        u64 generation_time_us = best->generation_time_us;
+        pthread_mutex_unlock(&pipeline->mutex);
+        
+        // CACHE: Copy outside the lock; workers only need the mutex for scheduling
+        world_chunk *chunk = 0;
+        if (!world_gen_find_chunk(system, staged->chunk_x, staged->chunk_y)) {
+            chunk = acquire_chunk_slot(system);
+        }
+        
+        if (chunk) {
+            memcpy(chunk, staged, sizeof(world_chunk));
+            chunk->chunk_id = ((u64)chunk->chunk_x << 32) | (u64)(u32)chunk->chunk_y;
+            chunk->generation_time_us = generation_time_us;
+            chunk->last_access_time = system->total_chunks_generated;
+            chunk->access_count = 1;
+            chunk->resident = 1;
+            chunk->referenced = 1;
+            chunk_map_insert(system, (u32)(chunk - system->active_chunks));
+            
+            system->total_chunks_generated++;
+            system->total_generation_time_us += generation_time_us;
+            system->chunks_published++;
+            published++;
+        }
+        
+        pthread_mutex_lock(&pipeline->mutex);
+        free_job(pipeline, best);
+        pthread_mutex_unlock(&pipeline->mutex);
+    }
+    
+    return published;
+}
+
+u32
+world_gen_pending_chunks(world_gen_system *system) {
+    if (!system || !system->pipeline || !system->pipeline->running) return 0;
+    
+    pthread_mutex_lock(&system->pipeline->mutex);
+    u32 pending = system->pipeline->live_jobs;
+    pthread_mutex_unlock(&system->pipeline->mutex);
+    
+    return pending;
 }
 
 // Preload chunks around a center point
@@ -364,6 +1179,25 @@ world_gen_preload_area(world_gen_system *system, i32 center_x, i32 center_y, i32
     i32 center_chunk_x = center_x / WORLD_CHUNK_SIZE;
     i32 center_chunk_y = center_y / WORLD_CHUNK_SIZE;
     
+    // With the pipeline running, queue the area nearest first and return
+    if (system->pipeline && system->pipeline->running) {
+        world_gen_set_generation_focus(system, (f32)center_chunk_x, (f32)center_chunk_y,
+                                       system->pipeline->keep_radius);
+        
+        u32 chunks_queued = 0;
+        for (i32 dy = -radius; dy <= radius; dy++) {
+            for (i32 dx = -radius; dx <= radius; dx++) {
+                if (world_gen_request_chunk(system, center_chunk_x + dx, center_chunk_y + dy)) {
+                    chunks_queued++;
+                }
+            }
+        }
+        
+        printf("[WORLD_GEN] Requested %u chunks around (%d,%d)\n",
+               chunks_queued, center_chunk_x, center_chunk_y);
+        return;
+    }
+    
     printf("[WORLD_GEN] Preloading %dx%d chunk area around (%d,%d)\n", 
            radius * 2 + 1, radius * 2 + 1, center_chunk_x, center_chunk_y);
     
@@ -410,12 +1244,11 @@ world_gen_print_chunk_info(world_chunk *chunk) {
     i32 feature_counts[16] = {0};
     i32 biome_counts[WORLD_BIOME_COUNT] = {0};
     
-    for (i32 y = 0; y < WORLD_CHUNK_SIZE; y++) {
-        for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
-            world_tile *tile = &chunk->tiles[x][y];
-            if (tile->feature < 16) feature_counts[tile->feature]++;
-            if (tile->biome < WORLD_BIOME_COUNT) biome_counts[tile->biome]++;
-        }
+    for (u32 i = 0; i < WORLD_CHUNK_TILES; i++) {
+        u8 feature = chunk->planes.feature[i];
+        u8 biome = chunk->planes.biome[i];
+        if (feature < 16) feature_counts[feature]++;
+        if (biome < WORLD_BIOME_COUNT) biome_counts[biome]++;
     }
     
     printf("Terrain features:\n");
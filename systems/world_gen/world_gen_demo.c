@@ -176,11 +176,11 @@ test_resource_generation(world_gen_system *world_gen) {
     
     for (i32 y = 0; y < WORLD_CHUNK_SIZE; y++) {
         for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
-            world_tile *tile = &chunk->tiles[x][y];
-            if (tile->resource != RESOURCE_NONE && tile->resource < WORLD_RESOURCE_TYPES) {
-                resource_counts[tile->resource]++;
-                total_density += tile->resource_density;
-                total_quality += tile->resource_quality;
+            world_tile tile = world_chunk_get_tile(chunk, x, y);
+            if (tile.resource != RESOURCE_NONE && tile.resource < WORLD_RESOURCE_TYPES) {
+                resource_counts[tile.resource]++;
+                total_density += tile.resource_density;
+                total_quality += tile.resource_quality;
                 resource_tiles++;
             }
         }
@@ -329,16 +329,16 @@ test_world_gen_integration(world_gen_system *world_gen, achievement_system *achi
                 // Mark some tiles as explored
                 for (i32 y = 0; y < WORLD_CHUNK_SIZE; y += 8) {
                     for (i32 x = 0; x < WORLD_CHUNK_SIZE; x += 8) {
-                        world_tile *tile = &chunk->tiles[x][y];
-                        tile->explored = 1;
+                        world_chunk_set_tile_flag(chunk->planes.explored, x, y, 1);
+                        world_tile tile = world_chunk_get_tile(chunk, x, y);
                         
                         // Count discoveries
-                        if (tile->biome != BIOME_OCEAN) biomes_discovered++;
-                        if (tile->resource != RESOURCE_NONE) resources_found++;
-                        if (tile->feature != FEATURE_NONE) features_discovered++;
+                        if (tile.biome != BIOME_OCEAN) biomes_discovered++;
+                        if (tile.resource != RESOURCE_NONE) resources_found++;
+                        if (tile.feature != FEATURE_NONE) features_discovered++;
                         
                         // Trigger exploration achievements
-                        world_gen_trigger_exploration_achievements(world_gen, achievements, tile);
+                        world_gen_trigger_exploration_achievements(world_gen, achievements, &tile);
                     }
                 }
             }
@@ -247,7 +247,7 @@ calculate_resource_probability(resource_pattern *pattern, world_tile *tile,
 // Determine what resource (if any) spawns at a location
 resource_type
 world_gen_determine_resource(generation_context *ctx, i32 x, i32 y) {
-    world_tile *tile = &ctx->chunk->tiles[x][y];
+    world_tile tile = world_chunk_get_tile(ctx->chunk, x, y);
     i32 world_x = ctx->global_x + x;
     i32 world_y = ctx->global_y + y;
     
@@ -265,7 +265,7 @@ world_gen_determine_resource(generation_context *ctx, i32 x, i32 y) {
     for (u32 i = 1; i < WORLD_RESOURCE_TYPES; i++) { // Skip RESOURCE_NONE
         resource_pattern *pattern = &patterns[i-1];
         
-        f32 probability = calculate_resource_probability(pattern, tile, 
+        f32 probability = calculate_resource_probability(pattern, &tile, 
                                                        (f32)world_x, (f32)world_y, 
                                                        ctx->world_gen);
         
@@ -284,7 +284,7 @@ f32
 world_gen_calculate_resource_density(generation_context *ctx, resource_type resource, i32 x, i32 y) {
     if (resource == RESOURCE_NONE) return 0.0f;
     
-    world_tile *tile = &ctx->chunk->tiles[x][y];
+    world_tile tile = world_chunk_get_tile(ctx->chunk, x, y);
     i32 world_x = ctx->global_x + x;
     i32 world_y = ctx->global_y + y;
     
@@ -297,21 +297,21 @@ world_gen_calculate_resource_density(generation_context *ctx, resource_type reso
     f32 biome_modifier = 1.0f;
     switch (resource) {
         case RESOURCE_STONE:
-            biome_modifier = tile->biome == BIOME_MOUNTAINS ? 1.5f : 1.0f;
+            biome_modifier = tile.biome == BIOME_MOUNTAINS ? 1.5f : 1.0f;
             break;
         case RESOURCE_IRON:
         case RESOURCE_GOLD:
         case RESOURCE_DIAMOND:
-            biome_modifier = tile->elevation > 500.0f ? 1.3f : 0.8f;
+            biome_modifier = tile.elevation > 500.0f ? 1.3f : 0.8f;
             break;
         case RESOURCE_WOOD:
-            biome_modifier = (tile->biome == BIOME_FOREST || tile->biome == BIOME_JUNGLE) ? 1.5f : 0.5f;
+            biome_modifier = (tile.biome == BIOME_FOREST || tile.biome == BIOME_JUNGLE) ? 1.5f : 0.5f;
             break;
         case RESOURCE_WATER:
-            biome_modifier = tile->climate.humidity;
+            biome_modifier = tile.climate.humidity;
             break;
         case RESOURCE_OIL:
-            biome_modifier = tile->elevation < 100.0f ? 1.2f : 0.6f;
+            biome_modifier = tile.elevation < 100.0f ? 1.2f : 0.6f;
             break;
         default:
             biome_modifier = 1.0f;
@@ -333,15 +333,15 @@ world_gen_distribute_resources(generation_context *ctx) {
     // Process each tile
     for (i32 y = 0; y < WORLD_CHUNK_SIZE; y++) {
         for (i32 x = 0; x < WORLD_CHUNK_SIZE; x++) {
-            world_tile *tile = &chunk->tiles[x][y];
+            u32 index = WORLD_TILE_INDEX(x, y);
             
             // Determine resource type
             resource_type resource = world_gen_determine_resource(ctx, x, y);
-            tile->resource = resource;
+            chunk->planes.resource[index] = (u8)resource;
             
             if (resource != RESOURCE_NONE) {
                 // Calculate density and quality
-                tile->resource_density = world_gen_calculate_resource_density(ctx, resource, x, y);
+                f32 density = world_gen_calculate_resource_density(ctx, resource, x, y);
                 
                 // Quality is partially random, partially based on depth/biome
                 u32 quality_seed = ctx->random_seed + x + y * WORLD_CHUNK_SIZE + (u32)resource * 1000;
@@ -349,16 +349,17 @@ world_gen_distribute_resources(generation_context *ctx) {
                 
                 // Deeper/rarer resources tend to be higher quality
                 f32 depth_bonus = 0.0f;
-                if (tile->elevation > 1000.0f) depth_bonus += 0.2f; // High altitude bonus
+                if (chunk->planes.elevation[index] > 1000.0f) depth_bonus += 0.2f; // High altitude bonus
                 if (resource == RESOURCE_DIAMOND || resource == RESOURCE_GOLD) depth_bonus += 0.3f;
                 
-                tile->resource_quality = fmaxf(0.0f, fminf(1.0f, base_quality + depth_bonus));
+                chunk->planes.resource_density[index] = WORLD_UNIT_TO_U8(density);
+                chunk->planes.resource_quality[index] = WORLD_UNIT_TO_U8(base_quality + depth_bonus);
                 
                 resources_placed++;
-                total_density += tile->resource_density;
+                total_density += density;
             } else {
-                tile->resource_density = 0.0f;
-                tile->resource_quality = 0.0f;
+                chunk->planes.resource_density[index] = 0;
+                chunk->planes.resource_quality[index] = 0;
             }
         }
     }